@@ -0,0 +1,180 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace TimeMaster {
+namespace Bench {
+
+/**
+ * @brief Keep a value alive so the optimizer cannot drop the work producing it
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Statistics for one benchmark (nanoseconds per iteration across runs)
+ */
+struct Result {
+    std::string name;
+    size_t itemsPerIteration;   // Work items processed by one iteration (entities, pairs...)
+    size_t iterationsPerRun;
+    int runs;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double stddevNs;
+    double p95Ns;
+    double maxNs;
+};
+
+/**
+ * @brief Microbenchmark harness: calibrate, warm up, repeat, summarize
+ *
+ * Each benchmark body is one iteration. The harness picks an iteration count so
+ * a single run lasts at least m_minRunSeconds, discards m_warmupRuns runs, then
+ * measures m_measuredRuns runs and reports per-iteration statistics.
+ */
+class Harness {
+private:
+    int m_warmupRuns;
+    int m_measuredRuns;
+    double m_minRunSeconds;
+    std::string m_filter;
+    std::vector<Result> m_results;
+    int m_failures;
+
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Fn>
+    static double TimeRun(Fn& fn, size_t iterations) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        auto end = Clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+public:
+    Harness(int warmupRuns = 3, int measuredRuns = 15, double minRunSeconds = 0.01)
+        : m_warmupRuns(warmupRuns)
+        , m_measuredRuns(measuredRuns)
+        , m_minRunSeconds(minRunSeconds)
+        , m_failures(0) {
+    }
+
+    void SetFilter(const std::string& filter) { m_filter = filter; }
+    void SetRuns(int warmupRuns, int measuredRuns) {
+        m_warmupRuns = warmupRuns;
+        m_measuredRuns = std::max(1, measuredRuns);
+    }
+    const std::vector<Result>& GetResults() const { return m_results; }
+    int GetFailureCount() const { return m_failures; }
+
+    /**
+     * @brief Check a guarantee a benchmark relies on; a failed one makes the
+     * run exit non-zero
+     */
+    void Expect(bool condition, const char* what) {
+        if (condition) return;
+        std::printf("FAILED: %s\n", what);
+        std::fflush(stdout);
+        m_failures++;
+    }
+
+    /**
+     * @brief Run one benchmark
+     * @param name Unique benchmark name (used by --filter and in JSON output)
+     * @param itemsPerIteration Work items per call of fn (for per-item figures)
+     * @param fn Body of one iteration
+     */
+    template <typename Fn>
+    void Run(const char* name, size_t itemsPerIteration, Fn&& fn) {
+        if (!m_filter.empty() && std::strstr(name, m_filter.c_str()) == nullptr) {
+            return;
+        }
+
+        // Calibrate: grow the iteration count until one run is long enough to time reliably
+        size_t iterations = 1;
+        const double minRunNs = m_minRunSeconds * 1e9;
+        for (;;) {
+            double ns = TimeRun(fn, iterations);
+            if (ns >= minRunNs || iterations >= (size_t(1) << 30)) break;
+            double scale = (ns > 0.0) ? (minRunNs / ns) * 1.2 : 10.0;
+            iterations = static_cast<size_t>(std::ceil(iterations * std::min(std::max(scale, 1.5), 100.0)));
+        }
+
+        for (int i = 0; i < m_warmupRuns; ++i) {
+            TimeRun(fn, iterations);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(m_measuredRuns);
+        for (int i = 0; i < m_measuredRuns; ++i) {
+            samples.push_back(TimeRun(fn, iterations) / static_cast<double>(iterations));
+        }
+
+        Result result;
+        result.name = name;
+        result.itemsPerIteration = itemsPerIteration;
+        result.iterationsPerRun = iterations;
+        result.runs = m_measuredRuns;
+
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        result.meanNs = sum / samples.size();
+        double variance = 0.0;
+        for (double s : samples) variance += (s - result.meanNs) * (s - result.meanNs);
+        result.stddevNs = std::sqrt(variance / samples.size());
+
+        std::sort(samples.begin(), samples.end());
+        result.minNs = samples.front();
+        result.maxNs = samples.back();
+        result.medianNs = samples[samples.size() / 2];
+        size_t p95Index = static_cast<size_t>(std::ceil(0.95 * samples.size())) - 1;
+        result.p95Ns = samples[std::min(p95Index, samples.size() - 1)];
+
+        std::printf("%-48s %12.1f ns/iter %10.2f ns/item  (min %.1f, p95 %.1f, +/- %.1f%%)\n",
+                    name, result.medianNs, result.medianNs / std::max<size_t>(1, itemsPerIteration),
+                    result.minNs, result.p95Ns,
+                    result.meanNs > 0.0 ? 100.0 * result.stddevNs / result.meanNs : 0.0);
+        std::fflush(stdout);
+
+        m_results.push_back(result);
+    }
+
+    /**
+     * @brief Write all results as JSON
+     */
+    bool WriteJson(const char* path) const {
+        FILE* file = std::fopen(path, "w");
+        if (!file) return false;
+
+        std::fprintf(file, "{\n  \"compiler\": \"%s\",\n  \"warmup_runs\": %d,\n  \"benchmarks\": [\n",
+                     __VERSION__, m_warmupRuns);
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const Result& r = m_results[i];
+            std::fprintf(file,
+                "    {\"name\": \"%s\", \"items_per_iteration\": %zu, \"iterations_per_run\": %zu, \"runs\": %d, "
+                "\"ns_per_iteration\": {\"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"stddev\": %.3f, \"p95\": %.3f, \"max\": %.3f}, "
+                "\"ns_per_item_median\": %.4f}%s\n",
+                r.name.c_str(), r.itemsPerIteration, r.iterationsPerRun, r.runs,
+                r.minNs, r.medianNs, r.meanNs, r.stddevNs, r.p95Ns, r.maxNs,
+                r.medianNs / std::max<size_t>(1, r.itemsPerIteration),
+                (i + 1 < m_results.size()) ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+};
+
+} // namespace Bench
+} // namespace TimeMaster
@@ -0,0 +1,635 @@
+#include "Bench.hpp"
+#include "BoneHitboxes.hpp"
+#include "Boss.hpp"
+#include "BossState.hpp"
+#include "BulletPattern.hpp"
+#include "BulletStore.hpp"
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "FlowField.hpp"
+#include "GameAssets.hpp"
+#include "HitboxHistory.hpp"
+#include "JobSystem.hpp"
+#include "MinionHorde.hpp"
+#include "ParticleSystem.hpp"
+#include "Player.hpp"
+#include "Projectile.hpp"
+#include "Random.hpp"
+#include "Replication.hpp"
+#include "Rewind.hpp"
+#include "Skinning.hpp"
+#include "TimerWheel.hpp"
+#include "Tomato.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace TimeMaster;
+using Bench::DoNotOptimize;
+using Bench::Harness;
+
+namespace {
+
+constexpr float BENCH_DELTA_TIME = 1.0f / 60.0f;
+constexpr int BENCH_PAIR_COUNT = 1024;
+
+float RandomRange(float min, float max) {
+    return min + (max - min) * (static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+}
+
+Vector3 RandomArenaPoint() {
+    return {RandomRange(-ARENA_SIZE, ARENA_SIZE), RandomRange(10.0f, 150.0f), RandomRange(-ARENA_SIZE, ARENA_SIZE)};
+}
+
+// Pairs clustered so roughly half of them overlap
+std::vector<AABB> MakeBoxes(int count, float spread) {
+    std::vector<AABB> boxes;
+    boxes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Vector3 center = {RandomRange(-spread, spread), 50.0f, RandomRange(-spread, spread)};
+        boxes.push_back(AABB::FromCenter(center, {30.0f, 40.0f, 30.0f}));
+    }
+    return boxes;
+}
+
+// A boss-sized cluster of bone capsules around the origin
+CapsuleSet MakeCapsules(float spread) {
+    CapsuleSet capsules = {};
+    for (uint32_t i = 0; i < MAX_HIT_CAPSULES; ++i) {
+        Vector3 start = {RandomRange(-spread, spread), RandomRange(10.0f, 60.0f), RandomRange(-spread, spread)};
+        Vector3 end = Vector3Add(start, {RandomRange(-20.0f, 20.0f), RandomRange(0.0f, 30.0f), RandomRange(-20.0f, 20.0f)});
+        capsules.Add({start, end, RandomRange(4.0f, 12.0f)});
+    }
+    return capsules;
+}
+
+void BenchCollision(Harness& harness) {
+    std::vector<AABB> a = MakeBoxes(BENCH_PAIR_COUNT, 60.0f);
+    std::vector<AABB> b = MakeBoxes(BENCH_PAIR_COUNT, 60.0f);
+    std::vector<Vector3> spheres;
+    for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+        spheres.push_back({RandomRange(-80.0f, 80.0f), RandomRange(0.0f, 100.0f), RandomRange(-80.0f, 80.0f)});
+    }
+
+    harness.Run("collision/AABB::Intersects", BENCH_PAIR_COUNT, [&]() {
+        int hits = 0;
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            hits += a[i].Intersects(b[i]) ? 1 : 0;
+        }
+        DoNotOptimize(hits);
+    });
+
+    harness.Run("collision/ResolveAABBCollision", BENCH_PAIR_COUNT, [&]() {
+        Vector3 total = {0, 0, 0};
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            CollisionResolution r = ResolveAABBCollision(a[i], b[i]);
+            total = Vector3Add(total, r.pushback);
+        }
+        DoNotOptimize(total);
+    });
+
+    // Four boxes of one size against b per call, as minions are resolved
+    std::vector<float> centerX;
+    std::vector<float> centerZ;
+    for (const AABB& box : a) {
+        centerX.push_back(box.GetCenter().x);
+        centerZ.push_back(box.GetCenter().z);
+    }
+    harness.Run("collision/ResolveAABBCollisionXZ_x4", BENCH_PAIR_COUNT, [&]() {
+        Float4 total = Float4::Splat(0.0f);
+        for (int i = 0; i < BENCH_PAIR_COUNT; i += SIMD_WIDTH) {
+            Float4 pushX;
+            Float4 pushZ;
+            ResolveAABBCollisionXZ(Float4::Load(&centerX[i]), Float4::Load(&centerZ[i]), 30.0f, 30.0f, b[i], pushX, pushZ);
+            total = total + pushX + pushZ;
+        }
+        DoNotOptimize(total.Sum());
+    });
+
+    harness.Run("collision/ResolveAABBCollision3D", BENCH_PAIR_COUNT, [&]() {
+        Vector3 total = {0, 0, 0};
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            CollisionResolution r = ResolveAABBCollision3D(a[i], b[i]);
+            total = Vector3Add(total, r.pushback);
+        }
+        DoNotOptimize(total);
+    });
+
+    harness.Run("collision/CheckAABBSphereCollision", BENCH_PAIR_COUNT, [&]() {
+        int hits = 0;
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            hits += CheckAABBSphereCollision(a[i], spheres[i], PROJECTILE_RADIUS) ? 1 : 0;
+        }
+        DoNotOptimize(hits);
+    });
+
+    // A full set of boss bone capsules against each sphere, one at a time and batched
+    CapsuleSet capsules = MakeCapsules(60.0f);
+    harness.Run("collision/CheckCapsuleSphereCollision_x8", BENCH_PAIR_COUNT, [&]() {
+        int hits = 0;
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            bool hit = false;
+            for (uint32_t c = 0; c < capsules.count && !hit; ++c) {
+                hit = CheckCapsuleSphereCollision(capsules.Get(c), spheres[i], PROJECTILE_RADIUS);
+            }
+            hits += hit ? 1 : 0;
+        }
+        DoNotOptimize(hits);
+    });
+
+    harness.Run("collision/CapsuleSet::OverlapsSphere_8", BENCH_PAIR_COUNT, [&]() {
+        int hits = 0;
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            hits += capsules.OverlapsSphere(spheres[i], PROJECTILE_RADIUS) ? 1 : 0;
+        }
+        DoNotOptimize(hits);
+    });
+}
+
+void BenchHitboxHistory(Harness& harness) {
+    // Lag-compensated hit tests: each shot looks up the boss at its shooter's
+    // view tick (0-12 ticks back) and tests the shot against those capsules
+    HitboxHistory history;
+    uint32_t tick = 1;
+    for (; tick <= HITBOX_HISTORY_TICKS; ++tick) {
+        AABB boxes[HITBOX_ENTITIES];
+        for (AABB& box : boxes) box = AABB::FromCenter(RandomArenaPoint(), {30.0f, 40.0f, 30.0f});
+        history.Record(tick, boxes, MakeCapsules(ARENA_SIZE));
+    }
+    uint32_t now = tick - 1;
+    std::vector<Vector3> shots;
+    std::vector<uint32_t> lags;
+    for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+        shots.push_back(RandomArenaPoint());
+        lags.push_back(static_cast<uint32_t>(std::rand()) % (LAG_COMPENSATION_MAX_TICKS + 1));
+    }
+
+    harness.Run("collision/HitboxHistory::Find_lagged_shot", BENCH_PAIR_COUNT, [&]() {
+        int hits = 0;
+        for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+            const CapsuleSet* seen = history.FindBossCapsules(now - lags[i]);
+            hits += seen && seen->OverlapsSphere(shots[i], PROJECTILE_RADIUS) ? 1 : 0;
+        }
+        DoNotOptimize(hits);
+    });
+}
+
+void BenchProjectiles(Harness& harness, int count, const char* name) {
+    // Same storage and systems as Game's player projectiles
+    GameConfig config;
+    ProjectileArchetype projectiles(count);
+    std::vector<uint8_t> status(count, PROJECTILE_FLYING);
+    Vector3 playerPosition = {-200.0f, 15.0f, 0.0f};
+    CapsuleSet capsules = {};
+    capsules.Add({playerPosition, playerPosition, 10.0f});
+    ProjectileTarget target = {&capsules, nullptr, 0};
+    auto refill = [&]() {
+        // Keep the archetype full so the working set stays constant
+        while (!projectiles.IsFull()) {
+            LaunchProjectile(projectiles, RandomArenaPoint(), playerPosition, config.projectileSpeed);
+        }
+    };
+    refill();
+
+    harness.Run(name, count, [&]() {
+        UpdateProjectiles(projectiles, 0, projectiles.GetCount(), BENCH_DELTA_TIME, target, status.data());
+        RemoveFinishedProjectiles(projectiles, status.data());
+        refill();
+        DoNotOptimize(projectiles.GetCount());
+    });
+}
+
+void BenchMinionHorde(Harness& harness, uint32_t count, const char* name) {
+    // One horde tick on this thread: grid, steering toward two players, swap
+    MinionHorde horde(count);
+    Random random(7);
+    horde.Spawn({0.0f, MINION_Y, 0.0f}, 40.0f, ARENA_SIZE - 20.0f, count, random);
+    HordeTargets targets = {};
+    targets.playerCount = 2;
+    targets.players[0] = {-150.0f, 15.0f, 80.0f};
+    targets.players[1] = {120.0f, 15.0f, -90.0f};
+    FlowTargets cells = {};
+    for (uint32_t i = 0; i < targets.playerCount; ++i) {
+        targets.playerBoxes[i] = AABB::FromCenter(targets.players[i], {10.0f, 15.0f, 10.0f});
+        targets.alive[i] = true;
+        cells.cells[cells.count] = FlowField::GetCell(targets.players[i].x, targets.players[i].z);
+        cells.ids[cells.count++] = static_cast<uint8_t>(i);
+    }
+    targets.bossBox = AABB::FromCenter({0.0f, 35.0f, 0.0f}, {24.0f, 35.0f, 24.0f});
+    targets.bossAlive = true;
+    NavGrid grid;
+    FlowField paths(grid);
+    paths.SetTargets(cells);
+    paths.Rebuild();
+    targets.paths = &paths;
+
+    harness.Run(name, count, [&]() {
+        horde.BuildGrid();
+        horde.Steer(0, horde.GetCount(), BENCH_DELTA_TIME, targets);
+        horde.EndStep();
+        DoNotOptimize(horde.GetContacts());
+    });
+}
+
+void BenchBulletStore(Harness& harness) {
+    // Full store, refilled at the tail each tick like pattern volleys do
+    BulletStore store(MAX_BOSS_PROJECTILES);
+    std::vector<uint8_t> hits(MAX_BOSS_PROJECTILES, 0);
+    Vector3 playerPosition = {-200.0f, 15.0f, 0.0f};
+    auto refill = [&]() {
+        uint32_t granted;
+        Bullet* bullets = store.Append(store.GetCapacity() - store.GetCount(), granted);
+        for (uint32_t i = 0; i < granted; ++i) {
+            Vector3 start = RandomArenaPoint();
+            Vector3 direction = Vector3Normalize(Vector3Subtract(playerPosition, start));
+            bullets[i] = {start, Vector3Scale(direction, 200.0f), PROJECTILE_RADIUS, ORANGE};
+        }
+    };
+    refill();
+
+    harness.Run("bullets/update_store_full", MAX_BOSS_PROJECTILES, [&]() {
+        store.Update(0, store.GetCount(), BENCH_DELTA_TIME, &playerPosition, 1, 10.0f, hits.data());
+        store.RemoveDead();
+        refill();
+        DoNotOptimize(store.GetCount());
+    });
+}
+
+void BenchBulletPatterns(Harness& harness, const GameAssets& assets) {
+    // Every bound pattern back to back: emission, integration and compaction per tick
+    const BulletPatternLibrary& patterns = assets.GetPatterns();
+    BulletStore store(MAX_BOSS_PROJECTILES);
+    BulletPatternRunner runner;
+    std::vector<uint8_t> hits(MAX_BOSS_PROJECTILES, 0);
+    Vector3 bossPosition = {200.0f, 45.0f, 0.0f};
+    Vector3 playerPosition = {-200.0f, 15.0f, 0.0f};
+
+    harness.Run("bullets/pattern_tick", 1, [&]() {
+        if (runner.IsIdle()) {
+            for (int s = 0; s < BOSS_STATE_COUNT; ++s) {
+                int pattern = patterns.GetPatternFor(static_cast<BossState>(s));
+                if (pattern >= 0) runner.Start(patterns, pattern, bossPosition, playerPosition);
+            }
+        }
+        runner.Update(BENCH_DELTA_TIME, bossPosition, playerPosition, store);
+        store.Update(0, store.GetCount(), BENCH_DELTA_TIME, &playerPosition, 1, 10.0f, hits.data());
+        store.RemoveDead();
+        DoNotOptimize(store.GetCount());
+    });
+}
+
+void CountTimer(void* context, uint32_t) {
+    ++*static_cast<uint64_t*>(context);
+}
+
+void BenchFlowField(Harness& harness) {
+    // Two players hopping between cells, so every tick has a build to work on
+    NavGrid grid;
+    FlowField paths(grid);
+    FlowTargets targets[2] = {};
+    for (FlowTargets& set : targets) {
+        for (uint32_t i = 0; i < MAX_PLAYERS; ++i) {
+            Vector3 point = RandomArenaPoint();
+            set.cells[set.count] = FlowField::GetCell(point.x, point.z);
+            set.ids[set.count++] = static_cast<uint8_t>(i);
+        }
+    }
+    std::vector<Vector3> chasers;
+    for (int i = 0; i < BENCH_PAIR_COUNT; ++i) {
+        chasers.push_back(RandomArenaPoint());
+    }
+
+    int flip = 0;
+    harness.Run("nav/FlowField::Rebuild", NAV_GRID_CELLS, [&]() {
+        paths.SetTargets(targets[flip ^= 1]);
+        paths.Rebuild();
+    });
+
+    harness.Run("nav/FlowField::Update_budget", FLOW_FIELD_BUDGET, [&]() {
+        paths.SetTargets(targets[flip ^= 1]);
+        paths.Update();
+    });
+
+    harness.Run("nav/FlowField::GetChaseDirection", BENCH_PAIR_COUNT, [&]() {
+        Vector3 total = {0, 0, 0};
+        for (const Vector3& chaser : chasers) {
+            total = Vector3Add(total, paths.GetChaseDirection(chaser, {0.0f, 0.0f, 0.0f}, 0));
+        }
+        DoNotOptimize(total);
+    });
+}
+
+void BenchTimerWheel(Harness& harness) {
+    // Mostly idle timers (pickup lifetimes, cooldowns) with a trickle expiring:
+    // each fired timer is re-armed, so the pending count stays constant
+    TimerWheel timers;
+    uint64_t fired = 0;
+    uint32_t pending = TIMER_WHEEL_CAPACITY - 24;
+    for (uint32_t i = 0; i < pending; ++i) {
+        timers.Schedule(1 + std::rand() % 6000, &CountTimer, &fired);
+    }
+    harness.Run("timers/advance_1k_pending", 1, [&]() {
+        uint64_t before = fired;
+        timers.Advance();
+        for (uint64_t i = before; i < fired; ++i) {
+            timers.Schedule(1 + std::rand() % 6000, &CountTimer, &fired);
+        }
+        DoNotOptimize(fired);
+    });
+
+    harness.Run("timers/schedule_cancel", 1, [&]() {
+        TimerHandle handle = timers.Schedule(1 + std::rand() % 6000, &CountTimer, &fired);
+        timers.Cancel(handle);
+    });
+}
+
+void BenchRewind(Harness& harness) {
+    // A mid-fight frame at full load: entity records (mostly unchanged since
+    // the keyframe) followed by MAX_BOSS_PROJECTILES boss bullets that all
+    // move every tick; bullets that leave the arena are replaced at once, as
+    // a pattern keeping the store full would
+    BulletStore store(MAX_BOSS_PROJECTILES);
+    std::vector<uint8_t> hits(MAX_BOSS_PROJECTILES, 0);
+    Vector3 playerPosition = {-200.0f, 15.0f, 0.0f};
+    auto refill = [&]() {
+        uint32_t granted;
+        Bullet* bullets = store.Append(MAX_BOSS_PROJECTILES - store.GetCount(), granted);
+        for (uint32_t i = 0; i < granted; ++i) {
+            Vector3 start = RandomArenaPoint();
+            Vector3 direction = Vector3Normalize(Vector3Subtract(playerPosition, start));
+            bullets[i] = {start, Vector3Scale(direction, 200.0f), PROJECTILE_RADIUS, ORANGE};
+        }
+    };
+    refill();
+    std::vector<uint32_t> records(256, 0);
+    for (uint32_t i = 0; i < records.size(); ++i) records[i] = static_cast<uint32_t>(std::rand());
+
+    uint32_t maxWords = static_cast<uint32_t>(records.size()) + BulletStore::GetMaxStateWords(MAX_BOSS_PROJECTILES);
+    RewindBuffer rewind(maxWords, REWIND_MAX_FRAMES);
+    uint32_t tick = 0;
+    auto capture = [&]() {
+        store.Update(0, store.GetCount(), BENCH_DELTA_TIME, nullptr, 0, 0.0f, hits.data());
+        store.RemoveDead();
+        refill();
+        records[0] = tick++;
+        StateWriter writer(rewind.GetFrame(), rewind.GetMaxFrameWords());
+        writer.WriteArray(records.data(), static_cast<uint32_t>(records.size()));
+        store.WriteRewind(writer, rewind.GetKeyframeAge());
+        rewind.Push(writer.GetWordCount());
+    };
+
+    // The rewind window must survive the byte budget at full load
+    for (uint32_t i = 0; i < 2 * REWIND_MAX_FRAMES; ++i) {
+        capture();
+    }
+    std::printf("rewind: %u frames in %u KB at %d bullets\n", rewind.GetFrameCount(),
+                rewind.GetStoredBytes() / 1024, MAX_BOSS_PROJECTILES);
+    harness.Expect(rewind.GetFrameCount() >= REWIND_MAX_FRAMES,
+                   "rewind keeps REWIND_MAX_FRAMES frames with MAX_BOSS_PROJECTILES bullets");
+
+    harness.Run("rewind/capture_full_bullets", 1, [&]() {
+        capture();
+        DoNotOptimize(rewind.GetFrameCount());
+    });
+
+    // Decode the newest frame and put it back (one scrub step minus the game restore)
+    harness.Run("rewind/restore_frame", 1, [&]() {
+        uint32_t words = 0;
+        rewind.Pop(words);
+        rewind.Push(words);
+        DoNotOptimize(words);
+    });
+}
+
+void BenchReplication(Harness& harness) {
+    // A server snapshot: 256 boss bullets in flight, encoded against the state
+    // the client acknowledged 4 ticks earlier (a typical round trip)
+    constexpr uint32_t ACK_TICKS = 4;
+    BulletStore store(MAX_BOSS_PROJECTILES);
+    std::vector<uint8_t> hits(MAX_BOSS_PROJECTILES, 0);
+    Vector3 playerPosition = {-200.0f, 15.0f, 0.0f};
+    uint32_t granted;
+    Bullet* bullets = store.Append(REPLICATION_MAX_BULLETS, granted);
+    for (uint32_t i = 0; i < granted; ++i) {
+        Vector3 start = RandomArenaPoint();
+        Vector3 direction = Vector3Normalize(Vector3Subtract(playerPosition, start));
+        bullets[i] = {start, Vector3Scale(direction, 200.0f), PROJECTILE_RADIUS, ORANGE};
+    }
+
+    std::vector<ReplicatedState> states(ACK_TICKS + 1);
+    for (uint32_t t = 0; t <= ACK_TICKS; ++t) {
+        store.Update(0, store.GetCount(), BENCH_DELTA_TIME, nullptr, 0, 0.0f, hits.data());
+        ReplicatedState& state = states[t];
+        state = {};
+        state.tick = t + 1;
+        state.state = static_cast<uint8_t>(GameState::PLAYING);
+        state.playerCount = 1;
+        state.players[0].position = QuantizePosition(Vector3Add(playerPosition, {static_cast<float>(t), 0.0f, 0.0f}));
+        state.players[0].time = static_cast<uint16_t>(6000 - t * 2);
+        state.players[0].alive = true;
+        state.boss.position = QuantizePosition({0.0f, 15.0f, 0.0f});
+        state.boss.time = 30000;
+        state.bulletCount = store.GetCount();
+        for (uint32_t i = 0; i < state.bulletCount; ++i) {
+            state.bullets[i] = QuantizeBullet(store.GetData()[i]);
+        }
+    }
+    const ReplicatedState& base = states[0];
+    const ReplicatedState& current = states[ACK_TICKS];
+
+    uint8_t packet[1400];
+    uint32_t deltaBytes = 0;
+    uint32_t fullBytes = 0;
+    uint32_t written = 0;
+    harness.Run("replication/encode_delta_256_bullets", REPLICATION_MAX_BULLETS, [&]() {
+        deltaBytes = EncodeReplicatedState(current, &base, packet, sizeof(packet), written);
+        DoNotOptimize(packet);
+    });
+    ReplicatedState decoded;
+    harness.Run("replication/decode_delta_256_bullets", REPLICATION_MAX_BULLETS, [&]() {
+        bool ok = DecodeReplicatedState(packet, deltaBytes, &base, current.tick, decoded);
+        DoNotOptimize(ok);
+    });
+    harness.Run("replication/encode_full_256_bullets", REPLICATION_MAX_BULLETS, [&]() {
+        fullBytes = EncodeReplicatedState(current, nullptr, packet, sizeof(packet), written);
+        DoNotOptimize(packet);
+    });
+    std::printf("replication: delta %u B, full %u B (%u of %u bullets fit)\n", deltaBytes, fullBytes, written,
+                current.bulletCount);
+}
+
+void BenchTomatoes(Harness& harness, int count, const char* name) {
+    GameConfig config;
+    TimerWheel timers;
+    TomatoArchetype tomatoes(count);
+    for (int i = 0; i < count; ++i) {
+        Vector3 p = RandomArenaPoint();
+        SpawnTomato(tomatoes, timers, {p.x, ARENA_FLOOR_Y + TOMATO_RADIUS, p.z}, config.tomatoLifetime);
+    }
+    Vector3 playerPosition = {0.0f, ARENA_FLOOR_Y + TOMATO_RADIUS, 0.0f};
+
+    harness.Run(name, count, [&]() {
+        int collected = 0;
+        for (uint32_t row = 0; row < tomatoes.GetCount(); ++row) {
+            collected += OverlapsSphere(tomatoes, row, playerPosition, 10.0f) ? 1 : 0;
+        }
+        DoNotOptimize(collected);
+    });
+}
+
+void BenchTimeStrings(Harness& harness, const GameAssets& assets) {
+    GameConfig config;
+    Player player(config, assets.GetPlayer());
+    char text[16];
+    harness.Run("hud/Player::FormatTime", 1, [&]() {
+        player.FormatTime(text, sizeof(text));
+        DoNotOptimize(text);
+    });
+}
+
+void BenchBossAnimation(Harness& harness, const GameAssets& assets, BossState state, const char* name) {
+    Random random(42);
+    GameConfig config;
+    const ModelAsset& asset = assets.GetBoss();
+    TimerWheel timers;
+    EventBus events;
+    Boss boss(random, config, asset, timers, events);
+    // Skinning lives in the renderer; do the same work it does for each snapshot
+    Skinner skinner;
+    skinner.Init(asset.model);
+    int updates = 0;
+    harness.Run(name, 1, [&]() {
+        // Re-enter the state every simulated second so the boss never leaves it
+        if (updates++ % 60 == 0) {
+            boss.Reset();
+            boss.SetState(state);
+        }
+        timers.Advance();
+        boss.Update(BENCH_DELTA_TIME);
+        BossSnapshot snapshot = boss.GetSnapshot();
+        if (snapshot.animIndex < 0) return;
+        JobSystem& jobs = JobSystem::GetInstance();
+        const ModelAnimation& animation = asset.animations[snapshot.animIndex];
+        if (Job* skinning = skinner.Schedule(jobs, asset.model, animation, snapshot.animFrame)) {
+            jobs.Wait(skinning);
+            skinner.Upload();
+        }
+    });
+}
+
+void BenchSkinning(Harness& harness) {
+    Model model = LoadModel("boss");
+    int animationCount = 0;
+    ModelAnimation* animations = LoadModelAnimations("boss", &animationCount);
+    const ModelAnimation& animation = animations[animationCount - 1];
+    int frame = 0;
+
+    harness.Run("skinning/raylib_UpdateModelAnimation", 1, [&]() {
+        UpdateModelAnimation(model, animation, frame++);
+    });
+
+    Skinner skinner;
+    skinner.Init(model);
+    JobSystem& jobs = JobSystem::GetInstance();
+    harness.Run("skinning/Skinner", 1, [&]() {
+        if (Job* job = skinner.Schedule(jobs, model, animation, frame++)) {
+            jobs.Wait(job);
+        }
+    });
+
+    // The simulation poses only the hit capsules' bones, every tick
+    BoneHitboxRig rig;
+    FitBoneHitboxes(model, rig);
+    CapsuleSet capsules = {};
+    harness.Run("skinning/PoseBoneHitboxes", 1, [&]() {
+        PoseBoneHitboxes(rig, model, &animation, frame++, MatrixIdentity(), 1.0f, capsules);
+        DoNotOptimize(capsules.count);
+    });
+
+    UnloadModelAnimations(animations, animationCount);
+    UnloadModel(model);
+}
+
+void BenchParticles(Harness& harness) {
+    // A full pool of mixed bursts, topped up after each step like a busy fight
+    ParticleSystem particles(MAX_PARTICLES);
+    uint32_t burst = 0;
+    auto refill = [&]() {
+        while (particles.GetCount() < particles.GetCapacity()) {
+            EffectKind kind = static_cast<EffectKind>(burst++ % static_cast<uint32_t>(EffectKind::COUNT));
+            particles.Emit(kind, RandomArenaPoint());
+        }
+    };
+    refill();
+
+    harness.Run("particles/Update_100k", MAX_PARTICLES, [&]() {
+        particles.Update(BENCH_DELTA_TIME);
+        DoNotOptimize(particles.GetCount());
+        refill();
+    });
+}
+
+void PrintUsage(const char* program) {
+    std::printf("Usage: %s [--json <path>] [--filter <substring>] [--runs <n>] [--warmup <n>] [--workers <n>]\n", program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    int runs = 15;
+    int warmup = 3;
+    Harness harness;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            harness.SetFilter(argv[++i]);
+        } else if (arg == "--runs" && hasValue) {
+            runs = std::atoi(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            warmup = std::atoi(argv[++i]);
+        } else if (arg == "--workers" && hasValue) {
+            JobSystem::SetWorkerCount(std::atoi(argv[++i]));
+        } else {
+            PrintUsage(argv[0]);
+            return (arg == "--help" || arg == "-h") ? 0 : 1;
+        }
+    }
+    harness.SetRuns(warmup, runs);
+    std::srand(42);
+    GameAssets assets;
+    assets.Load();
+
+    BenchCollision(harness);
+    BenchHitboxHistory(harness);
+    BenchProjectiles(harness, 10, "projectiles/update_10");
+    BenchProjectiles(harness, 1000, "projectiles/update_1k");
+    BenchProjectiles(harness, 100000, "projectiles/update_100k");
+    BenchMinionHorde(harness, 2000, "horde/Steer_2000");
+    BenchFlowField(harness);
+    BenchBulletStore(harness);
+    BenchTimerWheel(harness);
+    BenchRewind(harness);
+    BenchReplication(harness);
+    BenchBulletPatterns(harness, assets);
+    BenchTomatoes(harness, MAX_TOMATOES, "tomatoes/collection_pool");
+    BenchTomatoes(harness, 1000, "tomatoes/collection_1k");
+    BenchTimeStrings(harness, assets);
+    BenchBossAnimation(harness, assets, BossState::IDLE, "boss/Update_idle_walk");
+    BenchBossAnimation(harness, assets, BossState::ATTACK_3, "boss/Update_attack3");
+    BenchSkinning(harness);
+    BenchParticles(harness);
+
+    if (jsonPath) {
+        if (!harness.WriteJson(jsonPath)) {
+            std::fprintf(stderr, "Failed to write %s\n", jsonPath);
+            return 1;
+        }
+        std::printf("Wrote %s\n", jsonPath);
+    }
+    return harness.GetFailureCount() > 0 ? 1 : 0;
+}
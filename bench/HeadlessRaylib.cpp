@@ -0,0 +1,363 @@
+// Headless stand-ins for the raylib functions used by the benchmarked game code.
+// No window or GL context exists in the benchmark process: draw calls are no-ops,
+// and models/animations are synthesized on the CPU with the same shape as the
+// plant boss (6 meshes, ~2.7k vertices, 92 bones, 7 clips). UpdateMeshBuffer is
+// a no-op, so skinning benchmarks measure the CPU work the game pays for.
+// UpdateModelAnimation keeps raylib's serial CPU skinning as the reference the
+// job-system Skinner is compared against. The dedicated server (server/) links
+// this too; it never loads a model, so only the no-op stand-ins run there. So
+// does the headless game build behind `make perf`: the window, input, 2D and
+// rlgl calls below are no-ops too, so a frame costs its CPU work only.
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr int STUB_MESH_COUNT = 6;
+constexpr int STUB_VERTICES_PER_MESH = 446;   // ~2674 total, like the plant boss
+constexpr int STUB_BONE_COUNT = 92;
+constexpr int STUB_ANIMATION_COUNT = 7;
+constexpr int STUB_FRAME_COUNTS[STUB_ANIMATION_COUNT] = {60, 80, 94, 58, 80, 124, 18};
+const char* const STUB_ANIMATION_NAMES[STUB_ANIMATION_COUNT] = {
+    "Attack1", "Attack2", "Attack3", "Defense1", "Defense2", "Defense3", "Walk"
+};
+
+// Deterministic pseudo-random values so runs are comparable
+unsigned int s_stubSeed = 12345u;
+float StubRandom01() {
+    s_stubSeed = s_stubSeed * 1664525u + 1013904223u;
+    return static_cast<float>(s_stubSeed >> 8) / 16777216.0f;
+}
+
+template <typename T>
+T* StubAlloc(size_t count) {
+    return static_cast<T*>(std::calloc(count, sizeof(T)));
+}
+
+Mesh MakeSkinnedMesh(int vertexCount) {
+    Mesh mesh = {0};
+    mesh.vertexCount = vertexCount;
+    mesh.triangleCount = vertexCount * 3 / 2;
+    mesh.vertices = StubAlloc<float>(vertexCount * 3);
+    mesh.normals = StubAlloc<float>(vertexCount * 3);
+    mesh.animVertices = StubAlloc<float>(vertexCount * 3);
+    mesh.animNormals = StubAlloc<float>(vertexCount * 3);
+    mesh.boneIds = StubAlloc<unsigned char>(vertexCount * 4);
+    mesh.boneWeights = StubAlloc<float>(vertexCount * 4);
+
+    for (int v = 0; v < vertexCount; ++v) {
+        float height = StubRandom01() * 8.0f;
+        float angle = StubRandom01() * 2.0f * PI;
+        mesh.vertices[v * 3 + 0] = cosf(angle) * 1.5f;
+        mesh.vertices[v * 3 + 1] = height;
+        mesh.vertices[v * 3 + 2] = sinf(angle) * 1.5f;
+        mesh.normals[v * 3 + 0] = cosf(angle);
+        mesh.normals[v * 3 + 1] = 0.0f;
+        mesh.normals[v * 3 + 2] = sinf(angle);
+
+        // Four influences along the bone chain nearest to the vertex height
+        int baseBone = static_cast<int>(height / 8.0f * (STUB_BONE_COUNT - 4));
+        float weights[4] = {0.55f, 0.25f, 0.15f, 0.05f};
+        for (int j = 0; j < 4; ++j) {
+            mesh.boneIds[v * 4 + j] = static_cast<unsigned char>(baseBone + j);
+            mesh.boneWeights[v * 4 + j] = weights[j];
+        }
+    }
+    return mesh;
+}
+
+void FreeMesh(Mesh& mesh) {
+    std::free(mesh.vertices);
+    std::free(mesh.normals);
+    std::free(mesh.animVertices);
+    std::free(mesh.animNormals);
+    std::free(mesh.boneIds);
+    std::free(mesh.boneWeights);
+    mesh = Mesh{0};
+}
+
+Transform BindTransform(int bone) {
+    Transform t;
+    t.translation = {0.0f, bone * (8.0f / STUB_BONE_COUNT), 0.0f};
+    t.rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+    t.scale = {1.0f, 1.0f, 1.0f};
+    return t;
+}
+
+} // namespace
+
+extern "C" {
+
+bool FileExists(const char* fileName) {
+    (void)fileName;
+    return true;  // Every asset is synthesized
+}
+
+Model LoadModel(const char* fileName) {
+    (void)fileName;
+    Model model = {0};
+    model.transform = MatrixIdentity();
+    model.meshCount = STUB_MESH_COUNT;
+    model.meshes = StubAlloc<Mesh>(STUB_MESH_COUNT);
+    for (int m = 0; m < STUB_MESH_COUNT; ++m) {
+        model.meshes[m] = MakeSkinnedMesh(STUB_VERTICES_PER_MESH);
+    }
+    model.boneCount = STUB_BONE_COUNT;
+    model.bones = StubAlloc<BoneInfo>(STUB_BONE_COUNT);
+    model.bindPose = StubAlloc<Transform>(STUB_BONE_COUNT);
+    for (int b = 0; b < STUB_BONE_COUNT; ++b) {
+        std::snprintf(model.bones[b].name, sizeof(model.bones[b].name), "bone_%d", b);
+        model.bones[b].parent = b - 1;
+        model.bindPose[b] = BindTransform(b);
+    }
+    return model;
+}
+
+void UnloadModel(Model model) {
+    for (int m = 0; m < model.meshCount; ++m) {
+        FreeMesh(model.meshes[m]);
+    }
+    std::free(model.meshes);
+    std::free(model.bones);
+    std::free(model.bindPose);
+}
+
+ModelAnimation* LoadModelAnimations(const char* fileName, int* animCount) {
+    (void)fileName;
+    ModelAnimation* animations = StubAlloc<ModelAnimation>(STUB_ANIMATION_COUNT);
+    for (int a = 0; a < STUB_ANIMATION_COUNT; ++a) {
+        ModelAnimation& anim = animations[a];
+        anim.boneCount = STUB_BONE_COUNT;
+        anim.frameCount = STUB_FRAME_COUNTS[a];
+        std::snprintf(anim.name, sizeof(anim.name), "%s", STUB_ANIMATION_NAMES[a]);
+        anim.bones = StubAlloc<BoneInfo>(STUB_BONE_COUNT);
+        anim.framePoses = StubAlloc<Transform*>(anim.frameCount);
+        for (int f = 0; f < anim.frameCount; ++f) {
+            anim.framePoses[f] = StubAlloc<Transform>(STUB_BONE_COUNT);
+            float phase = 2.0f * PI * f / anim.frameCount;
+            for (int b = 0; b < STUB_BONE_COUNT; ++b) {
+                Transform pose = BindTransform(b);
+                pose.translation.x += 0.05f * b * sinf(phase);
+                pose.rotation = QuaternionFromAxisAngle({0.0f, 0.0f, 1.0f}, 0.01f * b * sinf(phase + a));
+                anim.framePoses[f][b] = pose;
+            }
+        }
+    }
+    *animCount = STUB_ANIMATION_COUNT;
+    return animations;
+}
+
+void UnloadModelAnimations(ModelAnimation* animations, int count) {
+    for (int a = 0; a < count; ++a) {
+        for (int f = 0; f < animations[a].frameCount; ++f) {
+            std::free(animations[a].framePoses[f]);
+        }
+        std::free(animations[a].framePoses);
+        std::free(animations[a].bones);
+    }
+    std::free(animations);
+}
+
+// Same CPU skinning as raylib 5.0's UpdateModelAnimation, minus rlUpdateVertexBuffer
+void UpdateModelAnimation(Model model, ModelAnimation anim, int frame) {
+    if (anim.frameCount <= 0 || anim.framePoses == nullptr) return;
+    if (frame >= anim.frameCount) frame = frame % anim.frameCount;
+
+    for (int m = 0; m < model.meshCount; m++) {
+        Mesh mesh = model.meshes[m];
+        if (mesh.boneIds == nullptr || mesh.boneWeights == nullptr) continue;
+
+        int boneCounter = 0;
+        const int vValues = mesh.vertexCount * 3;
+        for (int vCounter = 0; vCounter < vValues; vCounter += 3) {
+            mesh.animVertices[vCounter] = 0;
+            mesh.animVertices[vCounter + 1] = 0;
+            mesh.animVertices[vCounter + 2] = 0;
+            mesh.animNormals[vCounter] = 0;
+            mesh.animNormals[vCounter + 1] = 0;
+            mesh.animNormals[vCounter + 2] = 0;
+
+            for (int j = 0; j < 4; j++, boneCounter++) {
+                float boneWeight = mesh.boneWeights[boneCounter];
+                if (boneWeight == 0.0f) continue;
+                int boneId = mesh.boneIds[boneCounter];
+                Vector3 inTranslation = model.bindPose[boneId].translation;
+                Quaternion inRotation = model.bindPose[boneId].rotation;
+                Vector3 outTranslation = anim.framePoses[frame][boneId].translation;
+                Quaternion outRotation = anim.framePoses[frame][boneId].rotation;
+                Vector3 outScale = anim.framePoses[frame][boneId].scale;
+
+                Vector3 animVertex = {mesh.vertices[vCounter], mesh.vertices[vCounter + 1], mesh.vertices[vCounter + 2]};
+                animVertex = Vector3Subtract(animVertex, inTranslation);
+                animVertex = Vector3Multiply(animVertex, outScale);
+                animVertex = Vector3RotateByQuaternion(animVertex, QuaternionMultiply(outRotation, QuaternionInvert(inRotation)));
+                animVertex = Vector3Add(animVertex, outTranslation);
+                mesh.animVertices[vCounter] += animVertex.x * boneWeight;
+                mesh.animVertices[vCounter + 1] += animVertex.y * boneWeight;
+                mesh.animVertices[vCounter + 2] += animVertex.z * boneWeight;
+
+                Vector3 animNormal = {mesh.normals[vCounter], mesh.normals[vCounter + 1], mesh.normals[vCounter + 2]};
+                animNormal = Vector3RotateByQuaternion(animNormal, QuaternionMultiply(outRotation, QuaternionInvert(inRotation)));
+                mesh.animNormals[vCounter] += animNormal.x * boneWeight;
+                mesh.animNormals[vCounter + 1] += animNormal.y * boneWeight;
+                mesh.animNormals[vCounter + 2] += animNormal.z * boneWeight;
+            }
+        }
+    }
+}
+
+BoundingBox GetModelBoundingBox(Model model) {
+    BoundingBox box = {{0, 0, 0}, {0, 0, 0}};
+    bool first = true;
+    for (int m = 0; m < model.meshCount; ++m) {
+        const Mesh& mesh = model.meshes[m];
+        for (int v = 0; v < mesh.vertexCount; ++v) {
+            Vector3 p = {mesh.vertices[v * 3], mesh.vertices[v * 3 + 1], mesh.vertices[v * 3 + 2]};
+            if (first) {
+                box.min = box.max = p;
+                first = false;
+            } else {
+                box.min = Vector3Min(box.min, p);
+                box.max = Vector3Max(box.max, p);
+            }
+        }
+    }
+    return box;
+}
+
+int GetRandomValue(int min, int max) {
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+    return (std::rand() % (std::abs(max - min) + 1) + min);
+}
+
+void TraceLog(int logLevel, const char* text, ...) {
+    (void)logLevel;
+    (void)text;
+}
+
+void SetTextureFilter(Texture2D texture, int filter) {
+    (void)texture;
+    (void)filter;
+}
+
+bool IsKeyDown(int key) {
+    (void)key;
+    return false;
+}
+
+void DrawModel(Model, Vector3, float, Color) {}
+void DrawModelEx(Model, Vector3, Vector3, float, Vector3, Color) {}
+void DrawCube(Vector3, float, float, float, Color) {}
+void DrawCubeWires(Vector3, float, float, float, Color) {}
+void DrawSphere(Vector3, float, Color) {}
+void DrawSphereEx(Vector3, float, int, int, Color) {}
+void DrawCapsuleWires(Vector3, Vector3, float, int, int, Color) {}
+void DrawPlane(Vector3, Vector2, Color) {}
+void DrawGrid(int, float) {}
+void UpdateMeshBuffer(Mesh, int, const void*, int, int) {}
+
+// Window, input and 2D drawing (the headless game build)
+void InitWindow(int, int, const char*) {}
+void CloseWindow(void) {}
+bool WindowShouldClose(void) { return false; }
+void SetConfigFlags(unsigned int) {}
+void SetTargetFPS(int) {}
+void SetTraceLogLevel(int) {}
+float GetFrameTime(void) { return 1.0f / 60.0f; }
+void EnableCursor(void) {}
+void DisableCursor(void) {}
+bool IsKeyPressed(int) { return false; }
+bool IsMouseButtonPressed(int) { return false; }
+Vector2 GetMouseDelta(void) { return Vector2{0.0f, 0.0f}; }
+float GetMouseWheelMove(void) { return 0.0f; }
+
+void BeginDrawing(void) {}
+void EndDrawing(void) {}
+void ClearBackground(Color) {}
+void BeginMode3D(Camera3D) {}
+void EndMode3D(void) {}
+void BeginBlendMode(int) {}
+void EndBlendMode(void) {}
+void DrawLine(int, int, int, int, Color) {}
+void DrawLineEx(Vector2, Vector2, float, Color) {}
+void DrawCircle(int, int, float, Color) {}
+void DrawCircleLines(int, int, float, Color) {}
+void DrawCircleSector(Vector2, float, float, float, int, Color) {}
+void DrawRectangle(int, int, int, int, Color) {}
+void DrawRectangleLines(int, int, int, int, Color) {}
+void DrawRectangleLinesEx(Rectangle, float, Color) {}
+void DrawText(const char*, int, int, int, Color) {}
+void DrawTextEx(Font, const char*, Vector2, float, float, Color) {}
+
+Font LoadFont(const char*) {
+    Font font = {0};
+    return font;
+}
+
+Color Fade(Color color, float alpha) {
+    alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    color.a = static_cast<unsigned char>(255.0f * alpha);
+    return color;
+}
+
+int MeasureText(const char* text, int fontSize) {
+    return static_cast<int>(std::strlen(text)) * fontSize / 2;
+}
+
+const char* TextFormat(const char* text, ...) {
+    // Rotating buffers, like raylib, so a few results can be alive at once
+    static char buffers[4][512];
+    static int index = 0;
+    char* buffer = buffers[index];
+    index = (index + 1) % 4;
+
+    va_list args;
+    va_start(args, text);
+    std::vsnprintf(buffer, sizeof(buffers[0]), text, args);
+    va_end(args);
+    return buffer;
+}
+
+// rlgl (the instanced particle renderer); the shader loads as a non-default
+// program, so the renderer takes its instanced path
+unsigned int rlLoadShaderCode(const char*, const char*) { return 2; }
+void rlUnloadShaderProgram(unsigned int) {}
+unsigned int rlGetShaderIdDefault(void) { return 1; }
+int rlGetLocationAttrib(unsigned int, const char*) { return 0; }
+int rlGetLocationUniform(unsigned int, const char*) { return 0; }
+void rlSetUniform(int, const void*, int, int) {}
+void rlSetUniformMatrix(int, Matrix) {}
+void rlEnableShader(unsigned int) {}
+void rlDisableShader(void) {}
+unsigned int rlLoadVertexArray(void) { return 1; }
+void rlUnloadVertexArray(unsigned int) {}
+bool rlEnableVertexArray(unsigned int) { return true; }
+void rlDisableVertexArray(void) {}
+unsigned int rlLoadVertexBuffer(const void*, int, bool) { return 1; }
+void rlUnloadVertexBuffer(unsigned int) {}
+void rlUpdateVertexBuffer(unsigned int, const void*, int, int) {}
+#if RAYLIB_VERSION_MAJOR > 5 || (RAYLIB_VERSION_MAJOR == 5 && RAYLIB_VERSION_MINOR >= 5)
+void rlSetVertexAttribute(unsigned int, int, int, bool, int, int) {}
+#else
+void rlSetVertexAttribute(unsigned int, int, int, bool, int, const void*) {}
+#endif
+void rlEnableVertexAttribute(unsigned int) {}
+void rlSetVertexAttributeDivisor(unsigned int, int) {}
+void rlDrawVertexArrayInstanced(int, int, int) {}
+void rlDrawRenderBatchActive(void) {}
+void rlEnableDepthMask(void) {}
+void rlDisableDepthMask(void) {}
+Matrix rlGetMatrixModelview(void) { return MatrixIdentity(); }
+Matrix rlGetMatrixProjection(void) { return MatrixIdentity(); }
+
+} // extern "C"
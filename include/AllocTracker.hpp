@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace TimeMaster {
+
+// Allocation tracker configuration (fixed)
+constexpr int ALLOC_MAX_ZONES = 64;               // Matches the profiler's zone registry
+constexpr uint16_t ALLOC_NO_ZONE = 0xFFFF;
+constexpr int ALLOC_CALLSITE_SLOTS = 256;         // Distinct call stacks remembered (power of two)
+constexpr int ALLOC_CALLSTACK_DEPTH = 8;          // Frames captured per call site
+
+/**
+ * @brief Allocation counts for one frame
+ */
+struct AllocCounters {
+    uint32_t allocations;
+    uint64_t bytes;
+};
+
+/**
+ * @brief One attributed call stack (debug builds only)
+ */
+struct AllocCallSite {
+    std::atomic<uint64_t> hash;     // 0 = empty slot
+    std::atomic<uint32_t> count;
+    std::atomic<uint64_t> bytes;
+    void* frames[ALLOC_CALLSTACK_DEPTH];
+    int depth;
+};
+
+/**
+ * @brief Opt-in global heap allocation tracker
+ * The replaced global operator new forwards here. While disabled, the cost of
+ * an allocation is one relaxed atomic load. While enabled, allocations and
+ * bytes are counted per frame and per profiler zone (the innermost
+ * PROFILE_ZONE on the allocating thread); debug builds also record the call
+ * stack so offenders can be listed by call site.
+ */
+class AllocTracker {
+private:
+    static std::atomic<bool> s_enabled;
+    
+    std::atomic<uint32_t> m_frameAllocations;
+    std::atomic<uint64_t> m_frameBytes;
+    std::array<std::atomic<uint32_t>, ALLOC_MAX_ZONES> m_zoneAllocations;
+    
+    AllocCounters m_last;
+    std::array<uint32_t, ALLOC_MAX_ZONES> m_lastZoneAllocations;
+    
+    std::array<AllocCallSite, ALLOC_CALLSITE_SLOTS> m_callSites;
+    std::atomic<uint32_t> m_callSiteOverflow;
+    
+    AllocTracker();
+    AllocTracker(const AllocTracker&) = delete;
+    AllocTracker& operator=(const AllocTracker&) = delete;
+    
+    void RecordCallSite(size_t size);
+    
+public:
+    /**
+     * @brief Get the singleton instance
+     */
+    static AllocTracker& GetInstance();
+    
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Start/stop counting (counters restart on enable)
+     */
+    void SetEnabled(bool enabled);
+    void Toggle() { SetEnabled(!IsEnabled()); }
+    
+    /**
+     * @brief Called by the global operator new (must not allocate)
+     */
+    void OnAllocate(size_t size);
+    
+    /**
+     * @brief Profiler zone tracking for the calling thread
+     * @return The previously active zone, to pass back to LeaveZone
+     */
+    static uint16_t EnterZone(uint16_t zone);
+    static void LeaveZone(uint16_t previous);
+    
+    /**
+     * @brief Close the frame: publish its counters and reset them
+     */
+    void EndFrame();
+    
+    const AllocCounters& GetLastFrame() const { return m_last; }
+    uint32_t GetLastZoneAllocations(uint16_t zone) const { return m_lastZoneAllocations[zone]; }
+    
+    /**
+     * @brief Print the call sites recorded since tracking was enabled,
+     * most frequent first (debug builds; release prints a hint)
+     */
+    void ReportCallSites(int maxSites) const;
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,157 @@
+#pragma once
+#include "Rewind.hpp"
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace TimeMaster {
+
+/**
+ * @brief Stable name of an entity within its archetype (survives row moves)
+ */
+using EntityId = uint32_t;
+constexpr EntityId INVALID_ENTITY = UINT32_MAX;
+
+/**
+ * @brief Entities that all have exactly these components, stored as columns
+ *
+ * Every component type gets one dense array and the live entities occupy
+ * rows [0, GetCount()), so a system walks plain arrays with no per-entity
+ * indirection or virtual call. Destroying an entity moves the last row into
+ * its place; EntityId stays valid across such moves (GetRow maps it to the
+ * current row). Capacity is fixed at construction and nothing allocates
+ * afterwards. Components must be plain data: the whole archetype is copied
+ * word for word into rewind and rollback frames.
+ */
+template <typename... Components>
+class Archetype {
+    static_assert(sizeof...(Components) > 0, "an archetype needs at least one component");
+    static_assert((std::is_trivially_copyable<Components>::value && ...), "components must be plain data");
+
+private:
+    static constexpr uint32_t NO_ROW = UINT32_MAX;
+
+    std::tuple<std::vector<Components>...> m_columns;   // Sized to capacity
+    std::vector<EntityId> m_entities;                   // Row -> entity
+    std::vector<uint32_t> m_rows;                       // Entity -> row (NO_ROW when free)
+    std::vector<EntityId> m_free;                       // Unused ids, next one at the back
+    uint32_t m_count;
+
+public:
+    explicit Archetype(uint32_t capacity)
+        : m_columns(std::vector<Components>(capacity)...)
+        , m_entities(capacity)
+        , m_rows(capacity)
+        , m_free()
+        , m_count(0) {
+        m_free.reserve(capacity);
+        Clear();
+    }
+
+    /**
+     * @brief Add an entity at the tail; the caller fills its components
+     * @return INVALID_ENTITY when the archetype is full
+     */
+    EntityId Create() {
+        if (m_free.empty()) return INVALID_ENTITY;
+        EntityId entity = m_free.back();
+        m_free.pop_back();
+        m_entities[m_count] = entity;
+        m_rows[entity] = m_count;
+        m_count++;
+        return entity;
+    }
+
+    /**
+     * @brief Remove the entity in a row; the last row moves into it
+     */
+    void DestroyRow(uint32_t row) {
+        EntityId entity = m_entities[row];
+        uint32_t last = --m_count;
+        if (row != last) {
+            std::apply([&](auto&... columns) { ((columns[row] = columns[last]), ...); }, m_columns);
+            m_entities[row] = m_entities[last];
+            m_rows[m_entities[row]] = row;
+        }
+        m_rows[entity] = NO_ROW;
+        m_free.push_back(entity);
+    }
+
+    void Destroy(EntityId entity) {
+        if (IsAlive(entity)) DestroyRow(m_rows[entity]);
+    }
+
+    /**
+     * @brief Remove every entity; ids are handed out from 0 again
+     */
+    void Clear() {
+        uint32_t capacity = GetCapacity();
+        m_count = 0;
+        m_free.clear();
+        for (uint32_t i = 0; i < capacity; ++i) {
+            m_rows[i] = NO_ROW;
+            m_free.push_back(capacity - 1 - i);
+        }
+    }
+
+    bool IsAlive(EntityId entity) const { return entity < m_rows.size() && m_rows[entity] != NO_ROW; }
+    uint32_t GetRow(EntityId entity) const { return m_rows[entity]; }
+    EntityId GetEntity(uint32_t row) const { return m_entities[row]; }
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(m_entities.size()); }
+    bool IsFull() const { return m_count == GetCapacity(); }
+
+    /**
+     * @brief Dense column of one component, indexed by row
+     */
+    template <typename T>
+    T* Get() { return std::get<std::vector<T>>(m_columns).data(); }
+    template <typename T>
+    const T* Get() const { return std::get<std::vector<T>>(m_columns).data(); }
+
+    /**
+     * @brief Serialize the live rows and the id allocator (rewind, rollback)
+     */
+    void Write(StateWriter& writer) const {
+        writer.Write(m_count);
+        writer.WriteArray(m_entities.data(), m_count);
+        writer.WriteArray(m_free.data(), GetCapacity() - m_count);
+        std::apply([&](const auto&... columns) { (writer.WriteArray(columns.data(), m_count), ...); }, m_columns);
+    }
+
+    /**
+     * @brief Restore what Write saved
+     * @return false (and empty) if the frame is truncated or does not fit
+     */
+    bool Read(StateReader& reader) {
+        uint32_t count = 0;
+        uint32_t capacity = GetCapacity();
+        if (!reader.Read(count) || count > capacity) {
+            Clear();
+            return false;
+        }
+        m_count = count;
+        m_free.resize(capacity - count);
+        bool ok = reader.ReadArray(m_entities.data(), count) && reader.ReadArray(m_free.data(), capacity - count);
+        std::apply([&](auto&... columns) { ((ok = ok && reader.ReadArray(columns.data(), count)), ...); }, m_columns);
+        for (uint32_t i = 0; i < capacity; ++i) {
+            m_rows[i] = NO_ROW;
+        }
+        for (uint32_t row = 0; ok && row < count; ++row) {
+            ok = m_entities[row] < capacity;
+            if (ok) m_rows[m_entities[row]] = row;
+        }
+        if (!ok) Clear();
+        return ok;
+    }
+
+    /**
+     * @brief Upper bound of Write's output for an archetype of this capacity
+     */
+    static constexpr uint32_t GetMaxStateWords(uint32_t capacity) {
+        return 1 + capacity + (((static_cast<uint32_t>(sizeof(Components)) * capacity + 3) / 4) + ...);
+    }
+};
+
+} // namespace TimeMaster
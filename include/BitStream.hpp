@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief Little-endian bit packer over a caller-owned buffer
+ * Bits collect in a 64-bit register and go out a byte at a time. Writes past
+ * the capacity are dropped and clear IsValid.
+ */
+class BitWriter {
+private:
+    uint8_t* m_data;
+    uint32_t m_capacity;
+    uint32_t m_size;      // Whole bytes written
+    uint64_t m_pending;
+    uint32_t m_pendingBits;
+    bool m_valid;
+
+public:
+    BitWriter(uint8_t* data, uint32_t capacity)
+        : m_data(data), m_capacity(capacity), m_size(0), m_pending(0), m_pendingBits(0), m_valid(true) {}
+
+    /**
+     * @brief Append the low `bits` bits of value (1-32)
+     */
+    void Write(uint32_t value, uint32_t bits) {
+        m_pending |= (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << m_pendingBits;
+        m_pendingBits += bits;
+        while (m_pendingBits >= 8) {
+            if (m_size < m_capacity) {
+                m_data[m_size++] = static_cast<uint8_t>(m_pending);
+            } else {
+                m_valid = false;
+            }
+            m_pending >>= 8;
+            m_pendingBits -= 8;
+        }
+    }
+
+    void WriteBool(bool value) { Write(value ? 1u : 0u, 1); }
+
+    /**
+     * @brief Pad the last byte with zeros
+     * @return Bytes written (0 if the buffer overflowed)
+     */
+    uint32_t Finish() {
+        if (m_pendingBits > 0) {
+            Write(0, 8 - m_pendingBits);
+        }
+        return m_valid ? m_size : 0;
+    }
+
+    uint32_t GetBitCount() const { return m_size * 8 + m_pendingBits; }
+    bool IsValid() const { return m_valid; }
+};
+
+/**
+ * @brief Bounds-checked bit reader; reads past the end yield zeros and clear IsValid
+ */
+class BitReader {
+private:
+    const uint8_t* m_data;
+    uint32_t m_size;
+    uint32_t m_offset;
+    uint64_t m_pending;
+    uint32_t m_pendingBits;
+    bool m_valid;
+
+public:
+    BitReader(const uint8_t* data, uint32_t size)
+        : m_data(data), m_size(size), m_offset(0), m_pending(0), m_pendingBits(0), m_valid(true) {}
+
+    /**
+     * @brief Next `bits` bits (1-32)
+     */
+    uint32_t Read(uint32_t bits) {
+        while (m_pendingBits < bits) {
+            uint64_t byte = 0;
+            if (m_offset < m_size) {
+                byte = m_data[m_offset++];
+            } else {
+                m_valid = false;
+            }
+            m_pending |= byte << m_pendingBits;
+            m_pendingBits += 8;
+        }
+        uint32_t value = static_cast<uint32_t>(m_pending & ((1ull << bits) - 1));
+        m_pending >>= bits;
+        m_pendingBits -= bits;
+        return value;
+    }
+
+    bool ReadBool() { return Read(1) != 0; }
+    bool IsValid() const { return m_valid; }
+};
+
+} // namespace TimeMaster
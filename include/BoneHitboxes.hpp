@@ -0,0 +1,46 @@
+#pragma once
+#include "Collision.hpp"
+#include "raylib.h"
+#include <cstdint>
+
+namespace TimeMaster {
+
+// Bone hitbox configuration (fixed)
+constexpr uint32_t BONE_HITBOX_MIN_VERTICES = 8;   // Bones driving fewer vertices get no capsule
+
+/**
+ * @brief A capsule around the vertices one bone drives, in bind-pose model space
+ */
+struct BoneCapsule {
+    int bone;
+    Capsule capsule;
+};
+
+/**
+ * @brief Hit capsules fitted to a skinned model (once, at load)
+ */
+struct BoneHitboxRig {
+    BoneCapsule capsules[MAX_HIT_CAPSULES];
+    uint32_t count;         // 0 when the model has no skin to fit
+    float modelBottom;      // Lowest bind-pose point (y), where the model stands
+};
+
+/**
+ * @brief Fit capsules to the bones of a loaded model
+ * Each vertex belongs to its most weighted bone. The bones owning the most
+ * vertices (up to MAX_HIT_CAPSULES) get a capsule along the principal axis
+ * of their vertices, just wide and long enough to hold all of them.
+ */
+void FitBoneHitboxes(const Model& model, BoneHitboxRig& rig);
+
+/**
+ * @brief Pose the rig for one animation frame and place it in the world
+ * End points go through their bone's skinning transform (MakeSkinBone, the
+ * same one CPU skinning applies to the vertices), then modelToWorld; radii
+ * are multiplied by radiusScale and the bone's largest pose scale.
+ * @param animation nullptr keeps the bind pose
+ */
+void PoseBoneHitboxes(const BoneHitboxRig& rig, const Model& model, const ModelAnimation* animation, int frame,
+                      const Matrix& modelToWorld, float radiusScale, CapsuleSet& capsules);
+
+} // namespace TimeMaster
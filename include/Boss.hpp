@@ -1,22 +1,65 @@
 #pragma once
-#include "Entity.hpp"
 #include "Config.hpp"
 #include "Collision.hpp"
 #include "BossState.hpp"
+#include "Random.hpp"
+#include "GameAssets.hpp"
+#include "TimerWheel.hpp"
+#include "EventBus.hpp"
 #include "raylib.h"
+#include <cstddef>
 
 namespace TimeMaster {
 
 // Forward declaration
 class Player;
 
-class Boss : public Entity, public IDamageable, public ITimedEntity {
+/**
+ * @brief What the renderer needs to draw the Boss (copied into frame snapshots)
+ */
+struct BossSnapshot {
+    Vector3 position;
+    Vector3 size;
+    float rotation;
+    float time;
+    BossState state;
+    int animIndex;   // -1 = no animation playing
+    int animFrame;
+    Color color;
+    CapsuleSet hitCapsules;
+    bool alive;
+    bool showHitbox;
+};
+
+/**
+ * @brief Everything about the Boss that changes during a match (rewind frames)
+ */
+struct BossRecord {
+    Vector3 position;
+    Vector3 velocity;
+    float targetRotation;
+    float currentRotation;
+    float time;
+    float moveTimer;
+    float animTimer;
+    uint64_t attackReadyTick;
+    TimerRecord stateTimer;
+    int animIndex;
+    int animFrame;
+    Color color;
+    BossState state;
+    bool alive;
+    bool hasAttackedInState;
+};
+
+class Boss {
 private:
     // Position and physics
     float m_moveSpeed;
     Vector3 m_position;
     Vector3 m_velocity;
     Vector3 m_size;  // Width, Height, Depth (for hitbox)
+    CapsuleSet m_hitCapsules;  // What player projectiles hit, posed with the animation
     
     // Rotation and orientation
     float m_targetRotation;   // Target Y rotation to face player
@@ -25,54 +68,62 @@ private:
     
     // Game state
     float m_time;
-    float m_attackCooldown;
+    uint64_t m_attackReadyTick;   // Wheel tick when the attack cooldown ends
     float m_moveTimer;
     bool m_isAlive;
     Color m_color;
     
+    // Shared game RNG, settings, timers and events (owned by Game), read-only model data
+    Random& m_random;
+    const GameConfig& m_config;
+    const ModelAsset& m_asset;
+    TimerWheel& m_timers;
+    EventBus& m_events;
+    
     // Animation state
     BossState m_currentState;
-    float m_stateTimer;       // Time spent in current state
+    TimerHandle m_stateTimer;  // Ends the current state
     bool m_hasAttackedInState; // Track if attack was triggered in current attack state
     
-    // 3D Model
-    Model m_model;
-    ModelAnimation* m_animations;
-    int m_animationCount;
+    // Animation playback
     int m_currentAnimFrame;
     int m_currentAnimIndex;   // Currently playing animation index
     float m_animTimer;         // Timer for current animation playback
-    bool m_modelLoaded;
     
     // Debug
     bool m_showDebugHitbox;
     
     // Private methods
     void UpdateRotation(Vector3 playerPosition, float deltaTime);
-    void UpdateState(float deltaTime);
-    void LoadModel();
-    void UnloadModel();
-    void MoveTowards(const Vector3& target, float deltaTime);
+    void ScheduleStateTimer();
+    void OnStateTimer();
+    static void StateTimerExpired(void* context, uint32_t data);
+    void MoveTowards(const Vector3& target, Vector3 direction, float deltaTime);
+    void PoseHitCapsules();
     
 public:
-    Boss();
-    ~Boss();
+    Boss(Random& random, const GameConfig& config, const ModelAsset& asset,
+         TimerWheel& timers, EventBus& events);
     
-    // Entity interface
-    void Update(float deltaTime) override;
-    void UpdateWithPlayer(Vector3 playerPosition, float deltaTime);
-    void Draw() const override;
-    bool IsActive() const override { return m_isAlive; }
-    Vector3 GetPosition() const override { return m_position; }
+    // Lifecycle
+    void Update(float deltaTime);
+    /**
+     * @brief Update, turn toward the player and, when idle, walk along
+     * moveDirection (a unit vector on the floor, e.g. from the flow field)
+     */
+    void UpdateWithPlayer(Vector3 playerPosition, Vector3 moveDirection, float deltaTime);
+    void Draw() const;
+    bool IsActive() const { return m_isAlive; }
+    Vector3 GetPosition() const { return m_position; }
     
-    // IDamageable interface
-    void TakeDamage(float damage) override;
-    bool IsAlive() const override { return m_isAlive; }
-    float GetHealth() const override { return m_time; }
+    // Health
+    void TakeDamage(float damage);
+    bool IsAlive() const { return m_isAlive; }
+    float GetHealth() const { return m_time; }
     
-    // ITimedEntity interface
-    std::string GetTimeString() const override;
-    float GetTime() const override { return m_time; }
+    // Time (health) display
+    const char* FormatTime(char* buffer, size_t size) const;
+    float GetTime() const { return m_time; }
     
     // Boss specific methods
     void Reset();
@@ -81,6 +132,14 @@ public:
     bool CheckCollisionWithPlayer(const Player& player) const;
     void ToggleDebugHitbox() { m_showDebugHitbox = !m_showDebugHitbox; }
     
+    // Rewind (load after the timer wheel was restarted at the record's tick)
+    BossRecord SaveRecord() const;
+    void LoadRecord(const BossRecord& record);
+    
+    // Rendering
+    BossSnapshot GetSnapshot() const;
+    static void DrawSnapshot(const BossSnapshot& snapshot, const ModelAsset& asset);
+    
     // State management
     void SetState(BossState newState);
     BossState GetState() const { return m_currentState; }
@@ -89,9 +148,14 @@ public:
     
     // Collision
     AABB GetAABB() const;
+    /**
+     * @brief Capsules on the model's bones as posed this tick (one upright
+     * capsule filling the hitbox when there is no skinned model)
+     */
+    const CapsuleSet& GetHitCapsules() const { return m_hitCapsules; }
     void ApplyPushback(Vector3 pushback);
     Vector3 GetSize() const { return m_size; }
-    void SetPosition(Vector3 position) { m_position = position; }
+    void SetPosition(Vector3 position) { m_position = position; PoseHitCapsules(); }
 };
 
 } // namespace TimeMaster
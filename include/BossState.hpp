@@ -13,4 +13,20 @@ enum class BossState {
     DEATH       // Death animation (for later)
 };
 
+constexpr int BOSS_STATE_COUNT = 5;
+
+/**
+ * @brief State name as used in logs and data files
+ */
+inline const char* GetBossStateName(BossState state) {
+    switch (state) {
+        case BossState::IDLE:     return "IDLE";
+        case BossState::ATTACK_1: return "ATTACK_1";
+        case BossState::ATTACK_2: return "ATTACK_2";
+        case BossState::ATTACK_3: return "ATTACK_3";
+        case BossState::DEATH:    return "DEATH";
+    }
+    return "?";
+}
+
 } // namespace TimeMaster
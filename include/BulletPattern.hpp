@@ -0,0 +1,140 @@
+#pragma once
+#include "BossState.hpp"
+#include "BulletStore.hpp"
+#include "raylib.h"
+#include <string>
+#include <vector>
+
+namespace TimeMaster {
+
+// Bullet pattern configuration (fixed)
+constexpr int MAX_PATTERN_EMITTERS = 64;     // Volleys running at once per game
+constexpr int MAX_PATTERN_SHOT_BULLETS = 256; // Bullets in one shot of one volley
+constexpr float MIN_PATTERN_INTERVAL = 0.001f;
+constexpr const char* BULLET_PATTERNS_PATH = "assets/patterns/boss_patterns.json";
+
+/**
+ * @brief How the bullets of one shot are laid out
+ */
+enum class PatternShape : uint8_t {
+    FAN,          // Spread evenly over an arc
+    RING,         // Spread evenly over the full circle
+    SPIRAL,       // Ring whose base direction turns every shot
+    AIMED_BURST   // Fan re-aimed at the player on every shot
+};
+
+/**
+ * @brief One emitter of a pattern: `shots` shots of `count` bullets each
+ * Angles are yaw in radians; the base direction is taken relative to the
+ * boss->player direction when the pattern starts (every shot for bursts).
+ * Every bullet of a shot is pitched so it reaches the player's height.
+ */
+struct PatternVolley {
+    PatternShape shape;
+    int count;        // Bullets per shot
+    float arc;        // Spread of one shot (FAN / AIMED_BURST)
+    float angle;      // Offset from the aim direction
+    float turn;       // Added to the base direction after each shot
+    float delay;      // Seconds from pattern start to the first shot
+    float interval;   // Seconds between shots
+    int shots;
+    float speed;
+    float radius;
+    Color color;
+};
+
+/**
+ * @brief A named group of volleys started together
+ */
+struct BulletPattern {
+    std::string name;
+    uint32_t firstVolley;
+    uint32_t volleyCount;
+};
+
+/**
+ * @brief Bullet patterns read from a data file, bound to boss attack states
+ * Loaded once and shared read-only (lives in GameAssets). When nothing is
+ * loaded no state has a pattern and the boss fires single aimed shots.
+ */
+class BulletPatternLibrary {
+private:
+    std::vector<PatternVolley> m_volleys;
+    std::vector<BulletPattern> m_patterns;
+    int m_bindings[BOSS_STATE_COUNT];   // Pattern index per BossState, -1 = none
+
+public:
+    BulletPatternLibrary();
+
+    /**
+     * @brief Replace the library with the patterns in a JSON file
+     * @return false (and an empty library) if the file is missing or invalid
+     */
+    bool LoadFile(const char* path);
+
+    void Clear();
+
+    /**
+     * @brief Pattern index by name (-1 if unknown)
+     */
+    int Find(const char* name) const;
+
+    /**
+     * @brief Pattern bound to a boss state (-1 if none)
+     */
+    int GetPatternFor(BossState state) const { return m_bindings[static_cast<int>(state)]; }
+
+    int GetPatternCount() const { return static_cast<int>(m_patterns.size()); }
+    const BulletPattern& GetPattern(int index) const { return m_patterns[index]; }
+    const PatternVolley* GetVolleys(const BulletPattern& pattern) const { return m_volleys.data() + pattern.firstVolley; }
+    uint32_t GetVolleyIndex(const PatternVolley* volley) const { return static_cast<uint32_t>(volley - m_volleys.data()); }
+};
+
+/**
+ * @brief One running volley (plain data, so it can be saved in rewind frames)
+ */
+struct PatternEmitter {
+    const PatternVolley* volley;   // Into the shared library
+    float timer;       // Seconds from the start of the next tick to the next shot
+    float baseAngle;   // World yaw of the next shot
+    int shotsLeft;
+};
+
+/**
+ * @brief Runs started patterns and emits their shots into a BulletStore
+ * One per Game. Emitters live in a fixed array, so starting and running
+ * patterns never allocates; each shot is written as one contiguous batch.
+ */
+class BulletPatternRunner {
+private:
+    PatternEmitter m_emitters[MAX_PATTERN_EMITTERS];
+    int m_emitterCount;
+
+    static void Fire(PatternEmitter& emitter, float shotTime, Vector3 origin, Vector3 target, BulletStore& store);
+
+public:
+    BulletPatternRunner();
+
+    /**
+     * @brief Start every volley of a pattern, aimed from origin at target
+     */
+    void Start(const BulletPatternLibrary& library, int pattern, Vector3 origin, Vector3 target);
+
+    /**
+     * @brief Emit the shots due during the next deltaTime seconds
+     * Call before the bullet update: shots due part-way through the tick are
+     * back-dated so they end the tick where they would have flown to.
+     */
+    void Update(float deltaTime, Vector3 origin, Vector3 target, BulletStore& store);
+
+    void Clear() { m_emitterCount = 0; }
+
+    bool IsIdle() const { return m_emitterCount == 0; }
+    int GetActiveEmitters() const { return m_emitterCount; }
+    
+    // Rewind
+    const PatternEmitter* GetEmitters() const { return m_emitters; }
+    void Restore(const PatternEmitter* emitters, int count);
+};
+
+} // namespace TimeMaster
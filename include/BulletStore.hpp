@@ -0,0 +1,90 @@
+#pragma once
+#include "Rewind.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+/**
+ * @brief One boss bullet (plain data, stored contiguously)
+ */
+struct Bullet {
+    Vector3 position;
+    Vector3 velocity;
+    float radius;
+    Color color;
+};
+
+/**
+ * @brief Fixed-capacity contiguous store of live boss bullets
+ * Live bullets are packed in [0, count): pattern volleys append a whole
+ * batch at the tail and dead bullets are swap-removed once per tick, so
+ * updates and snapshots walk one dense array. Never allocates after
+ * construction; a volley that does not fit is truncated.
+ */
+class BulletStore {
+private:
+    std::vector<Bullet> m_bullets;   // Sized to capacity up front
+    std::vector<uint8_t> m_dead;     // Per slot, set by Update
+    uint32_t m_count;
+
+public:
+    explicit BulletStore(uint32_t capacity);
+
+    /**
+     * @brief Claim up to count slots at the tail for one volley
+     * @param granted Receives how many slots were claimed (0 when full)
+     * @return First claimed slot, to be filled by the caller
+     */
+    Bullet* Append(uint32_t count, uint32_t& granted);
+
+    /**
+     * @brief Move bullets [begin, end) and test them against the targets
+     * Bullets that leave the arena or hit die; hits[i] is set per slot to
+     * 1 + the index of the first target hit, or 0. Disjoint ranges may be
+     * updated from parallel jobs.
+     */
+    void Update(uint32_t begin, uint32_t end, float deltaTime,
+                const Vector3* targets, uint32_t targetCount, float targetRadius, uint8_t* hits);
+
+    /**
+     * @brief Drop the bullets that died in Update (reorders the survivors)
+     */
+    void RemoveDead();
+
+    void Clear() { m_count = 0; }
+
+    /**
+     * @brief Serialize the live bullets exactly (rollback)
+     */
+    void Write(StateWriter& writer) const;
+
+    /**
+     * @brief Serialize the live bullets for the rewind history
+     * Velocities are quantized as for replication and positions stored in
+     * REPLICATION_POSITION_STEP fixed point as where each bullet was `age`
+     * ticks earlier. A bullet that kept its slot since the keyframe `age`
+     * frames back then writes the words it wrote there, so a delta only
+     * carries the slots that changed.
+     */
+    void WriteRewind(StateWriter& writer, uint32_t age) const;
+
+    /**
+     * @brief Restore what Write or WriteRewind saved (WriteRewind bullets
+     * come back within a REPLICATION_POSITION_STEP or so)
+     * @return false (and empty) if the frame is truncated or does not fit
+     */
+    bool Read(StateReader& reader);
+    bool ReadRewind(StateReader& reader);
+
+    static constexpr uint32_t GetMaxStateWords(uint32_t capacity) {
+        return 2 + capacity * static_cast<uint32_t>(sizeof(Bullet) / sizeof(uint32_t));
+    }
+
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(m_bullets.size()); }
+    const Bullet* GetData() const { return m_bullets.data(); }
+};
+
+} // namespace TimeMaster
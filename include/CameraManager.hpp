@@ -1,5 +1,6 @@
 #pragma once
 #include "raylib.h"
+#include "Input.hpp"
 #include <memory>
 
 namespace TimeMaster {
@@ -22,6 +23,7 @@ private:
     // Mouse control
     float m_mouseSensitivity;
     bool m_cursorLocked;
+    int m_debugLogCounter;  // Throttles the per-frame debug log
 
     void ClampCameraToArena();
     
@@ -37,12 +39,12 @@ public:
     /**
      * @brief Update camera to follow player (third-person)
      */
-    void UpdateThirdPerson(Vector3 playerPosition, float deltaTime);
+    void UpdateThirdPerson(Vector3 playerPosition, const InputFrame& input, float deltaTime);
     
     /**
      * @brief Update camera with mouse input (always active)
      */
-    void HandleMouseInput(float deltaTime);
+    void HandleMouseInput(const InputFrame& input);
     
     /**
      * @brief Get camera forward direction (for movement)
@@ -54,6 +56,13 @@ public:
      */
     Vector3 GetRightDirection() const;
     
+    /**
+     * @brief Movement axes for a camera angle around the player (degrees),
+     * so players without a local camera move the same way
+     */
+    static Vector3 GetForwardDirection(float angleAroundPlayer);
+    static Vector3 GetRightDirection(float angleAroundPlayer);
+    
     /**
      * @brief Toggle between static and third-person mode
      */
@@ -76,9 +85,15 @@ public:
     
     /**
      * @brief Toggle cursor lock (for menu access)
+     * Only records the wanted state; the renderer applies it to the window.
      */
     void ToggleCursorLock();
     
+    /**
+     * @brief Lock (gameplay) or release (menus) the cursor
+     */
+    void SetCursorLocked(bool locked) { m_cursorLocked = locked; }
+    
     /**
      * @brief Check if cursor is locked
      */
@@ -1,6 +1,8 @@
 #pragma once
 #include "raylib.h"
 #include "raymath.h"
+#include "Simd.hpp"
+#include <cstdint>
 
 namespace TimeMaster {
 
@@ -98,6 +100,38 @@ inline CollisionResolution ResolveAABBCollision(const AABB& a, const AABB& b) {
     return {true, pushback};
 }
 
+/**
+ * @brief ResolveAABBCollision for four boxes of one size against box b, batched
+ * The boxes are given by their centers (x and z lanes) and half-extents on
+ * the horizontal plane; the caller checks that they overlap b on Y. Each lane
+ * gets the same axis of least penetration and sign as ResolveAABBCollision;
+ * lanes that do not intersect b get no pushback.
+ * @return Lanes that intersect b
+ */
+inline Mask4 ResolveAABBCollisionXZ(Float4 centerX, Float4 centerZ, float halfX, float halfZ, const AABB& b,
+                                    Float4& pushbackX, Float4& pushbackZ) {
+    Float4 minX = centerX - Float4::Splat(halfX);
+    Float4 maxX = centerX + Float4::Splat(halfX);
+    Float4 minZ = centerZ - Float4::Splat(halfZ);
+    Float4 maxZ = centerZ + Float4::Splat(halfZ);
+    Float4 bMinX = Float4::Splat(b.min.x);
+    Float4 bMaxX = Float4::Splat(b.max.x);
+    Float4 bMinZ = Float4::Splat(b.min.z);
+    Float4 bMaxZ = Float4::Splat(b.max.z);
+    Mask4 hit = (minX <= bMaxX) & (maxX >= bMinX) & (minZ <= bMaxZ) & (maxZ >= bMinZ);
+
+    Vector3 centerB = b.GetCenter();
+    Float4 overlapX = Select(maxX < bMaxX, maxX - bMinX, bMaxX - minX);
+    Float4 overlapZ = Select(maxZ < bMaxZ, maxZ - bMinZ, bMaxZ - minZ);
+    Float4 zero = Float4::Splat(0.0f);
+    Float4 pushX = Select(centerX < Float4::Splat(centerB.x), zero - overlapX, overlapX);
+    Float4 pushZ = Select(centerZ < Float4::Splat(centerB.z), zero - overlapZ, overlapZ);
+    Mask4 alongX = overlapX < overlapZ;
+    pushbackX = Select(hit & alongX, pushX, zero);
+    pushbackZ = Select(hit, Select(alongX, zero, pushZ), zero);
+    return hit;
+}
+
 /**
  * @brief Resolve collision between two AABBs with full 3D pushback
  * This version considers all three axes including Y
@@ -154,6 +188,106 @@ inline bool CheckAABBSphereCollision(const AABB& box, Vector3 sphereCenter, floa
     return distanceSquared <= (sphereRadius * sphereRadius);
 }
 
+// Capsule sets hold this many capsules at most (a multiple of SIMD_WIDTH)
+constexpr uint32_t MAX_HIT_CAPSULES = 8;
+static_assert(MAX_HIT_CAPSULES % SIMD_WIDTH == 0, "capsule columns must fill whole Float4 steps");
+
+/**
+ * @brief Every point within radius of the segment from start to end
+ */
+struct Capsule {
+    Vector3 start;
+    Vector3 end;
+    float radius;
+};
+
+/**
+ * @brief Check collision between a capsule and a sphere
+ * Closest point on the segment, then a distance test (the scalar form of
+ * CapsuleSet::OverlapsSphere)
+ */
+inline bool CheckCapsuleSphereCollision(const Capsule& capsule, Vector3 sphereCenter, float sphereRadius) {
+    Vector3 axis = Vector3Subtract(capsule.end, capsule.start);
+    float lengthSquared = Vector3LengthSqr(axis);
+    float t = lengthSquared > 0.0f
+        ? Clamp(Vector3DotProduct(Vector3Subtract(sphereCenter, capsule.start), axis) / lengthSquared, 0.0f, 1.0f)
+        : 0.0f;
+    Vector3 closestPoint = Vector3Add(capsule.start, Vector3Scale(axis, t));
+    float reach = capsule.radius + sphereRadius;
+    return Vector3LengthSqr(Vector3Subtract(sphereCenter, closestPoint)) <= reach * reach;
+}
+
+/**
+ * @brief Up to MAX_HIT_CAPSULES capsules stored as columns
+ * OverlapsSphere tests a sphere against four capsules per Float4 step. The
+ * axis and its inverse squared length are kept per capsule, so the kernel
+ * has no division and a zero-length capsule (a sphere) needs no branch.
+ */
+struct CapsuleSet {
+    float startX[MAX_HIT_CAPSULES];
+    float startY[MAX_HIT_CAPSULES];
+    float startZ[MAX_HIT_CAPSULES];
+    float axisX[MAX_HIT_CAPSULES];          // end - start
+    float axisY[MAX_HIT_CAPSULES];
+    float axisZ[MAX_HIT_CAPSULES];
+    float inverseLengthSquared[MAX_HIT_CAPSULES];   // 0 for a zero-length axis
+    float radius[MAX_HIT_CAPSULES];
+    uint32_t count;
+
+    void Clear() { count = 0; }
+
+    /**
+     * @brief Append a capsule (ignored once the set is full)
+     */
+    void Add(const Capsule& capsule) {
+        if (count >= MAX_HIT_CAPSULES) return;
+        Vector3 axis = Vector3Subtract(capsule.end, capsule.start);
+        float lengthSquared = Vector3LengthSqr(axis);
+        startX[count] = capsule.start.x;
+        startY[count] = capsule.start.y;
+        startZ[count] = capsule.start.z;
+        axisX[count] = axis.x;
+        axisY[count] = axis.y;
+        axisZ[count] = axis.z;
+        inverseLengthSquared[count] = lengthSquared > 0.0f ? 1.0f / lengthSquared : 0.0f;
+        radius[count] = capsule.radius;
+        count++;
+    }
+
+    Capsule Get(uint32_t i) const {
+        Vector3 start = {startX[i], startY[i], startZ[i]};
+        return {start, Vector3Add(start, {axisX[i], axisY[i], axisZ[i]}), radius[i]};
+    }
+
+    /**
+     * @brief Whether the sphere touches any capsule of the set
+     */
+    bool OverlapsSphere(Vector3 center, float sphereRadius) const {
+        Float4 centerX = Float4::Splat(center.x);
+        Float4 centerY = Float4::Splat(center.y);
+        Float4 centerZ = Float4::Splat(center.z);
+        Float4 zero = Float4::Splat(0.0f);
+        Float4 one = Float4::Splat(1.0f);
+        for (uint32_t i = 0; i < count; i += SIMD_WIDTH) {
+            Float4 toCenterX = centerX - Float4::Load(startX + i);
+            Float4 toCenterY = centerY - Float4::Load(startY + i);
+            Float4 toCenterZ = centerZ - Float4::Load(startZ + i);
+            Float4 axX = Float4::Load(axisX + i);
+            Float4 axY = Float4::Load(axisY + i);
+            Float4 axZ = Float4::Load(axisZ + i);
+            Float4 t = (toCenterX * axX + toCenterY * axY + toCenterZ * axZ) * Float4::Load(inverseLengthSquared + i);
+            t = Min(Max(t, zero), one);
+            Float4 dx = toCenterX - axX * t;
+            Float4 dy = toCenterY - axY * t;
+            Float4 dz = toCenterZ - axZ * t;
+            Float4 reach = Float4::Load(radius + i) + Float4::Splat(sphereRadius);
+            Mask4 hit = (dx * dx + dy * dy + dz * dz <= reach * reach) & Mask4::FirstLanes(count - i);
+            if (hit.Any()) return true;
+        }
+        return false;
+    }
+};
+
 /**
  * @brief Constrain an AABB within arena boundaries
  * @param aabb The bounding box to constrain
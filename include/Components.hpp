@@ -0,0 +1,77 @@
+#pragma once
+#include "TimerWheel.hpp"
+#include "raylib.h"
+#include <cstdint>
+
+namespace TimeMaster {
+
+// Entity components: plain data, one dense column each per archetype (Archetype.hpp)
+
+struct Position {
+    Vector3 value;
+};
+
+struct Velocity {
+    Vector3 value;   // Units per second
+};
+
+/**
+ * @brief Collision sphere around the position
+ */
+struct Collider {
+    float radius;
+};
+
+struct Renderable {
+    Color color;
+};
+
+/**
+ * @brief Expiry on the game's timer wheel
+ * The handle is only valid in the live game; rewind and rollback frames save
+ * TimerRecords beside the archetype and the owner restores the timers.
+ */
+struct Lifetime {
+    uint64_t spawnTick;
+    TimerHandle expiry;
+};
+
+/**
+ * @brief Ticks the shooter's view trailed the server by when it fired
+ * Hit tests look up the target that many ticks back (see HitboxHistory).
+ */
+struct LagCompensation {
+    uint32_t ticks;
+};
+
+/**
+ * @brief Position += Velocity * deltaTime for rows [begin, end)
+ * Works on any archetype with both components; rows are independent, so
+ * disjoint ranges may run in parallel jobs.
+ */
+template <typename ArchetypeT>
+void IntegrateMotion(ArchetypeT& archetype, uint32_t begin, uint32_t end, float deltaTime) {
+    Position* positions = archetype.template Get<Position>();
+    const Velocity* velocities = archetype.template Get<Velocity>();
+    for (uint32_t row = begin; row < end; ++row) {
+        positions[row].value.x += velocities[row].value.x * deltaTime;
+        positions[row].value.y += velocities[row].value.y * deltaTime;
+        positions[row].value.z += velocities[row].value.z * deltaTime;
+    }
+}
+
+/**
+ * @brief Whether a row's collider touches a sphere (any archetype with
+ * Position and Collider)
+ */
+template <typename ArchetypeT>
+bool OverlapsSphere(const ArchetypeT& archetype, uint32_t row, Vector3 center, float radius) {
+    const Vector3& position = archetype.template Get<Position>()[row].value;
+    float reach = archetype.template Get<Collider>()[row].radius + radius;
+    float dx = position.x - center.x;
+    float dy = position.y - center.y;
+    float dz = position.z - center.z;
+    return dx * dx + dy * dy + dz * dz < reach * reach;
+}
+
+} // namespace TimeMaster
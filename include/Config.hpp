@@ -6,9 +6,15 @@ namespace TimeMaster {
 constexpr int SCREEN_WIDTH = 1200;
 constexpr int SCREEN_HEIGHT = 800;
 
+// Simulation (fixed)
+constexpr float SIMULATION_TICK_RATE = 60.0f;   // Fixed simulation steps per second
+
 // Game configuration (fixed)
+constexpr int MAX_PLAYERS = 2;    // Co-op players in one match
 constexpr int MAX_TOMATOES = 5;
-constexpr int MAX_BOSS_PROJECTILES = 10;
+constexpr int MAX_BOSS_PROJECTILES = 2048;   // Live boss bullets (pattern volleys)
+constexpr int MAX_PLAYER_PROJECTILES = 10;
+constexpr int MAX_MINIONS = 2048;            // Live minions in horde mode
 constexpr float ARENA_SIZE = 400.0f;
 constexpr float ARENA_WALL_THICKNESS = 10.0f;  // Thickness of arena walls for collision
 constexpr float ARENA_FLOOR_Y = -50.0f;  // Y position of arena floor where entities stand
@@ -22,6 +28,8 @@ constexpr float BOSS_HEIGHT = 80.0f;
 constexpr float BOSS_DEPTH = 60.0f;
 constexpr float TOMATO_RADIUS = 12.0f;
 constexpr float PROJECTILE_RADIUS = 8.0f;
+constexpr float MINION_HALF_WIDTH = 5.0f;
+constexpr float MINION_HALF_HEIGHT = 7.0f;
 
 // Fixed camera settings
 constexpr float CAMERA_DISTANCE = 200.0f;  // Reduced for better view with smaller entities
@@ -29,7 +37,9 @@ constexpr float CAMERA_HEIGHT = 150.0f;    // Reduced proportionally
 constexpr float CAMERA_FOV = 45.0f;
 
 /**
- * @brief Singleton class to manage configurable game settings
+ * @brief Configurable game settings
+ * Each Game owns its own copy (edited by its settings screen); entities keep
+ * a const reference to their game's config.
  */
 class GameConfig {
 public:
@@ -55,40 +65,12 @@ public:
     // Camera settings
     float mouseSensitivity = 0.002f;
     
-    /**
-     * @brief Get the singleton instance
-     */
-    static GameConfig& GetInstance() {
-        static GameConfig instance;
-        return instance;
-    }
-    
     /**
      * @brief Reset all settings to default values
      */
     void ResetToDefaults() {
-        playerSpeed = 150.0f;
-        playerStartingTime = 60.0f;
-        playerMaxTime = 120.0f;
-        playerDamagePerHit = 5.0f;
-        
-        bossStartingTime = 300.0f;
-        bossDamagePerHit = 3.0f;
-        bossAttackCooldownMin = 1.5f;
-        bossAttackCooldownMax = 2.5f;
-        
-        tomatoLifetime = 8.0f;
-        tomatoHealAmount = 5.0f;
-        
-        projectileSpeed = 200.0f;
-        
-        mouseSensitivity = 0.002f;
+        *this = GameConfig();
     }
-    
-private:
-    GameConfig() = default;
-    GameConfig(const GameConfig&) = delete;
-    GameConfig& operator=(const GameConfig&) = delete;
 };
 
 } // namespace TimeMaster
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace TimeMaster {
+
+/**
+ * @brief Command-line options for the determinism test (--determinism-test)
+ */
+struct DeterminismOptions {
+    int ticks = 3600;               // Simulation ticks per run
+    uint64_t seed = 0x5eed;         // Game and input-stream seed
+    std::string recordPath;         // Write per-tick checksums here (optional)
+    std::string verifyPath;         // Compare against checksums recorded earlier (optional)
+    bool horde = false;             // Play horde mode instead of the boss fight
+};
+
+/**
+ * @brief Run a seeded, scripted input stream and check the simulation repeats
+ *
+ * Headless (no window or models). Without a path, two games run the same
+ * stream side by side in this process. --record writes every tick's
+ * checksum to a text file, and --verify replays the stream (seed and length
+ * from the file) against it, so builds from different compilers or -O
+ * levels can be compared. Reports the first divergent tick and the state
+ * fields that differ.
+ * @return Process exit code: 0 when every tick matched, 1 on divergence,
+ * 2 on usage/IO errors
+ */
+int RunDeterminismTest(const DeterminismOptions& options);
+
+} // namespace TimeMaster
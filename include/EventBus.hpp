@@ -0,0 +1,176 @@
+#pragma once
+#include "Archetype.hpp"
+#include "BossState.hpp"
+#include "Log.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace TimeMaster {
+
+// Event bus configuration (fixed)
+constexpr uint32_t EVENT_QUEUE_CAPACITY = 4096;   // Events of one type per tick (default)
+constexpr int EVENT_MAX_SUBSCRIBERS = 8;          // Handlers per event type
+
+enum class EventEntity : uint8_t {
+    PLAYER,
+    BOSS
+};
+
+/**
+ * @brief Damage from a projectile or melee hit (not the passive time drain)
+ */
+struct HitEvent {
+    EventEntity target;
+    uint8_t player;     // Which player, when the target is one
+    float damage;
+    Vector3 position;   // Point of impact
+};
+
+/**
+ * @brief A player regained time
+ */
+struct HealEvent {
+    uint8_t player;
+    float amount;
+    Vector3 position;
+};
+
+/**
+ * @brief A pickup was collected
+ */
+struct CollectEvent {
+    EntityId entity;    // Tomato
+    Vector3 position;
+};
+
+struct StateChangedEvent {
+    BossState from;
+    BossState to;
+};
+
+struct DeathEvent {
+    EventEntity entity;
+    uint8_t player;     // Which player, when the entity is one
+    Vector3 position;
+};
+
+/**
+ * @brief Receives every event of one type raised during a tick, in order
+ */
+template <typename T>
+using EventHandler = void (*)(void* context, const T* events, uint32_t count);
+
+/**
+ * @brief Per-tick contiguous buffer of one event type plus its subscribers
+ */
+template <typename T>
+class EventQueue {
+private:
+    struct Subscriber {
+        EventHandler<T> handler;
+        void* context;
+    };
+
+    std::vector<T> m_events;   // Sized to capacity up front
+    uint32_t m_count;
+    uint32_t m_dropped;
+    Subscriber m_subscribers[EVENT_MAX_SUBSCRIBERS];
+    int m_subscriberCount;
+
+public:
+    explicit EventQueue(uint32_t capacity)
+        : m_events(capacity), m_count(0), m_dropped(0), m_subscribers{}, m_subscriberCount(0) {}
+
+    void Push(const T& event) {
+        if (m_count < m_events.size()) {
+            m_events[m_count++] = event;
+        } else {
+            m_dropped++;
+        }
+    }
+
+    bool Subscribe(EventHandler<T> handler, void* context) {
+        if (m_subscriberCount == EVENT_MAX_SUBSCRIBERS) return false;
+        m_subscribers[m_subscriberCount++] = {handler, context};
+        return true;
+    }
+
+    void Dispatch() {
+        if (m_count > 0) {
+            for (int i = 0; i < m_subscriberCount; ++i) {
+                m_subscribers[i].handler(m_subscribers[i].context, m_events.data(), m_count);
+            }
+        }
+        m_count = 0;
+    }
+
+    void Clear() { m_count = 0; }
+
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetDropped() const { return m_dropped; }
+    const T* GetEvents() const { return m_events.data(); }
+};
+
+/**
+ * @brief Typed, batched gameplay event bus (one per Game)
+ * Simulation code only appends plain structs to per-type buffers while it
+ * runs; after the tick Dispatch hands each subscriber its whole batch with
+ * one call, then empties the buffers. Consumers (audio, particles, HUD
+ * flashes, telemetry) therefore add no branches or virtual calls to the
+ * update loops. Emitting and dispatching never allocate; events beyond a
+ * queue's capacity are counted and dropped.
+ */
+class EventBus {
+private:
+    std::tuple<EventQueue<HitEvent>,
+               EventQueue<HealEvent>,
+               EventQueue<CollectEvent>,
+               EventQueue<StateChangedEvent>,
+               EventQueue<DeathEvent>> m_queues;
+
+public:
+    explicit EventBus(uint32_t capacity = EVENT_QUEUE_CAPACITY)
+        : m_queues(EventQueue<HitEvent>(capacity), EventQueue<HealEvent>(capacity),
+                   EventQueue<CollectEvent>(capacity), EventQueue<StateChangedEvent>(capacity),
+                   EventQueue<DeathEvent>(capacity)) {}
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    template <typename T>
+    void Emit(const T& event) { std::get<EventQueue<T>>(m_queues).Push(event); }
+
+    /**
+     * @brief Register a batch handler (subscribe once, at setup)
+     */
+    template <typename T>
+    void Subscribe(EventHandler<T> handler, void* context) {
+        if (!std::get<EventQueue<T>>(m_queues).Subscribe(handler, context)) {
+            TM_LOG_ERROR(GAME, "Event type has more than %d subscribers", EVENT_MAX_SUBSCRIBERS);
+        }
+    }
+
+    /**
+     * @brief Events of one type raised so far this tick
+     */
+    template <typename T>
+    const EventQueue<T>& GetQueue() const { return std::get<EventQueue<T>>(m_queues); }
+
+    /**
+     * @brief Deliver this tick's batches (in declaration order of the types) and reset
+     */
+    void Dispatch() {
+        std::apply([](auto&... queue) { (queue.Dispatch(), ...); }, m_queues);
+    }
+
+    /**
+     * @brief Drop undelivered events (match restart)
+     */
+    void Clear() {
+        std::apply([](auto&... queue) { (queue.Clear(), ...); }, m_queues);
+    }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,115 @@
+#pragma once
+#include "BossState.hpp"
+#include "GameState.hpp"
+#include "Input.hpp"
+#include "Profiler.hpp"
+#include "Random.hpp"
+#include "raylib.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TimeMaster {
+
+// Flight recorder configuration (fixed)
+constexpr int FLIGHT_RECORDER_FRAMES = 600;               // ~10 seconds at 60 FPS
+constexpr float FLIGHT_RECORDER_COOLDOWN_SECONDS = 10.0f; // Minimum time between dumps
+
+/**
+ * @brief Gameplay state sampled once per update (filled by Game)
+ */
+struct GameplaySample {
+    GameState state;
+    BossState bossState;
+    float bossTime;
+    float playerTime;
+    Vector3 playerPosition;
+    uint16_t activeProjectiles;        // Boss projectiles in flight
+    uint16_t activePlayerProjectiles;
+    uint16_t activeTomatoes;
+    InputFrame input;
+    RandomState random;                // RNG state before this update
+    uint64_t stateHash;                // Game::ComputeChecksum after this update (0 unless TM_STATE_CHECKSUM)
+};
+
+/**
+ * @brief One recorded frame
+ */
+struct FlightFrame {
+    uint64_t frameIndex;
+    float frameMs;
+    GameplaySample gameplay;
+    std::array<float, PROFILER_MAX_ZONES> zoneMs;
+};
+
+/**
+ * @brief Always-on ring of the last ~10 seconds of frames
+ * Each frame costs one record copy. When a frame exceeds the hitch
+ * threshold (33 ms unless SetHitchThreshold) the ring is snapshotted and a background
+ * thread writes hitch_<timestamp>.json; dumps are rate-limited and skipped
+ * while a previous one is still being written.
+ */
+class FlightRecorder {
+private:
+    static float s_hitchThresholdMs;        // Frames slower than this dump the ring
+    
+    std::vector<FlightFrame> m_frames;       // Ring
+    uint64_t m_frameIndex;
+    GameplaySample m_pendingSample;
+    uint64_t m_lastDumpTime;                 // Profiler::Now() of the last dump, 0 = never
+    
+    // Snapshot handed to the writer thread
+    std::vector<FlightFrame> m_dumpFrames;
+    int m_dumpCount;
+    uint64_t m_dumpHitchFrame;
+    float m_dumpHitchMs;
+    float m_dumpThresholdMs;
+    RandomState m_dumpRandomState;
+    std::array<const char*, PROFILER_MAX_ZONES> m_dumpZoneNames;
+    int m_dumpZoneCount;
+    
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_dumpPending;                      // Guarded by m_mutex
+    bool m_stop;                             // Guarded by m_mutex
+    std::atomic<bool> m_writerBusy;
+    
+    FlightRecorder();
+    ~FlightRecorder();
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+    
+    void TriggerDump(const Profiler& profiler, float frameMs, float thresholdMs);
+    void WriterLoop();
+    bool WriteDump(const char* path) const;
+    
+public:
+    /**
+     * @brief Get the singleton instance (starts the writer thread)
+     */
+    static FlightRecorder& GetInstance();
+    
+    /**
+     * @brief Override the hitch threshold in milliseconds (call before the first frame)
+     */
+    static void SetHitchThreshold(float thresholdMs) { s_hitchThresholdMs = thresholdMs; }
+    
+    /**
+     * @brief Record the gameplay sample for the current frame
+     * (same thread as EndFrame; the sample comes from the drawn snapshot)
+     */
+    void SetGameplaySample(const GameplaySample& sample) { m_pendingSample = sample; }
+    
+    /**
+     * @brief Close the frame: append it to the ring and check for a hitch
+     * (call after Profiler::EndFrame)
+     */
+    void EndFrame(const Profiler& profiler);
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,178 @@
+#pragma once
+#include "Config.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+// Navigation configuration (fixed)
+constexpr float NAV_CELL_SIZE = 20.0f;
+constexpr int NAV_GRID_SIZE = static_cast<int>(2.0f * ARENA_SIZE / NAV_CELL_SIZE);   // Cells per side
+constexpr int NAV_GRID_CELLS = NAV_GRID_SIZE * NAV_GRID_SIZE;
+constexpr uint32_t FLOW_FIELD_BUDGET = 512;     // Recompute work per tick (cells settled or aimed)
+constexpr uint16_t FLOW_STRAIGHT_COST = 5;      // Path cost of one cell step; a diagonal one costs 7
+constexpr uint16_t FLOW_DIAGONAL_COST = 7;
+constexpr uint16_t FLOW_UNREACHED = UINT16_MAX;
+constexpr float FLOW_DIRECTION_SCALE = 127.0f;  // A unit direction component packs into an int8
+
+/**
+ * @brief What the field says about one cell
+ */
+struct FlowCell {
+    int8_t directionX;  // Unit direction down the path, packed (0, 0 in a target cell or an unreached one)
+    int8_t directionZ;
+    uint16_t distance;  // Path cost to the nearest target, FLOW_UNREACHED if there is none
+    uint8_t target;     // Id of that target
+    uint8_t inSight;    // 1 when nothing blocks the straight line to the target's cell
+
+    float GetDirectionX() const { return directionX * (1.0f / FLOW_DIRECTION_SCALE); }
+    float GetDirectionZ() const { return directionZ * (1.0f / FLOW_DIRECTION_SCALE); }
+};
+
+/**
+ * @brief The cells a field leads to; ids are chosen by the caller (player slots)
+ */
+struct FlowTargets {
+    uint16_t cells[MAX_PLAYERS];
+    uint8_t ids[MAX_PLAYERS];
+    uint32_t count;
+
+    bool operator==(const FlowTargets& other) const;
+    bool operator!=(const FlowTargets& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief The arena's walkable cells and the steps allowed between them
+ * Baked once at construction and only read afterwards, so every game's
+ * FlowField shares one (GameAssets holds it).
+ */
+struct NavGrid {
+    uint8_t walkable[NAV_GRID_CELLS];
+    uint8_t steps[NAV_GRID_CELLS];      // Per cell: bit s set when neighbour step s may be taken
+
+    NavGrid();
+};
+
+/**
+ * @brief Flow field state for rewind and rollback; the cells are rebuilt from it
+ */
+struct FlowFieldRecord {
+    FlowTargets published;
+    FlowTargets building;
+    uint32_t progress;      // Work done on the build (0 = no build running)
+};
+
+/**
+ * @brief Paths from every cell of the arena to the nearest of a few targets
+ *
+ * Paths follow a shared NavGrid. A field is a Dijkstra search out from the
+ * target cells (octile costs, no corner
+ * cutting), then a pass that points each cell down its neighbours' path
+ * costs. Cells settled after the cells between them and their target are
+ * marked in sight; chasers there walk straight at the target, since path
+ * costs on a grid only point in a few directions. Chasers read the
+ * published field with one lookup each, so the cost does not grow with
+ * their number.
+ *
+ * When the targets move to another cell, the next field is built over
+ * several ticks, FLOW_FIELD_BUDGET units of work per Update, while chasers
+ * keep following the published one. The budget counts work, not time, so
+ * every peer builds the same field on the same tick.
+ */
+class FlowField {
+private:
+    enum class Phase : uint8_t {
+        IDLE,
+        EXPANDING,      // Settling cells in path cost order
+        AIMING          // Pointing settled cells down the path
+    };
+
+    static constexpr uint32_t BUCKET_COUNT = FLOW_DIAGONAL_COST + 1;   // Costs in flight span less than this
+    static constexpr uint16_t NO_CELL = UINT16_MAX;
+
+    enum class CellState : uint8_t {
+        UNSEEN,
+        OPEN,
+        SETTLED
+    };
+
+    const NavGrid& m_grid;
+    std::vector<FlowCell> m_published;      // What chasers read
+    std::vector<FlowCell> m_building;       // The next field
+    std::vector<FlowCell> m_retired;        // The field published before (rollback often goes back to it; empty without history)
+    std::vector<CellState> m_cellStates;    // Of the field being built
+    std::vector<uint16_t> m_next;           // Open cells: doubly linked lists, one per cost modulo BUCKET_COUNT
+    std::vector<uint16_t> m_previous;
+    uint16_t m_buckets[BUCKET_COUNT];
+    uint32_t m_openCount;
+    uint32_t m_cost;                        // Cost being settled
+    uint32_t m_aimCursor;
+    uint32_t m_progress;
+    Phase m_phase;
+    FlowTargets m_desired;
+    FlowTargets m_publishedTargets;
+    FlowTargets m_buildTargets;
+    FlowTargets m_retiredTargets;
+
+    void StartBuild(const FlowTargets& targets);
+    uint32_t Step(uint32_t budget);
+    void Push(uint16_t cell, uint16_t distance, uint8_t target);
+    void Unlink(uint16_t cell);
+    void Settle(uint16_t cell);
+    bool IsInSight(uint16_t cell) const;
+    uint16_t GetTargetCell(uint8_t target) const;
+    void Aim(uint32_t cell);
+    void Publish();
+
+public:
+    /**
+     * @brief keepRetired holds on to the field before the published one, so
+     * restoring an earlier frame is often a swap (games without rewind or
+     * rollback save its cells)
+     */
+    explicit FlowField(const NavGrid& grid, bool keepRetired = true);
+
+    /**
+     * @brief Grid cell holding a world position (clamped to the arena)
+     */
+    static uint16_t GetCell(float x, float z);
+
+    /**
+     * @brief Where chasers should lead to from now on (every tick; cheap when unchanged)
+     */
+    void SetTargets(const FlowTargets& targets);
+
+    /**
+     * @brief Spend one tick's budget on the next field, publishing it when done
+     */
+    void Update(uint32_t budget = FLOW_FIELD_BUDGET);
+
+    /**
+     * @brief Build and publish the field for the current targets now (match start)
+     */
+    void Rebuild();
+
+    /**
+     * @brief The published cell under a world position
+     */
+    const FlowCell& Sample(float x, float z) const { return m_published[GetCell(x, z)]; }
+
+    /**
+     * @brief Unit direction (on the floor) for a chaser at from going to target
+     * Along the field while it leads to targetId out of sight and more than a
+     * step away, straight at the target otherwise.
+     */
+    Vector3 GetChaseDirection(Vector3 from, Vector3 target, uint8_t targetId) const;
+
+    FlowFieldRecord Save() const;
+
+    /**
+     * @brief Restore what Save returned, rebuilding the published and
+     * in-progress fields exactly as they were (only what differs: a rollback
+     * usually finds the same targets)
+     */
+    void Restore(const FlowFieldRecord& record);
+};
+
+} // namespace TimeMaster
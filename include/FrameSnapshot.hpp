@@ -0,0 +1,78 @@
+#pragma once
+#include "GameState.hpp"
+#include "Config.hpp"
+#include "Player.hpp"
+#include "Boss.hpp"
+#include "Projectile.hpp"
+#include "Tomato.hpp"
+#include "FlightRecorder.hpp"
+#include "ParticleSystem.hpp"
+#include "raylib.h"
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief Settings shown on the HUD and the settings screen
+ */
+struct ConfigSnapshot {
+    float mouseSensitivity;
+    float playerSpeed;
+    float playerStartingTime;
+    float playerMaxTime;
+    float playerDamagePerHit;
+    float bossStartingTime;
+    float bossDamagePerHit;
+    float tomatoHealAmount;
+};
+
+/**
+ * @brief Co-op connection status shown on the HUD (filled by the NetSession)
+ */
+struct NetSnapshot {
+    bool active;            // Networked match (everything else is zero otherwise)
+    bool connected;
+    bool desynced;          // A sync check failed
+    int localPlayer;
+    float pingMs;
+    int lastRollbackTicks;  // Depth of the latest rollback
+    uint32_t rollbacks;
+    uint32_t stalls;        // Ticks spent waiting for the peer
+};
+
+/**
+ * @brief Everything the renderer reads for one simulation tick
+ * Written by the simulation thread, handed over through a TripleBuffer and
+ * never modified once published. Plain values only, so copying it into the
+ * buffer slot never allocates.
+ */
+struct FrameSnapshot {
+    uint64_t tick;
+    GameState state;
+    MatchMode mode;
+    int selectedSetting;
+    bool cursorLocked;
+    Camera3D camera;
+
+    PlayerSnapshot player;                      // The local player (camera, HUD)
+    PlayerSnapshot partners[MAX_PLAYERS - 1];   // Co-op players controlled elsewhere
+    int partnerCount;
+    BossSnapshot boss;
+    float playerHitFlash;   // 1 on the tick the local player is hit, fading to 0
+    ProjectileSnapshot projectiles[MAX_BOSS_PROJECTILES + MAX_PLAYER_PROJECTILES];  // Live ones only: boss, then player
+    uint32_t projectileCount;
+    TomatoSnapshot tomatoes[MAX_TOMATOES];
+    Vector3 minions[MAX_MINIONS];               // Live ones only
+    uint32_t minionCount;
+    EffectSpawn effects[EFFECT_HISTORY];        // Newest bursts, oldest first; the renderer spawns the ones
+    uint32_t effectCount;                       // past the last tick it drew (a skipped snapshot loses none)
+    ConfigSnapshot config;
+    bool rewinding;
+    float rewindSeconds;    // History available to rewind
+    NetSnapshot net;
+
+    // Diagnostics: handed to the flight recorder by the render thread
+    GameplaySample flight;
+};
+
+} // namespace TimeMaster
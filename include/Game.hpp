@@ -4,47 +4,143 @@
 #include "Boss.hpp"
 #include "Tomato.hpp"
 #include "Projectile.hpp"
+#include "BulletPattern.hpp"
+#include "BulletStore.hpp"
 #include "CameraManager.hpp"
-#include "HUD.hpp"
 #include "Collision.hpp"
+#include "Input.hpp"
+#include "JobSystem.hpp"
+#include "Random.hpp"
+#include "TimerWheel.hpp"
+#include "EventBus.hpp"
+#include "FlowField.hpp"
+#include "HitboxHistory.hpp"
+#include "MinionHorde.hpp"
+#include "ParticleSystem.hpp"
+#include "Rewind.hpp"
+#include "StateHash.hpp"
+#include "FlightRecorder.hpp"
+#include "GameAssets.hpp"
 #include <vector>
 #include <memory>
 
 namespace TimeMaster {
 
+struct FrameSnapshot;
+struct ReplicatedState;
+
+/**
+ * @brief Per-match storage and threading, fixed at construction
+ * The defaults suit the client. A dedicated server hosting hundreds of
+ * matches uses Server(): no rewind history (4 MB of the client's footprint,
+ * more in horde matches), pools sized to a real fight's peak
+ * instead of stress tests, no horde mode, and updates that stay on the
+ * calling thread since matches already run in parallel.
+ */
+struct GameOptions {
+    uint32_t bossBullets = MAX_BOSS_PROJECTILES;    // At most MAX_BOSS_PROJECTILES
+    uint32_t minions = MAX_MINIONS;     // Horde mode cap (0 = boss fights only; at most MAX_MINIONS)
+    uint32_t timers = TIMER_WHEEL_CAPACITY;
+    uint32_t eventsPerType = EVENT_QUEUE_CAPACITY;
+    bool rewind = true;            // Keep the rewind history (INPUT_REWIND)
+    bool parallelUpdate = true;    // Spread projectile updates over the job system
+
+    static GameOptions Server() {
+        GameOptions options;
+        options.bossBullets = 256;
+        options.minions = 0;
+        options.timers = 64;
+        options.eventsPerType = 64;
+        options.rewind = false;
+        options.parallelUpdate = false;
+        return options;
+    }
+};
+
 /**
  * @brief Main game class that manages game logic and state
+ * Makes no GL calls: everything it shows is published through
+ * WriteSnapshot and drawn by the Renderer, so it can run on its own thread.
  */
 class Game {
 private:
-    // Game state
+    // Game state (everything a match needs is per instance, so several games
+    // can run side by side on different threads)
     GameState m_state;
+    MatchMode m_matchMode;
+    GameOptions m_options;
+    GameConfig m_config;
+    Random m_random;
+    uint64_t m_tick;
+    TimerWheel m_timers;   // Advanced once per PLAYING tick, so pausing freezes every timer
+    EventBus m_events;     // Filled during a tick, dispatched at its end
     
     // Game entities
-    std::unique_ptr<Player> m_player;
+    std::unique_ptr<Player> m_players[MAX_PLAYERS];   // [0, m_playerCount) take part in the match
+    int m_playerCount;
+    int m_localPlayer;                                 // Followed by the camera, shown on the HUD
     std::unique_ptr<Boss> m_boss;
-    std::vector<std::unique_ptr<Tomato>> m_tomatoes;
-    std::vector<std::unique_ptr<Projectile>> m_projectiles;       // Boss projectiles
-    std::vector<std::unique_ptr<Projectile>> m_playerProjectiles; // Player projectiles
+    TomatoArchetype m_tomatoes;
+    BulletStore m_bullets;                      // Boss projectiles
+    ProjectileArchetype m_playerProjectiles;    // Player projectiles
+    MinionHorde m_horde;                        // Boss minions (horde mode)
+    FlowField m_flowField;                      // Paths to the living players (boss, minions)
+    
+    // Boss attack patterns (library shared through GameAssets)
+    const BulletPatternLibrary& m_patterns;
+    BulletPatternRunner m_patternRunner;
     
     // Systems
     std::unique_ptr<CameraManager> m_cameraManager;
-    std::unique_ptr<HUD> m_hud;
     
-    // Arena model
-    Model m_arenaModel;
-    bool m_arenaModelLoaded;
+    // Spawn timer and cooldowns (ticks on m_timers)
+    TimerHandle m_tomatoSpawnTimer;
+    TimerHandle m_hordeWaveTimer;   // Horde mode only
+    uint64_t m_playerAttackReadyTick[MAX_PLAYERS];
+    uint64_t m_playerHitTick;   // Last tick the local player took a hit (0 = never), drives the HUD flash
+    
+    // Particle bursts for the renderer: the newest EFFECT_HISTORY, a ring ending before m_effectHead.
+    // Only dispatched events add to it, so a rollback's replayed ticks never repeat a burst.
+    EffectSpawn m_effects[EFFECT_HISTORY];
+    uint32_t m_effectHead;
+    uint32_t m_effectCount;
+    
+    // Lag compensation (networked ticks only): hitboxes as each tick ended, and
+    // the tick each player's view showed when its current command was sent
+    HitboxHistory m_hitboxes;
+    uint32_t m_playerViewTick[MAX_PLAYERS];   // 0 = sees the live state (local and co-op players)
     
-    // Spawn timers
-    float m_tomatoSpawnTimer;
-    float m_playerAttackCooldown;
+    // Rewind history (captured every PLAYING tick, scrubbed while INPUT_REWIND is held;
+    // null when GameOptions::rewind is off)
+    std::unique_ptr<RewindBuffer> m_rewind;
+    bool m_rewinding;
     
     // Settings menu state
     int m_selectedSetting;
     
+    // Read-only inputs for the parallel update jobs, filled before they are queued
+    struct UpdateJobContext {
+        float deltaTime;
+        Vector3 playerPositions[MAX_PLAYERS];   // Living players only
+        uint8_t playerIndices[MAX_PLAYERS];     // Player behind each position
+        uint32_t playerCount;
+        float playerRadius;
+        ProjectileTarget boss;                  // What player projectiles hit (the boss's bone capsules)
+        uint32_t bulletCount;
+        uint32_t projectileCount;
+        HordeTargets horde;                     // What minions chase (playerIndices maps them back)
+    };
+    UpdateJobContext m_jobContext;
+    std::vector<uint8_t> m_projectileHits;  // Per row: boss bullets, then player projectiles (status)
+    
+    // Diagnostics for the last update, published with the snapshot
+    GameplaySample m_flightSample;
+    
 public:
-    Game();
-    ~Game();
+    /**
+     * @brief Create a match; assets must outlive it and may be shared by many games
+     */
+    Game(const GameAssets& assets, uint64_t seed, const GameOptions& options = GameOptions{});
     
     /**
      * @brief Initialize/reset the game
@@ -52,48 +148,157 @@ public:
     void Init();
     
     /**
-     * @brief Update game logic
+     * @brief Advance one tick with the given input and timestep
+     */
+    void Update(const InputFrame& input, float deltaTime);
+    
+    /**
+     * @brief Players in the next match and which of them this process controls
+     * (co-op; takes effect on StartMatch)
+     */
+    void SetPlayers(int count, int localPlayer);
+    
+    /**
+     * @brief Boss fight or minion horde for the next match (takes effect on
+     * StartMatch; restarts keep it)
+     */
+    void SetMatchMode(MatchMode mode) { m_matchMode = mode; }
+    
+    /**
+     * @brief Move the camera from raw input and return the local player's command
+     * Camera look is view state, not simulation state: networked play resolves
+     * it here once per real tick and exchanges only the resulting commands.
+     */
+    PlayerCommand UpdateView(const InputFrame& input, float deltaTime);
+    
+    /**
+     * @brief Advance one networked tick from every player's command
+     * (commands[GetPlayerCount()]; no menus, pause or rewind)
+     */
+    void UpdateNetworked(const PlayerCommand* commands, float deltaTime);
+    
+    /**
+     * @brief Replay a networked tick after a rollback; its events are dropped,
+     * since the ones shown the first time cannot be taken back
+     */
+    void ResimulateNetworked(const PlayerCommand* commands, float deltaTime);
+    
+    /**
+     * @brief The newest tick a remote player had on screen (0 = none)
+     * A dedicated server passes each client's acknowledged snapshot before
+     * UpdateNetworked; that player's melee and shots then hit the boss where
+     * the player saw it, up to LAG_COMPENSATION_MAX_TICKS back.
+     */
+    void SetPlayerViewTick(int player, uint32_t tick) { m_playerViewTick[player] = tick; }
+    
+    /**
+     * @brief Serialize the simulation state (what a rewind frame holds) as raw words
+     * Valid only inside this process. Used for rollback, which needs every
+     * frame at hand without decoding.
+     * @return Words written (0 if capacity is below GetMaxStateWords())
      */
-    void Update();
+    uint32_t SaveState(uint32_t* words, uint32_t capacity) const;
+    void LoadState(const uint32_t* words, uint32_t count);
+    static uint32_t GetMaxStateWords();
     
     /**
-     * @brief Render the game
+     * @brief Copy everything the renderer needs into a snapshot
      */
-    void Draw();
+    void WriteSnapshot(FrameSnapshot& snapshot) const;
     
     /**
-     * @brief Check if game should close
+     * @brief Quantized view of this tick for remote clients (see Replication.hpp)
+     * Bullets past REPLICATION_MAX_BULLETS are left out; absent players and
+     * inactive slots are zeroed, as the snapshot decoder leaves them.
      */
-    bool ShouldClose() const;
+    void WriteReplicatedState(ReplicatedState& state) const;
+    
+    /**
+     * @brief Reset entities and enter the PLAYING state
+     */
+    void StartMatch();
+    
+    /**
+     * @brief Hash the whole simulation state (everything rewind frames hold)
+     * Identical inputs from the same seed must give identical checksums on
+     * every tick, whatever the build; see --determinism-test.
+     */
+    StateChecksum ComputeChecksum() const;
+    
+    GameState GetState() const { return m_state; }
+    MatchMode GetMatchMode() const { return m_matchMode; }
+    uint32_t GetTick() const { return static_cast<uint32_t>(m_tick); }
+    int GetPlayerCount() const { return m_playerCount; }
+    int GetLocalPlayer() const { return m_localPlayer; }
+    Random& GetRandom() { return m_random; }
+    const GameConfig& GetConfig() const { return m_config; }
+    
+    // Scenario hooks (perf scenarios / debugging)
+    void DebugFireBossVolley();
+    void DebugStartBossPatterns();
+    void DebugFillTomatoPool();
+    void DebugFillHorde();
+    void DebugBurstEffects();
     
 private:
     // State-specific updates
-    void UpdateMenu();
-    void UpdateSettings();
-    void UpdatePlaying();
-    void UpdatePaused();
-    void UpdateGameOver();
-    void UpdateVictory();
-    
-    // State-specific rendering
-    void DrawMenu();
-    void DrawSettings();
-    void DrawPlaying();
-    void DrawPaused();
-    void DrawGameOver();
-    void DrawVictory();
+    void UpdateMenu(const InputFrame& input);
+    void UpdateSettings(const InputFrame& input);
+    void UpdatePlaying(const InputFrame& input, float deltaTime);
+    void Simulate(const PlayerCommand* commands, float deltaTime);
+    void UpdatePaused(const InputFrame& input);
+    void UpdateGameOver(const InputFrame& input);
+    void UpdateVictory(const InputFrame& input);
     
     // Game logic helpers
-    void HandlePlayerAttack();
+    Player& LocalPlayer() { return *m_players[m_localPlayer]; }
+    const Player& LocalPlayer() const { return *m_players[m_localPlayer]; }
+    const Player& GetBossTarget() const;
+    int GetBossTargetSlot() const;
+    FlowTargets GetFlowTargets() const;
+    uint32_t GetViewLag(int player) const;
+    const AABB* FindSeenHitbox(int entity, uint32_t lagTicks) const;
+    void RecordHitboxes();
+    void HandlePlayerAttack(int player);
+    void HandlePlayerShot(int player);
     void HandleBossAttack();
-    void UpdateProjectiles(float deltaTime);
-    void UpdateTomatoes(float deltaTime);
+    void FireBossBullet();
+    Job* ScheduleSimulation(JobSystem& jobs, bool minions);
+    void ApplyProjectileHits();
+    void ApplyContacts();
     void CheckTomatoCollection();
     void SpawnTomato();
-    void DrawArena() const;
+    static void TomatoSpawnTimerExpired(void* context, uint32_t data);
+    void ApplyMinionContacts(float deltaTime);
+    void SummonMinions(uint32_t count);
+    void AddEffect(EffectKind kind, Vector3 position, uint64_t tick);
+    static void HordeWaveTimerExpired(void* context, uint32_t data);
+    
+    // Rewind
+    enum class StateEncoding { EXACT, REWIND };   // REWIND: bullets and minions quantized (WriteRewind)
+    void WriteState(StateWriter& writer, StateEncoding encoding) const;
+    void ReadState(StateReader& reader, StateEncoding encoding);
+    void CaptureRewindFrame();
+    void RewindStep();
     
     // State transitions
     void TransitionTo(GameState newState);
+    
+    // Job entry points (context is the Game)
+    static void UpdateProjectilesJob(void* context, uint32_t begin, uint32_t end);
+    static void SteerMinionsJob(void* context, uint32_t begin, uint32_t end);
+    static void BuildGridJob(void* context, uint32_t begin, uint32_t end);
+    static void ApplyProjectileHitsJob(void* context, uint32_t begin, uint32_t end);
+    static void ApplyContactsJob(void* context, uint32_t begin, uint32_t end);
+    
+    // Event subscribers (context is the Game)
+    static void OnBossStateChanged(void* context, const StateChangedEvent* events, uint32_t count);
+    static void OnHit(void* context, const HitEvent* events, uint32_t count);
+    static void OnHeal(void* context, const HealEvent* events, uint32_t count);
+    static void OnCollect(void* context, const CollectEvent* events, uint32_t count);
+    
+    // Diagnostics
+    void RecordFlightSample(const InputFrame& input, const RandomState& randomBefore);
 };
 
 } // namespace TimeMaster
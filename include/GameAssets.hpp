@@ -0,0 +1,71 @@
+#pragma once
+#include "BoneHitboxes.hpp"
+#include "BulletPattern.hpp"
+#include "FlowField.hpp"
+#include "raylib.h"
+
+namespace TimeMaster {
+
+/**
+ * @brief One loaded model and its animations (animations may be empty)
+ */
+struct ModelAsset {
+    Model model;
+    ModelAnimation* animations;
+    int animationCount;
+    BoneHitboxRig hitboxes;     // Fitted at load for models that are hit (the boss)
+    bool loaded;
+};
+
+/**
+ * @brief Models and data shared read-only by every Game instance and the Renderer
+ * Loaded once per process on the thread that owns the GL context, and must
+ * outlive every Game built from it. The simulation only reads animation
+ * metadata (names, frame counts), bullet patterns and the navigation grid
+ * (baked on construction, so headless games have it too); skinned vertices
+ * belong to the Renderer. A GameAssets that was never loaded (headless
+ * simulation) makes entities fall back to primitive shapes, skip animation
+ * and fire single shots.
+ */
+class GameAssets {
+private:
+    ModelAsset m_player;
+    ModelAsset m_boss;
+    ModelAsset m_tomato;
+    BulletPatternLibrary m_patterns;
+    NavGrid m_navGrid;
+    
+    void LoadPlayer();
+    void LoadBoss();
+    void LoadTomato();
+    
+public:
+    GameAssets();
+    ~GameAssets();
+    
+    GameAssets(const GameAssets&) = delete;
+    GameAssets& operator=(const GameAssets&) = delete;
+    
+    /**
+     * @brief Load every model and the bullet patterns (GL thread, after InitWindow)
+     */
+    void Load();
+    
+    /**
+     * @brief Load only what the simulation reads without models (headless runs, any thread)
+     */
+    void LoadData();
+    
+    /**
+     * @brief Unload everything (no Game or Renderer may use it afterwards)
+     */
+    void Unload();
+    
+    const ModelAsset& GetPlayer() const { return m_player; }
+    const ModelAsset& GetBoss() const { return m_boss; }
+    const ModelAsset& GetTomato() const { return m_tomato; }
+    const BulletPatternLibrary& GetPatterns() const { return m_patterns; }
+    const NavGrid& GetNavGrid() const { return m_navGrid; }
+};
+
+} // namespace TimeMaster
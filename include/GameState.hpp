@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 
 namespace TimeMaster {
 
@@ -11,4 +12,12 @@ enum class GameState {
     VICTORY
 };
 
+/**
+ * @brief How a match is played (picked on the menu, kept across restarts)
+ */
+enum class MatchMode : uint8_t {
+    BOSS,    // The boss alone
+    HORDE    // The boss also summons waves of minions
+};
+
 } // namespace TimeMaster
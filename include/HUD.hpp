@@ -1,11 +1,13 @@
 #pragma once
 #include "raylib.h"
-#include <string>
 
 namespace TimeMaster {
 
-class Player;
-class Boss;
+class Profiler;
+class RenderStats;
+struct FrameSnapshot;
+struct ConfigSnapshot;
+struct NetSnapshot;
 
 /**
  * @brief Renders HUD elements (health bars, time displays, messages)
@@ -22,7 +24,7 @@ public:
     /**
      * @brief Draw all HUD elements
      */
-    void Draw(const Player& player, const Boss& boss);
+    void Draw(const FrameSnapshot& frame);
     
     /**
      * @brief Draw menu screen
@@ -32,26 +34,46 @@ public:
     /**
      * @brief Draw settings screen
      */
-    void DrawSettings(int selectedOption);
+    void DrawSettings(int selectedOption, const ConfigSnapshot& config);
     
     /**
-     * @brief Draw game over screen
+     * @brief Draw game over screen (co-op matches cannot be retried)
      */
-    void DrawGameOver();
+    void DrawGameOver(bool canRetry);
     
     /**
      * @brief Draw victory screen
      */
-    void DrawVictory();
+    void DrawVictory(bool canRetry);
+    
+    /**
+     * @brief Draw co-op connection status (top right; also the waiting screen)
+     */
+    void DrawNetStatus(const NetSnapshot& net);
     
     /**
      * @brief Draw attack hint message
      */
     void DrawAttackHint(float distance);
     
+    /**
+     * @brief Draw profiler overlay (zone timings and frame-time graph)
+     */
+    void DrawProfilerOverlay(Profiler& profiler);
+    
+    /**
+     * @brief Draw trace capture progress / last written file
+     */
+    void DrawTraceCaptureStatus(const Profiler& profiler);
+    
+    /**
+     * @brief Draw render counters of the last frame and CSV recording state
+     */
+    void DrawRenderStatsOverlay(const RenderStats& stats);
+    
 private:
     void DrawTimeBar(int x, int y, float current, float max, Color color);
-    void DrawTimerDisplay(const std::string& label, const std::string& time, 
+    void DrawTimerDisplay(const char* label, const char* time, 
                          int x, int y, Color labelColor, Color timeColor);
     void DrawClockDisplay(int x, int y, float current, float max, int radius);
     void DrawTextWithFont(const char* text, int x, int y, int fontSize, Color color);
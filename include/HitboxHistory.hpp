@@ -0,0 +1,69 @@
+#pragma once
+#include "Collision.hpp"
+#include "Config.hpp"
+#include <cstdint>
+
+namespace TimeMaster {
+
+// Lag compensation configuration (fixed)
+constexpr uint32_t HITBOX_HISTORY_TICKS = 32;                    // Power of two (~0.5 s at 60 Hz)
+constexpr uint32_t LAG_COMPENSATION_MAX_TICKS = 12;              // Rewind at most 200 ms for a shooter
+constexpr int HITBOX_BOSS = 0;                                   // Entity slots: the boss, then each player
+constexpr int HITBOX_ENTITIES = 1 + MAX_PLAYERS;
+
+static_assert((HITBOX_HISTORY_TICKS & (HITBOX_HISTORY_TICKS - 1)) == 0, "HITBOX_HISTORY_TICKS must be a power of two");
+static_assert(LAG_COMPENSATION_MAX_TICKS < HITBOX_HISTORY_TICKS, "lag compensation must stay inside the history");
+
+constexpr int GetPlayerHitbox(int player) { return 1 + player; }
+
+/**
+ * @brief Hitboxes of the last HITBOX_HISTORY_TICKS networked ticks
+ *
+ * One fixed frame per tick holds every entity's AABB as the tick ended, which
+ * is what the snapshot of that tick showed, and the boss's hit capsules. Frames sit in a ring indexed by
+ * tick, so recording and looking up a tick are O(1) and never allocate.
+ * Hits by a remote shooter are tested against the frame it was looking at.
+ */
+class HitboxHistory {
+private:
+    struct Frame {
+        uint32_t tick;       // 0 = empty
+        AABB boxes[HITBOX_ENTITIES];
+        CapsuleSet bossCapsules;
+    };
+    Frame m_frames[HITBOX_HISTORY_TICKS];
+
+public:
+    HitboxHistory();
+
+    /**
+     * @brief Forget every frame (a new match)
+     */
+    void Clear();
+
+    /**
+     * @brief Store the hitboxes of a tick (boxes[HITBOX_ENTITIES]), replacing
+     * the frame HITBOX_HISTORY_TICKS ticks older
+     */
+    void Record(uint32_t tick, const AABB* boxes, const CapsuleSet& bossCapsules);
+
+    /**
+     * @brief An entity's hitbox at the end of a tick
+     * @return nullptr if that tick is no longer (or not yet) held
+     */
+    const AABB* Find(uint32_t tick, int entity) const {
+        const Frame& frame = m_frames[tick & (HITBOX_HISTORY_TICKS - 1)];
+        return tick != 0 && frame.tick == tick ? &frame.boxes[entity] : nullptr;
+    }
+
+    /**
+     * @brief The boss's hit capsules at the end of a tick
+     * @return nullptr if that tick is no longer (or not yet) held
+     */
+    const CapsuleSet* FindBossCapsules(uint32_t tick) const {
+        const Frame& frame = m_frames[tick & (HITBOX_HISTORY_TICKS - 1)];
+        return tick != 0 && frame.tick == tick ? &frame.bossCapsules : nullptr;
+    }
+};
+
+} // namespace TimeMaster
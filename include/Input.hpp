@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+
+namespace TimeMaster {
+
+/**
+ * @brief Gameplay and menu buttons carried by an InputFrame (bit flags)
+ */
+enum InputButton : uint32_t {
+    INPUT_FORWARD        = 1 << 0,
+    INPUT_BACKWARD       = 1 << 1,
+    INPUT_LEFT           = 1 << 2,
+    INPUT_RIGHT          = 1 << 3,
+    INPUT_RUN            = 1 << 4,
+    INPUT_MELEE          = 1 << 5,
+    INPUT_SHOOT          = 1 << 6,
+    INPUT_TOGGLE_CAMERA  = 1 << 7,
+    INPUT_TOGGLE_CURSOR  = 1 << 8,
+    INPUT_TOGGLE_HITBOX  = 1 << 9,
+    INPUT_PAUSE          = 1 << 10,
+    
+    // Menu navigation (arrow keys only, unlike movement)
+    INPUT_CONFIRM        = 1 << 11,
+    INPUT_BACK           = 1 << 12,
+    INPUT_OPEN_SETTINGS  = 1 << 13,
+    INPUT_MENU_UP        = 1 << 14,
+    INPUT_MENU_DOWN      = 1 << 15,
+    INPUT_MENU_LEFT      = 1 << 16,
+    INPUT_MENU_RIGHT     = 1 << 17,
+    INPUT_RESET_SETTINGS = 1 << 18,
+    INPUT_REWIND         = 1 << 19,
+    INPUT_START_HORDE    = 1 << 20
+};
+
+// Buttons that drive a player in the simulation (everything else is view or menu)
+constexpr uint32_t INPUT_PLAYER_BUTTONS = INPUT_FORWARD | INPUT_BACKWARD | INPUT_LEFT | INPUT_RIGHT |
+                                          INPUT_RUN | INPUT_MELEE | INPUT_SHOOT;
+
+/**
+ * @brief Gameplay input for one simulation step
+ * Sampled from the keyboard/mouse by SampleInput(), or scripted (perf scenarios).
+ */
+struct InputFrame {
+    uint32_t held;     // Buttons held down this frame
+    uint32_t pressed;  // Buttons that went down this frame
+    float lookX;       // Mouse delta in pixels
+    float lookY;
+    float zoom;        // Mouse wheel movement
+
+    bool IsDown(InputButton button) const { return (held & button) != 0; }
+    bool WasPressed(InputButton button) const { return (pressed & button) != 0; }
+};
+
+/**
+ * @brief What one player feeds the simulation for a tick
+ * Camera look is view state: whoever owns the player's camera resolves it to
+ * the facing the movement keys are relative to. Commands are all the
+ * simulation needs, so they are what co-op peers exchange and replay.
+ */
+struct PlayerCommand {
+    uint32_t held;     // INPUT_PLAYER_BUTTONS only
+    uint32_t pressed;
+    float aimYaw;      // Camera angle around the player (degrees)
+
+    bool IsDown(InputButton button) const { return (held & button) != 0; }
+    bool WasPressed(InputButton button) const { return (pressed & button) != 0; }
+    bool operator==(const PlayerCommand& other) const {
+        return held == other.held && pressed == other.pressed && aimYaw == other.aimYaw;
+    }
+    bool operator!=(const PlayerCommand& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Read the current keyboard/mouse state into an InputFrame
+ */
+InputFrame SampleInput();
+
+/**
+ * @brief Hands input from the render thread to the simulation thread
+ * Frames pushed between two simulation steps are merged: presses are kept,
+ * held buttons are the latest state and look/zoom deltas add up, so nothing
+ * is lost when the two threads run at different rates.
+ */
+class InputMailbox {
+private:
+    std::mutex m_mutex;
+    InputFrame m_pending;
+    
+public:
+    InputMailbox() : m_pending{0, 0, 0.0f, 0.0f, 0.0f} {}
+    
+    void Push(const InputFrame& input);
+    
+    /**
+     * @brief Take everything pushed since the last call
+     */
+    InputFrame Take();
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace TimeMaster {
+
+// Job system configuration (fixed)
+constexpr int JOB_MAX_WORKERS = 16;
+constexpr int JOB_MAX_EXTERNAL_THREADS = 4;   // Non-worker threads that create and wait on jobs
+constexpr uint32_t JOB_POOL_SIZE = 4096;      // Jobs alive at once (power of two)
+constexpr uint32_t JOB_QUEUE_CAPACITY = 4096; // Per-thread deque capacity (power of two)
+constexpr uint32_t JOB_MAX_CHUNKS = JOB_POOL_SIZE / 8;   // Chunks one parallel-for may split into
+constexpr int JOB_MAX_CONTINUATIONS = 8;      // Dependents per job
+constexpr int JOB_IDLE_SPINS = 64;            // Failed steal rounds before a worker sleeps
+
+/**
+ * @brief Job entry point; [begin, end) is the job's slice of its range
+ */
+using JobFunction = void (*)(void* context, uint32_t begin, uint32_t end);
+
+struct Job;
+
+/**
+ * @brief Chase-Lev work-stealing deque of job pointers (fixed capacity)
+ * The owning thread pushes and pops at the bottom (LIFO, cache-warm);
+ * other threads steal from the top (FIFO, oldest and usually largest work).
+ */
+class WorkStealingQueue {
+private:
+    std::atomic<int64_t> m_top;
+    std::atomic<int64_t> m_bottom;
+    std::unique_ptr<std::atomic<Job*>[]> m_jobs;
+
+public:
+    WorkStealingQueue();
+
+    bool Push(Job* job);  // Owner only; false when full
+    Job* Pop();           // Owner only
+    Job* Steal();         // Any thread
+};
+
+/**
+ * @brief Work-stealing job system with dependencies and parallel-for
+ * Every worker owns a deque; idle workers steal from the others and sleep
+ * when there is nothing to steal. Jobs come from a fixed ring pool, so
+ * creating and running them never touches the heap.
+ *
+ * Jobs may be created and submitted from the workers and from up to
+ * JOB_MAX_EXTERNAL_THREADS other threads (the simulation and render threads);
+ * each external thread claims a deque on first use and helps run jobs while
+ * it waits. A job's dependencies must be added before either job
+ * is submitted. Handles stay valid until the pool wraps (JOB_POOL_SIZE jobs
+ * later), so wait for a frame's jobs within that frame; debug builds assert
+ * when a slot is handed out again before its job has finished.
+ */
+class JobSystem {
+private:
+    static int s_requestedWorkers;  // -1 = hardware threads - 1
+
+    std::unique_ptr<Job[]> m_pool;
+    std::atomic<uint32_t> m_nextJob;
+
+    // Deques [0, JOB_MAX_EXTERNAL_THREADS) belong to external threads, the rest to the workers
+    std::vector<std::unique_ptr<WorkStealingQueue>> m_queues;
+    std::atomic<int> m_nextExternalQueue;
+    std::vector<std::thread> m_workers;
+    char m_workerNames[JOB_MAX_WORKERS][20];   // "Worker " and any int
+
+    // Sleeping workers are woken when jobs are queued
+    std::atomic<int32_t> m_queuedJobs;
+    std::atomic<int32_t> m_sleepingWorkers;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_stop;  // Set under m_sleepMutex
+
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int GetQueueIndex();
+    Job* AllocateJob();
+    void Enqueue(Job* job);
+    Job* FindJob(int queueIndex);
+    void Execute(Job* job);
+    void Finish(Job* job);
+    void WorkerLoop(int queueIndex);
+
+public:
+    /**
+     * @brief Get the singleton instance (starts the workers on first use)
+     */
+    static JobSystem& GetInstance();
+
+    /**
+     * @brief Override the worker count (call before the first GetInstance);
+     * 0 runs every job on the thread that waits for it
+     */
+    static void SetWorkerCount(int workers) { s_requestedWorkers = workers; }
+
+    /**
+     * @brief Create a job over [begin, end); it runs once, after Submit and
+     * after every dependency has finished
+     */
+    Job* Create(JobFunction function, void* context, uint32_t begin = 0, uint32_t end = 0);
+
+    /**
+     * @brief Create a job that runs function over [0, count) in chunks of
+     * at most grain items, spread across the workers. Finishes when every
+     * chunk has finished, so it can be waited on and depended on like any job.
+     * The grain grows when count would need more than JOB_MAX_CHUNKS chunks:
+     * every chunk holds a pool slot while it runs, and a range that wrapped
+     * the pool would overwrite its own root.
+     */
+    Job* CreateParallelFor(uint32_t count, uint32_t grain, JobFunction function, void* context);
+
+    /**
+     * @brief Make job wait for prerequisite (neither may be submitted yet)
+     * @return false if prerequisite already has JOB_MAX_CONTINUATIONS dependents
+     */
+    bool AddDependency(Job* job, Job* prerequisite);
+
+    /**
+     * @brief Hand a job to the scheduler (queued once its dependencies finish)
+     */
+    void Submit(Job* job);
+
+    /**
+     * @brief Block until the job has finished, running queued jobs meanwhile
+     */
+    void Wait(const Job* job);
+
+    bool IsFinished(const Job* job) const;
+    int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
+
+    /**
+     * @brief Run fn(begin, end) over [0, count) in parallel and wait for it
+     */
+    template <typename Fn>
+    void ParallelFor(uint32_t count, uint32_t grain, Fn&& fn) {
+        using Callable = std::remove_reference_t<Fn>;
+        JobFunction trampoline = [](void* context, uint32_t begin, uint32_t end) {
+            (*static_cast<Callable*>(context))(begin, end);
+        };
+        Job* job = CreateParallelFor(count, grain, trampoline, const_cast<void*>(static_cast<const void*>(&fn)));
+        Submit(job);
+        Wait(job);
+    }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace TimeMaster {
+
+/**
+ * @brief Minimal JSON document value (for data/config files, not hot paths)
+ */
+class JsonValue {
+public:
+    enum class Type {
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+    
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;       // ARRAY elements, or OBJECT values
+    std::vector<std::string> keys;      // OBJECT keys (parallel to items)
+    
+    bool IsObject() const { return type == Type::OBJECT; }
+    bool IsArray() const { return type == Type::ARRAY; }
+    bool IsNumber() const { return type == Type::NUMBER; }
+    bool IsString() const { return type == Type::STRING; }
+    
+    /**
+     * @brief Look up an object member (nullptr if missing or not an object)
+     */
+    const JsonValue* Find(const char* key) const;
+    
+    /**
+     * @brief Typed member accessors with fallbacks
+     */
+    double GetNumber(const char* key, double fallback) const;
+    std::string GetString(const char* key, const std::string& fallback) const;
+    bool GetBool(const char* key, bool fallback) const;
+};
+
+/**
+ * @brief Parse JSON text
+ * @param error Receives a message with the byte offset on failure (optional)
+ */
+bool ParseJson(const std::string& text, JsonValue& out, std::string* error = nullptr);
+
+/**
+ * @brief Read and parse a JSON file
+ */
+bool LoadJsonFile(const char* path, JsonValue& out, std::string* error = nullptr);
+
+} // namespace TimeMaster
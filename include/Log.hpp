@@ -0,0 +1,191 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace TimeMaster {
+
+// Logger configuration (fixed)
+constexpr uint32_t LOG_RING_CAPACITY = 1024;   // Pending records (power of two)
+constexpr int LOG_MAX_ARGS = 8;                // Arguments captured per record
+constexpr int LOG_STRING_BYTES = 96;           // Storage for copied %s arguments
+constexpr int LOG_LINE_BYTES = 512;            // Longest formatted line
+
+enum class LogLevel : uint8_t {
+    DEBUG,     // Compiled out in release builds (NDEBUG)
+    INFO,
+    WARNING,
+    ERROR
+};
+
+enum class LogCategory : uint8_t {
+    GAME,
+    BOSS,
+    PLAYER,
+    CAMERA,
+    ASSETS,
+    PROFILER,
+    NET
+};
+
+enum class LogArgType : uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    STRING,    // Offset into LogRecord::strings
+    POINTER
+};
+
+union LogArgValue {
+    int64_t i;
+    uint64_t u;
+    double d;
+    const void* p;
+};
+
+/**
+ * @brief One deferred log message: the format literal plus raw arguments
+ * Formatting happens on the writer thread; the caller only copies values.
+ */
+struct LogRecord {
+    uint64_t timestamp;        // Nanoseconds since the logger started
+    const char* format;        // Must be a string literal (not copied)
+    LogLevel level;
+    LogCategory category;
+    uint8_t argCount;
+    uint8_t stringBytes;
+    LogArgType types[LOG_MAX_ARGS];
+    LogArgValue args[LOG_MAX_ARGS];
+    char strings[LOG_STRING_BYTES];
+};
+
+/**
+ * @brief Format a record printf-style into out (always NUL-terminated)
+ * @return Number of characters written
+ */
+int FormatLogMessage(const LogRecord& record, char* out, int size);
+
+/**
+ * @brief Asynchronous logger
+ * Producers (any thread) claim a slot in a bounded lock-free MPSC ring, copy
+ * their arguments and publish; a background thread formats and writes. When
+ * the ring is full the message is dropped and counted, so logging never
+ * blocks the frame.
+ */
+class Logger {
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+    
+    Cell* m_cells;
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) size_t m_dequeuePos;             // Writer thread only
+    std::atomic<uint32_t> m_dropped;
+    std::atomic<uint8_t> m_minLevel;
+    std::atomic<bool> m_running;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::thread m_writer;
+    
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+    
+    LogRecord* Acquire(size_t& position);
+    void Publish(size_t position);
+    bool WriteNext(char* line);
+    void WriterLoop();
+    
+    static void CaptureString(LogRecord& record, const char* text);
+    
+    template <typename T>
+    static void CaptureArg(LogRecord& record, T value) {
+        if (record.argCount >= LOG_MAX_ARGS) return;
+        int index = record.argCount++;
+        if constexpr (std::is_floating_point_v<T>) {
+            record.types[index] = LogArgType::DOUBLE;
+            record.args[index].d = static_cast<double>(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            record.types[index] = LogArgType::INT;
+            record.args[index].i = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            record.types[index] = LogArgType::INT;
+            record.args[index].i = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral_v<T>) {
+            record.types[index] = LogArgType::UINT;
+            record.args[index].u = static_cast<uint64_t>(value);
+        } else if constexpr (std::is_convertible_v<T, const char*>) {
+            record.argCount--;
+            CaptureString(record, value);
+        } else {
+            static_assert(std::is_pointer_v<T>, "Log arguments must be numbers, C strings or pointers");
+            record.types[index] = LogArgType::POINTER;
+            record.args[index].p = static_cast<const void*>(value);
+        }
+    }
+    
+public:
+    /**
+     * @brief Get the singleton instance (starts the writer thread)
+     */
+    static Logger& GetInstance();
+    
+    /**
+     * @brief Messages below this level are discarded at the call site
+     */
+    void SetMinLevel(LogLevel level) { m_minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed); }
+    bool IsEnabled(LogLevel level) const {
+        return static_cast<uint8_t>(level) >= m_minLevel.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Number of messages dropped because the ring was full
+     */
+    uint32_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Queue a message (format must be a string literal)
+     */
+    template <typename... Args>
+    void Write(LogLevel level, LogCategory category, const char* format, Args... args) {
+        if (!IsEnabled(level)) return;
+        
+        size_t position;
+        LogRecord* record = Acquire(position);
+        if (!record) return;
+        
+        record->timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_startTime).count());
+        record->format = format;
+        record->level = level;
+        record->category = category;
+        record->argCount = 0;
+        record->stringBytes = 0;
+        (CaptureArg(*record, args), ...);
+        Publish(position);
+    }
+};
+
+} // namespace TimeMaster
+
+/**
+ * @brief Logging macros: TM_LOG_INFO(BOSS, "State %d", state)
+ * In release builds TM_LOG_DEBUG is dead code: arguments are still type-checked
+ * (so they don't trigger unused-variable warnings) but nothing is emitted.
+ */
+#define TM_LOG(level, category, ...) \
+    ::TimeMaster::Logger::GetInstance().Write(::TimeMaster::LogLevel::level, ::TimeMaster::LogCategory::category, __VA_ARGS__)
+
+#ifdef NDEBUG
+#define TM_LOG_DEBUG(category, ...) do { if (false) { TM_LOG(DEBUG, category, __VA_ARGS__); } } while (0)
+#else
+#define TM_LOG_DEBUG(category, ...) TM_LOG(DEBUG, category, __VA_ARGS__)
+#endif
+#define TM_LOG_INFO(category, ...) TM_LOG(INFO, category, __VA_ARGS__)
+#define TM_LOG_WARNING(category, ...) TM_LOG(WARNING, category, __VA_ARGS__)
+#define TM_LOG_ERROR(category, ...) TM_LOG(ERROR, category, __VA_ARGS__)
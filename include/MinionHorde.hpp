@@ -0,0 +1,142 @@
+#pragma once
+#include "Collision.hpp"
+#include "Config.hpp"
+#include "FlowField.hpp"
+#include "Random.hpp"
+#include "Rewind.hpp"
+#include "Simd.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+// Horde configuration (fixed)
+constexpr float MINION_Y = MINION_HALF_HEIGHT + 5.0f;       // On the floor, like the player and boss
+constexpr float MINION_SPEED = 95.0f;                       // Top speed (units per second)
+constexpr float MINION_NEIGHBOR_RADIUS = 24.0f;             // Cohesion range, also the grid cell size
+constexpr float MINION_SEPARATION_RADIUS = 14.0f;           // Closer neighbours push each other apart
+constexpr int MINION_GRID_SIZE = static_cast<int>(2.0f * ARENA_SIZE / MINION_NEIGHBOR_RADIUS) + 1;   // Cells per side
+constexpr int MINION_GRID_CELLS = MINION_GRID_SIZE * MINION_GRID_SIZE;
+
+/**
+ * @brief What the minions chase and are pushed out of during one tick
+ */
+struct HordeTargets {
+    Vector3 players[MAX_PLAYERS];   // By player slot
+    AABB playerBoxes[MAX_PLAYERS];
+    bool alive[MAX_PLAYERS];
+    uint32_t playerCount;           // Slots in the match
+    AABB bossBox;
+    bool bossAlive;
+    const FlowField* paths;         // Leads to the living players (ids are slots)
+};
+
+/**
+ * @brief Boss minions: boids that chase the players, stored as columns
+ *
+ * Positions and velocities are separate float arrays (x and z only: minions
+ * stay on the floor) walked four minions at a time with Float4. Each tick:
+ *  - BuildGrid counting-sorts the rows by grid cell, so every cell's minions
+ *    are one contiguous run and a neighbour query reads 3x3 runs;
+ *  - Steer adds seek (along the flow field, so its cost does not depend on
+ *    the player count), separation and cohesion, integrates, and pushes the
+ *    minions out of the boss and players (ResolveAABBCollisionXZ). It reads
+ *    the sorted columns and writes a second set, so disjoint row ranges may
+ *    run in parallel jobs;
+ *  - EndStep makes the written set current.
+ * Capacity is fixed at construction and nothing allocates afterwards.
+ */
+class MinionHorde {
+private:
+    struct Columns {
+        std::vector<float> x;   // Each padded by SIMD_WIDTH, so a lane past the end stays in bounds
+        std::vector<float> z;
+        std::vector<float> velocityX;
+        std::vector<float> velocityZ;
+
+        explicit Columns(uint32_t size) : x(size, 0.0f), z(size, 0.0f), velocityX(size, 0.0f), velocityZ(size, 0.0f) {}
+    };
+
+    Columns m_current;
+    Columns m_next;                         // Written by BuildGrid and Steer, then swapped in
+    std::vector<uint32_t> m_cellStart;      // Rows of cell c are [m_cellStart[c], m_cellStart[c + 1])
+    std::vector<uint32_t> m_cellCursor;     // BuildGrid scratch
+    std::vector<uint16_t> m_rowCell;        // BuildGrid scratch, per row
+    std::vector<float> m_flockX;            // Steer scratch, per row: separation + cohesion
+    std::vector<float> m_flockZ;
+    std::vector<uint8_t> m_contacts;        // Per row: bit t set when it touched player slot t in Steer
+    uint32_t m_capacity;
+    uint32_t m_count;
+
+    void Flock(uint32_t row);
+
+public:
+    explicit MinionHorde(uint32_t capacity);
+
+    /**
+     * @brief Add up to count minions at rest, scattered over a ring around center
+     * @return Minions added (fewer when the horde is full)
+     */
+    uint32_t Spawn(Vector3 center, float innerRadius, float outerRadius, uint32_t count, Random& random);
+
+    /**
+     * @brief Remove the minions whose box intersects this one (melee)
+     * @return Minions removed
+     */
+    uint32_t KillInBox(const AABB& box);
+
+    /**
+     * @brief Sort the rows by grid cell (before Steer; reorders the minions)
+     */
+    void BuildGrid();
+
+    /**
+     * @brief Steer, move and push out rows [begin, end) (BuildGrid first)
+     */
+    void Steer(uint32_t begin, uint32_t end, float deltaTime, const HordeTargets& targets);
+
+    /**
+     * @brief Make the positions Steer wrote current (after every range ran)
+     */
+    void EndStep();
+
+    /**
+     * @brief Players touched in the last Steer (bit t = player slot t)
+     */
+    uint32_t GetContacts() const;
+
+    void Clear() { m_count = 0; }
+
+    /**
+     * @brief Serialize the live minions (rewind, rollback)
+     */
+    void Write(StateWriter& writer) const;
+
+    /**
+     * @brief Serialize the live minions for the rewind history, quantized as
+     * for replication (every minion moves every tick, so an exact delta would
+     * cost all 16 bytes of each; this halves it)
+     */
+    void WriteRewind(StateWriter& writer) const;
+
+    /**
+     * @brief Restore what Write or WriteRewind saved (WriteRewind minions come
+     * back within half a REPLICATION_POSITION_STEP, velocities within a
+     * tenth of a unit per second)
+     * @return false (and empty) if the frame is truncated or does not fit
+     */
+    bool Read(StateReader& reader);
+    bool ReadRewind(StateReader& reader);
+
+    static constexpr uint32_t GetMaxStateWords(uint32_t capacity) { return 1 + 4 * capacity; }
+
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetCapacity() const { return m_capacity; }
+    const float* GetX() const { return m_current.x.data(); }
+    const float* GetZ() const { return m_current.z.data(); }
+    const float* GetVelocityX() const { return m_current.velocityX.data(); }
+    const float* GetVelocityZ() const { return m_current.velocityZ.data(); }
+};
+
+} // namespace TimeMaster
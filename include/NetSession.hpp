@@ -0,0 +1,155 @@
+#pragma once
+#include "Input.hpp"
+#include "Random.hpp"
+#include "Rollback.hpp"
+#include "UdpSocket.hpp"
+#include <cstdint>
+#include <string>
+
+namespace TimeMaster {
+
+class Game;
+struct NetSnapshot;
+
+// Co-op networking configuration (fixed)
+constexpr uint16_t NET_DEFAULT_PORT = 47600;
+constexpr uint8_t NET_PROTOCOL_VERSION = 1;
+constexpr uint32_t NET_INPUT_DELAY = 2;             // Local commands apply this many ticks late
+constexpr uint32_t NET_COMMANDS_PER_PACKET = 16;    // Unacknowledged commands resent with every packet
+constexpr uint32_t NET_MAX_PACKET_BYTES = 128;
+constexpr uint32_t NET_SHIM_QUEUE = 256;            // Packets the latency shim can hold back
+constexpr float NET_TIMEOUT_SECONDS = 5.0f;
+
+/**
+ * @brief Simulated network conditions, applied to every packet this process sends
+ */
+struct NetConditions {
+    float latencyMs = 0.0f;     // One-way delay
+    float jitterMs = 0.0f;      // Delay varies by up to this much either way (reorders packets)
+    float lossPercent = 0.0f;   // Packets dropped outright
+};
+
+/**
+ * @brief Command-line options for a co-op session (--coop-host / --coop-join)
+ */
+struct NetOptions {
+    bool enabled = false;
+    bool host = false;
+    std::string address = "127.0.0.1";   // Host to join
+    uint16_t port = NET_DEFAULT_PORT;     // Host: port to listen on; client: port to send to
+    uint64_t seed = 0;                    // Host's match seed (0 = from the clock)
+    NetConditions conditions;
+};
+
+/**
+ * @brief Two-player co-op over UDP with rollback
+ *
+ * Peers exchange only compact commands (movement and attack buttons plus a
+ * 16-bit facing) and run the whole simulation each, driven by a
+ * RollbackSession. The host listens and picks the seed; the client says
+ * hello and starts when the host answers. Every packet carries the sender's
+ * commands the peer has not acknowledged yet (up to NET_COMMANDS_PER_PACKET),
+ * so a lost packet costs nothing once the next one arrives, plus the latest
+ * sync checksum: a mismatch on a final frame flags a desync. Packets also
+ * carry the sender's frame, so whichever peer runs ahead can idle a tick
+ * now and then and leave both predicting the same distance.
+ *
+ * The latency/loss shim holds outgoing packets back (or drops them) inside
+ * this process, so two instances on localhost behave like a real link.
+ */
+class NetSession {
+private:
+    enum PacketType : uint8_t {
+        PACKET_HELLO = 1,     // Client -> host until welcomed
+        PACKET_WELCOME,       // Host -> client: seed
+        PACKET_INPUT          // Both ways every tick once started
+    };
+
+    struct DelayedPacket {
+        double sendAtMs;
+        uint32_t size;
+        uint8_t data[NET_MAX_PACKET_BYTES];
+    };
+
+    Game& m_game;
+    NetOptions m_options;
+    float m_deltaTime;
+    UdpSocket m_socket;
+    NetAddress m_peer;
+    bool m_hasPeer;
+    bool m_started;
+    uint64_t m_seed;
+    RollbackSession m_rollback;
+    int m_remotePlayer;
+
+    uint32_t m_peerKnown;           // How many of our commands the peer has acknowledged
+    uint32_t m_pendingPressed;      // Presses made while stalled, sent with the next command
+    uint32_t m_handshakeTicks;
+    uint32_t m_peerSendTime;        // Echoed back for the round-trip time
+    uint32_t m_remoteFrame;         // Peer's latest reported frame (time sync)
+    uint32_t m_lastWaitFrame;
+    uint32_t m_timeSyncWaits;       // Ticks idled to let the peer catch up
+    double m_lastReceiveMs;
+    float m_pingMs;
+    uint32_t m_remoteSyncFrame;     // Latest checksum the peer reported (0 = none pending)
+    uint64_t m_remoteSyncChecksum;
+    uint32_t m_checkedSyncFrame;    // Latest peer checksum already compared
+    uint32_t m_syncChecks;
+    bool m_desynced;
+    bool m_timedOut;
+    double m_startMs;
+
+    // Latency / loss shim
+    Random m_shimRandom;
+    DelayedPacket m_shim[NET_SHIM_QUEUE];
+    uint32_t m_shimCount;
+
+    void StartMatch(uint64_t seed);
+    void Receive(double nowMs);
+    void HandleInput(const uint8_t* data, uint32_t size, double nowMs);
+    void SendHandshake(double nowMs);
+    void SendInputs(double nowMs);
+    void CheckSync();
+    void Send(const uint8_t* data, uint32_t size, double nowMs);
+    void FlushShim(double nowMs);
+
+public:
+    NetSession(Game& game, const NetOptions& options, float deltaTime);
+
+    NetSession(const NetSession&) = delete;
+    NetSession& operator=(const NetSession&) = delete;
+
+    /**
+     * @brief Open the socket (host: bind the port) and resolve the host to join
+     */
+    bool Open();
+
+    /**
+     * @brief One real tick: exchange packets, take the local command and advance
+     * (or stall); before the peer answers only the handshake runs
+     */
+    void Tick(const InputFrame& input);
+
+    /**
+     * @brief Connection status for the HUD (the game fills the rest of the snapshot)
+     */
+    void WriteSnapshot(NetSnapshot& snapshot) const;
+
+    bool IsStarted() const { return m_started; }
+    bool IsDesynced() const { return m_desynced; }
+    bool HasTimedOut() const { return m_timedOut; }
+    uint32_t GetSyncChecks() const { return m_syncChecks; }
+    uint32_t GetTimeSyncWaits() const { return m_timeSyncWaits; }
+    float GetPingMs() const { return m_pingMs; }
+    uint64_t GetSeed() const { return m_seed; }
+    const RollbackSession& GetRollback() const { return m_rollback; }
+
+    /**
+     * @brief Wire form of a command: buttons in one byte, facing in 16 bits
+     * The local player simulates the decoded command too, so both peers run
+     * exactly the same values.
+     */
+    static PlayerCommand Quantize(const PlayerCommand& command);
+};
+
+} // namespace TimeMaster
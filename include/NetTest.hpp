@@ -0,0 +1,20 @@
+#pragma once
+#include "NetSession.hpp"
+
+namespace TimeMaster {
+
+/**
+ * @brief Play a scripted co-op match against another process (--net-test)
+ *
+ * Headless and paced at the real tick rate: run one instance with
+ * --coop-host and one with --coop-join, optionally through the latency/loss
+ * shim. Each side feeds its own seeded input stream (movement, attacks and
+ * camera turns), so predictions keep failing and the rollback path is
+ * exercised all match long. Prints sync checks, rollback depths,
+ * re-simulation times and stalls when `ticks` frames are done.
+ * @return Process exit code: 0 when every sync check matched, 1 on desync,
+ * 2 when the peer never answered or went silent
+ */
+int RunNetTest(const NetOptions& options, int ticks);
+
+} // namespace TimeMaster
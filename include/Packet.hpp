@@ -0,0 +1,59 @@
+#pragma once
+#include "Input.hpp"
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief Little-endian packet builder over a caller-owned buffer
+ * The caller sizes the buffer for the largest packet it builds.
+ */
+class PacketWriter {
+private:
+    uint8_t* m_data;
+    uint32_t m_size;
+
+public:
+    explicit PacketWriter(uint8_t* data) : m_data(data), m_size(0) {}
+
+    void Put8(uint8_t value) { m_data[m_size++] = value; }
+    void Put16(uint16_t value) { Put8(static_cast<uint8_t>(value)); Put8(static_cast<uint8_t>(value >> 8)); }
+    void Put32(uint32_t value) { Put16(static_cast<uint16_t>(value)); Put16(static_cast<uint16_t>(value >> 16)); }
+    void Put64(uint64_t value) { Put32(static_cast<uint32_t>(value)); Put32(static_cast<uint32_t>(value >> 32)); }
+    uint32_t GetSize() const { return m_size; }
+};
+
+/**
+ * @brief Bounds-checked reader; reads past the end yield zero and clear IsValid
+ */
+class PacketReader {
+private:
+    const uint8_t* m_data;
+    uint32_t m_size;
+    uint32_t m_offset;
+    bool m_valid;
+
+public:
+    PacketReader(const uint8_t* data, uint32_t size) : m_data(data), m_size(size), m_offset(0), m_valid(true) {}
+
+    uint8_t Get8() {
+        if (m_offset >= m_size) { m_valid = false; return 0; }
+        return m_data[m_offset++];
+    }
+    uint16_t Get16() { uint16_t low = Get8(); return static_cast<uint16_t>(low | (Get8() << 8)); }
+    uint32_t Get32() { uint32_t low = Get16(); return low | (static_cast<uint32_t>(Get16()) << 16); }
+    uint64_t Get64() { uint64_t low = Get32(); return low | (static_cast<uint64_t>(Get32()) << 32); }
+    uint32_t GetRemaining() const { return m_size - m_offset; }
+    const uint8_t* GetCursor() const { return m_data + m_offset; }   // Start of the unread bytes
+    bool IsValid() const { return m_valid; }
+};
+
+/**
+ * @brief Wire form of a PlayerCommand: held movement and one-tick presses in
+ * one byte, the facing in 16 bits (65536 steps per turn)
+ */
+uint8_t EncodeCommandButtons(const PlayerCommand& command);
+uint16_t EncodeCommandYaw(float yaw);
+PlayerCommand DecodeCommand(uint8_t buttons, uint16_t yaw);
+
+} // namespace TimeMaster
@@ -0,0 +1,50 @@
+#pragma once
+#include "ParticleSystem.hpp"
+#include "raylib.h"
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief Draws a ParticleSystem as camera-facing quads in one instanced draw
+ *
+ * The instance buffer holds one run per drawn column (position, size,
+ * colour), each read by its own float attribute, so the system's columns are
+ * uploaded as they are: no per-particle packing on the CPU. A vertex shader
+ * turns one quad towards the camera for every instance and the fragment
+ * shader rounds it into a soft dot. Particles blend additively and test the
+ * scene's depth without writing it, so they need no sorting.
+ *
+ * Goes through rlgl (raylib's DrawMeshInstanced wants a matrix per
+ * instance and copies all of them every call). Render thread only; the GL
+ * context must exist for the whole lifetime.
+ */
+class ParticleRenderer {
+private:
+    static constexpr uint32_t COLUMN_COUNT = 8;     // x, y, z, size, red, green, blue, alpha
+
+    unsigned int m_shader;
+    unsigned int m_vertexArray;
+    unsigned int m_cornerBuffer;
+    unsigned int m_instanceBuffer;
+    int m_mvpLocation;
+    int m_cameraRightLocation;
+    int m_cameraUpLocation;
+    uint32_t m_capacity;
+    bool m_ready;                                   // The shader built, so there is something to draw with
+
+public:
+    explicit ParticleRenderer(uint32_t capacity = MAX_PARTICLES);
+    ~ParticleRenderer();
+
+    ParticleRenderer(const ParticleRenderer&) = delete;
+    ParticleRenderer& operator=(const ParticleRenderer&) = delete;
+
+    /**
+     * @brief Upload the live particles and draw them (inside BeginMode3D)
+     * Draws at most the capacity given at construction.
+     */
+    void Draw(const ParticleSystem& particles, const Camera3D& camera);
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,117 @@
+#pragma once
+#include "Random.hpp"
+#include "Simd.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+// Particle configuration (fixed)
+constexpr uint32_t MAX_PARTICLES = 100000;
+constexpr float PARTICLE_DRAG = 1.5f;               // Share of its velocity a particle loses per second
+constexpr float PARTICLE_MAX_DELTA_TIME = 0.1f;     // A longer frame (a stall) only advances this much
+constexpr uint32_t EFFECT_HISTORY = 64;             // Newest bursts a snapshot carries
+
+/**
+ * @brief Gameplay moments shown as a burst of particles
+ */
+enum class EffectKind : uint8_t {
+    BOSS_HIT,       // Player projectile or melee on the boss
+    PLAYER_HIT,     // Boss bullet or minion on a player
+    PICKUP,         // Tomato collected
+    HEAL,           // Time restored to a player
+    COUNT
+};
+
+/**
+ * @brief One burst to spawn, stamped with the tick whose events caused it
+ */
+struct EffectSpawn {
+    uint64_t tick;
+    Vector3 position;
+    EffectKind kind;
+};
+
+/**
+ * @brief Cosmetic particles in a fixed pool, stored as columns
+ *
+ * Every particle is a row across float columns (position, velocity, age,
+ * lifetime, colour and the colour's rate of change, size), so Update walks
+ * them four at a time with Float4: gravity and drag on the velocity, the
+ * velocity into the position, the colour towards its end value, the age
+ * forward. Rows past their lifetime are then replaced by the last live row;
+ * order does not matter, since particles blend additively. Emit drops what
+ * does not fit. Capacity is fixed at construction and nothing allocates
+ * afterwards.
+ *
+ * Particles never feed back into the simulation: the renderer owns them,
+ * spawns bursts from the EffectSpawns in each snapshot and hands the
+ * position, size and colour columns to the GPU as they are
+ * (ParticleRenderer).
+ */
+class ParticleSystem {
+private:
+    enum Column : uint32_t {
+        POSITION_X,
+        POSITION_Y,
+        POSITION_Z,
+        VELOCITY_X,
+        VELOCITY_Y,
+        VELOCITY_Z,
+        AGE,
+        LIFETIME,
+        COLOR_RED,
+        COLOR_GREEN,
+        COLOR_BLUE,
+        COLOR_ALPHA,
+        COLOR_RED_RATE, // Colour change per second, end colour reached at the end of the lifetime
+        COLOR_GREEN_RATE,
+        COLOR_BLUE_RATE,
+        COLOR_ALPHA_RATE,
+        SIZE,
+        COLUMN_COUNT
+    };
+
+    std::vector<float> m_columns;           // COLUMN_COUNT runs of m_stride floats
+    std::vector<uint32_t> m_expiredGroups;  // Update scratch: first rows of the groups where a particle expired
+    uint32_t m_stride;                      // Capacity padded by SIMD_WIDTH, so a lane past the end stays in bounds
+    uint32_t m_capacity;
+    uint32_t m_count;
+    Random m_random;
+
+    float* GetColumn(Column column) { return m_columns.data() + column * m_stride; }
+    const float* GetColumn(Column column) const { return m_columns.data() + column * m_stride; }
+    void MoveRow(uint32_t from, uint32_t to);
+
+public:
+    explicit ParticleSystem(uint32_t capacity = MAX_PARTICLES);
+
+    /**
+     * @brief Spawn the burst for one effect around position
+     * @return Particles added (fewer when the pool is full)
+     */
+    uint32_t Emit(EffectKind kind, Vector3 position);
+
+    /**
+     * @brief Advance every particle by deltaTime and drop the expired ones
+     */
+    void Update(float deltaTime);
+
+    void Clear() { m_count = 0; }
+
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetCapacity() const { return m_capacity; }
+
+    // Columns the billboards are drawn from (GetCount() rows each; colour in 0-1)
+    const float* GetX() const { return GetColumn(POSITION_X); }
+    const float* GetY() const { return GetColumn(POSITION_Y); }
+    const float* GetZ() const { return GetColumn(POSITION_Z); }
+    const float* GetSize() const { return GetColumn(SIZE); }
+    const float* GetRed() const { return GetColumn(COLOR_RED); }
+    const float* GetGreen() const { return GetColumn(COLOR_GREEN); }
+    const float* GetBlue() const { return GetColumn(COLOR_BLUE); }
+    const float* GetAlpha() const { return GetColumn(COLOR_ALPHA); }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace TimeMaster {
+
+/**
+ * @brief Command-line options for scripted performance runs (--perf)
+ */
+struct PerfOptions {
+    std::string scenario = "all";     // Scenario name, or "all"
+    std::string baselinePath;         // Baseline JSON to compare against (optional)
+    std::string resultsPath;          // Where to write measured results (optional)
+    std::string writeBaselinePath;    // Write results as a new baseline (optional)
+    int warmupFrames = 60;            // Frames discarded before measuring
+    int frames = 600;                 // Measured frames per scenario
+    bool allocTest = false;           // Fail if a steady-state frame allocates
+};
+
+/**
+ * @brief Frame-time distribution for one scenario run (milliseconds)
+ */
+struct PerfResult {
+    std::string name;
+    int frames;
+    float mean;
+    float p50;
+    float p95;
+    float p99;
+    float max;
+    int allocatingFrames;   // Steady-state frames that hit the heap (alloc test)
+    uint64_t allocations;
+};
+
+/**
+ * @brief Run scripted scenarios in a hidden window and gate on the baseline
+ * make perf runs them on the headless build (time_master_perf), where draw
+ * calls are no-ops and a frame is CPU work only.
+ *
+ * Scenarios drive Game through InputFrame with a fixed timestep, so every run
+ * simulates the same frames; only the measured wall time differs. With
+ * allocTest set, heap allocations are tracked after warm-up and any
+ * steady-state gameplay frame that allocates fails the run.
+ * @return Process exit code: 0 on success, 1 when a scenario's p99 frame time
+ * regressed past the baseline tolerance or has no baseline entry (or a frame
+ * allocated in alloc-test mode), 2 on usage/IO errors
+ */
+int RunPerfScenarios(const PerfOptions& options);
+
+/**
+ * @brief Print the available scenario names
+ */
+void ListPerfScenarios();
+
+} // namespace TimeMaster
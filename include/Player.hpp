@@ -1,12 +1,45 @@
 #pragma once
-#include "Entity.hpp"
 #include "Config.hpp"
 #include "Collision.hpp"
+#include "GameAssets.hpp"
+#include "Input.hpp"
 #include "raylib.h"
+#include <cstddef>
 
 namespace TimeMaster {
 
-class Player : public Entity, public IDamageable, public ITimedEntity {
+/**
+ * @brief What the renderer needs to draw a Player (copied into frame snapshots)
+ */
+struct PlayerSnapshot {
+    Vector3 position;
+    Vector3 size;
+    float rotation;
+    float time;
+    int animIndex;   // -1 = no animation playing
+    int animFrame;
+    Color color;
+    bool alive;
+};
+
+/**
+ * @brief Everything about a Player that changes during a match (rewind frames)
+ */
+struct PlayerRecord {
+    Vector3 position;
+    Vector3 velocity;
+    float time;
+    float rotation;
+    float animTimer;
+    int animIndex;
+    int animFrame;
+    Color color;
+    bool alive;
+    bool moving;
+    bool running;
+};
+
+class Player {
 private:
     Vector3 m_position;
     Vector3 m_velocity;     // Velocity for physics (gravity)
@@ -24,40 +57,34 @@ private:
     bool m_isRunning;       // Running state (shift key)
     float m_rotationAngle;  // Rotation angle to face camera
     
-    // Static model (shared by all players, though typically only one exists)
-    static Model s_model;
-    static bool s_modelLoaded;
-    static ModelAnimation* s_animations;
-    static int s_animationCount;
+    // Shared read-only data
+    const GameConfig& m_config;
+    const ModelAsset& m_asset;
     
-public:
-    Player();
-    ~Player();
+    // Animation indices resolved from the asset's animation names (-1 = none)
+    int m_idleAnim;
+    int m_walkAnim;
+    int m_runAnim;
     
-    /**
-     * @brief Load shared player model (call once)
-     */
-    static void LoadModel();
+    void UpdateAnimation(float deltaTime);
     
-    /**
-     * @brief Unload shared player model (call once on cleanup)
-     */
-    static void UnloadModel();
+public:
+    Player(const GameConfig& config, const ModelAsset& asset);
     
-    // Entity interface
-    void Update(float deltaTime) override;
-    void Draw() const override;
-    bool IsActive() const override { return m_isAlive; }
-    Vector3 GetPosition() const override { return m_position; }
+    // Lifecycle
+    void Update(float deltaTime);
+    void Draw() const;
+    bool IsActive() const { return m_isAlive; }
+    Vector3 GetPosition() const { return m_position; }
     
-    // IDamageable interface
-    void TakeDamage(float damage) override;
-    bool IsAlive() const override { return m_isAlive; }
-    float GetHealth() const override { return m_time; }
+    // Health
+    void TakeDamage(float damage);
+    bool IsAlive() const { return m_isAlive; }
+    float GetHealth() const { return m_time; }
     
-    // ITimedEntity interface
-    std::string GetTimeString() const override;
-    float GetTime() const override { return m_time; }
+    // Time (health) display
+    const char* FormatTime(char* buffer, size_t size) const;
+    float GetTime() const { return m_time; }
     
     // Player specific methods
     void Heal(float amount);
@@ -78,7 +105,16 @@ public:
     void Move(Vector3 direction, float deltaTime);
     void SetPosition(Vector3 position) { m_position = position; }
     void SetCameraAngle(float angle) { m_rotationAngle = angle; }
-    void UpdateWithCamera(float deltaTime, Vector3 cameraForward, Vector3 cameraRight);
+    void SetColor(Color color) { m_color = color; }
+    void UpdateWithCamera(const PlayerCommand& command, float deltaTime, Vector3 cameraForward, Vector3 cameraRight);
+    
+    // Rewind
+    PlayerRecord SaveRecord() const;
+    void LoadRecord(const PlayerRecord& record);
+    
+    // Rendering
+    PlayerSnapshot GetSnapshot() const;
+    static void DrawSnapshot(const PlayerSnapshot& snapshot, const ModelAsset& asset);
 
     void ClampToArenaCircle();
 };
@@ -0,0 +1,288 @@
+#pragma once
+#include "AllocTracker.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TimeMaster {
+
+using ZoneId = uint16_t;
+
+// Profiler configuration (fixed)
+constexpr int PROFILER_MAX_ZONES = 64;
+constexpr int PROFILER_HISTORY_FRAMES = 240;        // ~4 seconds at 60 FPS
+constexpr uint32_t PROFILER_THREAD_EVENTS = 4096;   // Per-thread ring capacity (power of two)
+constexpr float PROFILER_CAPTURE_SECONDS = 5.0f;    // Default trace capture length
+
+static_assert(PROFILER_MAX_ZONES <= ALLOC_MAX_ZONES, "Allocation tracker must cover every zone");
+
+enum class ZoneEventKind : uint8_t {
+    ZONE,    // Timed scope (start..end)
+    MARKER   // Instant event (start == end)
+};
+
+/**
+ * @brief One timed zone instance recorded by a thread
+ */
+struct ZoneEvent {
+    uint64_t start;  // Nanoseconds (steady clock)
+    uint64_t end;
+    ZoneId zone;
+    ZoneEventKind kind;
+};
+
+/**
+ * @brief Zone event tagged with its thread, kept while a trace capture runs
+ */
+struct CapturedEvent {
+    ZoneEvent event;
+    uint32_t thread;
+};
+
+/**
+ * @brief Frame boundary kept while a trace capture runs
+ */
+struct CapturedFrame {
+    uint64_t start;
+    uint64_t end;
+    uint64_t index;
+    uint32_t thread;
+};
+
+/**
+ * @brief Single-producer/single-consumer ring of zone events
+ * The owning thread pushes, the main thread drains once per frame.
+ * Events are dropped (and counted) when the ring is full.
+ */
+class ThreadEventBuffer {
+private:
+    std::array<ZoneEvent, PROFILER_THREAD_EVENTS> m_events;
+    std::atomic<uint32_t> m_head;   // Written by producer
+    std::atomic<uint32_t> m_tail;   // Written by consumer
+    std::atomic<uint32_t> m_dropped;
+    uint32_t m_threadIndex;
+    const char* m_name;
+
+public:
+    explicit ThreadEventBuffer(uint32_t threadIndex)
+        : m_head(0), m_tail(0), m_dropped(0), m_threadIndex(threadIndex), m_name(nullptr) {}
+
+    void Push(const ZoneEvent& event) {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= PROFILER_THREAD_EVENTS) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_events[head & (PROFILER_THREAD_EVENTS - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consume all pending events, calling fn(const ZoneEvent&) for each
+     */
+    template <typename Fn>
+    void Drain(Fn&& fn) {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        uint32_t head = m_head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            fn(m_events[tail & (PROFILER_THREAD_EVENTS - 1)]);
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    uint32_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint32_t GetThreadIndex() const { return m_threadIndex; }
+    const char* GetName() const { return m_name; }
+    void SetName(const char* name) { m_name = name; }
+};
+
+/**
+ * @brief Aggregated timings for one zone over the frame history (milliseconds)
+ */
+struct ZoneStats {
+    float last;
+    float average;
+    float p95;
+    float p99;
+};
+
+/**
+ * @brief Scoped-zone frame profiler
+ * Zones are only timed while the profiler is enabled (overlay visible, a
+ * trace capture running, or background timing requested by the flight
+ * recorder), so the cost of an instrumented scope when disabled is a single
+ * relaxed atomic load.
+ */
+class Profiler {
+private:
+    static std::atomic<bool> s_enabled;
+
+    // Zone registry
+    std::mutex m_mutex;
+    std::array<const char*, PROFILER_MAX_ZONES> m_zoneNames;
+    int m_zoneCount;
+
+    // Per-thread event rings (owned here, referenced thread_local by producers)
+    std::vector<std::unique_ptr<ThreadEventBuffer>> m_threadBuffers;
+
+    // Frame history
+    uint64_t m_frameStart;
+    uint64_t m_frameIndex;
+    std::array<float, PROFILER_HISTORY_FRAMES> m_frameTimes;
+    std::array<std::array<float, PROFILER_MAX_ZONES>, PROFILER_HISTORY_FRAMES> m_zoneTimes;
+    std::array<float, PROFILER_MAX_ZONES> m_currentZoneTimes;
+    mutable std::array<float, PROFILER_HISTORY_FRAMES> m_scratch;
+
+    bool m_overlayVisible;
+    bool m_backgroundTiming;
+
+    // Chrome trace capture
+    bool m_capturing;
+    uint64_t m_captureStart;
+    uint64_t m_captureDuration;
+    std::vector<CapturedEvent> m_capturedEvents;
+    std::vector<CapturedFrame> m_capturedFrames;
+    std::string m_lastCapturePath;
+
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    ThreadEventBuffer& GetThreadBuffer();
+    ZoneStats ComputeStats(const float* samples, int stride, int count) const;
+    void UpdateEnabled();
+    void FinishCapture();
+    bool WriteChromeTrace(const char* path) const;
+
+public:
+    /**
+     * @brief Get the singleton instance
+     */
+    static Profiler& GetInstance();
+
+    /**
+     * @brief Check whether zones are currently being timed
+     */
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Current timestamp in nanoseconds
+     */
+    static uint64_t Now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Register a zone name (same name returns the same id)
+     */
+    ZoneId RegisterZone(const char* name);
+
+    /**
+     * @brief Record a finished zone on the calling thread
+     */
+    void Record(ZoneId zone, uint64_t start, uint64_t end) {
+        GetThreadBuffer().Push({start, end, zone, ZoneEventKind::ZONE});
+    }
+
+    /**
+     * @brief Record an instant marker (e.g. a state transition) on the calling thread
+     * @param name String literal; registered like a zone name
+     */
+    void Marker(const char* name);
+
+    /**
+     * @brief Name the calling thread in trace output (string literal)
+     */
+    void SetThreadName(const char* name);
+
+    /**
+     * @brief Mark frame boundaries (call from the main thread)
+     */
+    void BeginFrame();
+    void EndFrame();
+
+    /**
+     * @brief Toggle the on-screen overlay (also enables/disables zone timing)
+     */
+    void ToggleOverlay() { SetOverlayVisible(!m_overlayVisible); }
+    void SetOverlayVisible(bool visible);
+    bool IsOverlayVisible() const { return m_overlayVisible; }
+
+    /**
+     * @brief Keep timing zones without overlay or capture (flight recorder)
+     */
+    void SetBackgroundTiming(bool enabled);
+
+    /**
+     * @brief Capture every zone, marker and frame boundary for the given time,
+     * then write a Chrome trace-event JSON file (about://tracing / Perfetto)
+     */
+    void BeginCapture(float seconds);
+    bool IsCapturing() const { return m_capturing; }
+    float GetCaptureProgress() const;
+    const std::string& GetLastCapturePath() const { return m_lastCapturePath; }
+
+    // Overlay queries
+    int GetZoneCount() const { return m_zoneCount; }
+    const char* GetZoneName(ZoneId zone) const { return m_zoneNames[zone]; }
+    int GetHistoryCount() const;
+    float GetFrameTime(int framesAgo) const;
+    ZoneStats GetFrameStats() const;
+    ZoneStats GetZoneStats(ZoneId zone) const;
+    const std::array<float, PROFILER_MAX_ZONES>& GetLastZoneTimes() const { return m_currentZoneTimes; }
+    uint32_t GetDroppedEventCount();
+};
+
+/**
+ * @brief RAII timer for one zone instance
+ * Also attributes heap allocations to the zone while AllocTracker is enabled.
+ */
+class ScopedZone {
+private:
+    ZoneId m_zone;
+    uint64_t m_start;  // 0 when the profiler was disabled on entry
+    uint16_t m_previousAllocZone;
+    bool m_trackingAllocs;
+
+public:
+    explicit ScopedZone(ZoneId zone)
+        : m_zone(zone)
+        , m_start(Profiler::IsEnabled() ? Profiler::Now() : 0)
+        , m_previousAllocZone(ALLOC_NO_ZONE)
+        , m_trackingAllocs(AllocTracker::IsEnabled()) {
+        if (m_trackingAllocs) {
+            m_previousAllocZone = AllocTracker::EnterZone(zone);
+        }
+    }
+
+    ~ScopedZone() {
+        if (m_trackingAllocs) {
+            AllocTracker::LeaveZone(m_previousAllocZone);
+        }
+        if (m_start != 0) {
+            Profiler::GetInstance().Record(m_zone, m_start, Profiler::Now());
+        }
+    }
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+};
+
+} // namespace TimeMaster
+
+#define TM_PROFILE_CONCAT_INNER(a, b) a##b
+#define TM_PROFILE_CONCAT(a, b) TM_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Time the enclosing scope under the given zone name (string literal)
+ */
+#define PROFILE_ZONE(name)                                                              \
+    static const ::TimeMaster::ZoneId TM_PROFILE_CONCAT(tmZoneId_, __LINE__) =          \
+        ::TimeMaster::Profiler::GetInstance().RegisterZone(name);                       \
+    ::TimeMaster::ScopedZone TM_PROFILE_CONCAT(tmZone_, __LINE__)(TM_PROFILE_CONCAT(tmZoneId_, __LINE__))
@@ -1,32 +1,68 @@
 #pragma once
-#include "Entity.hpp"
+#include "Archetype.hpp"
+#include "Components.hpp"
 #include "Config.hpp"
+#include "HitboxHistory.hpp"
 #include "raylib.h"
+#include <cstdint>
 
 namespace TimeMaster {
 
-class Projectile : public Entity {
-private:
-    Vector3 m_position;
-    Vector3 m_velocity;
-    float m_radius;
-    bool m_active;
-    Color m_color;
-    
-public:
-    Projectile();
-    
-    // Entity interface
-    void Update(float deltaTime) override;
-    void Draw() const override;
-    bool IsActive() const override { return m_active; }
-    Vector3 GetPosition() const override { return m_position; }
-    
-    // Projectile specific methods
-    void Launch(Vector3 startPos, Vector3 targetPos);
-    void Deactivate();
-    bool CheckCollision(Vector3 pos, float otherRadius);
-    float GetRadius() const { return m_radius; }
+/**
+ * @brief What the renderer needs to draw a Projectile (copied into frame snapshots)
+ */
+struct ProjectileSnapshot {
+    Vector3 position;
+    float radius;
+    Color color;
+    bool active;
 };
 
+/**
+ * @brief Player projectiles: one row per projectile in flight
+ */
+using ProjectileArchetype = Archetype<Position, Velocity, Collider, Renderable, LagCompensation>;
+
+// UpdateProjectiles results, per row
+constexpr uint8_t PROJECTILE_FLYING = 0;
+constexpr uint8_t PROJECTILE_HIT = 1;
+constexpr uint8_t PROJECTILE_LEFT_ARENA = 2;
+
+/**
+ * @brief The capsules projectiles are tested against (the boss's)
+ * Projectiles fired with lag meet the hitbox history's capsules of that many
+ * ticks before `tick` instead (the live ones when it is not held).
+ */
+struct ProjectileTarget {
+    const CapsuleSet* capsules;
+    const HitboxHistory* history;
+    uint32_t tick;
+};
+
+/**
+ * @brief Add a projectile flying from start toward target
+ * @param lagTicks Ticks the shooter's view trailed the server by
+ * @return INVALID_ENTITY when every projectile is already in flight
+ */
+EntityId LaunchProjectile(ProjectileArchetype& projectiles, Vector3 start, Vector3 target, float speed,
+                          uint32_t lagTicks = 0);
+
+/**
+ * @brief Move rows [begin, end) and test their colliders against the target
+ * status[row] becomes PROJECTILE_HIT, PROJECTILE_LEFT_ARENA or
+ * PROJECTILE_FLYING. Rows are independent, so disjoint ranges may run in
+ * parallel jobs.
+ */
+void UpdateProjectiles(ProjectileArchetype& projectiles, uint32_t begin, uint32_t end, float deltaTime,
+                       const ProjectileTarget& target, uint8_t* status);
+
+/**
+ * @brief Destroy the rows UpdateProjectiles finished (reorders the survivors
+ * and their status entries)
+ */
+void RemoveFinishedProjectiles(ProjectileArchetype& projectiles, uint8_t* status);
+
+ProjectileSnapshot GetProjectileSnapshot(const ProjectileArchetype& projectiles, uint32_t row);
+void DrawProjectileSnapshot(const ProjectileSnapshot& snapshot);
+
 } // namespace TimeMaster
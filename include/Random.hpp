@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief Complete generator state (can be saved, logged and restored)
+ */
+struct RandomState {
+    uint64_t state;
+    uint64_t increment;
+};
+
+/**
+ * @brief Small deterministic random number generator (PCG32)
+ * Replaces raylib's GetRandomValue so the game owns its RNG state: it can be
+ * recorded alongside frame data and restored to reproduce a run.
+ */
+class Random {
+private:
+    RandomState m_state;
+    
+public:
+    explicit Random(uint64_t seed = 0x853c49e6748fea9bull) { Seed(seed); }
+    
+    /**
+     * @brief Restart the sequence from a seed
+     */
+    void Seed(uint64_t seed, uint64_t sequence = 0xda3e39cb94b95bdbull) {
+        m_state.state = 0;
+        m_state.increment = (sequence << 1) | 1u;
+        NextU32();
+        m_state.state += seed;
+        NextU32();
+    }
+    
+    uint32_t NextU32() {
+        uint64_t old = m_state.state;
+        m_state.state = old * 6364136223846793005ull + m_state.increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+    
+    /**
+     * @brief Random integer in [min, max] (same contract as GetRandomValue)
+     */
+    int Range(int min, int max) {
+        if (min > max) {
+            int tmp = max;
+            max = min;
+            min = tmp;
+        }
+        uint32_t span = static_cast<uint32_t>(max - min) + 1u;
+        return span == 0 ? static_cast<int>(NextU32()) : min + static_cast<int>(NextU32() % span);
+    }
+    
+    /**
+     * @brief Random float in [0, 1)
+     */
+    float Float01() {
+        return static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f);
+    }
+    
+    const RandomState& GetState() const { return m_state; }
+    void SetState(const RandomState& state) { m_state = state; }
+};
+
+} // namespace TimeMaster
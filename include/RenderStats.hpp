@@ -0,0 +1,116 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TimeMaster {
+
+constexpr int RENDER_STATS_SPHERE_TRIANGLES = 18 * 16 * 2;   // DrawSphere: 16 rings (+2 caps) x 16 slices
+constexpr size_t RENDER_STATS_CSV_RESERVE = 60 * 60;          // One minute at 60 FPS
+
+/**
+ * @brief Render work submitted during one frame
+ */
+struct RenderCounters {
+    uint32_t drawCalls;          // Mesh draws plus immediate-mode batch flushes
+    uint32_t triangles;          // Triangles submitted (meshes and immediate shapes)
+    uint32_t skinnedVertices;    // Vertices processed by CPU skinning
+    uint64_t uploadBytes;        // Bytes sent to GPU vertex buffers (skinned vertices, particles)
+    uint32_t textureBinds;       // Texture changes between consecutive draws
+    uint32_t shaderSwitches;     // Shader program changes between consecutive draws
+};
+
+/**
+ * @brief Per-frame render statistics
+ * Counts are accumulated by the Gfx:: wrappers below, which stand in for the
+ * raylib calls used by gameplay draw code. Texture binds and shader switches
+ * are estimated the way rlgl batches: immediate-mode shapes share one batch
+ * (default texture/shader) until a mesh draw breaks it.
+ * Main thread only.
+ */
+class RenderStats {
+private:
+    RenderCounters m_current;
+    RenderCounters m_last;
+    uint64_t m_frameIndex;
+    
+    // Batch state used to estimate binds/switches
+    unsigned int m_boundTexture;
+    unsigned int m_boundShader;
+    bool m_batchOpen;
+    
+    bool m_overlayVisible;
+    
+    // CSV recording (rows buffered in memory, written when recording stops)
+    bool m_recording;
+    std::vector<RenderCounters> m_csvRows;
+    std::string m_lastCsvPath;
+    
+    RenderStats();
+    RenderStats(const RenderStats&) = delete;
+    RenderStats& operator=(const RenderStats&) = delete;
+    
+    void Bind(unsigned int texture, unsigned int shader);
+    bool WriteCsv(const char* path) const;
+    
+public:
+    /**
+     * @brief Get the singleton instance
+     */
+    static RenderStats& GetInstance();
+    
+    /**
+     * @brief Mark frame boundaries (call from the main loop)
+     */
+    void BeginFrame();
+    void EndFrame();
+    
+    /**
+     * @brief Accounting hooks used by the Gfx:: wrappers (and Skinner uploads,
+     * and the particle draw, which goes through rlgl)
+     */
+    void AddMesh(const Mesh& mesh, const Material& material);
+    void AddImmediate(uint32_t triangles);
+    void AddSkinning(uint32_t vertices, uint64_t uploadBytes);
+    void AddInstanced(uint32_t triangles, unsigned int shader, uint64_t uploadBytes);
+    
+    /**
+     * @brief Counters of the last completed frame
+     */
+    const RenderCounters& GetLastFrame() const { return m_last; }
+    
+    /**
+     * @brief Toggle the on-screen overlay
+     */
+    void ToggleOverlay() { m_overlayVisible = !m_overlayVisible; }
+    bool IsOverlayVisible() const { return m_overlayVisible; }
+    
+    /**
+     * @brief Start/stop recording one CSV row per frame; stopping writes
+     * render_stats_<timestamp>.csv
+     */
+    void ToggleCsvRecording();
+    bool IsRecording() const { return m_recording; }
+    size_t GetRecordedFrames() const { return m_csvRows.size(); }
+    const std::string& GetLastCsvPath() const { return m_lastCsvPath; }
+};
+
+/**
+ * @brief Counting wrappers around the raylib draw calls used by the game
+ */
+namespace Gfx {
+
+void DrawModel(Model model, Vector3 position, float scale, Color tint);
+void DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint);
+void DrawCube(Vector3 position, float width, float height, float length, Color color);
+void DrawCubeWires(Vector3 position, float width, float height, float length, Color color);
+void DrawSphere(Vector3 centerPos, float radius, Color color);
+void DrawSphereEx(Vector3 centerPos, float radius, int rings, int slices, Color color);
+void DrawCapsuleWires(Vector3 startPos, Vector3 endPos, float radius, int slices, int rings, Color color);
+void DrawPlane(Vector3 centerPos, Vector2 size, Color color);
+void DrawGrid(int slices, float spacing);
+
+} // namespace Gfx
+
+} // namespace TimeMaster
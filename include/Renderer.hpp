@@ -0,0 +1,67 @@
+#pragma once
+#include "GameAssets.hpp"
+#include "HUD.hpp"
+#include "ParticleRenderer.hpp"
+#include "ParticleSystem.hpp"
+#include "Skinning.hpp"
+#include "raylib.h"
+#include <cstdint>
+
+namespace TimeMaster {
+
+struct FrameSnapshot;
+
+/**
+ * @brief Draws published frame snapshots (render thread)
+ * Owns every GL-side resource that is not a shared model: the arena, the
+ * HUD font, the skinning output and the particles. Apart from the snapshot
+ * it only reads the shared GameAssets, so the simulation can keep running
+ * meanwhile.
+ */
+class Renderer {
+private:
+    const GameAssets& m_assets;
+    HUD m_hud;
+
+    // Arena model
+    Model m_arenaModel;
+    bool m_arenaModelLoaded;
+
+    // Skinned poses are computed here, from the snapshot's animation frames
+    Skinner m_bossSkinner;
+    Skinner m_playerSkinner;
+
+    // Hit and pickup particles, spawned from the snapshots' effects
+    ParticleSystem m_particles;
+    ParticleRenderer m_particleRenderer;
+    uint64_t m_lastEffectTick;      // Effects up to this tick are spawned already
+
+    // Cursor state last applied to the window
+    bool m_cursorLocked;
+
+    void DrawPlaying(const FrameSnapshot& frame);
+    void DrawPaused(const FrameSnapshot& frame);
+    void DrawArena() const;
+    void UpdateParticles(const FrameSnapshot& frame);
+    Job* ScheduleBossSkinning(JobSystem& jobs, const FrameSnapshot& frame);
+    Job* SchedulePlayerSkinning(JobSystem& jobs, const FrameSnapshot& frame);
+
+public:
+    explicit Renderer(const GameAssets& assets);
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    /**
+     * @brief Debug hotkeys (F3-F7): profiler, trace capture, render stats, CSV, alloc tracking
+     */
+    void HandleDebugKeys();
+
+    /**
+     * @brief Draw one snapshot (between BeginDrawing and EndDrawing)
+     */
+    void Draw(const FrameSnapshot& frame);
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,114 @@
+#pragma once
+#include "BossState.hpp"
+#include "Config.hpp"
+#include "GameState.hpp"
+#include "raylib.h"
+#include <cstdint>
+
+namespace TimeMaster {
+
+struct PlayerSnapshot;
+struct BossSnapshot;
+struct Bullet;
+
+// Replicated state quantization (server -> client snapshots, fixed)
+constexpr uint32_t REPLICATION_POSITION_BITS = 14;     // x / z across [-ARENA_SIZE, ARENA_SIZE]
+constexpr uint32_t REPLICATION_HEIGHT_BITS = 13;       // y across [-ARENA_SIZE / 2, ARENA_SIZE / 2]
+constexpr float REPLICATION_POSITION_STEP = 2.0f * ARENA_SIZE / (1u << REPLICATION_POSITION_BITS);   // ~0.05 units
+constexpr uint32_t REPLICATION_VELOCITY_BITS = 14;     // Signed, position steps per REPLICATION_VELOCITY_TICKS
+constexpr int32_t REPLICATION_VELOCITY_TICKS = 16;
+constexpr uint32_t REPLICATION_TIME_BITS = 16;         // Centiseconds (~11 minutes)
+constexpr float REPLICATION_TIME_SCALE = 100.0f;
+constexpr uint32_t REPLICATION_ROTATION_BITS = 10;     // Steps per turn: 1024
+constexpr uint32_t REPLICATION_STATE_BITS = 3;         // GameState, BossState
+constexpr uint32_t REPLICATION_MAX_BULLETS = 256;      // Bullets beyond this (or the packet) are not sent
+
+static_assert(BOSS_STATE_COUNT <= (1 << REPLICATION_STATE_BITS), "BossState must fit REPLICATION_STATE_BITS");
+
+/**
+ * @brief One match tick as clients see it, quantized
+ * Positions are arena-relative fixed point, so they are small unsigned
+ * integers; the codec below sends them as deltas against a baseline.
+ * Accessors turn them back into world units.
+ */
+struct ReplicatedState {
+    struct Point {
+        uint16_t x, y, z;
+    };
+    struct Player {
+        Point position;
+        uint16_t time;
+        uint16_t rotation;
+        bool alive;
+    };
+    struct Boss {
+        Point position;
+        uint16_t time;
+        uint16_t rotation;
+        uint8_t state;        // BossState
+    };
+    struct Bullet {
+        Point position;
+        int16_t vx, vy, vz;
+    };
+
+    uint32_t tick;
+    uint8_t state;            // GameState
+    uint8_t playerCount;
+    Player players[MAX_PLAYERS];
+    Boss boss;
+    uint32_t tomatoMask;                          // Bit per active tomato slot
+    Point tomatoes[MAX_TOMATOES];
+    uint32_t projectileMask;                      // Bit per active player projectile
+    Point projectiles[MAX_PLAYER_PROJECTILES];
+    uint32_t bulletCount;
+    Bullet bullets[REPLICATION_MAX_BULLETS];
+};
+
+/**
+ * @brief Entity state -> fixed point (clamped to the representable range)
+ * Tomatoes and player projectiles are plain positions.
+ */
+ReplicatedState::Point QuantizePosition(Vector3 position);
+int16_t QuantizeSpeed(float unitsPerSecond);                  // One velocity component
+ReplicatedState::Player QuantizePlayer(const PlayerSnapshot& player);
+ReplicatedState::Boss QuantizeBoss(const BossSnapshot& boss);
+ReplicatedState::Bullet QuantizeBullet(const Bullet& bullet);
+
+/**
+ * @brief Fixed point -> world units
+ */
+Vector3 GetReplicatedPosition(const ReplicatedState::Point& point);
+float GetReplicatedSpeed(int16_t speed);
+float GetReplicatedTime(uint16_t time);
+float GetReplicatedRotation(uint16_t rotation);
+
+/**
+ * @brief Bit-pack a state as a delta against a baseline both sides hold
+ *
+ * Every field is "unchanged" in one bit, a small change in 6 or 11 bits, or
+ * its raw value. Bullets are predicted from the baseline's velocity over the
+ * ticks in between (new bullets from their predecessor in the same volley),
+ * so a steady bullet costs a few bits. Bullets that would overflow capacity
+ * are left out; bulletsWritten says how many went in, and the sender must
+ * trim its copy to match before using it as a baseline.
+ * @param base Baseline (nullptr = none: every field against zero)
+ * @return Bytes written (0 if even the entities before the bullets do not fit)
+ */
+uint32_t EncodeReplicatedState(const ReplicatedState& state, const ReplicatedState* base,
+                               uint8_t* out, uint32_t capacity, uint32_t& bulletsWritten);
+
+/**
+ * @brief Rebuild a state from EncodeReplicatedState output and the same baseline
+ * Bounds-checked, so it is safe on untrusted input. Allocation-free.
+ * @return false if the data is truncated or malformed
+ */
+bool DecodeReplicatedState(const uint8_t* data, uint32_t size, const ReplicatedState* base, uint32_t tick,
+                           ReplicatedState& state);
+
+/**
+ * @brief Checksum of everything the codec carries (detects a wrong baseline)
+ */
+uint32_t ComputeReplicatedChecksum(const ReplicatedState& state);
+
+} // namespace TimeMaster
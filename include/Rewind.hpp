@@ -0,0 +1,204 @@
+#pragma once
+#include "Config.hpp"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace TimeMaster {
+
+// Rewind configuration (fixed)
+constexpr float REWIND_SECONDS = 10.0f;                          // History kept while playing
+constexpr uint32_t REWIND_MAX_FRAMES = static_cast<uint32_t>(REWIND_SECONDS * SIMULATION_TICK_RATE);
+constexpr uint32_t REWIND_KEYFRAME_INTERVAL = 30;                // Ticks between keyframes
+// Encoded history budget per game: the full window with MAX_BOSS_PROJECTILES
+// bullets in flight (the rewind bench checks it)
+constexpr uint32_t REWIND_STORAGE_BYTES = 4u << 20;
+// Added per live horde minion: minions move every tick, so each costs its
+// quantized record (8 bytes, MinionHorde::WriteRewind) in every frame
+constexpr uint32_t REWIND_STORAGE_BYTES_PER_MINION = 8 * REWIND_MAX_FRAMES;
+constexpr int REWIND_FRAMES_PER_TICK = 2;                        // Scrub speed while rewinding
+
+/**
+ * @brief Worst-case EncodeDelta output for a frame of `words` words
+ * (alternating zero / non-zero words)
+ */
+constexpr uint32_t GetMaxDeltaWords(uint32_t words) { return words * 2 + 4; }
+
+/**
+ * @brief XOR a frame against a base frame and run-length encode the zero words
+ * Encoded as [frame words] then tokens of [zero words << 16 | literal words]
+ * [literal words...]. Words past the end of the base (or every word, with no
+ * base) are taken as they are. Rewind records and network snapshots use it.
+ * @return Words written to out (at most GetMaxDeltaWords(words))
+ */
+uint32_t EncodeDelta(const uint32_t* frame, uint32_t words, const uint32_t* base, uint32_t baseWords, uint32_t* out);
+
+/**
+ * @brief Rebuild a frame from EncodeDelta output and the same base
+ * Bounds-checked, so it is safe on untrusted input.
+ * @return false if the encoding is malformed or the frame exceeds capacity
+ */
+bool DecodeDelta(const uint32_t* encoded, uint32_t encodedWords, const uint32_t* base, uint32_t baseWords,
+                 uint32_t* out, uint32_t capacity, uint32_t& words);
+
+/**
+ * @brief Appends plain values to a frame as 32-bit words (no allocation)
+ * Only trivially copyable types can be written; they are copied byte for byte
+ * and padded to a whole word, so a frame is valid only inside this process.
+ */
+class StateWriter {
+private:
+    uint32_t* m_words;
+    uint32_t m_capacity;
+    uint32_t m_count;
+    bool m_overflow;
+
+public:
+    StateWriter(uint32_t* words, uint32_t capacity)
+        : m_words(words), m_capacity(capacity), m_count(0), m_overflow(false) {}
+
+    template <typename T>
+    void WriteArray(const T* values, uint32_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "rewind state must be trivially copyable");
+        uint32_t bytes = static_cast<uint32_t>(sizeof(T)) * count;
+        uint32_t words = (bytes + 3) / 4;
+        if (m_count + words > m_capacity) {
+            m_overflow = true;
+            return;
+        }
+        if (words > 0) m_words[m_count + words - 1] = 0;   // Zero the padding
+        std::memcpy(m_words + m_count, values, bytes);
+        m_count += words;
+    }
+
+    template <typename T>
+    void Write(const T& value) { WriteArray(&value, 1); }
+
+    uint32_t GetWordCount() const { return m_count; }
+    bool HasOverflowed() const { return m_overflow; }
+};
+
+/**
+ * @brief Reads values back in the order a StateWriter wrote them
+ */
+class StateReader {
+private:
+    const uint32_t* m_words;
+    uint32_t m_count;
+    uint32_t m_position;
+
+public:
+    StateReader(const uint32_t* words, uint32_t count)
+        : m_words(words), m_count(count), m_position(0) {}
+
+    template <typename T>
+    bool ReadArray(T* values, uint32_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "rewind state must be trivially copyable");
+        uint32_t bytes = static_cast<uint32_t>(sizeof(T)) * count;
+        uint32_t words = (bytes + 3) / 4;
+        if (m_position + words > m_count) return false;
+        std::memcpy(static_cast<void*>(values), m_words + m_position, bytes);
+        m_position += words;
+        return true;
+    }
+
+    template <typename T>
+    bool Read(T& value) { return ReadArray(&value, 1); }
+};
+
+/**
+ * @brief Ring buffer of per-tick game state frames for the rewind ability
+ * Frames are serialized into GetFrame() and pushed once per tick. Every
+ * REWIND_KEYFRAME_INTERVAL ticks a keyframe is stored; the frames between
+ * are XOR deltas against it. Both are run-length encoded on zero words, so
+ * state that did not change since the keyframe costs almost nothing and any
+ * frame decodes from two records. When the frame count or byte budget is
+ * exceeded the oldest keyframe group is dropped. Allocates only when the
+ * budget is reserved, grown past the reservation or reset.
+ */
+class RewindBuffer {
+private:
+    static constexpr uint64_t NO_KEYFRAME = UINT64_MAX;
+
+    struct Record {
+        uint32_t offset;       // In m_storage (words)
+        uint32_t words;        // Encoded size
+        uint64_t keyframe;     // Sequence number of the keyframe it is encoded against
+    };
+
+    std::vector<uint32_t> m_frame;       // Raw frame being written or just decoded
+    std::vector<uint32_t> m_keyframe;    // Raw copy of keyframe m_keyframeSequence
+    std::vector<uint32_t> m_encoded;     // Encoder scratch (worst case)
+    std::vector<uint32_t> m_storage;     // Encoded records, used as a circular log
+    std::vector<Record> m_records;       // Indexed by sequence % capacity
+    uint32_t m_keyframeWords;
+    uint64_t m_keyframeSequence;         // NO_KEYFRAME when m_keyframe is not valid
+    uint64_t m_oldest;                   // Sequence numbers [m_oldest, m_next) are stored
+    uint64_t m_next;
+    uint32_t m_writeOffset;
+
+    Record& GetRecord(uint64_t sequence) { return m_records[sequence % m_records.size()]; }
+    const Record& GetRecord(uint64_t sequence) const { return m_records[sequence % m_records.size()]; }
+    uint32_t Encode(uint32_t words, const uint32_t* base, uint32_t baseWords);
+    uint32_t Decode(const Record& record, const uint32_t* base, uint32_t baseWords, uint32_t* out) const;
+    bool Reserve(uint32_t words, uint32_t& offset);
+    void DropOldestGroup();
+
+public:
+    /**
+     * @brief maxFrameWords bounds one serialized frame; maxFrames the history
+     * length; storageBytes the encoded history
+     */
+    RewindBuffer(uint32_t maxFrameWords, uint32_t maxFrames, uint32_t storageBytes = REWIND_STORAGE_BYTES);
+
+    RewindBuffer(const RewindBuffer&) = delete;
+    RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+    /**
+     * @brief Scratch frame to serialize into before Push (GetMaxFrameWords long)
+     */
+    uint32_t* GetFrame() { return m_frame.data(); }
+    uint32_t GetMaxFrameWords() const { return static_cast<uint32_t>(m_frame.size()); }
+
+    /**
+     * @brief Encode the first `words` words of GetFrame() as the newest frame
+     */
+    void Push(uint32_t words);
+
+    /**
+     * @brief Frames between the keyframe the next Push is encoded against
+     * and that frame (0 when it will be a keyframe itself)
+     */
+    uint32_t GetKeyframeAge() const;
+
+    /**
+     * @brief Remove the newest frame and decode it into GetFrame()
+     * @return false if the history is empty
+     */
+    bool Pop(uint32_t& words);
+
+    void Clear();
+
+    /**
+     * @brief Set aside room for the encoded history to grow to `bytes` (one
+     * allocation; its pages stay untouched until GrowStorage uses them)
+     */
+    void ReserveStorage(uint32_t bytes);
+
+    /**
+     * @brief Raise the encoded history budget to `bytes`, keeping the history
+     * Does not allocate within what ReserveStorage set aside.
+     */
+    void GrowStorage(uint32_t bytes);
+
+    /**
+     * @brief Clear the history and set the budget to `bytes`, freeing the rest
+     */
+    void ResetStorage(uint32_t bytes);
+
+    uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_next - m_oldest); }
+    uint32_t GetStoredBytes() const;
+};
+
+} // namespace TimeMaster
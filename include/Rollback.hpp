@@ -0,0 +1,128 @@
+#pragma once
+#include "Config.hpp"
+#include "Input.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+class Game;
+
+// Rollback configuration (fixed)
+constexpr uint32_t ROLLBACK_MAX_TICKS = 8;          // Deepest re-simulation; prediction never runs further ahead
+constexpr uint32_t ROLLBACK_COMMAND_WINDOW = 64;    // Commands kept per player (power of two)
+constexpr uint32_t ROLLBACK_SYNC_INTERVAL = 30;     // Ticks between checksums of confirmed frames
+constexpr uint32_t ROLLBACK_SYNC_HISTORY = 16;      // Checksums kept for the peer to compare against
+
+/**
+ * @brief Rollback counters shown on the HUD and printed by --net-test
+ */
+struct RollbackStats {
+    uint32_t rollbacks;          // Mispredictions corrected
+    uint32_t resimulatedTicks;   // Ticks replayed by them
+    uint32_t lastDepth;          // Ticks replayed by the latest one
+    uint32_t maxDepth;
+    uint32_t stalls;             // Advance calls that waited for remote commands
+    double resimulateUs;         // Total time spent re-simulating
+    double maxResimulateUs;      // Worst single rollback (load + replay)
+};
+
+/**
+ * @brief Predict-and-rollback driver for a networked Game (transport agnostic)
+ *
+ * Frame n is the state after n ticks of the match. Every player's command
+ * for each frame comes in through AddCommand, in frame order; the local one
+ * ahead of time, remote ones whenever the network delivers them. Advance
+ * simulates the next frame with the commands known so far, predicting a
+ * missing remote command as the last known one (held buttons kept, presses
+ * dropped). The raw state before each of the last ROLLBACK_MAX_TICKS frames
+ * is kept, so when a remote command arrives that differs from what was
+ * predicted, the next Advance loads the state before it and replays up to
+ * ROLLBACK_MAX_TICKS frames with the corrected commands. Advance refuses to
+ * predict further than that and stalls instead.
+ *
+ * Frames whose commands are all confirmed are final: every
+ * ROLLBACK_SYNC_INTERVAL of them is checksummed so peers can verify they
+ * agree. Never allocates after construction.
+ */
+class RollbackSession {
+private:
+    static constexpr uint32_t STATE_SLOTS = ROLLBACK_MAX_TICKS + 1;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct SyncPoint {
+        uint32_t frame;     // NONE = empty
+        uint64_t checksum;
+    };
+
+    Game& m_game;
+    int m_playerCount;
+    int m_localPlayer;
+    float m_deltaTime;
+
+    uint32_t m_frame;                                                // Frames simulated
+    uint32_t m_known[MAX_PLAYERS];                                   // Commands for frames [0, m_known) are in
+    PlayerCommand m_commands[MAX_PLAYERS][ROLLBACK_COMMAND_WINDOW];  // By frame % window
+    PlayerCommand m_used[MAX_PLAYERS][ROLLBACK_COMMAND_WINDOW];      // What each simulated frame ran with
+    uint32_t m_mispredicted;                                         // Earliest frame to replay (NONE)
+
+    std::vector<uint32_t> m_states;                                  // STATE_SLOTS raw frames, by frame % slots
+    uint32_t m_stateWords[STATE_SLOTS];
+    uint32_t m_stateSlotWords;
+
+    SyncPoint m_sync[ROLLBACK_SYNC_HISTORY];                         // By (frame / interval) % history
+    uint32_t m_lastSyncFrame;
+    RollbackStats m_stats;
+
+    uint32_t* GetStateSlot(uint32_t frame) { return m_states.data() + (frame % STATE_SLOTS) * m_stateSlotWords; }
+    uint32_t GetConfirmedFrames() const;
+    PlayerCommand GetCommand(int player, uint32_t frame) const;
+    void SimulateFrame(bool resimulate);
+    void Rollback();
+
+public:
+    /**
+     * @brief Drive `game` with playerCount players, localPlayer being this process's
+     */
+    RollbackSession(Game& game, int playerCount, int localPlayer, float deltaTime);
+
+    RollbackSession(const RollbackSession&) = delete;
+    RollbackSession& operator=(const RollbackSession&) = delete;
+
+    /**
+     * @brief Start the match from frame 0
+     * Commands for frames [0, inputDelay) are empty for every player, so each
+     * peer can send its first real command inputDelay frames ahead.
+     */
+    void Start(uint32_t inputDelay);
+
+    /**
+     * @brief Supply a player's command for a frame
+     * Only the next unknown frame is taken (GetKnownFrames); duplicates and
+     * gaps are ignored, so resent commands are harmless.
+     * @return true if the command was taken
+     */
+    bool AddCommand(int player, uint32_t frame, const PlayerCommand& command);
+
+    /**
+     * @brief Correct any misprediction, then simulate the next frame
+     * @return false if it had to stall for remote commands
+     */
+    bool Advance();
+
+    /**
+     * @brief Checksum of a final frame, if it was a sync point and is still kept
+     */
+    bool GetSyncChecksum(uint32_t frame, uint64_t& checksum) const;
+    uint32_t GetLastSyncFrame() const { return m_lastSyncFrame; }
+
+    uint32_t GetFrame() const { return m_frame; }
+    uint32_t GetKnownFrames(int player) const { return m_known[player]; }
+    const PlayerCommand& GetKnownCommand(int player, uint32_t frame) const {
+        return m_commands[player][frame % ROLLBACK_COMMAND_WINDOW];
+    }
+    int GetLocalPlayer() const { return m_localPlayer; }
+    const RollbackStats& GetStats() const { return m_stats; }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,160 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// TM_SIMD=0 swaps the SSE2 lanes for plain arrays (for comparison and for
+// targets without SSE2); both give bit-identical results, see Float4
+#ifndef TM_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TM_SIMD 1
+#else
+#define TM_SIMD 0
+#endif
+#endif
+
+#if TM_SIMD
+#include <emmintrin.h>
+#endif
+
+namespace TimeMaster {
+
+constexpr uint32_t SIMD_WIDTH = 4;
+
+/**
+ * @brief Per-lane condition from a Float4 comparison (all bits set when true)
+ */
+struct Mask4 {
+#if TM_SIMD
+    __m128 v;
+#else
+    uint32_t v[SIMD_WIDTH];
+#endif
+
+    /**
+     * @brief Lanes [0, count) set (count clamped to SIMD_WIDTH)
+     */
+    static Mask4 FirstLanes(uint32_t count);
+
+    bool Any() const;
+    bool IsSet(uint32_t lane) const;
+};
+
+/**
+ * @brief Four floats processed together
+ * Only correctly rounded operations are offered (no reciprocal estimates or
+ * fused multiply-add), and the scalar fallback performs the same operations
+ * lane by lane, so simulation code written with Float4 gives the same bits
+ * with or without SSE2 (see make determinism-test).
+ */
+struct Float4 {
+#if TM_SIMD
+    __m128 v;
+#else
+    float v[SIMD_WIDTH];
+#endif
+
+    static Float4 Load(const float* values);   // Unaligned
+    static Float4 Splat(float value);
+    void Store(float* values) const;           // Unaligned
+
+    /**
+     * @brief Sum of the lanes, always added as (0 + 1) + (2 + 3)
+     */
+    float Sum() const;
+};
+
+#if TM_SIMD
+
+inline Mask4 Mask4::FirstLanes(uint32_t count) {
+    __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+    __m128i limit = _mm_set1_epi32(static_cast<int>(count < SIMD_WIDTH ? count : SIMD_WIDTH));
+    return {_mm_castsi128_ps(_mm_cmplt_epi32(lanes, limit))};
+}
+inline bool Mask4::Any() const { return _mm_movemask_ps(v) != 0; }
+inline bool Mask4::IsSet(uint32_t lane) const { return (_mm_movemask_ps(v) >> lane) & 1; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return {_mm_and_ps(a.v, b.v)}; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return {_mm_or_ps(a.v, b.v)}; }
+
+inline Float4 Float4::Load(const float* values) { return {_mm_loadu_ps(values)}; }
+inline Float4 Float4::Splat(float value) { return {_mm_set1_ps(value)}; }
+inline void Float4::Store(float* values) const { _mm_storeu_ps(values, v); }
+inline float Float4::Sum() const {
+    float lanes[SIMD_WIDTH];
+    Store(lanes);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+inline Float4 operator+(Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float4 operator/(Float4 a, Float4 b) { return {_mm_div_ps(a.v, b.v)}; }
+inline Float4 Min(Float4 a, Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float4 Max(Float4 a, Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Float4 Sqrt(Float4 a) { return {_mm_sqrt_ps(a.v)}; }
+inline Mask4 operator<(Float4 a, Float4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mask4 operator>(Float4 a, Float4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mask4 operator>=(Float4 a, Float4 b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+
+/**
+ * @brief mask ? a : b per lane
+ */
+inline Float4 Select(Mask4 mask, Float4 a, Float4 b) {
+    return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+}
+
+#else
+
+inline Mask4 Mask4::FirstLanes(uint32_t count) {
+    Mask4 mask;
+    for (uint32_t i = 0; i < SIMD_WIDTH; ++i) mask.v[i] = i < count ? UINT32_MAX : 0;
+    return mask;
+}
+inline bool Mask4::Any() const { return (v[0] | v[1] | v[2] | v[3]) != 0; }
+inline bool Mask4::IsSet(uint32_t lane) const { return v[lane] != 0; }
+inline Mask4 operator&(Mask4 a, Mask4 b) {
+    for (uint32_t i = 0; i < SIMD_WIDTH; ++i) a.v[i] &= b.v[i];
+    return a;
+}
+inline Mask4 operator|(Mask4 a, Mask4 b) {
+    for (uint32_t i = 0; i < SIMD_WIDTH; ++i) a.v[i] |= b.v[i];
+    return a;
+}
+
+inline Float4 Float4::Load(const float* values) { return {{values[0], values[1], values[2], values[3]}}; }
+inline Float4 Float4::Splat(float value) { return {{value, value, value, value}}; }
+inline void Float4::Store(float* values) const {
+    for (uint32_t i = 0; i < SIMD_WIDTH; ++i) values[i] = v[i];
+}
+inline float Float4::Sum() const { return (v[0] + v[1]) + (v[2] + v[3]); }
+
+// Lane by lane; min/max keep SSE's rule of returning b when the lanes are unordered
+#define TM_FLOAT4_LANES(expression) \
+    Float4 r; \
+    for (uint32_t i = 0; i < SIMD_WIDTH; ++i) r.v[i] = (expression); \
+    return r
+#define TM_MASK4_LANES(condition) \
+    Mask4 r; \
+    for (uint32_t i = 0; i < SIMD_WIDTH; ++i) r.v[i] = (condition) ? UINT32_MAX : 0; \
+    return r
+
+inline Float4 operator+(Float4 a, Float4 b) { TM_FLOAT4_LANES(a.v[i] + b.v[i]); }
+inline Float4 operator-(Float4 a, Float4 b) { TM_FLOAT4_LANES(a.v[i] - b.v[i]); }
+inline Float4 operator*(Float4 a, Float4 b) { TM_FLOAT4_LANES(a.v[i] * b.v[i]); }
+inline Float4 operator/(Float4 a, Float4 b) { TM_FLOAT4_LANES(a.v[i] / b.v[i]); }
+inline Float4 Min(Float4 a, Float4 b) { TM_FLOAT4_LANES(a.v[i] < b.v[i] ? a.v[i] : b.v[i]); }
+inline Float4 Max(Float4 a, Float4 b) { TM_FLOAT4_LANES(a.v[i] > b.v[i] ? a.v[i] : b.v[i]); }
+inline Float4 Sqrt(Float4 a) { TM_FLOAT4_LANES(std::sqrt(a.v[i])); }
+inline Mask4 operator<(Float4 a, Float4 b) { TM_MASK4_LANES(a.v[i] < b.v[i]); }
+inline Mask4 operator<=(Float4 a, Float4 b) { TM_MASK4_LANES(a.v[i] <= b.v[i]); }
+inline Mask4 operator>(Float4 a, Float4 b) { TM_MASK4_LANES(a.v[i] > b.v[i]); }
+inline Mask4 operator>=(Float4 a, Float4 b) { TM_MASK4_LANES(a.v[i] >= b.v[i]); }
+
+inline Float4 Select(Mask4 mask, Float4 a, Float4 b) { TM_FLOAT4_LANES(mask.v[i] ? a.v[i] : b.v[i]); }
+
+#undef TM_FLOAT4_LANES
+#undef TM_MASK4_LANES
+
+#endif
+
+} // namespace TimeMaster
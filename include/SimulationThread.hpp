@@ -0,0 +1,51 @@
+#pragma once
+#include "FrameSnapshot.hpp"
+#include "Input.hpp"
+#include "TripleBuffer.hpp"
+#include <atomic>
+#include <thread>
+
+namespace TimeMaster {
+
+class Game;
+class NetSession;
+
+constexpr int SIMULATION_MAX_LAG_TICKS = 5;     // Further behind than this: drop the backlog
+
+/**
+ * @brief Runs Game::Update on its own thread at a fixed tick rate
+ * Input arrives through an InputMailbox; after every tick the game is copied
+ * into the write slot of a triple buffer and published, so the render thread
+ * always draws the newest complete tick without ever blocking the simulation.
+ * The Game must not be touched by other threads while this runs, apart from
+ * the immutable model data the Renderer reads. With a NetSession the ticks
+ * go through it instead (co-op), and so does the session.
+ */
+class SimulationThread {
+private:
+    Game& m_game;
+    InputMailbox& m_input;
+    TripleBuffer<FrameSnapshot>& m_snapshots;
+    NetSession* m_session;
+    std::thread m_thread;
+    std::atomic<bool> m_stop;
+    
+    void Run();
+    
+public:
+    SimulationThread(Game& game, InputMailbox& input, TripleBuffer<FrameSnapshot>& snapshots,
+                     NetSession* session = nullptr);
+    ~SimulationThread();
+    
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+    
+    void Start();
+    
+    /**
+     * @brief Finish the current tick and join the thread
+     */
+    void Stop();
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,86 @@
+#pragma once
+#include "JobSystem.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+constexpr uint32_t SKINNING_VERTICES_PER_JOB = 512;
+
+/**
+ * @brief Per-bone skinning transform for one animation frame
+ * position: 3x4 row-major (rotation * scale | translation), applied to bind-pose vertices
+ * normal:   3x3 row-major rotation, applied to bind-pose normals
+ */
+struct SkinBone {
+    float position[12];
+    float normal[9];
+};
+
+/**
+ * @brief The skinning transform of one bone, from its bind and animated transforms
+ */
+SkinBone MakeSkinBone(const Transform& bind, const Transform& pose);
+
+/**
+ * @brief A bind-pose point carried into the pose by one bone (fully weighted)
+ */
+inline Vector3 SkinPoint(const SkinBone& bone, Vector3 point) {
+    const float* p = bone.position;
+    return {p[0] * point.x + p[1] * point.y + p[2]  * point.z + p[3],
+            p[4] * point.x + p[5] * point.y + p[6]  * point.z + p[7],
+            p[8] * point.x + p[9] * point.y + p[10] * point.z + p[11]};
+}
+
+/**
+ * @brief CPU skinning for one model, run on the job system
+ * Same result as raylib's UpdateModelAnimation, but the bind-to-pose
+ * transform is built once per bone instead of once per vertex influence,
+ * vertices are skinned in parallel chunks, and the GPU upload is a separate
+ * step that must run on the thread owning the GL context.
+ */
+class Skinner {
+private:
+    struct SkinnedMesh {
+        int meshIndex;
+        uint32_t firstVertex;  // Offset in the model-wide vertex range
+    };
+
+    const Model* m_model;
+    const ModelAnimation* m_animation;
+    int m_frame;
+    std::vector<SkinBone> m_bones;
+    std::vector<SkinnedMesh> m_meshes;
+    uint32_t m_vertexCount;
+    bool m_pendingUpload;
+
+    static void ComputeBonesJob(void* context, uint32_t begin, uint32_t end);
+    static void SkinVerticesJob(void* context, uint32_t begin, uint32_t end);
+    void SkinVertices(uint32_t begin, uint32_t end) const;
+
+public:
+    Skinner();
+
+    /**
+     * @brief Size the bone and mesh tables for a loaded model (call once per load)
+     */
+    void Init(const Model& model);
+
+    /**
+     * @brief Queue pose sampling and vertex skinning for the given frame
+     * @return Job that finishes when animVertices/animNormals are written,
+     * or nullptr when the model has nothing to skin or already holds this pose
+     */
+    Job* Schedule(JobSystem& jobs, const Model& model, const ModelAnimation& animation, int frame);
+
+    /**
+     * @brief Upload the skinned vertices of the last finished Schedule
+     * (main/GL thread only; no-op when nothing is pending)
+     */
+    void Upload();
+
+    uint32_t GetVertexCount() const { return m_vertexCount; }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,143 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <cstring>
+
+// Debug builds checksum the simulation every tick (published with the flight
+// recorder sample); release builds only hash on request
+#ifndef TM_STATE_CHECKSUM
+#ifdef NDEBUG
+#define TM_STATE_CHECKSUM 0
+#else
+#define TM_STATE_CHECKSUM 1
+#endif
+#endif
+
+namespace TimeMaster {
+
+/**
+ * @brief Independently hashed parts of the simulation state
+ * Fine-grained so a divergence report names what went wrong, not just when.
+ */
+enum class StateField : uint8_t {
+    GAME,                 // Game state, match mode, tick, cooldowns, spawn and wave timers
+    RANDOM,
+    TIMERS,               // Wheel clock and pending timer count
+    PLAYER_POSITION,
+    PLAYER_TIME,
+    PLAYER_MOTION,        // Velocity, facing, movement flags
+    PLAYER_ANIMATION,
+    BOSS_POSITION,
+    BOSS_TIME,
+    BOSS_STATE,           // State, state timer, attack cooldown
+    BOSS_MOTION,
+    BOSS_ANIMATION,
+    BOSS_BULLETS,
+    PLAYER_PROJECTILES,
+    TOMATOES,
+    PATTERNS,             // Running pattern emitters
+    MINIONS,
+    FLOW_FIELD,           // Targets and progress of the published and building fields
+    COUNT
+};
+
+constexpr int STATE_FIELD_COUNT = static_cast<int>(StateField::COUNT);
+
+/**
+ * @brief Field name as printed in divergence reports
+ */
+inline const char* GetStateFieldName(StateField field) {
+    switch (field) {
+        case StateField::GAME:               return "game";
+        case StateField::RANDOM:             return "rng";
+        case StateField::TIMERS:             return "timers";
+        case StateField::PLAYER_POSITION:    return "player.position";
+        case StateField::PLAYER_TIME:        return "player.time";
+        case StateField::PLAYER_MOTION:      return "player.motion";
+        case StateField::PLAYER_ANIMATION:   return "player.animation";
+        case StateField::BOSS_POSITION:      return "boss.position";
+        case StateField::BOSS_TIME:          return "boss.time";
+        case StateField::BOSS_STATE:         return "boss.state";
+        case StateField::BOSS_MOTION:        return "boss.motion";
+        case StateField::BOSS_ANIMATION:     return "boss.animation";
+        case StateField::BOSS_BULLETS:       return "boss_bullets";
+        case StateField::PLAYER_PROJECTILES: return "player_projectiles";
+        case StateField::TOMATOES:           return "tomatoes";
+        case StateField::PATTERNS:           return "patterns";
+        case StateField::MINIONS:            return "minions";
+        case StateField::FLOW_FIELD:         return "flow_field";
+        case StateField::COUNT:              break;
+    }
+    return "?";
+}
+
+/**
+ * @brief 64-bit FNV-1a over 32-bit words
+ * Values are hashed field by field (floats by bit pattern), never as raw
+ * struct memory, so padding bytes cannot leak into the result.
+ */
+class StateHasher {
+private:
+    static constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ull;
+    static constexpr uint64_t PRIME = 0x100000001b3ull;
+
+    uint64_t m_hash;
+
+public:
+    StateHasher() : m_hash(OFFSET_BASIS) {}
+
+    void Add(uint32_t value) { m_hash = (m_hash ^ value) * PRIME; }
+    void Add(uint64_t value) {
+        Add(static_cast<uint32_t>(value));
+        Add(static_cast<uint32_t>(value >> 32));
+    }
+    void Add(int value) { Add(static_cast<uint32_t>(value)); }
+    void Add(bool value) { Add(static_cast<uint32_t>(value)); }
+    void Add(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Add(bits);
+    }
+    void Add(Vector3 value) {
+        Add(value.x);
+        Add(value.y);
+        Add(value.z);
+    }
+    void Add(Color value) {
+        Add(static_cast<uint32_t>(value.r) | static_cast<uint32_t>(value.g) << 8 |
+            static_cast<uint32_t>(value.b) << 16 | static_cast<uint32_t>(value.a) << 24);
+    }
+
+    uint64_t GetHash() const { return m_hash; }
+};
+
+/**
+ * @brief Hash of every StateField after one tick, plus their combination
+ */
+struct StateChecksum {
+    uint64_t fields[STATE_FIELD_COUNT];
+    uint64_t combined;
+
+    /**
+     * @brief Fill `combined` from the field hashes
+     */
+    void Combine() {
+        StateHasher hasher;
+        for (uint64_t field : fields) {
+            hasher.Add(field);
+        }
+        combined = hasher.GetHash();
+    }
+
+    /**
+     * @brief First field that differs from another checksum (COUNT if none)
+     */
+    StateField FirstDifference(const StateChecksum& other) const {
+        for (int i = 0; i < STATE_FIELD_COUNT; ++i) {
+            if (fields[i] != other.fields[i]) return static_cast<StateField>(i);
+        }
+        return StateField::COUNT;
+    }
+};
+
+} // namespace TimeMaster
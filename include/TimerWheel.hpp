@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace TimeMaster {
+
+// Timer wheel configuration (fixed)
+constexpr int TIMER_WHEEL_LEVELS = 4;
+constexpr int TIMER_WHEEL_SLOT_BITS = 6;                     // 64 slots per level
+constexpr uint32_t TIMER_WHEEL_CAPACITY = 1024;              // Pending timers per game (default)
+
+/**
+ * @brief Called when a timer expires (context and data as given to Schedule)
+ */
+using TimerCallback = void (*)(void* context, uint32_t data);
+
+/**
+ * @brief Identifies a scheduled timer; stale once it fired or was cancelled
+ */
+struct TimerHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+/**
+ * @brief A timer's schedule as saved in rewind and rollback frames
+ */
+struct TimerRecord {
+    uint64_t deadline = 0;   // 0 = not pending
+    uint64_t sequence = 0;   // Schedule order (see TimerWheel::Advance)
+};
+
+/**
+ * @brief Hierarchical timing wheel driven by simulation ticks
+ * Four levels of 64 slots cover 2^24 ticks (~77 hours at 60 Hz). Insert and
+ * cancel are O(1) list operations; a timer is touched again only when its
+ * level cascades and when it fires, so pending timers cost nothing per tick.
+ * Timers live in a fixed pool: scheduling never allocates.
+ *
+ * Callbacks run inside Advance and may schedule or cancel timers (including
+ * others due on the same tick). Timers due on the same tick fire in the order
+ * they were scheduled; that order is saved with each timer, so a restored
+ * wheel fires exactly like the original one.
+ */
+class TimerWheel {
+private:
+    static constexpr uint32_t SLOTS = 1u << TIMER_WHEEL_SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint64_t MAX_DELAY = (1ull << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1;
+
+    struct Timer {
+        uint64_t deadline;
+        uint64_t sequence;
+        TimerCallback callback;
+        void* context;
+        uint32_t data;
+        uint32_t generation;
+        uint32_t prev;
+        uint32_t next;     // Slot list, or free list when unused
+        uint32_t bucket;   // level * SLOTS + slot, NONE when free
+    };
+
+    std::vector<Timer> m_timers;
+    uint32_t m_buckets[TIMER_WHEEL_LEVELS * SLOTS];
+    uint32_t m_free;
+    uint32_t m_pending;
+    uint64_t m_now;
+    uint64_t m_sequence;   // Next schedule order number
+
+    void Insert(uint32_t index);
+    void Unlink(uint32_t index);
+    void Release(uint32_t index);
+    void Cascade(int level);
+    TimerHandle Allocate(uint64_t tick, uint64_t sequence, TimerCallback callback, void* context, uint32_t data);
+
+public:
+    explicit TimerWheel(uint32_t capacity = TIMER_WHEEL_CAPACITY);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Fire callback(context, data) on the given tick (at least the next one)
+     * @return Invalid handle (and a warning) if the pool is full
+     */
+    TimerHandle ScheduleAt(uint64_t tick, TimerCallback callback, void* context, uint32_t data = 0);
+
+    /**
+     * @brief Fire callback(context, data) after delayTicks ticks (minimum 1)
+     */
+    TimerHandle Schedule(uint64_t delayTicks, TimerCallback callback, void* context, uint32_t data = 0) {
+        return ScheduleAt(m_now + delayTicks, callback, context, data);
+    }
+
+    /**
+     * @brief Cancel a pending timer (no-op for stale handles)
+     */
+    void Cancel(TimerHandle& handle);
+
+    bool IsPending(TimerHandle handle) const;
+    
+    /**
+     * @brief Move to the next tick and fire the timers due on it
+     */
+    void Advance();
+
+    /**
+     * @brief Drop every pending timer without firing it; handles go stale
+     */
+    void Clear();
+    
+    /**
+     * @brief Deadline and schedule order of a pending timer (zeroes for stale handles)
+     */
+    TimerRecord SaveTimer(TimerHandle handle) const;
+
+    /**
+     * @brief Re-create a saved timer after Restart (invalid handle if it was not pending)
+     */
+    TimerHandle RestoreTimer(const TimerRecord& record, TimerCallback callback, void* context, uint32_t data = 0);
+
+    /**
+     * @brief Clear and jump to a saved tick and schedule counter (rewind, rollback);
+     * owners then restore their timers with RestoreTimer
+     */
+    void Restart(uint64_t now, uint64_t sequence);
+
+    uint64_t GetNow() const { return m_now; }
+    uint64_t GetSequence() const { return m_sequence; }
+    uint32_t GetPendingCount() const { return m_pending; }
+
+    /**
+     * @brief Whole ticks covering a duration (rounded up, at least 1)
+     */
+    static uint64_t SecondsToTicks(float seconds);
+};
+
+} // namespace TimeMaster
@@ -1,47 +1,49 @@
 #pragma once
-#include "Entity.hpp"
+#include "Archetype.hpp"
+#include "Components.hpp"
 #include "Config.hpp"
+#include "GameAssets.hpp"
+#include "TimerWheel.hpp"
 #include "raylib.h"
 
 namespace TimeMaster {
 
-class Tomato : public Entity, public ICollectible {
-private:
-    Vector3 m_position;
-    float m_radius;
-    float m_lifetime;
-    float m_rotationAngle;
-    bool m_active;
-    
-    static Model s_model;
-    static bool s_modelLoaded;
-    
-public:
-    Tomato();
-    
-    /**
-     * @brief Load shared tomato model (call once)
-     */
-    static void LoadModel();
-    
-    /**
-     * @brief Unload shared tomato model (call once on cleanup)
-     */
-    static void UnloadModel();
-    
-    // Entity interface
-    void Update(float deltaTime) override;
-    void Draw() const override;
-    bool IsActive() const override { return m_active; }
-    Vector3 GetPosition() const override { return m_position; }
-    
-    // ICollectible interface
-    void OnCollect() override;
-    float GetCollectionRadius() const override { return m_radius; }
-    
-    // Tomato specific methods
-    void Spawn(float x, float y, float z);
-    bool CheckCollision(Vector3 pos, float otherRadius) const;
+/**
+ * @brief What the renderer needs to draw a Tomato (copied into frame snapshots)
+ */
+struct TomatoSnapshot {
+    Vector3 position;
+    float radius;
+    float rotation;
+    bool active;
 };
 
+/**
+ * @brief Healing pickups: one row per tomato on the ground
+ * Expiry is a timer on the game's wheel and the spin is derived from the
+ * spawn tick, so a live tomato costs nothing per tick.
+ */
+using TomatoArchetype = Archetype<Position, Collider, Lifetime>;
+
+/**
+ * @brief Put a tomato on the ground that expires after lifetime seconds
+ * @return INVALID_ENTITY when MAX_TOMATOES are already out
+ */
+EntityId SpawnTomato(TomatoArchetype& tomatoes, TimerWheel& timers, Vector3 position, float lifetime);
+
+/**
+ * @brief Remove a collected tomato (its row is taken by the last one) and cancel its expiry
+ */
+void CollectTomato(TomatoArchetype& tomatoes, TimerWheel& timers, uint32_t row);
+
+/**
+ * @brief Rewind and rollback: expiry timers of rows [0, count) as records,
+ * and rescheduled after the archetype and the wheel were restored
+ */
+void SaveTomatoTimers(const TomatoArchetype& tomatoes, const TimerWheel& timers, TimerRecord* records);
+void RestoreTomatoTimers(TomatoArchetype& tomatoes, TimerWheel& timers, const TimerRecord* records);
+
+TomatoSnapshot GetTomatoSnapshot(const TomatoArchetype& tomatoes, uint32_t row, uint64_t now);
+void DrawTomatoSnapshot(const TomatoSnapshot& snapshot, const ModelAsset& asset);
+
 } // namespace TimeMaster
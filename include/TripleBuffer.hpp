@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief Lock-free single-writer/single-reader triple buffer
+ * The writer fills its private slot and publishes it by swapping it with the
+ * shared middle slot; the reader swaps the middle slot in when it holds a
+ * newer value. Neither side ever waits, the reader always sees the most
+ * recently published value, and a slot is never written while being read.
+ */
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;  // Middle slot holds an unread value
+
+    std::array<T, 3> m_slots;
+    std::atomic<uint8_t> m_middle;
+    uint8_t m_write;  // Writer only
+    uint8_t m_read;   // Reader only
+
+public:
+    TripleBuffer() : m_slots{}, m_middle(1), m_write(0), m_read(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Writer: the slot to fill before Publish
+     */
+    T& GetWriteSlot() { return m_slots[m_write]; }
+
+    /**
+     * @brief Writer: make the filled slot the latest value
+     */
+    void Publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_write | FRESH_BIT), std::memory_order_acq_rel);
+        m_write = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Reader: switch to the latest published value, if there is a new one
+     * @return true when the read slot changed
+     */
+    bool Acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+            return false;
+        }
+        m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Reader: the value obtained by the last Acquire
+     */
+    const T& GetReadSlot() const { return m_slots[m_read]; }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+
+namespace TimeMaster {
+
+/**
+ * @brief IPv4 endpoint (host byte order)
+ */
+struct NetAddress {
+    uint32_t ip = 0;
+    uint16_t port = 0;
+
+    bool operator==(const NetAddress& other) const { return ip == other.ip && port == other.port; }
+    bool operator!=(const NetAddress& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Look up a host name or dotted quad (blocking, IPv4 only)
+ */
+bool ResolveAddress(const char* host, uint16_t port, NetAddress& address);
+
+/**
+ * @brief Non-blocking IPv4 UDP socket (POSIX sockets or Winsock)
+ */
+class UdpSocket {
+private:
+    intptr_t m_handle;   // -1 when closed
+
+public:
+    UdpSocket();
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /**
+     * @brief Bind to a local port on every interface (0 = any free port)
+     */
+    bool Open(uint16_t port);
+    void Close();
+    bool IsOpen() const { return m_handle != -1; }
+
+    /**
+     * @brief Grow the kernel send/receive buffers (servers with many clients)
+     */
+    bool SetBufferSize(uint32_t bytes);
+
+    /**
+     * @brief Native handle (fd / SOCKET) for readiness polling; -1 when closed
+     */
+    intptr_t GetHandle() const { return m_handle; }
+
+    bool Send(const NetAddress& to, const uint8_t* data, uint32_t size);
+
+    /**
+     * @brief Next queued datagram, without waiting
+     * @return Its size, or -1 when nothing is queued
+     */
+    int Receive(NetAddress& from, uint8_t* data, uint32_t capacity);
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,340 @@
+#include "GameServer.hpp"
+#include "AllocTracker.hpp"
+#include "Config.hpp"
+#include "JobSystem.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr double STATS_INTERVAL_MS = 1000.0;
+constexpr double MAX_TICK_DEBT_MS = 250.0;   // Further behind than this, skip ticks instead of catching up
+
+double NowMs() {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+std::atomic<bool> GameServer::s_stopRequested(false);
+
+GameServer::GameServer(const ServerOptions& options)
+    : m_options(options)
+    , m_deltaTime(1.0f / SIMULATION_TICK_RATE)
+    , m_poller(1)
+    , m_random(options.seed ? options.seed : static_cast<uint64_t>(NowMs()))
+    , m_matchBytes(0) {
+}
+
+bool GameServer::Open() {
+    m_assets.LoadData();
+
+    // Every slot up front: a join must not allocate (or fail to) mid-tick.
+    // The first one is measured to report what a match costs.
+    AllocTracker& tracker = AllocTracker::GetInstance();
+    m_matches.reserve(m_options.maxMatches);
+    m_active.reserve(m_options.maxMatches);
+    for (uint32_t i = 0; i < m_options.maxMatches; ++i) {
+        if (i == 0) {
+            tracker.SetEnabled(true);
+            tracker.EndFrame();
+        }
+        uint64_t seed = static_cast<uint64_t>(m_random.NextU32()) << 32;
+        seed |= m_random.NextU32();
+        auto match = std::make_unique<Match>();
+        match->game = std::make_unique<Game>(m_assets, seed, GameOptions::Server());
+        match->game->SetPlayers(1, 0);
+        match->active = false;
+        m_matches.push_back(std::move(match));
+        if (i == 0) {
+            tracker.EndFrame();
+            m_matchBytes = tracker.GetLastFrame().bytes;
+            tracker.SetEnabled(false);
+        }
+    }
+
+    if (!m_socket.Open(m_options.port)) {
+        return false;
+    }
+    m_socket.SetBufferSize(SERVER_SOCKET_BUFFER_BYTES);
+    if (!m_poller.IsOpen() || !m_poller.Add(m_socket.GetHandle(), 0)) {
+        return false;
+    }
+
+    TM_LOG_INFO(NET, "Serving up to %u matches on UDP port %u with %d worker thread(s), %.1f KB per match",
+                m_options.maxMatches, static_cast<unsigned>(m_options.port),
+                JobSystem::GetInstance().GetWorkerCount(), m_matchBytes / 1024.0);
+    return true;
+}
+
+int GameServer::Run() {
+    const double tickMs = 1000.0 / SIMULATION_TICK_RATE;
+    const double startMs = NowMs();
+    double nextTickMs = startMs;
+    double lastReportMs = startMs;
+    uint64_t ready[1];
+
+    while (!s_stopRequested.load()) {
+        double nowMs = NowMs();
+        if (m_options.seconds > 0.0f && nowMs - startMs >= m_options.seconds * 1000.0) break;
+
+        // Sleep on the socket until the next tick, handling packets as they come
+        if (nowMs < nextTickMs) {
+            int timeoutMs = static_cast<int>(std::ceil(nextTickMs - nowMs));
+            if (m_poller.Wait(timeoutMs, ready, 1) > 0) {
+                Receive(NowMs());
+            }
+            continue;
+        }
+
+        Receive(nowMs);
+        DropSilentClients(nowMs);
+
+        double tickStartMs = NowMs();
+        Tick();
+        Send();
+        double tickTimeMs = NowMs() - tickStartMs;
+        m_stats.ticks++;
+        m_stats.tickMsTotal += tickTimeMs;
+        m_stats.tickMsMax = std::max(m_stats.tickMsMax, tickTimeMs);
+
+        nextTickMs += tickMs;
+        if (nowMs - nextTickMs > MAX_TICK_DEBT_MS) {
+            nextTickMs = nowMs;
+        }
+        if (nowMs - lastReportMs >= STATS_INTERVAL_MS) {
+            ReportStats((nowMs - lastReportMs) / 1000.0);
+            lastReportMs = nowMs;
+        }
+    }
+
+    TM_LOG_INFO(NET, "Server stopped after %.1f s", (NowMs() - startMs) / 1000.0);
+    return 0;
+}
+
+void GameServer::Receive(double nowMs) {
+    uint8_t data[SERVER_MAX_PACKET_BYTES];
+    NetAddress from;
+    int size;
+    while ((size = m_socket.Receive(from, data, sizeof(data))) >= 0) {
+        m_stats.packetsIn++;
+        HandlePacket(from, data, static_cast<uint32_t>(size), nowMs);
+    }
+}
+
+void GameServer::HandlePacket(const NetAddress& from, const uint8_t* data, uint32_t size, double nowMs) {
+    PacketReader reader(data, size);
+    uint8_t type = ReadServerHeader(reader);
+
+    if (type == SERVER_PACKET_CONNECT) {
+        uint32_t nonce = reader.Get32();
+        if (reader.IsValid()) {
+            HandleConnect(from, nonce, nowMs);
+        }
+        return;
+    }
+
+    if (type == SERVER_PACKET_INPUT) {
+        uint32_t matchId = reader.Get32();
+        uint32_t token = reader.Get32();
+        uint32_t ackTick = reader.Get32();
+        uint8_t buttons = reader.Get8();
+        uint16_t yaw = reader.Get16();
+        Match* match = reader.IsValid() ? FindMatch(matchId, token, from) : nullptr;
+        if (!match) return;
+
+        PlayerCommand command = DecodeCommand(buttons, yaw);
+        match->command.held = command.held;
+        match->command.pressed |= command.pressed;
+        match->command.aimYaw = command.aimYaw;
+        // Only ticks still in the history can serve as a baseline
+        if (ackTick > match->ackedTick && match->history[ackTick & (SERVER_SNAPSHOT_HISTORY - 1)].tick == ackTick) {
+            match->ackedTick = ackTick;
+        }
+        match->lastHeardMs = nowMs;
+        return;
+    }
+
+    if (type == SERVER_PACKET_LEAVE) {
+        uint32_t matchId = reader.Get32();
+        uint32_t token = reader.Get32();
+        if (reader.IsValid() && FindMatch(matchId, token, from)) {
+            m_stats.leaves++;
+            Release(matchId);
+        }
+    }
+}
+
+void GameServer::HandleConnect(const NetAddress& from, uint32_t nonce, double nowMs) {
+    // A retransmitted CONNECT gets the same answer
+    for (uint32_t index : m_active) {
+        const Match& match = *m_matches[index];
+        if (match.client == from && match.nonce == nonce) {
+            SendReply(from, SERVER_PACKET_ACCEPT, nonce, &match, index);
+            return;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_matches.size(); ++i) {
+        if (!m_matches[i]->active) {
+            Accept(i, from, nonce, nowMs);
+            return;
+        }
+    }
+    SendReply(from, SERVER_PACKET_REJECT, nonce, nullptr, 0);
+}
+
+GameServer::Match* GameServer::FindMatch(uint32_t matchId, uint32_t token, const NetAddress& from) {
+    if (matchId >= m_matches.size()) return nullptr;
+    Match& match = *m_matches[matchId];
+    if (!match.active || match.token != token || match.client != from) return nullptr;
+    return &match;
+}
+
+void GameServer::Accept(uint32_t matchId, const NetAddress& from, uint32_t nonce, double nowMs) {
+    Match& match = *m_matches[matchId];
+    match.active = true;
+    match.client = from;
+    match.token = m_random.NextU32();
+    match.nonce = nonce;
+    match.command = PlayerCommand{0, 0, 0.0f};
+    match.ackedTick = 0;
+    match.lastHeardMs = nowMs;
+    match.finished = false;
+    for (ReplicatedState& state : match.history) {
+        state.tick = 0;
+    }
+    match.packetSize = 0;
+    match.game->StartMatch();
+
+    m_stats.connects++;
+    RebuildActive();
+    SendReply(from, SERVER_PACKET_ACCEPT, nonce, &match, matchId);
+}
+
+void GameServer::Release(uint32_t matchId) {
+    m_matches[matchId]->active = false;
+    RebuildActive();
+}
+
+void GameServer::RebuildActive() {
+    m_active.clear();
+    for (uint32_t i = 0; i < m_matches.size(); ++i) {
+        if (m_matches[i]->active) {
+            m_active.push_back(i);
+        }
+    }
+}
+
+void GameServer::DropSilentClients(double nowMs) {
+    bool dropped = false;
+    for (uint32_t index : m_active) {
+        Match& match = *m_matches[index];
+        if (nowMs - match.lastHeardMs > SERVER_TIMEOUT_SECONDS * 1000.0) {
+            match.active = false;
+            m_stats.timeouts++;
+            dropped = true;
+        }
+    }
+    if (dropped) {
+        RebuildActive();
+    }
+}
+
+void GameServer::SendReply(const NetAddress& to, ServerPacketType type, uint32_t nonce, const Match* match,
+                           uint32_t matchId) {
+    uint8_t data[SERVER_HEADER_BYTES + 12];
+    PacketWriter writer(data);
+    WriteServerHeader(writer, type);
+    writer.Put32(nonce);
+    if (match) {
+        writer.Put32(matchId);
+        writer.Put32(match->token);
+    }
+    m_socket.Send(to, data, writer.GetSize());
+}
+
+void GameServer::Tick() {
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(m_active.size()), SERVER_MATCHES_PER_JOB,
+        [this](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                SimulateMatch(*m_matches[m_active[i]], m_deltaTime);
+            }
+        });
+}
+
+void GameServer::SimulateMatch(Match& match, float deltaTime) {
+    Game& game = *match.game;
+    if (game.GetState() == GameState::PLAYING) {
+        PlayerCommand command = match.command;
+        game.SetPlayerViewTick(0, match.ackedTick);   // Hits are judged against what the client last saw
+        game.UpdateNetworked(&command, deltaTime);
+        match.command.pressed = 0;
+    } else if (match.finished) {
+        // The final state went out already; resend it unchanged until the client leaves
+        return;
+    }
+
+    uint32_t tick = game.GetTick();
+    ReplicatedState& state = match.history[tick & (SERVER_SNAPSHOT_HISTORY - 1)];
+    game.WriteReplicatedState(state);
+    match.finished = game.GetState() != GameState::PLAYING;
+
+    // Delta against the newest tick the client has, while it is still in the history
+    uint32_t base = match.ackedTick;
+    const ReplicatedState& baseState = match.history[base & (SERVER_SNAPSHOT_HISTORY - 1)];
+    const ReplicatedState* baseline = base != 0 && baseState.tick == base ? &baseState : nullptr;
+
+    uint32_t bullets = 0;
+    uint32_t size = EncodeReplicatedState(state, baseline, match.packet + SERVER_SNAPSHOT_HEADER_BYTES,
+                                          SERVER_MAX_PACKET_BYTES - SERVER_SNAPSHOT_HEADER_BYTES, bullets);
+    match.bulletsLeftOut = state.bulletCount - bullets;
+    state.bulletCount = bullets;   // The client's copy will hold only what was sent
+
+    PacketWriter writer(match.packet);
+    WriteServerHeader(writer, SERVER_PACKET_SNAPSHOT);
+    writer.Put32(tick);
+    writer.Put32(baseline ? base : 0);
+    writer.Put32(ComputeReplicatedChecksum(state));
+    match.packetSize = size > 0 ? writer.GetSize() + size : 0;
+    match.delta = baseline != nullptr;
+}
+
+void GameServer::Send() {
+    for (uint32_t index : m_active) {
+        Match& match = *m_matches[index];
+        if (match.packetSize == 0) continue;
+        m_socket.Send(match.client, match.packet, match.packetSize);
+        m_stats.packetsOut++;
+        m_stats.bytesOut += match.packetSize;
+        m_stats.bulletsLeftOut += match.bulletsLeftOut;
+        if (match.delta) {
+            m_stats.deltas++;
+        } else {
+            m_stats.fulls++;
+        }
+    }
+}
+
+void GameServer::ReportStats(double seconds) {
+    double averageMs = m_stats.ticks ? m_stats.tickMsTotal / m_stats.ticks : 0.0;
+    uint32_t snapshots = m_stats.deltas + m_stats.fulls;
+    std::printf("[server] %3zu matches | tick avg %.2f ms max %.2f ms (budget %.2f) | in %.0f pkt/s | "
+                "out %.0f pkt/s %.1f KB/s (avg %.0f B, %u%% deltas, %llu bullets left out) | +%u -%u timeouts %u\n",
+                m_active.size(), averageMs, m_stats.tickMsMax, 1000.0 / SIMULATION_TICK_RATE,
+                m_stats.packetsIn / seconds, m_stats.packetsOut / seconds, m_stats.bytesOut / 1024.0 / seconds,
+                snapshots ? static_cast<double>(m_stats.bytesOut) / snapshots : 0.0,
+                snapshots ? m_stats.deltas * 100 / snapshots : 0,
+                static_cast<unsigned long long>(m_stats.bulletsLeftOut),
+                m_stats.connects, m_stats.leaves, m_stats.timeouts);
+    std::fflush(stdout);
+    m_stats = Stats();
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,131 @@
+#pragma once
+#include "Game.hpp"
+#include "GameAssets.hpp"
+#include "Input.hpp"
+#include "Poller.hpp"
+#include "Random.hpp"
+#include "ServerProtocol.hpp"
+#include "UdpSocket.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TimeMaster {
+
+constexpr uint32_t SERVER_SOCKET_BUFFER_BYTES = 4 * 1024 * 1024;
+constexpr uint32_t SERVER_MATCHES_PER_JOB = 4;   // Matches one job simulates back to back
+
+/**
+ * @brief Command-line options for the dedicated server
+ */
+struct ServerOptions {
+    uint16_t port = SERVER_DEFAULT_PORT;
+    uint32_t maxMatches = SERVER_DEFAULT_MAX_MATCHES;
+    float seconds = 0.0f;     // Stop after this long (0 = until interrupted)
+    uint64_t seed = 0;        // Match seeds derive from this (0 = from the clock)
+};
+
+/**
+ * @brief Headless authoritative server: one single-player boss fight per client
+ *
+ * Every match slot is allocated up front (GameOptions::Server(): no rewind,
+ * small pools) with its snapshot history, so accepting a client never
+ * touches the heap. Each tick the main thread drains the socket (epoll),
+ * then the job system simulates the active matches in parallel; a job also
+ * writes its matches' replicated state and encodes the next snapshot as a
+ * delta against the tick the client last acknowledged. The main thread then
+ * sends every snapshot. Workers only touch their own match, so the tick
+ * needs no locks.
+ *
+ * Clients send their held buttons and facing every tick; presses are kept
+ * until the next simulated tick, so a press in a lost packet is lost with it.
+ */
+class GameServer {
+private:
+    struct Match {
+        std::unique_ptr<Game> game;
+        bool active;
+        NetAddress client;
+        uint32_t token;
+        uint32_t nonce;             // The client's CONNECT nonce (answers retransmits)
+        PlayerCommand command;      // Latest held buttons and facing; presses pile up until the tick
+        uint32_t ackedTick;         // Newest snapshot the client decoded (0 = none)
+        double lastHeardMs;
+        bool finished;              // Game over or victory already sent
+
+        ReplicatedState history[SERVER_SNAPSHOT_HISTORY];   // As sent (bullets trimmed to the packet)
+
+        uint8_t packet[SERVER_MAX_PACKET_BYTES];
+        uint32_t packetSize;
+        bool delta;                 // Packet encoded against a baseline
+        uint32_t bulletsLeftOut;    // Bullets that did not fit the packet
+    };
+
+    struct Stats {
+        uint32_t ticks = 0;
+        double tickMsTotal = 0.0;
+        double tickMsMax = 0.0;
+        uint64_t packetsIn = 0;
+        uint64_t packetsOut = 0;
+        uint64_t bytesOut = 0;
+        uint32_t deltas = 0;
+        uint32_t fulls = 0;
+        uint64_t bulletsLeftOut = 0;
+        uint32_t connects = 0;
+        uint32_t leaves = 0;
+        uint32_t timeouts = 0;
+    };
+
+    static std::atomic<bool> s_stopRequested;
+
+    ServerOptions m_options;
+    float m_deltaTime;
+    GameAssets m_assets;
+    UdpSocket m_socket;
+    Poller m_poller;
+    std::vector<std::unique_ptr<Match>> m_matches;
+    std::vector<uint32_t> m_active;       // Indices of active matches (rebuilt on join/leave)
+    Random m_random;                      // Match seeds and client tokens
+    size_t m_matchBytes;                  // Heap per match slot, measured when allocating
+    Stats m_stats;
+
+    void Receive(double nowMs);
+    void HandlePacket(const NetAddress& from, const uint8_t* data, uint32_t size, double nowMs);
+    void HandleConnect(const NetAddress& from, uint32_t nonce, double nowMs);
+    Match* FindMatch(uint32_t matchId, uint32_t token, const NetAddress& from);
+    void Accept(uint32_t matchId, const NetAddress& from, uint32_t nonce, double nowMs);
+    void Release(uint32_t matchId);
+    void RebuildActive();
+    void SendReply(const NetAddress& to, ServerPacketType type, uint32_t nonce, const Match* match, uint32_t matchId);
+
+    void Tick();
+    void Send();
+    void DropSilentClients(double nowMs);
+    static void SimulateMatch(Match& match, float deltaTime);
+    void ReportStats(double seconds);
+
+public:
+    explicit GameServer(const ServerOptions& options);
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * @brief Load game data, allocate every match slot and bind the port
+     */
+    bool Open();
+
+    /**
+     * @brief Serve until the time limit or RequestStop
+     * @return Process exit code
+     */
+    int Run();
+
+    /**
+     * @brief Ask Run to return after the current tick (safe from a signal handler)
+     */
+    static void RequestStop() { s_stopRequested.store(true); }
+};
+
+} // namespace TimeMaster
@@ -0,0 +1,252 @@
+#include "LoadGenerator.hpp"
+#include "Config.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr double MAX_TICK_DEBT_MS = 250.0;
+constexpr int INPUT_HOLD_TICKS = 12;   // Ticks each scripted movement choice is held
+
+double NowMs() {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+LoadGenerator::LoadGenerator(const LoadOptions& options)
+    : m_options(options)
+    , m_random(options.seed)
+    , m_poller(static_cast<int>(options.clients)) {
+}
+
+bool LoadGenerator::Open() {
+    if (!m_poller.IsOpen() || !ResolveAddress(m_options.address.c_str(), m_options.port, m_server)) {
+        return false;
+    }
+    m_clients.reserve(m_options.clients);
+    for (uint32_t i = 0; i < m_options.clients; ++i) {
+        auto client = std::make_unique<Client>();
+        if (!client->socket.Open(0) || !m_poller.Add(client->socket.GetHandle(), i)) {
+            TM_LOG_ERROR(NET, "Opened only %u of %u client sockets", i, m_options.clients);
+            return false;
+        }
+        client->accepted = false;
+        client->everAccepted = false;
+        client->nonce = 0;
+        client->lastConnectMs = -LOAD_CONNECT_RETRY_MS;
+        client->connectStartMs = 0.0;
+        client->held = PlayerCommand{0, 0, 0.0f};
+        client->inputTick = 0;
+        m_clients.push_back(std::move(client));
+    }
+    TM_LOG_INFO(NET, "Load test: %u clients against %s:%u for %.0f s", m_options.clients,
+                m_options.address.c_str(), static_cast<unsigned>(m_options.port), m_options.seconds);
+    return true;
+}
+
+int LoadGenerator::Run() {
+    const double tickMs = 1000.0 / SIMULATION_TICK_RATE;
+    const double startMs = NowMs();
+    double nextTickMs = startMs;
+    uint64_t ready[POLLER_MAX_EVENTS];
+
+    for (;;) {
+        double nowMs = NowMs();
+        if (nowMs - startMs >= m_options.seconds * 1000.0) break;
+
+        if (nowMs < nextTickMs) {
+            int timeoutMs = static_cast<int>(std::ceil(nextTickMs - nowMs));
+            int count = m_poller.Wait(timeoutMs, ready, POLLER_MAX_EVENTS);
+            double receivedMs = NowMs();
+            for (int i = 0; i < count; ++i) {
+                Receive(*m_clients[ready[i]], receivedMs);
+            }
+            continue;
+        }
+
+        for (auto& client : m_clients) {
+            if (client->accepted) {
+                SendInput(*client);
+            } else if (nowMs - client->lastConnectMs >= LOAD_CONNECT_RETRY_MS) {
+                SendConnect(*client, nowMs);
+            }
+        }
+
+        nextTickMs += tickMs;
+        if (nowMs - nextTickMs > MAX_TICK_DEBT_MS) {
+            nextTickMs = nowMs;
+        }
+    }
+
+    uint32_t connected = 0;
+    for (auto& client : m_clients) {
+        if (client->accepted) {
+            SendLeave(*client);
+        }
+        if (client->everAccepted) {
+            connected++;
+        }
+    }
+
+    const Stats& stats = m_stats;
+    double seconds = m_options.seconds;
+    uint64_t expected = stats.snapshots + stats.missedTicks;
+    std::printf("Load test: %u clients for %.0f s against %s:%u\n", m_options.clients, seconds,
+                m_options.address.c_str(), static_cast<unsigned>(m_options.port));
+    std::printf("  connected %u/%u (avg %.1f ms, max %.1f ms), rejected %u, matches finished %u\n",
+                connected, m_options.clients, stats.connects ? stats.connectMsTotal / stats.connects : 0.0,
+                stats.connectMsMax, stats.rejects, stats.matchesFinished);
+    std::printf("  snapshots %llu (%.1f/s per client), avg %.0f bytes, %.0f%% deltas\n",
+                static_cast<unsigned long long>(stats.snapshots),
+                connected ? stats.snapshots / seconds / connected : 0.0,
+                stats.snapshots ? static_cast<double>(stats.bytes) / stats.snapshots : 0.0,
+                stats.snapshots ? stats.deltas * 100.0 / stats.snapshots : 0.0);
+    std::printf("  missed ticks %llu (%.2f%%), stale %llu, missing baselines %u\n",
+                static_cast<unsigned long long>(stats.missedTicks),
+                expected ? stats.missedTicks * 100.0 / expected : 0.0,
+                static_cast<unsigned long long>(stats.staleSnapshots), stats.missingBase);
+    std::printf("  decode errors %u, checksum errors %u\n", stats.decodeErrors, stats.checksumErrors);
+
+    bool ok = connected == m_options.clients && stats.decodeErrors == 0 && stats.checksumErrors == 0;
+    std::printf("Load test %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+void LoadGenerator::SendConnect(Client& client, double nowMs) {
+    if (client.lastConnectMs < 0.0) {   // A new attempt, not a retransmit
+        client.nonce = m_random.NextU32() | 1u;
+        client.connectStartMs = nowMs;
+    }
+    client.lastConnectMs = nowMs;
+
+    uint8_t data[SERVER_HEADER_BYTES + 4];
+    PacketWriter writer(data);
+    WriteServerHeader(writer, SERVER_PACKET_CONNECT);
+    writer.Put32(client.nonce);
+    client.socket.Send(m_server, data, writer.GetSize());
+}
+
+void LoadGenerator::SendInput(Client& client) {
+    // Hold each movement choice for a while, like a player would, and turn slowly
+    if (client.inputTick % INPUT_HOLD_TICKS == 0) {
+        client.held.held = m_random.NextU32() & (INPUT_FORWARD | INPUT_BACKWARD | INPUT_LEFT | INPUT_RIGHT | INPUT_RUN);
+        client.held.aimYaw = std::fmod(client.held.aimYaw + static_cast<float>(m_random.Range(-30, 30)) + 360.0f,
+                                       360.0f);
+    }
+    client.inputTick++;
+    PlayerCommand command = {client.held.held, 0, client.held.aimYaw};
+    uint32_t roll = m_random.NextU32();
+    if (roll % 10 == 0) command.pressed |= INPUT_SHOOT;
+    if ((roll >> 8) % 40 == 0) command.pressed |= INPUT_MELEE;
+
+    uint8_t data[SERVER_HEADER_BYTES + 15];
+    PacketWriter writer(data);
+    WriteServerHeader(writer, SERVER_PACKET_INPUT);
+    writer.Put32(client.matchId);
+    writer.Put32(client.token);
+    writer.Put32(client.latestTick);
+    writer.Put8(EncodeCommandButtons(command));
+    writer.Put16(EncodeCommandYaw(command.aimYaw));
+    client.socket.Send(m_server, data, writer.GetSize());
+}
+
+void LoadGenerator::SendLeave(Client& client) {
+    uint8_t data[SERVER_HEADER_BYTES + 8];
+    PacketWriter writer(data);
+    WriteServerHeader(writer, SERVER_PACKET_LEAVE);
+    writer.Put32(client.matchId);
+    writer.Put32(client.token);
+    client.socket.Send(m_server, data, writer.GetSize());
+}
+
+void LoadGenerator::Receive(Client& client, double nowMs) {
+    uint8_t data[SERVER_MAX_PACKET_BYTES];
+    NetAddress from;
+    int size;
+    while ((size = client.socket.Receive(from, data, sizeof(data))) >= 0) {
+        if (from != m_server) continue;
+        PacketReader reader(data, static_cast<uint32_t>(size));
+        uint8_t type = ReadServerHeader(reader);
+
+        if (type == SERVER_PACKET_ACCEPT || type == SERVER_PACKET_REJECT) {
+            uint32_t nonce = reader.Get32();
+            if (client.accepted || nonce != client.nonce) continue;
+            if (type == SERVER_PACKET_REJECT) {
+                m_stats.rejects++;
+                continue;
+            }
+            client.matchId = reader.Get32();
+            client.token = reader.Get32();
+            if (!reader.IsValid()) continue;
+            client.accepted = true;
+            client.everAccepted = true;
+            client.latestTick = 0;
+            for (ReplicatedState& state : client.history) {
+                state.tick = 0;
+            }
+            double connectMs = nowMs - client.connectStartMs;
+            m_stats.connects++;
+            m_stats.connectMsTotal += connectMs;
+            m_stats.connectMsMax = std::max(m_stats.connectMsMax, connectMs);
+        } else if (type == SERVER_PACKET_SNAPSHOT && client.accepted) {
+            HandleSnapshot(client, reader, static_cast<uint32_t>(size));
+        }
+    }
+}
+
+void LoadGenerator::HandleSnapshot(Client& client, PacketReader& reader, uint32_t size) {
+    uint32_t tick = reader.Get32();
+    uint32_t base = reader.Get32();
+    uint32_t checksum = reader.Get32();
+    if (!reader.IsValid()) {
+        m_stats.decodeErrors++;
+        return;
+    }
+    if (tick <= client.latestTick) {
+        if (tick < client.latestTick) m_stats.staleSnapshots++;
+        return;
+    }
+
+    const ReplicatedState* baseline = nullptr;
+    if (base != 0) {
+        baseline = &client.history[base & (SERVER_SNAPSHOT_HISTORY - 1)];
+        if (baseline->tick != base) {
+            m_stats.missingBase++;
+            return;
+        }
+    }
+    if (!DecodeReplicatedState(reader.GetCursor(), reader.GetRemaining(), baseline, tick, m_decoded)) {
+        m_stats.decodeErrors++;
+        return;
+    }
+    if (ComputeReplicatedChecksum(m_decoded) != checksum) {
+        m_stats.checksumErrors++;
+        return;
+    }
+
+    client.history[tick & (SERVER_SNAPSHOT_HISTORY - 1)] = m_decoded;
+    if (client.latestTick != 0) {
+        m_stats.missedTicks += tick - client.latestTick - 1;
+    }
+    client.latestTick = tick;
+    m_stats.snapshots++;
+    m_stats.bytes += size;
+    if (base != 0) m_stats.deltas++;
+
+    // Match over: leave and queue up for a fresh one
+    if (m_decoded.state != static_cast<uint8_t>(GameState::PLAYING)) {
+        m_stats.matchesFinished++;
+        SendLeave(client);
+        client.accepted = false;
+        client.lastConnectMs = -LOAD_CONNECT_RETRY_MS;
+    }
+}
+
+} // namespace TimeMaster
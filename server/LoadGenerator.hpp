@@ -0,0 +1,102 @@
+#pragma once
+#include "Input.hpp"
+#include "Poller.hpp"
+#include "Random.hpp"
+#include "Replication.hpp"
+#include "ServerProtocol.hpp"
+#include "UdpSocket.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TimeMaster {
+
+constexpr double LOAD_CONNECT_RETRY_MS = 500.0;
+
+/**
+ * @brief Command-line options for the load generator (--load-test)
+ */
+struct LoadOptions {
+    std::string address = "127.0.0.1";
+    uint16_t port = SERVER_DEFAULT_PORT;
+    uint32_t clients = 200;
+    float seconds = 20.0f;
+    uint64_t seed = 1;
+};
+
+/**
+ * @brief Many scripted clients in one process, for loading a GameServer
+ *
+ * Each client has its own socket (so the server sees separate endpoints),
+ * all watched by one poller. Clients send held buttons and facing every
+ * tick, decode every snapshot against their own history exactly as a game
+ * client would, verify its checksum and acknowledge the newest tick. When a
+ * match ends the client leaves and connects again, so slots churn.
+ */
+class LoadGenerator {
+private:
+    struct Client {
+        UdpSocket socket;
+        uint32_t nonce;
+        bool accepted;
+        bool everAccepted;
+        uint32_t matchId;
+        uint32_t token;
+        double lastConnectMs;
+        double connectStartMs;
+        PlayerCommand held;
+        uint32_t inputTick;
+
+        ReplicatedState history[SERVER_SNAPSHOT_HISTORY];
+        uint32_t latestTick;
+    };
+
+    struct Stats {
+        uint64_t snapshots = 0;
+        uint64_t deltas = 0;
+        uint64_t bytes = 0;
+        uint64_t missedTicks = 0;        // Gaps between consecutive snapshots (loss or late ticks)
+        uint64_t staleSnapshots = 0;     // Older than one already decoded
+        uint32_t missingBase = 0;        // Delta against a tick this client no longer has
+        uint32_t decodeErrors = 0;
+        uint32_t checksumErrors = 0;
+        uint32_t connects = 0;
+        uint32_t rejects = 0;
+        uint32_t matchesFinished = 0;
+        double connectMsTotal = 0.0;
+        double connectMsMax = 0.0;
+    };
+
+    LoadOptions m_options;
+    NetAddress m_server;
+    Random m_random;
+    Poller m_poller;
+    std::vector<std::unique_ptr<Client>> m_clients;
+    ReplicatedState m_decoded;        // Scratch for validating snapshots
+    Stats m_stats;
+
+    void SendConnect(Client& client, double nowMs);
+    void SendInput(Client& client);
+    void SendLeave(Client& client);
+    void Receive(Client& client, double nowMs);
+    void HandleSnapshot(Client& client, PacketReader& reader, uint32_t size);
+
+public:
+    explicit LoadGenerator(const LoadOptions& options);
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    /**
+     * @brief Resolve the server and open every client socket
+     */
+    bool Open();
+
+    /**
+     * @brief Drive the clients for the configured time and print a report
+     * @return 0 if every client connected and every snapshot decoded, 1 otherwise
+     */
+    int Run();
+};
+
+} // namespace TimeMaster
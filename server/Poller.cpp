@@ -0,0 +1,108 @@
+#include "Poller.hpp"
+#include "Log.hpp"
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#else
+#include <poll.h>
+#include <vector>
+#endif
+
+namespace TimeMaster {
+
+#ifdef __linux__
+
+Poller::Poller(int capacity)
+    : m_handle(epoll_create1(0))
+    , m_count(0)
+    , m_handles(nullptr)
+    , m_userData(nullptr)
+    , m_capacity(capacity) {
+    if (m_handle == -1) {
+        TM_LOG_ERROR(NET, "Cannot create an epoll instance");
+    }
+}
+
+Poller::~Poller() {
+    if (m_handle != -1) {
+        close(m_handle);
+    }
+}
+
+bool Poller::IsOpen() const {
+    return m_handle != -1;
+}
+
+bool Poller::Add(intptr_t socket, uint64_t userData) {
+    if (m_handle == -1 || m_count >= m_capacity) return false;
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = userData;
+    if (epoll_ctl(m_handle, EPOLL_CTL_ADD, static_cast<int>(socket), &event) != 0) {
+        TM_LOG_ERROR(NET, "Cannot watch socket %d", static_cast<int>(socket));
+        return false;
+    }
+    m_count++;
+    return true;
+}
+
+int Poller::Wait(int timeoutMs, uint64_t* ready, int capacity) {
+    epoll_event events[POLLER_MAX_EVENTS];
+    int count = epoll_wait(m_handle, events, std::min(capacity, POLLER_MAX_EVENTS), std::max(timeoutMs, 0));
+    if (count < 0) return 0;   // EINTR (a signal): the caller re-checks its clock
+    for (int i = 0; i < count; ++i) {
+        ready[i] = events[i].data.u64;
+    }
+    return count;
+}
+
+#else
+
+Poller::Poller(int capacity)
+    : m_handle(0)
+    , m_count(0)
+    , m_handles(new intptr_t[capacity])
+    , m_userData(new uint64_t[capacity])
+    , m_capacity(capacity) {
+}
+
+Poller::~Poller() {
+    delete[] m_handles;
+    delete[] m_userData;
+}
+
+bool Poller::IsOpen() const {
+    return true;
+}
+
+bool Poller::Add(intptr_t socket, uint64_t userData) {
+    if (m_count >= m_capacity) return false;
+    m_handles[m_count] = socket;
+    m_userData[m_count] = userData;
+    m_count++;
+    return true;
+}
+
+int Poller::Wait(int timeoutMs, uint64_t* ready, int capacity) {
+    static thread_local std::vector<pollfd> fds;
+    fds.resize(m_count);
+    for (int i = 0; i < m_count; ++i) {
+        fds[i].fd = static_cast<int>(m_handles[i]);
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+    if (poll(fds.data(), fds.size(), std::max(timeoutMs, 0)) <= 0) return 0;
+    int count = 0;
+    for (int i = 0; i < m_count && count < capacity; ++i) {
+        if (fds[i].revents & POLLIN) {
+            ready[count++] = m_userData[i];
+        }
+    }
+    return count;
+}
+
+#endif
+
+} // namespace TimeMaster
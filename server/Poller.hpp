@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+namespace TimeMaster {
+
+constexpr int POLLER_MAX_EVENTS = 256;   // Ready handles returned per Wait
+
+/**
+ * @brief Socket readiness for many non-blocking sockets at once
+ * epoll on Linux (O(ready) per wait, however many sockets are registered);
+ * poll() over the registered set elsewhere on POSIX.
+ */
+class Poller {
+private:
+    int m_handle;               // epoll fd (Linux)
+    int m_count;
+    intptr_t* m_handles;        // Registered sockets (poll fallback)
+    uint64_t* m_userData;
+    int m_capacity;
+
+public:
+    /**
+     * @param capacity Most sockets registered at once
+     */
+    explicit Poller(int capacity);
+    ~Poller();
+
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+
+    bool IsOpen() const;
+
+    /**
+     * @brief Watch a socket for readability; Wait reports it by userData
+     */
+    bool Add(intptr_t socket, uint64_t userData);
+
+    /**
+     * @brief Block until at least one socket is readable or the timeout passes
+     * @param ready Receives the userData of each readable socket
+     * @return Number of entries written (0 on timeout)
+     */
+    int Wait(int timeoutMs, uint64_t* ready, int capacity);
+};
+
+} // namespace TimeMaster
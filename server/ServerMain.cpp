@@ -0,0 +1,90 @@
+#include "GameServer.hpp"
+#include "JobSystem.hpp"
+#include "LoadGenerator.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace TimeMaster;
+
+namespace {
+
+void PrintUsage(const char* program) {
+    std::printf("Usage: %s [--port <port>] [--max-matches <n>] [--seconds <s>] [--seed <n>] [--workers <n>]\n"
+                "       %s --load-test <clients> [--connect <host[:port]>] [--seconds <s>] [--seed <n>]\n"
+                "       --max-matches <n>  matches held at once, 1-%u (default: %u)\n"
+                "       --workers <n>   job system worker threads (default: hardware threads - 1)\n",
+                program, program, SERVER_MAX_MATCHES, SERVER_DEFAULT_MAX_MATCHES);
+}
+
+/**
+ * @brief Parse "host", "host:port" for --connect
+ */
+void ParseConnectAddress(const std::string& value, LoadOptions& options) {
+    size_t colon = value.rfind(':');
+    if (colon == std::string::npos) {
+        options.address = value;
+        return;
+    }
+    options.address = value.substr(0, colon);
+    options.port = static_cast<uint16_t>(std::atoi(value.c_str() + colon + 1));
+}
+
+void HandleStopSignal(int) {
+    GameServer::RequestStop();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ServerOptions serverOptions;
+    LoadOptions loadOptions;
+    bool loadTest = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            serverOptions.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+            loadOptions.port = serverOptions.port;
+        } else if (arg == "--max-matches" && hasValue) {
+            int matches = std::clamp(std::atoi(argv[++i]), 1, static_cast<int>(SERVER_MAX_MATCHES));
+            serverOptions.maxMatches = static_cast<uint32_t>(matches);
+        } else if (arg == "--seconds" && hasValue) {
+            float seconds = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+            serverOptions.seconds = seconds;
+            loadOptions.seconds = seconds;
+        } else if (arg == "--seed" && hasValue) {
+            serverOptions.seed = std::strtoull(argv[++i], nullptr, 0);
+            loadOptions.seed = serverOptions.seed;
+        } else if (arg == "--load-test" && hasValue) {
+            loadTest = true;
+            loadOptions.clients = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--connect" && hasValue) {
+            ParseConnectAddress(argv[++i], loadOptions);
+        } else if (arg == "--workers" && hasValue) {
+            JobSystem::SetWorkerCount(std::max(0, std::atoi(argv[++i])));
+        } else {
+            PrintUsage(argv[0]);
+            return (arg == "--help" || arg == "-h") ? 0 : 2;
+        }
+    }
+
+    if (loadTest) {
+        LoadGenerator generator(loadOptions);
+        if (!generator.Open()) {
+            return 2;
+        }
+        return generator.Run();
+    }
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+    GameServer server(serverOptions);
+    if (!server.Open()) {
+        return 2;
+    }
+    return server.Run();
+}
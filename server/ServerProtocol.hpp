@@ -0,0 +1,64 @@
+#pragma once
+#include "Packet.hpp"
+#include "Replication.hpp"
+#include <cstdint>
+
+namespace TimeMaster {
+
+// Dedicated server protocol (fixed)
+constexpr uint16_t SERVER_DEFAULT_PORT = 47700;
+constexpr uint8_t SERVER_PROTOCOL_VERSION = 2;
+constexpr uint32_t SERVER_DEFAULT_MAX_MATCHES = 512;
+constexpr uint32_t SERVER_MAX_MATCHES = 4096;           // --max-matches limit (each match preallocates its Game)
+constexpr uint32_t SERVER_SNAPSHOT_HISTORY = 16;      // Ticks kept as delta baselines (power of two)
+constexpr uint32_t SERVER_MAX_PACKET_BYTES = 1400;    // Below a typical path MTU
+constexpr float SERVER_TIMEOUT_SECONDS = 10.0f;
+constexpr uint32_t SERVER_HEADER_BYTES = 4;
+constexpr uint32_t SERVER_SNAPSHOT_HEADER_BYTES = SERVER_HEADER_BYTES + 4 + 4 + 4;
+
+static_assert((SERVER_SNAPSHOT_HISTORY & (SERVER_SNAPSHOT_HISTORY - 1)) == 0,
+              "SERVER_SNAPSHOT_HISTORY must be a power of two");
+
+/**
+ * @brief Packet types; every packet starts 'T' 'S' version type
+ *
+ *   CONNECT   client: nonce                     (repeated until answered)
+ *   ACCEPT    server: nonce, match, token
+ *   REJECT    server: nonce                     (no free match)
+ *   INPUT     client: match, token, ack tick, buttons, yaw
+ *   SNAPSHOT  server: tick, base tick, checksum, EncodeReplicatedState bytes
+ *   LEAVE     client: match, token
+ *
+ * The snapshot is a delta against the client's copy of the base tick, which
+ * the client acknowledged in an INPUT; base tick 0 means no baseline. The
+ * checksum (ComputeReplicatedChecksum) covers the decoded state.
+ */
+enum ServerPacketType : uint8_t {
+    SERVER_PACKET_CONNECT = 1,
+    SERVER_PACKET_ACCEPT,
+    SERVER_PACKET_REJECT,
+    SERVER_PACKET_INPUT,
+    SERVER_PACKET_SNAPSHOT,
+    SERVER_PACKET_LEAVE
+};
+
+inline void WriteServerHeader(PacketWriter& writer, ServerPacketType type) {
+    writer.Put8('T');
+    writer.Put8('S');
+    writer.Put8(SERVER_PROTOCOL_VERSION);
+    writer.Put8(type);
+}
+
+/**
+ * @brief Check the header and return the packet type (0 if not ours)
+ */
+inline uint8_t ReadServerHeader(PacketReader& reader) {
+    uint8_t tag0 = reader.Get8();
+    uint8_t tag1 = reader.Get8();
+    uint8_t version = reader.Get8();
+    uint8_t type = reader.Get8();
+    if (!reader.IsValid() || tag0 != 'T' || tag1 != 'S' || version != SERVER_PROTOCOL_VERSION) return 0;
+    return type;
+}
+
+} // namespace TimeMaster
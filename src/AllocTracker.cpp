@@ -0,0 +1,254 @@
+#include "AllocTracker.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if !defined(NDEBUG) && (defined(__GLIBC__) || defined(__APPLE__))
+#include <execinfo.h>
+#define TM_ALLOC_CALLSITES 1
+// Pin the hook's frame layout so a fixed number of frames can be skipped
+#define TM_ALLOC_HOOK_INLINE inline __attribute__((always_inline))
+#define TM_ALLOC_HOOK_NOINLINE __attribute__((noinline))
+#else
+#define TM_ALLOC_CALLSITES 0
+#define TM_ALLOC_HOOK_INLINE inline
+#define TM_ALLOC_HOOK_NOINLINE
+#endif
+
+namespace TimeMaster {
+
+std::atomic<bool> AllocTracker::s_enabled(false);
+
+namespace {
+
+constexpr int ALLOC_SKIPPED_FRAMES = 3;   // RecordCallSite, OnAllocate, operator new
+
+thread_local uint16_t t_allocZone = ALLOC_NO_ZONE;
+thread_local bool t_inHook = false;        // backtrace() must not re-enter the hook
+
+} // namespace
+
+AllocTracker::AllocTracker()
+    : m_frameAllocations(0)
+    , m_frameBytes(0)
+    , m_last{0, 0}
+    , m_lastZoneAllocations{}
+    , m_callSiteOverflow(0) {
+    for (auto& count : m_zoneAllocations) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    for (auto& site : m_callSites) {
+        site.hash.store(0, std::memory_order_relaxed);
+        site.count.store(0, std::memory_order_relaxed);
+        site.bytes.store(0, std::memory_order_relaxed);
+        site.depth = 0;
+    }
+}
+
+AllocTracker& AllocTracker::GetInstance() {
+    static AllocTracker instance;
+    return instance;
+}
+
+void AllocTracker::SetEnabled(bool enabled) {
+    if (enabled && !IsEnabled()) {
+        m_frameAllocations.store(0, std::memory_order_relaxed);
+        m_frameBytes.store(0, std::memory_order_relaxed);
+        for (auto& count : m_zoneAllocations) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        for (auto& site : m_callSites) {
+            site.hash.store(0, std::memory_order_relaxed);
+            site.count.store(0, std::memory_order_relaxed);
+            site.bytes.store(0, std::memory_order_relaxed);
+        }
+        m_callSiteOverflow.store(0, std::memory_order_relaxed);
+#if TM_ALLOC_CALLSITES
+        // The first backtrace() loads the unwinder; do it outside the hook
+        void* warmup[1];
+        backtrace(warmup, 1);
+#endif
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+TM_ALLOC_HOOK_NOINLINE void AllocTracker::OnAllocate(size_t size) {
+    if (t_inHook) return;
+    
+    m_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    m_frameBytes.fetch_add(size, std::memory_order_relaxed);
+    if (t_allocZone != ALLOC_NO_ZONE) {
+        m_zoneAllocations[t_allocZone].fetch_add(1, std::memory_order_relaxed);
+    }
+#if TM_ALLOC_CALLSITES
+    RecordCallSite(size);
+#endif
+}
+
+TM_ALLOC_HOOK_NOINLINE void AllocTracker::RecordCallSite(size_t size) {
+#if TM_ALLOC_CALLSITES
+    t_inHook = true;
+    void* frames[ALLOC_CALLSTACK_DEPTH + ALLOC_SKIPPED_FRAMES];
+    int depth = backtrace(frames, ALLOC_CALLSTACK_DEPTH + ALLOC_SKIPPED_FRAMES) - ALLOC_SKIPPED_FRAMES;
+    t_inHook = false;
+    if (depth <= 0) return;
+    void** stack = frames + ALLOC_SKIPPED_FRAMES;
+    
+    // FNV-1a over the return addresses
+    uint64_t hash = 1469598103934665603ull;
+    for (int i = 0; i < depth; ++i) {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(stack[i])) * 1099511628211ull;
+    }
+    if (hash == 0) hash = 1;
+    
+    for (int probe = 0; probe < ALLOC_CALLSITE_SLOTS; ++probe) {
+        AllocCallSite& site = m_callSites[(hash + probe) & (ALLOC_CALLSITE_SLOTS - 1)];
+        uint64_t current = site.hash.load(std::memory_order_acquire);
+        if (current == 0) {
+            uint64_t expected = 0;
+            if (site.hash.compare_exchange_strong(expected, hash, std::memory_order_acq_rel)) {
+                std::copy(stack, stack + depth, site.frames);
+                site.depth = depth;
+                current = hash;
+            } else {
+                current = expected;
+            }
+        }
+        if (current == hash) {
+            site.count.fetch_add(1, std::memory_order_relaxed);
+            site.bytes.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+    }
+    m_callSiteOverflow.fetch_add(1, std::memory_order_relaxed);
+#else
+    (void)size;
+#endif
+}
+
+uint16_t AllocTracker::EnterZone(uint16_t zone) {
+    uint16_t previous = t_allocZone;
+    t_allocZone = zone < ALLOC_MAX_ZONES ? zone : ALLOC_NO_ZONE;
+    return previous;
+}
+
+void AllocTracker::LeaveZone(uint16_t previous) {
+    t_allocZone = previous;
+}
+
+void AllocTracker::EndFrame() {
+    m_last.allocations = m_frameAllocations.exchange(0, std::memory_order_relaxed);
+    m_last.bytes = m_frameBytes.exchange(0, std::memory_order_relaxed);
+    for (int i = 0; i < ALLOC_MAX_ZONES; ++i) {
+        m_lastZoneAllocations[i] = m_zoneAllocations[i].exchange(0, std::memory_order_relaxed);
+    }
+}
+
+void AllocTracker::ReportCallSites(int maxSites) const {
+#if TM_ALLOC_CALLSITES
+    int order[ALLOC_CALLSITE_SLOTS];
+    int used = 0;
+    for (int i = 0; i < ALLOC_CALLSITE_SLOTS; ++i) {
+        if (m_callSites[i].hash.load(std::memory_order_acquire) != 0) {
+            order[used++] = i;
+        }
+    }
+    std::sort(order, order + used, [this](int a, int b) {
+        return m_callSites[a].count.load(std::memory_order_relaxed) > m_callSites[b].count.load(std::memory_order_relaxed);
+    });
+    
+    std::printf("Allocation call sites (%d recorded, %u untracked):\n",
+                used, m_callSiteOverflow.load(std::memory_order_relaxed));
+    for (int i = 0; i < std::min(used, maxSites); ++i) {
+        const AllocCallSite& site = m_callSites[order[i]];
+        std::printf("  #%d  %u allocations, %llu bytes\n", i + 1,
+                    site.count.load(std::memory_order_relaxed),
+                    static_cast<unsigned long long>(site.bytes.load(std::memory_order_relaxed)));
+        char** symbols = backtrace_symbols(site.frames, site.depth);
+        for (int f = 0; f < site.depth; ++f) {
+            std::printf("      %s\n", symbols ? symbols[f] : "?");
+        }
+        std::free(symbols);
+    }
+#else
+    (void)maxSites;
+    std::printf("Allocation call sites are only recorded in debug builds (make DEBUG=1)\n");
+#endif
+}
+
+} // namespace TimeMaster
+
+// Global allocation hooks. Counting happens only while the tracker is enabled.
+namespace {
+
+TM_ALLOC_HOOK_INLINE void TrackAllocation(std::size_t size) {
+    if (TimeMaster::AllocTracker::IsEnabled()) {
+        TimeMaster::AllocTracker::GetInstance().OnAllocate(size);
+    }
+}
+
+void* AllocateAligned(std::size_t size, std::size_t alignment) {
+    size = (size + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, size ? size : alignment);
+#endif
+}
+
+void FreeAligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    TrackAllocation(size);
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    TrackAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    TrackAllocation(size);
+    void* ptr = AllocateAligned(size, static_cast<std::size_t>(alignment));
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
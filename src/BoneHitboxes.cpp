@@ -0,0 +1,193 @@
+#include "BoneHitboxes.hpp"
+#include "Skinning.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr int AXIS_ITERATIONS = 16;     // Power iterations for a bone's principal axis
+
+/**
+ * @brief What one bone's vertices add up to while fitting
+ */
+struct BoneFit {
+    uint32_t vertices;
+    double sum[3];
+    double covariance[6];   // xx, xy, xz, yy, yz, zz
+    Vector3 mean;
+    Vector3 axis;
+    float minAlong;
+    float maxAlong;
+    float maxAcrossSquared;
+    float low;                      // Shortest segment that covers every vertex at that radius
+    float high;
+    float maxMiddleDistanceSquared; // From the middle of the extent, should the segment vanish
+};
+
+// Calls visit(bone, position) for every skinned vertex with the bone weighing most on it
+template <typename Visitor>
+void ForEachOwnedVertex(const Model& model, Visitor visit) {
+    for (int m = 0; m < model.meshCount; ++m) {
+        const Mesh& mesh = model.meshes[m];
+        if (mesh.vertices == nullptr || mesh.boneIds == nullptr || mesh.boneWeights == nullptr) continue;
+        for (int v = 0; v < mesh.vertexCount; ++v) {
+            int owner = -1;
+            float weight = 0.0f;
+            for (int j = v * 4; j < v * 4 + 4; ++j) {
+                if (mesh.boneWeights[j] > weight) {
+                    weight = mesh.boneWeights[j];
+                    owner = mesh.boneIds[j];
+                }
+            }
+            if (owner < 0 || owner >= model.boneCount) continue;
+            const float* p = mesh.vertices + v * 3;
+            visit(owner, Vector3{p[0], p[1], p[2]});
+        }
+    }
+}
+
+// Principal axis of a bone's vertices; models stand on Y, so start from there
+Vector3 GetPrincipalAxis(const double* c) {
+    double x = 0.0, y = 1.0, z = 0.0;
+    for (int i = 0; i < AXIS_ITERATIONS; ++i) {
+        double nx = c[0] * x + c[1] * y + c[2] * z;
+        double ny = c[1] * x + c[3] * y + c[4] * z;
+        double nz = c[2] * x + c[4] * y + c[5] * z;
+        double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (length <= 0.0) return {0.0f, 1.0f, 0.0f};   // All vertices in one point
+        x = nx / length;
+        y = ny / length;
+        z = nz / length;
+    }
+    return {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)};
+}
+
+} // namespace
+
+void FitBoneHitboxes(const Model& model, BoneHitboxRig& rig) {
+    rig = {};
+    rig.modelBottom = GetModelBoundingBox(model).min.y;
+    if (model.boneCount <= 0 || model.bindPose == nullptr) return;
+
+    std::vector<BoneFit> fits(static_cast<size_t>(model.boneCount), BoneFit{});
+    ForEachOwnedVertex(model, [&](int bone, Vector3 p) {
+        BoneFit& fit = fits[bone];
+        fit.vertices++;
+        fit.sum[0] += p.x;
+        fit.sum[1] += p.y;
+        fit.sum[2] += p.z;
+    });
+
+    // Largest bones first (lowest index on a tie)
+    std::vector<int> bones;
+    for (int b = 0; b < model.boneCount; ++b) {
+        if (fits[b].vertices >= BONE_HITBOX_MIN_VERTICES) bones.push_back(b);
+    }
+    std::stable_sort(bones.begin(), bones.end(), [&](int a, int b) { return fits[a].vertices > fits[b].vertices; });
+    if (bones.size() > MAX_HIT_CAPSULES) bones.resize(MAX_HIT_CAPSULES);
+    if (bones.empty()) return;
+
+    std::vector<uint8_t> selected(static_cast<size_t>(model.boneCount), 0);
+    for (int b : bones) {
+        BoneFit& fit = fits[b];
+        double count = static_cast<double>(fit.vertices);
+        fit.mean = {static_cast<float>(fit.sum[0] / count), static_cast<float>(fit.sum[1] / count),
+                    static_cast<float>(fit.sum[2] / count)};
+        selected[b] = 1;
+    }
+
+    // Spread around the mean, then the extent along and across its main axis
+    ForEachOwnedVertex(model, [&](int bone, Vector3 p) {
+        if (!selected[bone]) return;
+        BoneFit& fit = fits[bone];
+        double dx = p.x - fit.mean.x, dy = p.y - fit.mean.y, dz = p.z - fit.mean.z;
+        fit.covariance[0] += dx * dx;
+        fit.covariance[1] += dx * dy;
+        fit.covariance[2] += dx * dz;
+        fit.covariance[3] += dy * dy;
+        fit.covariance[4] += dy * dz;
+        fit.covariance[5] += dz * dz;
+    });
+    for (int b : bones) {
+        BoneFit& fit = fits[b];
+        fit.axis = GetPrincipalAxis(fit.covariance);
+        fit.minAlong = 0.0f;
+        fit.maxAlong = 0.0f;
+        fit.maxAcrossSquared = 0.0f;
+    }
+    ForEachOwnedVertex(model, [&](int bone, Vector3 p) {
+        if (!selected[bone]) return;
+        BoneFit& fit = fits[bone];
+        Vector3 offset = Vector3Subtract(p, fit.mean);
+        float along = Vector3DotProduct(offset, fit.axis);
+        fit.minAlong = std::min(fit.minAlong, along);
+        fit.maxAlong = std::max(fit.maxAlong, along);
+        fit.maxAcrossSquared = std::max(fit.maxAcrossSquared, Vector3LengthSqr(offset) - along * along);
+    });
+
+    // The radius holds every vertex across the axis; trim the segment to the
+    // part the round ends still need to reach the vertices along it
+    for (int b : bones) {
+        BoneFit& fit = fits[b];
+        fit.low = fit.maxAlong;
+        fit.high = fit.minAlong;
+        fit.maxMiddleDistanceSquared = 0.0f;
+    }
+    ForEachOwnedVertex(model, [&](int bone, Vector3 p) {
+        if (!selected[bone]) return;
+        BoneFit& fit = fits[bone];
+        Vector3 offset = Vector3Subtract(p, fit.mean);
+        float along = Vector3DotProduct(offset, fit.axis);
+        float acrossSquared = std::max(Vector3LengthSqr(offset) - along * along, 0.0f);
+        float reach = std::sqrt(std::max(fit.maxAcrossSquared - acrossSquared, 0.0f));
+        fit.low = std::min(fit.low, along + reach);
+        fit.high = std::max(fit.high, along - reach);
+        float fromMiddle = along - 0.5f * (fit.minAlong + fit.maxAlong);
+        fit.maxMiddleDistanceSquared = std::max(fit.maxMiddleDistanceSquared, fromMiddle * fromMiddle + acrossSquared);
+    });
+
+    for (int b : bones) {
+        const BoneFit& fit = fits[b];
+        float radius = std::sqrt(std::max(fit.maxAcrossSquared, 0.0f));
+        float low = fit.low;
+        float high = fit.high;
+        if (low > high) {
+            // Rounder than long: a sphere around the middle
+            low = high = 0.5f * (fit.minAlong + fit.maxAlong);
+            radius = std::sqrt(fit.maxMiddleDistanceSquared);
+        }
+        BoneCapsule& capsule = rig.capsules[rig.count++];
+        capsule.bone = b;
+        capsule.capsule = {Vector3Add(fit.mean, Vector3Scale(fit.axis, low)),
+                           Vector3Add(fit.mean, Vector3Scale(fit.axis, high)), radius};
+    }
+}
+
+void PoseBoneHitboxes(const BoneHitboxRig& rig, const Model& model, const ModelAnimation* animation, int frame,
+                      const Matrix& modelToWorld, float radiusScale, CapsuleSet& capsules) {
+    capsules.Clear();
+    bool posed = animation != nullptr && animation->framePoses != nullptr && animation->frameCount > 0;
+    if (posed) frame %= animation->frameCount;
+    for (uint32_t i = 0; i < rig.count; ++i) {
+        const BoneCapsule& bone = rig.capsules[i];
+        Capsule capsule = bone.capsule;
+        float scale = radiusScale;
+        if (posed && bone.bone < animation->boneCount) {
+            const Transform& pose = animation->framePoses[frame][bone.bone];
+            SkinBone skin = MakeSkinBone(model.bindPose[bone.bone], pose);
+            capsule.start = SkinPoint(skin, capsule.start);
+            capsule.end = SkinPoint(skin, capsule.end);
+            scale *= std::max(std::fabs(pose.scale.x), std::max(std::fabs(pose.scale.y), std::fabs(pose.scale.z)));
+        }
+        capsule.start = Vector3Transform(capsule.start, modelToWorld);
+        capsule.end = Vector3Transform(capsule.end, modelToWorld);
+        capsule.radius *= scale;
+        capsules.Add(capsule);
+    }
+}
+
+} // namespace TimeMaster
@@ -1,5 +1,7 @@
 #include "Boss.hpp"
 #include "Player.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
 #include "raymath.h"
 #include <cstdio>
 #include <cstdlib>
@@ -7,104 +9,85 @@
 
 namespace TimeMaster {
 
-Boss::Boss() 
+namespace {
+
+// How long each state lasts before the state timer moves the boss on
+constexpr float BOSS_IDLE_SECONDS = 5.0f;
+constexpr float BOSS_ATTACK_SECONDS = 1.5f;
+
+// The model is drawn this many times its own size, standing on the arena floor
+constexpr float BOSS_MODEL_SCALE = 12.0f;
+constexpr float BOSS_FLOOR_Y = 5.0f;   // Clears the arena's visual thickness
+constexpr int BOSS_CAPSULE_SLICES = 8;  // Debug capsule wires
+constexpr int BOSS_CAPSULE_RINGS = 2;
+
+Vector3 GetModelPosition(Vector3 position, float modelBottom) {
+    return {position.x, -modelBottom * BOSS_MODEL_SCALE + BOSS_FLOOR_Y, position.z};
+}
+
+// Same placement as DrawModelEx: model transform, scale, rotation about Y, translation
+Matrix GetModelToWorld(const Model& model, Vector3 modelPosition, float rotation) {
+    Matrix placement = MatrixMultiply(MatrixMultiply(MatrixScale(BOSS_MODEL_SCALE, BOSS_MODEL_SCALE, BOSS_MODEL_SCALE),
+                                                     MatrixRotateY(rotation * DEG2RAD)),
+                                      MatrixTranslate(modelPosition.x, modelPosition.y, modelPosition.z));
+    return MatrixMultiply(model.transform, placement);
+}
+
+} // namespace
+
+Boss::Boss(Random& random, const GameConfig& config, const ModelAsset& asset,
+           TimerWheel& timers, EventBus& events) 
     : m_moveSpeed(40.0f) 
+    , m_hitCapsules{}
     , m_targetRotation(0.0f)
     , m_currentRotation(0.0f)
     , m_rotationSpeed(3.0f)
+    , m_random(random)
+    , m_config(config)
+    , m_asset(asset)
+    , m_timers(timers)
+    , m_events(events)
     , m_currentState(BossState::IDLE)
-    , m_stateTimer(0.0f)
     , m_hasAttackedInState(false)
-    , m_animations(nullptr)
-    , m_animationCount(0)
     , m_currentAnimFrame(0)
     , m_currentAnimIndex(-1)
     , m_animTimer(0.0f)
-    , m_modelLoaded(false)
     , m_showDebugHitbox(true) {
     
-    LoadModel();
     Reset();
 }
 
-Boss::~Boss() {
-    UnloadModel();
-}
-
-void Boss::LoadModel() {
-    const char* modelPath = "assets/models/plant_boss/scene.gltf";
-    
-    if (FileExists(modelPath)) {
-        m_model = ::LoadModel(modelPath);  // Use global Raylib function
-        m_animations = ::LoadModelAnimations(modelPath, &m_animationCount);
-        m_modelLoaded = true;
-        printf("Boss model loaded successfully!\n");
-        printf("  Animations found: %d\n", m_animationCount);
-        
-        // Print info about each animation
-        for (int i = 0; i < m_animationCount; i++) {
-            printf("  Animation %d: %d frames\n", i, m_animations[i].frameCount);
-        }
-        
-        // Print model bounds for debugging
-        BoundingBox bounds = GetModelBoundingBox(m_model);
-        printf("  Model bounds: min(%.2f, %.2f, %.2f) max(%.2f, %.2f, %.2f)\n",
-               bounds.min.x, bounds.min.y, bounds.min.z,
-               bounds.max.x, bounds.max.y, bounds.max.z);
-        Vector3 modelSize = {
-            bounds.max.x - bounds.min.x,
-            bounds.max.y - bounds.min.y,
-            bounds.max.z - bounds.min.z
-        };
-        printf("  Model size: (%.2f, %.2f, %.2f)\n", modelSize.x, modelSize.y, modelSize.z);
-        printf("  Using fixed scale: 12.0 (hitbox is for collision only, not visual sizing)\n");
-    } else {
-        printf("Warning: Boss model not found at %s\n", modelPath);
-        m_modelLoaded = false;
-    }
-}
-
-void Boss::UnloadModel() {
-    if (m_modelLoaded) {
-        ::UnloadModel(m_model);  // Use global Raylib function
-        if (m_animations) {
-            ::UnloadModelAnimations(m_animations, m_animationCount);
-        }
-    }
-}
-
 void Boss::Reset() {
-    auto& config = GameConfig::GetInstance();
+    const GameConfig& config = m_config;
     // Reduced hitbox to match visual scale better
     m_size = {BOSS_WIDTH * 0.8f, BOSS_HEIGHT * 0.8f, BOSS_DEPTH * 0.8f};
     float halfHeight = m_size.y / 2.0f;
     m_position = {200, halfHeight + 5.0f, 0};  // Above ground to avoid visual collision with arena thickness
     m_time = config.bossStartingTime;
     m_isAlive = true;
-    m_attackCooldown = 0.0f;
+    m_attackReadyTick = 0;
     m_moveTimer = 0.0f;
     m_velocity = {0, 0, 0};  // Plant boss is stationary
     m_color = GREEN;
     m_currentRotation = 0.0f;
     m_targetRotation = 0.0f;
     m_currentState = BossState::IDLE;
-    m_stateTimer = 0.0f;
+    ScheduleStateTimer();
     m_currentAnimFrame = 0;
     m_currentAnimIndex = -1;
     m_animTimer = 0.0f;
+    PoseHitCapsules();
 }
 
 void Boss::Update(float deltaTime) {
-    if (!m_isAlive) return;
+    PROFILE_ZONE("Boss::Update");
     
-    // Update state machine
-    UpdateState(deltaTime);
+    if (!m_isAlive) return;
     
-    // Update attack cooldown (legacy, not used anymore)
-    m_attackCooldown -= deltaTime;
+    // State changes are driven by m_stateTimer on the game's timer wheel
     
     // Update animation frames based on current state
-    if (m_modelLoaded && m_animationCount > 0) {
+    if (m_asset.loaded && m_asset.animationCount > 0) {
         // Choose which animation to play based on state
         // Animations in GLTF: 0=Attack1, 1=Attack2, 2=Attack3, 3=Defense1, 4=Defense2, 5=Defense3, 6=Walk
         int animIndex = 6; // Default to Walk (as idle)
@@ -139,7 +122,7 @@ void Boss::Update(float deltaTime) {
         }
         
         // Make sure animIndex is valid
-        if (animIndex >= m_animationCount) {
+        if (animIndex >= m_asset.animationCount) {
             animIndex = 0;
         }
         
@@ -157,13 +140,13 @@ void Boss::Update(float deltaTime) {
         
         if (shouldLoop) {
             // Loop animation
-            float animDuration = m_animations[animIndex].frameCount / animFPS;
+            float animDuration = m_asset.animations[animIndex].frameCount / animFPS;
             while (m_animTimer >= animDuration) {
                 m_animTimer -= animDuration;
             }
         } else {
             // Clamp to animation duration for non-looping animations
-            float animDuration = m_animations[animIndex].frameCount / animFPS;
+            float animDuration = m_asset.animations[animIndex].frameCount / animFPS;
             if (m_animTimer > animDuration) {
                 m_animTimer = animDuration - 0.001f; // Stay just before the end
             }
@@ -173,21 +156,41 @@ void Boss::Update(float deltaTime) {
         m_currentAnimFrame = (int)(m_animTimer * animFPS);
         
         // Clamp to valid frame range
-        if (m_currentAnimFrame >= m_animations[animIndex].frameCount) {
-            m_currentAnimFrame = m_animations[animIndex].frameCount - 1;
+        if (m_currentAnimFrame >= m_asset.animations[animIndex].frameCount) {
+            m_currentAnimFrame = m_asset.animations[animIndex].frameCount - 1;
         }
-        
-        // Update the model animation
-        UpdateModelAnimation(m_model, m_animations[animIndex], m_currentAnimFrame);
     }
 }
 
-void Boss::UpdateWithPlayer(Vector3 playerPosition, float deltaTime) {
+void Boss::UpdateWithPlayer(Vector3 playerPosition, Vector3 moveDirection, float deltaTime) {
     Update(deltaTime);
     UpdateRotation(playerPosition, deltaTime);
     if (m_currentState == BossState::IDLE) {
-        MoveTowards(playerPosition, deltaTime);
+        MoveTowards(playerPosition, moveDirection, deltaTime);
     }
+    PoseHitCapsules();
+}
+
+void Boss::PoseHitCapsules() {
+    const BoneHitboxRig& rig = m_asset.hitboxes;
+    if (m_asset.loaded && rig.count > 0) {
+        const ModelAnimation* animation = nullptr;
+        if (m_currentAnimIndex >= 0 && m_currentAnimIndex < m_asset.animationCount) {
+            animation = &m_asset.animations[m_currentAnimIndex];
+        }
+        Matrix modelToWorld = GetModelToWorld(m_asset.model, GetModelPosition(m_position, rig.modelBottom),
+                                              m_currentRotation);
+        PoseBoneHitboxes(rig, m_asset.model, animation, m_currentAnimFrame, modelToWorld, BOSS_MODEL_SCALE,
+                         m_hitCapsules);
+        return;
+    }
+    
+    // No skeleton: one upright capsule as wide as the hitbox and as tall
+    float radius = m_size.x / 2.0f;
+    float halfSegment = std::fmax(m_size.y / 2.0f - radius, 0.0f);
+    m_hitCapsules.Clear();
+    m_hitCapsules.Add({{m_position.x, m_position.y - halfSegment, m_position.z},
+                       {m_position.x, m_position.y + halfSegment, m_position.z}, radius});
 }
 
 void Boss::UpdateRotation(Vector3 playerPosition, float deltaTime) {
@@ -215,119 +218,148 @@ void Boss::UpdateRotation(Vector3 playerPosition, float deltaTime) {
     }
 }
 
-void Boss::UpdateState(float deltaTime) {
-    m_stateTimer += deltaTime;
-    
+void Boss::ScheduleStateTimer() {
+    m_timers.Cancel(m_stateTimer);
     switch (m_currentState) {
         case BossState::IDLE:
-            // Idle/standby animation - wait 5 seconds before attacking
-            if (m_stateTimer > 5.0f) {
-                // Randomly choose an attack
-                int attack = GetRandomValue(1, 3);
-                if (attack == 1) {
-                    SetState(BossState::ATTACK_1);
-                    printf("Boss: ATTACK_1\n");
-                } else if (attack == 2) {
-                    SetState(BossState::ATTACK_2);
-                    printf("Boss: ATTACK_2\n");
-                } else {
-                    SetState(BossState::ATTACK_3);
-                    printf("Boss: ATTACK_3\n");
-                }
-            }
+            m_stateTimer = m_timers.Schedule(TimerWheel::SecondsToTicks(BOSS_IDLE_SECONDS), &Boss::StateTimerExpired, this);
             break;
-            
         case BossState::ATTACK_1:
-            // Attack 1 logic - lasts 1.5 seconds
-            if (m_stateTimer > 1.5f) {
-                SetState(BossState::IDLE);
-                printf("Boss: Back to IDLE\n");
-            }
-            break;
-            
         case BossState::ATTACK_2:
-            // Attack 2 logic - lasts 1.5 seconds
-            if (m_stateTimer > 1.5f) {
-                SetState(BossState::IDLE);
-                printf("Boss: Back to IDLE\n");
+        case BossState::ATTACK_3:
+            m_stateTimer = m_timers.Schedule(TimerWheel::SecondsToTicks(BOSS_ATTACK_SECONDS), &Boss::StateTimerExpired, this);
+            break;
+        case BossState::DEATH:
+            break;
+    }
+}
+
+void Boss::StateTimerExpired(void* context, uint32_t) {
+    static_cast<Boss*>(context)->OnStateTimer();
+}
+
+void Boss::OnStateTimer() {
+    if (!m_isAlive) return;
+    
+    switch (m_currentState) {
+        case BossState::IDLE: {
+            // Idle/standby over - randomly choose an attack
+            int attack = m_random.Range(1, 3);
+            if (attack == 1) {
+                SetState(BossState::ATTACK_1);
+            } else if (attack == 2) {
+                SetState(BossState::ATTACK_2);
+            } else {
+                SetState(BossState::ATTACK_3);
             }
             break;
+        }
             
+        case BossState::ATTACK_1:
+        case BossState::ATTACK_2:
         case BossState::ATTACK_3:
-            // Attack 3 logic - lasts 1.5 seconds
-            if (m_stateTimer > 1.5f) {
-                SetState(BossState::IDLE);
-                printf("Boss: Back to IDLE\n");
-            }
+            SetState(BossState::IDLE);
             break;
             
         case BossState::DEATH:
-            // Death animation
             break;
     }
 }
 
 void Boss::SetState(BossState newState) {
     if (m_currentState != newState) {
+        m_events.Emit(StateChangedEvent{m_currentState, newState});
         m_currentState = newState;
-        m_stateTimer = 0.0f;
+        ScheduleStateTimer();
         m_currentAnimFrame = 0;
         m_hasAttackedInState = false;  // Reset attack flag when changing state
     }
 }
 
+BossRecord Boss::SaveRecord() const {
+    return {m_position, m_velocity, m_targetRotation, m_currentRotation, m_time, m_moveTimer, m_animTimer,
+            m_attackReadyTick, m_timers.SaveTimer(m_stateTimer), m_currentAnimIndex, m_currentAnimFrame,
+            m_color, m_currentState, m_isAlive, m_hasAttackedInState};
+}
+
+void Boss::LoadRecord(const BossRecord& record) {
+    m_position = record.position;
+    m_velocity = record.velocity;
+    m_targetRotation = record.targetRotation;
+    m_currentRotation = record.currentRotation;
+    m_time = record.time;
+    m_moveTimer = record.moveTimer;
+    m_animTimer = record.animTimer;
+    m_attackReadyTick = record.attackReadyTick;
+    m_currentAnimIndex = record.animIndex;
+    m_currentAnimFrame = record.animFrame;
+    m_color = record.color;
+    m_currentState = record.state;
+    m_isAlive = record.alive;
+    m_hasAttackedInState = record.hasAttackedInState;
+    m_stateTimer = m_timers.RestoreTimer(record.stateTimer, &Boss::StateTimerExpired, this);
+    PoseHitCapsules();
+}
+
 void Boss::Draw() const {
-    if (!m_isAlive) return;
+    DrawSnapshot(GetSnapshot(), m_asset);
+}
+
+BossSnapshot Boss::GetSnapshot() const {
+    BossSnapshot snapshot;
+    snapshot.position = m_position;
+    snapshot.size = m_size;
+    snapshot.rotation = m_currentRotation;
+    snapshot.time = m_time;
+    snapshot.state = m_currentState;
+    snapshot.animIndex = m_currentAnimIndex;
+    snapshot.animFrame = m_currentAnimFrame;
+    snapshot.color = m_color;
+    snapshot.hitCapsules = m_hitCapsules;
+    snapshot.alive = m_isAlive;
+    snapshot.showHitbox = m_showDebugHitbox;
+    return snapshot;
+}
+
+void Boss::DrawSnapshot(const BossSnapshot& snapshot, const ModelAsset& asset) {
+    if (!snapshot.alive) return;
     
     // Draw 3D model if loaded
-    if (m_modelLoaded) {
-        // Get model bounds to calculate proper positioning
-        BoundingBox bounds = GetModelBoundingBox(m_model);
-        
-        // Calculate scale - the hitbox is in game units which are much larger than model units
-        // Use a reasonable scale factor instead of trying to match the huge hitbox
-        // A scale of ~10-15 should make the boss visible but not enormous
-        float uniformScale = 12.0f;  // Fixed scale for now, can adjust based on visual testing
-        
-        Vector3 modelScale = {uniformScale, uniformScale, uniformScale};
+    if (asset.loaded) {
+        // The hitbox is in game units which are much larger than model units,
+        // so the model uses a fixed scale instead of trying to match it
+        Vector3 modelScale = {BOSS_MODEL_SCALE, BOSS_MODEL_SCALE, BOSS_MODEL_SCALE};
         
-        // Adjust position to place model on ground
-        // The boss hitbox center is at m_position (200, halfHeight + 5.0f, 0)
-        // We want the model's bottom to be above y=0 to account for arena visual thickness
-        Vector3 drawPosition = m_position;
-        
-        // Calculate where the bottom of the scaled model would be relative to its center
-        float scaledModelBottom = bounds.min.y * uniformScale;
-        
-        // The model should be drawn so its bottom is above ground (y=5.0) to clear arena thickness
-        // Since the model's center is at origin, we need to lift it by -scaledModelBottom + 5.0
-        drawPosition.y = -scaledModelBottom + 5.0f;
-        
-        // Keep X and Z from m_position for horizontal placement
-        drawPosition.x = m_position.x;
-        drawPosition.z = m_position.z;
+        // Lift the model so its bottom (measured at load) stands on the floor;
+        // the hit capsules are placed the same way
+        Vector3 drawPosition = GetModelPosition(snapshot.position, asset.hitboxes.modelBottom);
         
         // Draw model with rotation
-        DrawModelEx(
-            m_model,
+        Gfx::DrawModelEx(
+            asset.model,
             drawPosition,
             {0.0f, 1.0f, 0.0f},  // Rotate around Y axis
-            m_currentRotation,
+            snapshot.rotation,
             modelScale,
             WHITE
         );
     } else {
         // Fallback: Draw simple cube if model not loaded
-        DrawCube(m_position, m_size.x, m_size.y, m_size.z, m_color);
-        DrawCubeWires(m_position, m_size.x, m_size.y, m_size.z, DARKGREEN);
+        const Vector3& size = snapshot.size;
+        Gfx::DrawCube(snapshot.position, size.x, size.y, size.z, snapshot.color);
+        Gfx::DrawCubeWires(snapshot.position, size.x, size.y, size.z, DARKGREEN);
     }
     
     // Draw debug hitbox (toggle with key)
-    if (m_showDebugHitbox) {
-        AABB hitbox = GetAABB();
+    if (snapshot.showHitbox) {
+        AABB hitbox = AABB::FromCenter(snapshot.position, Vector3Scale(snapshot.size, 0.5f));
         Vector3 hitboxSize = Vector3Subtract(hitbox.max, hitbox.min);
         Vector3 hitboxCenter = hitbox.GetCenter();
-        DrawCubeWires(hitboxCenter, hitboxSize.x, hitboxSize.y, hitboxSize.z, YELLOW);
+        Gfx::DrawCubeWires(hitboxCenter, hitboxSize.x, hitboxSize.y, hitboxSize.z, YELLOW);
+        for (uint32_t i = 0; i < snapshot.hitCapsules.count; ++i) {
+            Capsule capsule = snapshot.hitCapsules.Get(i);
+            Gfx::DrawCapsuleWires(capsule.start, capsule.end, capsule.radius, BOSS_CAPSULE_SLICES, BOSS_CAPSULE_RINGS, RED);
+        }
     }
 }
 
@@ -340,14 +372,15 @@ void Boss::TakeDamage(float damage) {
 }
 
 bool Boss::CanAttack() const {
-    return m_attackCooldown <= 0;
+    return m_timers.GetNow() >= m_attackReadyTick;
 }
 
 void Boss::ResetAttackCooldown() {
-    auto& config = GameConfig::GetInstance();
-    float random = static_cast<float>(GetRandomValue(0, 100)) / 100.0f;
-    m_attackCooldown = config.bossAttackCooldownMin + 
-                       random * (config.bossAttackCooldownMax - config.bossAttackCooldownMin);
+    const GameConfig& config = m_config;
+    float random = static_cast<float>(m_random.Range(0, 100)) / 100.0f;
+    float cooldown = config.bossAttackCooldownMin + 
+                     random * (config.bossAttackCooldownMax - config.bossAttackCooldownMin);
+    m_attackReadyTick = m_timers.GetNow() + TimerWheel::SecondsToTicks(cooldown);
 }
 
 AABB Boss::GetAABB() const {
@@ -370,25 +403,24 @@ bool Boss::CheckCollisionWithPlayer(const Player& player) const {
     return GetAABB().Intersects(player.GetAABB());
 }
 
-std::string Boss::GetTimeString() const {
+const char* Boss::FormatTime(char* buffer, size_t size) const {
     int minutes = static_cast<int>(m_time / 60);
     int seconds = static_cast<int>(m_time) % 60;
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%d:%02d", minutes, seconds);
-    return std::string(buffer);
+    snprintf(buffer, size, "%d:%02d", minutes, seconds);
+    return buffer;
 }
 
-void Boss::MoveTowards(const Vector3& target, float deltaTime) {
-    Vector3 direction = Vector3Subtract(target, m_position);
-    direction.y = 0; // on ne change pas la hauteur
+void Boss::MoveTowards(const Vector3& target, Vector3 direction, float deltaTime) {
+    Vector3 offset = Vector3Subtract(target, m_position);
+    offset.y = 0; // on ne change pas la hauteur
 
-    float distance = Vector3Length(direction);
+    float distance = Vector3Length(offset);
     if (distance > 0.1f) { // éviter division par 0
-        Vector3 moveDir = Vector3Scale(Vector3Normalize(direction), m_moveSpeed * deltaTime);
+        Vector3 moveDir = Vector3Scale(direction, m_moveSpeed * deltaTime);
         
         // ne pas dépasser la cible
         if (Vector3Length(moveDir) > distance) {
-            moveDir = Vector3Scale(Vector3Normalize(direction), distance);
+            moveDir = Vector3Scale(direction, distance);
         }
 
         ApplyPushback(moveDir);
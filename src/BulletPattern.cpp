@@ -0,0 +1,225 @@
+#include "BulletPattern.hpp"
+#include "Config.hpp"
+#include "JsonReader.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace TimeMaster {
+
+namespace {
+
+bool ParseShape(const std::string& name, PatternShape& out) {
+    if (name == "fan")         { out = PatternShape::FAN;         return true; }
+    if (name == "ring")        { out = PatternShape::RING;        return true; }
+    if (name == "spiral")      { out = PatternShape::SPIRAL;      return true; }
+    if (name == "aimed_burst") { out = PatternShape::AIMED_BURST; return true; }
+    return false;
+}
+
+Color ParseColor(const JsonValue* value, Color fallback) {
+    if (!value || !value->IsArray() || value->items.size() < 3) return fallback;
+    auto channel = [&](size_t i, unsigned char defaultValue) {
+        if (i >= value->items.size() || !value->items[i].IsNumber()) return defaultValue;
+        return static_cast<unsigned char>(std::clamp(value->items[i].number, 0.0, 255.0));
+    };
+    return {channel(0, fallback.r), channel(1, fallback.g), channel(2, fallback.b), channel(3, 255)};
+}
+
+float Radians(double degrees) {
+    return static_cast<float>(degrees) * DEG2RAD;
+}
+
+/**
+ * @brief Read one volley; shape-specific defaults apply to missing fields
+ */
+bool ParseVolley(const JsonValue& json, PatternVolley& out) {
+    if (!ParseShape(json.GetString("shape", ""), out.shape)) {
+        return false;
+    }
+    double defaultArc = out.shape == PatternShape::AIMED_BURST ? 10.0 : 60.0;
+    double defaultTurn = out.shape == PatternShape::SPIRAL ? 15.0 : 0.0;
+
+    out.count = std::clamp(static_cast<int>(json.GetNumber("count", 1)), 1, MAX_PATTERN_SHOT_BULLETS);
+    out.arc = Radians(json.GetNumber("arc", defaultArc));
+    out.angle = Radians(json.GetNumber("angle", 0.0));
+    out.turn = Radians(json.GetNumber("turn", defaultTurn));
+    out.delay = std::max(0.0f, static_cast<float>(json.GetNumber("delay", 0.0)));
+    out.interval = std::max(MIN_PATTERN_INTERVAL, static_cast<float>(json.GetNumber("interval", 0.1)));
+    out.shots = std::max(1, static_cast<int>(json.GetNumber("shots", 1)));
+    out.speed = static_cast<float>(json.GetNumber("speed", GameConfig().projectileSpeed));
+    out.radius = static_cast<float>(json.GetNumber("radius", PROJECTILE_RADIUS));
+    out.color = ParseColor(json.Find("color"), ORANGE);
+    return true;
+}
+
+} // namespace
+
+BulletPatternLibrary::BulletPatternLibrary() {
+    Clear();
+}
+
+void BulletPatternLibrary::Clear() {
+    m_volleys.clear();
+    m_patterns.clear();
+    std::fill(std::begin(m_bindings), std::end(m_bindings), -1);
+}
+
+bool BulletPatternLibrary::LoadFile(const char* path) {
+    Clear();
+
+    JsonValue root;
+    std::string error;
+    if (!LoadJsonFile(path, root, &error)) {
+        TM_LOG_WARNING(ASSETS, "Failed to load bullet patterns %s (%s) - boss fires single shots", path, error.c_str());
+        return false;
+    }
+
+    const JsonValue* patterns = root.Find("patterns");
+    if (!patterns || !patterns->IsObject()) {
+        TM_LOG_WARNING(ASSETS, "%s has no \"patterns\" object - boss fires single shots", path);
+        return false;
+    }
+
+    for (size_t p = 0; p < patterns->items.size(); ++p) {
+        const JsonValue& volleys = patterns->items[p];
+        if (!volleys.IsArray()) {
+            TM_LOG_WARNING(ASSETS, "Bullet pattern %s: expected an array of volleys", patterns->keys[p].c_str());
+            continue;
+        }
+
+        BulletPattern pattern;
+        pattern.name = patterns->keys[p];
+        pattern.firstVolley = static_cast<uint32_t>(m_volleys.size());
+        for (const JsonValue& json : volleys.items) {
+            PatternVolley volley;
+            if (ParseVolley(json, volley)) {
+                m_volleys.push_back(volley);
+            } else {
+                TM_LOG_WARNING(ASSETS, "Bullet pattern %s: skipping volley with unknown shape", pattern.name.c_str());
+            }
+        }
+        pattern.volleyCount = static_cast<uint32_t>(m_volleys.size()) - pattern.firstVolley;
+        m_patterns.push_back(pattern);
+    }
+
+    if (const JsonValue* bindings = root.Find("bindings")) {
+        for (size_t b = 0; b < bindings->keys.size(); ++b) {
+            const char* stateName = bindings->keys[b].c_str();
+            int state = -1;
+            for (int s = 0; s < BOSS_STATE_COUNT; ++s) {
+                if (std::strcmp(GetBossStateName(static_cast<BossState>(s)), stateName) == 0) state = s;
+            }
+            int pattern = bindings->items[b].IsString() ? Find(bindings->items[b].string.c_str()) : -1;
+            if (state < 0 || pattern < 0) {
+                TM_LOG_WARNING(ASSETS, "Bullet patterns: ignoring binding %s", stateName);
+                continue;
+            }
+            m_bindings[state] = pattern;
+        }
+    }
+
+    TM_LOG_INFO(ASSETS, "Bullet patterns loaded: %d patterns, %d volleys",
+                static_cast<int>(m_patterns.size()), static_cast<int>(m_volleys.size()));
+    return true;
+}
+
+int BulletPatternLibrary::Find(const char* name) const {
+    for (size_t i = 0; i < m_patterns.size(); ++i) {
+        if (m_patterns[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+BulletPatternRunner::BulletPatternRunner()
+    : m_emitters{}
+    , m_emitterCount(0) {
+}
+
+void BulletPatternRunner::Start(const BulletPatternLibrary& library, int pattern, Vector3 origin, Vector3 target) {
+    const BulletPattern& definition = library.GetPattern(pattern);
+    const PatternVolley* volleys = library.GetVolleys(definition);
+    float aim = atan2f(target.z - origin.z, target.x - origin.x);
+
+    for (uint32_t v = 0; v < definition.volleyCount; ++v) {
+        if (m_emitterCount == MAX_PATTERN_EMITTERS) {
+            TM_LOG_WARNING(BOSS, "Bullet pattern %s: emitter limit reached", definition.name.c_str());
+            return;
+        }
+        const PatternVolley& volley = volleys[v];
+        m_emitters[m_emitterCount++] = {&volley, volley.delay, aim + volley.angle, volley.shots};
+    }
+}
+
+void BulletPatternRunner::Update(float deltaTime, Vector3 origin, Vector3 target, BulletStore& store) {
+    PROFILE_ZONE("Game::EmitBulletPatterns");
+
+    int i = 0;
+    while (i < m_emitterCount) {
+        PatternEmitter& emitter = m_emitters[i];
+        while (emitter.shotsLeft > 0 && emitter.timer < deltaTime) {
+            Fire(emitter, emitter.timer, origin, target, store);
+            emitter.shotsLeft--;
+            emitter.timer += emitter.volley->interval;
+        }
+        emitter.timer -= deltaTime;
+
+        if (emitter.shotsLeft == 0) {
+            m_emitters[i] = m_emitters[--m_emitterCount];
+        } else {
+            ++i;
+        }
+    }
+}
+
+void BulletPatternRunner::Restore(const PatternEmitter* emitters, int count) {
+    m_emitterCount = std::min(count, MAX_PATTERN_EMITTERS);
+    std::copy(emitters, emitters + m_emitterCount, m_emitters);
+}
+
+void BulletPatternRunner::Fire(PatternEmitter& emitter, float shotTime, Vector3 origin, Vector3 target, BulletStore& store) {
+    const PatternVolley& volley = *emitter.volley;
+
+    float dx = target.x - origin.x;
+    float dz = target.z - origin.z;
+    float yaw = emitter.baseAngle;
+    if (volley.shape == PatternShape::AIMED_BURST) {
+        yaw = atan2f(dz, dx) + volley.angle;
+    }
+    emitter.baseAngle += volley.turn;
+
+    // Closed shapes split the full circle, open ones span their arc end to end
+    float step;
+    float first;
+    if (volley.shape == PatternShape::RING || volley.shape == PatternShape::SPIRAL) {
+        step = 2.0f * PI / static_cast<float>(volley.count);
+        first = yaw;
+    } else {
+        step = volley.count > 1 ? volley.arc / static_cast<float>(volley.count - 1) : 0.0f;
+        first = volley.count > 1 ? yaw - volley.arc / 2.0f : yaw;
+    }
+
+    float pitch = atan2f(target.y - origin.y, sqrtf(dx * dx + dz * dz));
+    float horizontal = cosf(pitch) * volley.speed;
+    float vertical = sinf(pitch) * volley.speed;
+
+    uint32_t granted;
+    Bullet* bullets = store.Append(static_cast<uint32_t>(volley.count), granted);
+    for (uint32_t b = 0; b < granted; ++b) {
+        float angle = first + step * static_cast<float>(b);
+        Vector3 velocity = {cosf(angle) * horizontal, vertical, sinf(angle) * horizontal};
+
+        // The bullet update moves everything a full tick; start late shots
+        // behind the origin by the part of the tick they did not fly
+        bullets[b].position = {origin.x - velocity.x * shotTime,
+                               origin.y - velocity.y * shotTime,
+                               origin.z - velocity.z * shotTime};
+        bullets[b].velocity = velocity;
+        bullets[b].radius = volley.radius;
+        bullets[b].color = volley.color;
+    }
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,140 @@
+#include "BulletStore.hpp"
+#include "Config.hpp"
+#include "Replication.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace TimeMaster {
+
+namespace {
+/**
+ * @brief A bullet in a rewind frame: the position `age` ticks back in
+ * REPLICATION_POSITION_STEP fixed point (room for any arena bullet moved
+ * back a keyframe interval) and the velocity as replication quantizes it
+ */
+struct RewindBullet {
+    int16_t x, y, z;
+    int16_t velocityX, velocityY, velocityZ;
+    float radius;
+    Color color;
+};
+
+static_assert(sizeof(RewindBullet) <= sizeof(Bullet), "GetMaxStateWords counts full bullets");
+
+constexpr float REWIND_TICK_SECONDS = 1.0f / SIMULATION_TICK_RATE;
+
+int16_t ToFixed(float value) {
+    float steps = std::round(value / REPLICATION_POSITION_STEP);
+    return static_cast<int16_t>(std::max(-32767.0f, std::min(steps, 32767.0f)));
+}
+}
+
+BulletStore::BulletStore(uint32_t capacity)
+    : m_bullets(capacity)
+    , m_dead(capacity, 0)
+    , m_count(0) {
+}
+
+Bullet* BulletStore::Append(uint32_t count, uint32_t& granted) {
+    granted = std::min(count, GetCapacity() - m_count);
+    Bullet* first = m_bullets.data() + m_count;
+    std::fill_n(m_dead.begin() + m_count, granted, 0);
+    m_count += granted;
+    return first;
+}
+
+void BulletStore::Update(uint32_t begin, uint32_t end, float deltaTime,
+                         const Vector3* targets, uint32_t targetCount, float targetRadius, uint8_t* hits) {
+    for (uint32_t i = begin; i < end; ++i) {
+        Bullet& bullet = m_bullets[i];
+        bullet.position.x += bullet.velocity.x * deltaTime;
+        bullet.position.y += bullet.velocity.y * deltaTime;
+        bullet.position.z += bullet.velocity.z * deltaTime;
+
+        // Same bounds as Projectile::Update
+        bool outOfBounds = std::fabs(bullet.position.x) > ARENA_SIZE ||
+                           bullet.position.y < 0 ||
+                           bullet.position.y > 200 ||
+                           std::fabs(bullet.position.z) > ARENA_SIZE;
+
+        uint8_t hit = 0;
+        float reach = bullet.radius + targetRadius;
+        for (uint32_t t = 0; t < targetCount && !outOfBounds && hit == 0; ++t) {
+            float dx = bullet.position.x - targets[t].x;
+            float dy = bullet.position.y - targets[t].y;
+            float dz = bullet.position.z - targets[t].z;
+            if (dx * dx + dy * dy + dz * dz < reach * reach) {
+                hit = static_cast<uint8_t>(t + 1);
+            }
+        }
+
+        hits[i] = hit;
+        m_dead[i] = outOfBounds || hit != 0;
+    }
+}
+
+void BulletStore::RemoveDead() {
+    uint32_t i = 0;
+    while (i < m_count) {
+        if (m_dead[i]) {
+            --m_count;
+            m_bullets[i] = m_bullets[m_count];
+            m_dead[i] = m_dead[m_count];
+        } else {
+            ++i;
+        }
+    }
+}
+
+void BulletStore::Write(StateWriter& writer) const {
+    writer.Write(m_count);
+    writer.WriteArray(m_bullets.data(), m_count);
+}
+
+void BulletStore::WriteRewind(StateWriter& writer, uint32_t age) const {
+    writer.Write(m_count);
+    writer.Write(age);
+    const float seconds = static_cast<float>(age) * REWIND_TICK_SECONDS;
+    for (uint32_t i = 0; i < m_count; ++i) {
+        // Moved back along the exact velocity, so it stays put while the bullet flies
+        const Bullet& bullet = m_bullets[i];
+        writer.Write(RewindBullet{ToFixed(bullet.position.x - bullet.velocity.x * seconds),
+                                  ToFixed(bullet.position.y - bullet.velocity.y * seconds),
+                                  ToFixed(bullet.position.z - bullet.velocity.z * seconds),
+                                  QuantizeSpeed(bullet.velocity.x), QuantizeSpeed(bullet.velocity.y),
+                                  QuantizeSpeed(bullet.velocity.z), bullet.radius, bullet.color});
+    }
+}
+
+bool BulletStore::Read(StateReader& reader) {
+    uint32_t count = 0;
+    bool ok = reader.Read(count) && count <= GetCapacity() &&
+              reader.ReadArray(m_bullets.data(), count);
+    m_count = ok ? count : 0;
+    std::fill_n(m_dead.begin(), m_count, 0);
+    return ok;
+}
+
+bool BulletStore::ReadRewind(StateReader& reader) {
+    uint32_t count = 0;
+    uint32_t age = 0;
+    m_count = 0;
+    if (!reader.Read(count) || count > GetCapacity() || !reader.Read(age)) return false;
+
+    const float seconds = static_cast<float>(age) * REWIND_TICK_SECONDS;
+    for (uint32_t i = 0; i < count; ++i) {
+        RewindBullet saved;
+        if (!reader.Read(saved)) return false;
+        Vector3 velocity = {GetReplicatedSpeed(saved.velocityX), GetReplicatedSpeed(saved.velocityY),
+                            GetReplicatedSpeed(saved.velocityZ)};
+        m_bullets[i] = {{saved.x * REPLICATION_POSITION_STEP + velocity.x * seconds,
+                         saved.y * REPLICATION_POSITION_STEP + velocity.y * seconds,
+                         saved.z * REPLICATION_POSITION_STEP + velocity.z * seconds},
+                        velocity, saved.radius, saved.color};
+    }
+    m_count = count;
+    std::fill_n(m_dead.begin(), m_count, 0);
+    return true;
+}
+
+} // namespace TimeMaster
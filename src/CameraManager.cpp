@@ -1,8 +1,8 @@
 #include "CameraManager.hpp"
 #include "Config.hpp"
+#include "Log.hpp"
 #include "raymath.h"
 #include <cmath>
-#include <cstdio>
 
 constexpr float ARENA_RADIUS = 375.0f;
 constexpr Vector2 ARENA_CENTER = { 60.0f, 10.0f };
@@ -15,8 +15,9 @@ CameraManager::CameraManager()
     , m_angleAroundPlayer(0.0f)
     , m_pitch(20.0f)
     , m_isThirdPerson(true)
-    , m_mouseSensitivity(0.15f)
+    , m_mouseSensitivity(GameConfig().mouseSensitivity)
     , m_cursorLocked(false)
+    , m_debugLogCounter(0)
 {
     Reset();
 }
@@ -38,14 +39,16 @@ void CameraManager::Reset() {
     m_pitch = 20.0f;
 }
 
-void CameraManager::UpdateThirdPerson(Vector3 playerPosition, float deltaTime) {
+void CameraManager::UpdateThirdPerson(Vector3 playerPosition, const InputFrame& input, float deltaTime) {
+    (void)deltaTime;
+
     if (!m_isThirdPerson) {
         return;
     }
 
-    HandleMouseInput(deltaTime);
+    HandleMouseInput(input);
 
-    float wheel = GetMouseWheelMove();
+    float wheel = input.zoom;
     if (wheel != 0) {
         AdjustDistance(-wheel * 20.0f);
     }
@@ -90,22 +93,18 @@ void CameraManager::ClampCameraToArena()
     }
 }
 
-void CameraManager::HandleMouseInput(float deltaTime) {
-    (void)deltaTime;
-
-    Vector2 mouseDelta = GetMouseDelta();
+void CameraManager::HandleMouseInput(const InputFrame& input) {
+    Vector2 mouseDelta = {input.lookX, input.lookY};
     mouseDelta.x *= 0.01f;
     mouseDelta.y *= 0.01f;
 
-    static int frameCount = 0;
-    frameCount++;
-    if (frameCount % 60 == 0) {
-        printf("Camera: Delta=(%.2f, %.2f) | Angle=%.2f | Pitch=%.2f\n", 
-               mouseDelta.x, mouseDelta.y, m_angleAroundPlayer, m_pitch);
-        fflush(stdout);
+    m_debugLogCounter++;
+    if (m_debugLogCounter % 60 == 0) {
+        TM_LOG_DEBUG(CAMERA, "Delta=(%.2f, %.2f) | Angle=%.2f | Pitch=%.2f",
+                     mouseDelta.x, mouseDelta.y, m_angleAroundPlayer, m_pitch);
     }
 
-    float sensitivity = GameConfig::GetInstance().mouseSensitivity * 1000.0f;
+    float sensitivity = m_mouseSensitivity * 1000.0f;
 
     m_angleAroundPlayer -= mouseDelta.x * sensitivity;
 
@@ -118,15 +117,23 @@ void CameraManager::HandleMouseInput(float deltaTime) {
 }
 
 Vector3 CameraManager::GetForwardDirection() const {
+    return GetForwardDirection(m_angleAroundPlayer);
+}
+
+Vector3 CameraManager::GetRightDirection() const {
+    return GetRightDirection(m_angleAroundPlayer);
+}
+
+Vector3 CameraManager::GetForwardDirection(float angleAroundPlayer) {
     Vector3 forward;
-    forward.x = sinf(m_angleAroundPlayer * DEG2RAD);
+    forward.x = sinf(angleAroundPlayer * DEG2RAD);
     forward.y = 0.0f;
-    forward.z = cosf(m_angleAroundPlayer * DEG2RAD);
+    forward.z = cosf(angleAroundPlayer * DEG2RAD);
     return Vector3Normalize(forward);
 }
 
-Vector3 CameraManager::GetRightDirection() const {
-    Vector3 forward = GetForwardDirection();
+Vector3 CameraManager::GetRightDirection(float angleAroundPlayer) {
+    Vector3 forward = GetForwardDirection(angleAroundPlayer);
     Vector3 up = {0.0f, 1.0f, 0.0f};
     return Vector3Normalize(Vector3CrossProduct(forward, up));
 }
@@ -144,14 +151,7 @@ void CameraManager::AdjustDistance(float delta) {
 }
 
 void CameraManager::ToggleCursorLock() {
-    if (IsCursorHidden()) {
-        EnableCursor();
-        m_cursorLocked = false;
-    } else {
-        DisableCursor();
-        GetMouseDelta();
-        m_cursorLocked = true;
-    }
+    m_cursorLocked = !m_cursorLocked;
 }
 
 bool CameraManager::IsCursorLocked() const {
@@ -0,0 +1,229 @@
+#include "DeterminismTest.hpp"
+#include "Game.hpp"
+#include "GameAssets.hpp"
+#include "Input.hpp"
+#include "Random.hpp"
+#include "StateHash.hpp"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr float DETERMINISM_DELTA_TIME = 1.0f / 60.0f;
+constexpr int REWIND_PERIOD_TICKS = 600;   // Hold rewind for the last REWIND_HOLD_TICKS of every period
+constexpr int REWIND_HOLD_TICKS = 30;
+constexpr int FILE_VERSION = 1;
+
+#ifdef NDEBUG
+constexpr const char* BUILD_TYPE = "release";
+#else
+constexpr const char* BUILD_TYPE = "debug";
+#endif
+
+/**
+ * @brief Next frame of the scripted input stream
+ * Drawn from its own generator and kept to integer-derived values, so the
+ * stream itself is identical in every build.
+ */
+InputFrame NextInput(Random& random, const Game& game, int tick) {
+    InputFrame input = {0, 0, 0.0f, 0.0f, 0.0f};
+    if (game.GetState() != GameState::PLAYING) {
+        input.pressed = INPUT_CONFIRM;   // Restart after game over / victory
+        return input;
+    }
+
+    uint32_t roll = random.NextU32();
+    input.held = roll & (INPUT_FORWARD | INPUT_BACKWARD | INPUT_LEFT | INPUT_RIGHT | INPUT_RUN);
+    if ((roll >> 8) % 8 == 0)   input.pressed |= INPUT_SHOOT;
+    if ((roll >> 11) % 32 == 0) input.pressed |= INPUT_MELEE;
+    if (tick % REWIND_PERIOD_TICKS >= REWIND_PERIOD_TICKS - REWIND_HOLD_TICKS) {
+        input.held |= INPUT_REWIND;
+    }
+    input.lookX = static_cast<float>(static_cast<int>((roll >> 16) % 21) - 10) * 0.5f;
+    input.lookY = static_cast<float>(static_cast<int>((roll >> 24) % 5) - 2) * 0.5f;
+    return input;
+}
+
+/**
+ * @brief One game fed by its own copy of the input stream
+ */
+struct Run {
+    Game game;
+    Random input;
+
+    Run(const GameAssets& assets, uint64_t seed, MatchMode mode)
+        : game(assets, seed), input(seed ^ 0x1f2e3d4c5b6a7988ull) {
+        game.SetMatchMode(mode);
+        game.StartMatch();
+    }
+
+    StateChecksum Step(int tick) {
+        game.Update(NextInput(input, game, tick), DETERMINISM_DELTA_TIME);
+        return game.ComputeChecksum();
+    }
+};
+
+void PrintChecksum(FILE* file, int tick, const StateChecksum& checksum) {
+    std::fprintf(file, "%d %016" PRIx64, tick, checksum.combined);
+    for (uint64_t field : checksum.fields) {
+        std::fprintf(file, " %016" PRIx64, field);
+    }
+    std::fprintf(file, "\n");
+}
+
+bool ReadChecksum(FILE* file, int& tick, StateChecksum& checksum) {
+    if (std::fscanf(file, "%d %" SCNx64, &tick, &checksum.combined) != 2) return false;
+    for (uint64_t& field : checksum.fields) {
+        if (std::fscanf(file, "%" SCNx64, &field) != 1) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Print the divergence at a tick
+ * @return true if the checksums differ
+ */
+bool ReportDivergence(int tick, const StateChecksum& expected, const StateChecksum& actual,
+                      const char* expectedName, const char* actualName) {
+    if (expected.combined == actual.combined) return false;
+
+    std::printf("DIVERGED at tick %d\n", tick);
+    for (int i = 0; i < STATE_FIELD_COUNT; ++i) {
+        if (expected.fields[i] != actual.fields[i]) {
+            std::printf("  %-20s %s %016" PRIx64 "  %s %016" PRIx64 "\n",
+                        GetStateFieldName(static_cast<StateField>(i)),
+                        expectedName, expected.fields[i], actualName, actual.fields[i]);
+        }
+    }
+    return true;
+}
+
+double NowUs() {
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+MatchMode GetMode(const DeterminismOptions& options) {
+    return options.horde ? MatchMode::HORDE : MatchMode::BOSS;
+}
+
+int RunSideBySide(const DeterminismOptions& options, const GameAssets& assets) {
+    auto a = std::make_unique<Run>(assets, options.seed, GetMode(options));
+    auto b = std::make_unique<Run>(assets, options.seed, GetMode(options));
+
+    double checksumUs = 0.0;
+    for (int tick = 1; tick <= options.ticks; ++tick) {
+        StateChecksum first = a->Step(tick);
+        double start = NowUs();
+        StateChecksum second = b->Step(tick);
+        checksumUs += NowUs() - start;
+        if (ReportDivergence(tick, first, second, "run A", "run B")) {
+            return 1;
+        }
+    }
+    std::printf("Determinism OK: %d ticks, two runs identical (update + checksum %.1f us/tick)\n",
+                options.ticks, checksumUs / options.ticks);
+    return 0;
+}
+
+int Record(const DeterminismOptions& options, const GameAssets& assets) {
+    FILE* file = std::fopen(options.recordPath.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Failed to open %s for writing\n", options.recordPath.c_str());
+        return 2;
+    }
+    std::fprintf(file, "# time_master determinism v%d, %s build, compiler %s\n", FILE_VERSION, BUILD_TYPE, __VERSION__);
+    std::fprintf(file, "seed %" PRIu64 " ticks %d fields %d mode %s\n", options.seed, options.ticks, STATE_FIELD_COUNT,
+                 options.horde ? "horde" : "boss");
+
+    auto run = std::make_unique<Run>(assets, options.seed, GetMode(options));
+    for (int tick = 1; tick <= options.ticks; ++tick) {
+        PrintChecksum(file, tick, run->Step(tick));
+    }
+    if (std::fclose(file) != 0) {
+        std::fprintf(stderr, "Failed to write %s\n", options.recordPath.c_str());
+        return 2;
+    }
+    std::printf("Recorded %d tick checksums to %s\n", options.ticks, options.recordPath.c_str());
+    return 0;
+}
+
+int Verify(const DeterminismOptions& options, const GameAssets& assets) {
+    FILE* file = std::fopen(options.verifyPath.c_str(), "r");
+    if (!file) {
+        std::fprintf(stderr, "Failed to open %s\n", options.verifyPath.c_str());
+        return 2;
+    }
+
+    char header[256] = {};
+    uint64_t seed = 0;
+    int ticks = 0;
+    int fields = 0;
+    if (!std::fgets(header, sizeof(header), file) ||
+        std::fscanf(file, " seed %" SCNu64 " ticks %d fields %d", &seed, &ticks, &fields) != 3) {
+        std::fprintf(stderr, "%s is not a determinism recording\n", options.verifyPath.c_str());
+        std::fclose(file);
+        return 2;
+    }
+    // Recordings from before horde mode have no mode and played the boss fight
+    char mode[16] = "boss";
+    std::fscanf(file, " mode %15s", mode);
+    if (fields != STATE_FIELD_COUNT) {
+        std::fprintf(stderr, "%s hashes %d state fields, this build %d - re-record it\n",
+                     options.verifyPath.c_str(), fields, STATE_FIELD_COUNT);
+        std::fclose(file);
+        return 2;
+    }
+    std::printf("Verifying against %s", header);
+    std::printf("  this build: %s, compiler %s\n", BUILD_TYPE, __VERSION__);
+
+    auto run = std::make_unique<Run>(assets, seed, std::strcmp(mode, "horde") == 0 ? MatchMode::HORDE : MatchMode::BOSS);
+    int result = 0;
+    for (int tick = 1; tick <= ticks; ++tick) {
+        int recordedTick = 0;
+        StateChecksum expected;
+        if (!ReadChecksum(file, recordedTick, expected) || recordedTick != tick) {
+            std::fprintf(stderr, "%s: bad or missing line for tick %d\n", options.verifyPath.c_str(), tick);
+            result = 2;
+            break;
+        }
+        if (ReportDivergence(tick, expected, run->Step(tick), "recorded", "this build")) {
+            result = 1;
+            break;
+        }
+    }
+    std::fclose(file);
+    if (result == 0) {
+        std::printf("Determinism OK: %d ticks match the recording\n", ticks);
+    }
+    return result;
+}
+
+} // namespace
+
+int RunDeterminismTest(const DeterminismOptions& options) {
+    if (!options.recordPath.empty() && !options.verifyPath.empty()) {
+        std::fprintf(stderr, "--record and --verify are exclusive\n");
+        return 2;
+    }
+
+    // Models only affect animation playback, which must then match between
+    // runs anyway; headless keeps the test runnable without a display
+    GameAssets assets;
+    assets.LoadData();
+
+    if (!options.verifyPath.empty()) {
+        return Verify(options, assets);
+    }
+    if (!options.recordPath.empty()) {
+        return Record(options, assets);
+    }
+    return RunSideBySide(options, assets);
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,178 @@
+#include "FlightRecorder.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace TimeMaster {
+
+namespace {
+
+const char* GetGameStateName(GameState state) {
+    switch (state) {
+        case GameState::MENU:      return "MENU";
+        case GameState::SETTINGS:  return "SETTINGS";
+        case GameState::PLAYING:   return "PLAYING";
+        case GameState::PAUSED:    return "PAUSED";
+        case GameState::GAME_OVER: return "GAME_OVER";
+        case GameState::VICTORY:   return "VICTORY";
+    }
+    return "?";
+}
+
+} // namespace
+
+float FlightRecorder::s_hitchThresholdMs = 33.0f;
+
+FlightRecorder::FlightRecorder()
+    : m_frames(FLIGHT_RECORDER_FRAMES)
+    , m_frameIndex(0)
+    , m_pendingSample{}
+    , m_lastDumpTime(0)
+    , m_dumpFrames(FLIGHT_RECORDER_FRAMES)
+    , m_dumpCount(0)
+    , m_dumpHitchFrame(0)
+    , m_dumpHitchMs(0.0f)
+    , m_dumpThresholdMs(0.0f)
+    , m_dumpRandomState{}
+    , m_dumpZoneNames{}
+    , m_dumpZoneCount(0)
+    , m_dumpPending(false)
+    , m_stop(false)
+    , m_writerBusy(false) {
+    m_pendingSample.state = GameState::MENU;
+    m_pendingSample.bossState = BossState::IDLE;
+    
+    // Zone timings must be collected every frame, not only with the overlay open
+    Profiler::GetInstance().SetBackgroundTiming(true);
+    
+    m_writer = std::thread(&FlightRecorder::WriterLoop, this);
+}
+
+FlightRecorder::~FlightRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+FlightRecorder& FlightRecorder::GetInstance() {
+    static FlightRecorder instance;
+    return instance;
+}
+
+void FlightRecorder::EndFrame(const Profiler& profiler) {
+    FlightFrame& frame = m_frames[m_frameIndex % FLIGHT_RECORDER_FRAMES];
+    frame.frameIndex = m_frameIndex;
+    frame.frameMs = profiler.GetFrameTime(0);
+    frame.gameplay = m_pendingSample;
+    frame.zoneMs = profiler.GetLastZoneTimes();
+    m_frameIndex++;
+    
+    float thresholdMs = s_hitchThresholdMs;
+    if (frame.frameMs > thresholdMs) {
+        TriggerDump(profiler, frame.frameMs, thresholdMs);
+    }
+}
+
+void FlightRecorder::TriggerDump(const Profiler& profiler, float frameMs, float thresholdMs) {
+    uint64_t now = Profiler::Now();
+    uint64_t cooldown = static_cast<uint64_t>(FLIGHT_RECORDER_COOLDOWN_SECONDS * 1e9f);
+    if (m_lastDumpTime != 0 && now - m_lastDumpTime < cooldown) return;
+    if (m_writerBusy.load(std::memory_order_acquire)) return;
+    m_lastDumpTime = now;
+    
+    // Snapshot oldest-to-newest; the writer owns the copy until it clears m_writerBusy
+    int count = static_cast<int>(std::min<uint64_t>(m_frameIndex, FLIGHT_RECORDER_FRAMES));
+    uint64_t first = m_frameIndex - static_cast<uint64_t>(count);
+    for (int i = 0; i < count; ++i) {
+        m_dumpFrames[i] = m_frames[(first + i) % FLIGHT_RECORDER_FRAMES];
+    }
+    m_dumpCount = count;
+    m_dumpHitchFrame = m_frameIndex - 1;
+    m_dumpHitchMs = frameMs;
+    m_dumpThresholdMs = thresholdMs;
+    m_dumpRandomState = m_pendingSample.random;
+    m_dumpZoneCount = profiler.GetZoneCount();
+    for (int i = 0; i < m_dumpZoneCount; ++i) {
+        m_dumpZoneNames[i] = profiler.GetZoneName(static_cast<ZoneId>(i));
+    }
+    
+    TM_LOG_WARNING(GAME, "Hitch: frame %llu took %.1f ms (threshold %.1f ms), dumping flight recorder",
+                   static_cast<unsigned long long>(m_dumpHitchFrame), frameMs, thresholdMs);
+    
+    m_writerBusy.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dumpPending = true;
+    }
+    m_wake.notify_one();
+}
+
+void FlightRecorder::WriterLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_dumpPending || m_stop; });
+            if (!m_dumpPending) return;
+            m_dumpPending = false;
+        }
+        
+        char path[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(path, sizeof(path), "hitch_%Y%m%d_%H%M%S.json", std::localtime(&now));
+        if (WriteDump(path)) {
+            TM_LOG_INFO(GAME, "Wrote %d frames of flight recorder data to %s", m_dumpCount, path);
+        } else {
+            TM_LOG_ERROR(GAME, "Failed to write flight recorder dump %s", path);
+        }
+        m_writerBusy.store(false, std::memory_order_release);
+    }
+}
+
+bool FlightRecorder::WriteDump(const char* path) const {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+    
+    std::fprintf(file, "{\n  \"hitch_frame\": %llu,\n  \"hitch_ms\": %.3f,\n  \"threshold_ms\": %.3f,\n",
+                 static_cast<unsigned long long>(m_dumpHitchFrame), m_dumpHitchMs, m_dumpThresholdMs);
+    std::fprintf(file, "  \"rng\": {\"state\": \"0x%016llx\", \"increment\": \"0x%016llx\"},\n",
+                 static_cast<unsigned long long>(m_dumpRandomState.state),
+                 static_cast<unsigned long long>(m_dumpRandomState.increment));
+    
+    std::fprintf(file, "  \"zones\": [");
+    for (int z = 0; z < m_dumpZoneCount; ++z) {
+        std::fprintf(file, "%s\"%s\"", z > 0 ? ", " : "", m_dumpZoneNames[z]);
+    }
+    std::fprintf(file, "],\n  \"frames\": [\n");
+    
+    for (int i = 0; i < m_dumpCount; ++i) {
+        const FlightFrame& frame = m_dumpFrames[i];
+        const GameplaySample& g = frame.gameplay;
+        std::fprintf(file,
+            "    {\"frame\": %llu, \"ms\": %.3f, \"state\": \"%s\", \"boss_state\": \"%s\", "
+            "\"boss_time\": %.2f, \"player_time\": %.2f, \"player\": [%.1f, %.1f, %.1f], "
+            "\"projectiles\": %u, \"player_projectiles\": %u, \"tomatoes\": %u, "
+            "\"input\": {\"held\": %u, \"pressed\": %u, \"look\": [%.2f, %.2f], \"zoom\": %.2f}, "
+            "\"rng\": \"0x%016llx\", \"state_hash\": \"0x%016llx\", \"zone_ms\": [",
+            static_cast<unsigned long long>(frame.frameIndex), frame.frameMs,
+            GetGameStateName(g.state), GetBossStateName(g.bossState),
+            g.bossTime, g.playerTime, g.playerPosition.x, g.playerPosition.y, g.playerPosition.z,
+            g.activeProjectiles, g.activePlayerProjectiles, g.activeTomatoes,
+            g.input.held, g.input.pressed, g.input.lookX, g.input.lookY, g.input.zoom,
+            static_cast<unsigned long long>(g.random.state),
+            static_cast<unsigned long long>(g.stateHash));
+        for (int z = 0; z < m_dumpZoneCount; ++z) {
+            std::fprintf(file, "%s%.3f", z > 0 ? ", " : "", frame.zoneMs[z]);
+        }
+        std::fprintf(file, "]}%s\n", (i + 1 < m_dumpCount) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,358 @@
+#include "FlowField.hpp"
+#include "Profiler.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace TimeMaster {
+
+namespace {
+struct NeighborStep {
+    int dx;
+    int dz;
+    uint16_t cost;
+    float scale;    // Unit length along the step
+};
+
+constexpr float DIAGONAL_SCALE = 0.70710678f;
+constexpr NeighborStep NEIGHBOR_STEPS[] = {
+    {1, 0, FLOW_STRAIGHT_COST, 1.0f},
+    {-1, 0, FLOW_STRAIGHT_COST, 1.0f},
+    {0, 1, FLOW_STRAIGHT_COST, 1.0f},
+    {0, -1, FLOW_STRAIGHT_COST, 1.0f},
+    {1, 1, FLOW_DIAGONAL_COST, DIAGONAL_SCALE},
+    {1, -1, FLOW_DIAGONAL_COST, DIAGONAL_SCALE},
+    {-1, 1, FLOW_DIAGONAL_COST, DIAGONAL_SCALE},
+    {-1, -1, FLOW_DIAGONAL_COST, DIAGONAL_SCALE},
+};
+constexpr uint32_t NEIGHBOR_STEP_COUNT = sizeof(NEIGHBOR_STEPS) / sizeof(NEIGHBOR_STEPS[0]);
+
+int GetGridCoordinate(float position) {
+    int cell = static_cast<int>((position + ARENA_SIZE) * (1.0f / NAV_CELL_SIZE));
+    return std::max(0, std::min(cell, NAV_GRID_SIZE - 1));
+}
+
+float GetCellCenter(int coordinate) {
+    return -ARENA_SIZE + (static_cast<float>(coordinate) + 0.5f) * NAV_CELL_SIZE;
+}
+
+int8_t PackDirection(float component) {
+    return static_cast<int8_t>(std::lround(component * FLOW_DIRECTION_SCALE));
+}
+
+bool CanStep(const uint8_t* walkable, int x, int z, int dx, int dz) {
+    int toX = x + dx;
+    int toZ = z + dz;
+    if (toX < 0 || toX >= NAV_GRID_SIZE || toZ < 0 || toZ >= NAV_GRID_SIZE) return false;
+    if (!walkable[toZ * NAV_GRID_SIZE + toX]) return false;
+    // Diagonals may not cut a blocked corner
+    return dx == 0 || dz == 0 ||
+           (walkable[z * NAV_GRID_SIZE + toX] && walkable[toZ * NAV_GRID_SIZE + x]);
+}
+}
+
+NavGrid::NavGrid() {
+    // The arena is an open floor inside four walls: walkable where a cell's
+    // centre is clear of them. Obstacles added to the arena get marked here.
+    const float limit = ARENA_SIZE - ARENA_WALL_THICKNESS;
+    for (int z = 0; z < NAV_GRID_SIZE; ++z) {
+        for (int x = 0; x < NAV_GRID_SIZE; ++x) {
+            bool clear = std::fabs(GetCellCenter(x)) <= limit && std::fabs(GetCellCenter(z)) <= limit;
+            walkable[z * NAV_GRID_SIZE + x] = clear ? 1 : 0;
+        }
+    }
+    for (int z = 0; z < NAV_GRID_SIZE; ++z) {
+        for (int x = 0; x < NAV_GRID_SIZE; ++x) {
+            uint8_t allowed = 0;
+            for (uint32_t s = 0; s < NEIGHBOR_STEP_COUNT; ++s) {
+                if (CanStep(walkable, x, z, NEIGHBOR_STEPS[s].dx, NEIGHBOR_STEPS[s].dz)) {
+                    allowed |= static_cast<uint8_t>(1u << s);
+                }
+            }
+            steps[z * NAV_GRID_SIZE + x] = allowed;
+        }
+    }
+}
+
+bool FlowTargets::operator==(const FlowTargets& other) const {
+    if (count != other.count) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (cells[i] != other.cells[i] || ids[i] != other.ids[i]) return false;
+    }
+    return true;
+}
+
+FlowField::FlowField(const NavGrid& grid, bool keepRetired)
+    : m_grid(grid)
+    , m_published(NAV_GRID_CELLS, FlowCell{0, 0, FLOW_UNREACHED, 0, 0})
+    , m_building(NAV_GRID_CELLS, FlowCell{0, 0, FLOW_UNREACHED, 0, 0})
+    , m_retired(keepRetired ? NAV_GRID_CELLS : 0, FlowCell{0, 0, FLOW_UNREACHED, 0, 0})
+    , m_cellStates(NAV_GRID_CELLS, CellState::UNSEEN)
+    , m_next(NAV_GRID_CELLS, NO_CELL)
+    , m_previous(NAV_GRID_CELLS, NO_CELL)
+    , m_buckets{}
+    , m_openCount(0)
+    , m_cost(0)
+    , m_aimCursor(0)
+    , m_progress(0)
+    , m_phase(Phase::IDLE)
+    , m_desired{}
+    , m_publishedTargets{}
+    , m_buildTargets{}
+    , m_retiredTargets{} {
+}
+
+uint16_t FlowField::GetCell(float x, float z) {
+    return static_cast<uint16_t>(GetGridCoordinate(z) * NAV_GRID_SIZE + GetGridCoordinate(x));
+}
+
+void FlowField::SetTargets(const FlowTargets& targets) {
+    m_desired = targets;
+}
+
+void FlowField::Update(uint32_t budget) {
+    PROFILE_ZONE("FlowField::Update");
+
+    // A build runs to the end even if the targets move on, or a target that
+    // keeps changing cells would never get a field
+    if (m_phase == Phase::IDLE) {
+        if (m_desired == m_publishedTargets) return;
+        StartBuild(m_desired);
+    }
+    Step(budget);
+}
+
+void FlowField::Rebuild() {
+    StartBuild(m_desired);
+    Step(UINT32_MAX);
+}
+
+void FlowField::StartBuild(const FlowTargets& targets) {
+    m_buildTargets = targets;
+    std::fill(m_building.begin(), m_building.end(), FlowCell{0, 0, FLOW_UNREACHED, 0, 0});
+    std::fill(m_cellStates.begin(), m_cellStates.end(), CellState::UNSEEN);
+    std::fill(std::begin(m_buckets), std::end(m_buckets), NO_CELL);
+    m_openCount = 0;
+    m_cost = 0;
+    m_aimCursor = 0;
+    m_progress = 0;
+    m_phase = Phase::EXPANDING;
+
+    // The first target listed keeps a cell two of them share
+    for (uint32_t i = 0; i < targets.count; ++i) {
+        if (m_cellStates[targets.cells[i]] == CellState::UNSEEN) {
+            Push(targets.cells[i], 0, targets.ids[i]);
+        }
+    }
+}
+
+uint32_t FlowField::Step(uint32_t budget) {
+    // Everything below depends only on the work done so far, never on how it
+    // was split across ticks (Restore replays a build in one call)
+    uint32_t work = 0;
+    while (work < budget && m_phase == Phase::EXPANDING) {
+        if (m_openCount == 0) {
+            m_phase = Phase::AIMING;
+            break;
+        }
+        uint16_t cell = m_buckets[m_cost % BUCKET_COUNT];
+        if (cell == NO_CELL) {
+            m_cost++;
+            continue;
+        }
+        Unlink(cell);
+        Settle(cell);
+        work++;
+    }
+    while (work < budget && m_phase == Phase::AIMING) {
+        if (m_aimCursor == NAV_GRID_CELLS) {
+            Publish();
+            break;
+        }
+        Aim(m_aimCursor++);
+        work++;
+    }
+    m_progress += work;
+    return work;
+}
+
+void FlowField::Push(uint16_t cell, uint16_t distance, uint8_t target) {
+    if (m_cellStates[cell] == CellState::OPEN) {
+        Unlink(cell);
+    }
+    m_building[cell].distance = distance;
+    m_building[cell].target = target;
+    m_cellStates[cell] = CellState::OPEN;
+
+    uint16_t& head = m_buckets[distance % BUCKET_COUNT];
+    m_previous[cell] = NO_CELL;
+    m_next[cell] = head;
+    if (head != NO_CELL) {
+        m_previous[head] = cell;
+    }
+    head = cell;
+    m_openCount++;
+}
+
+void FlowField::Unlink(uint16_t cell) {
+    uint16_t next = m_next[cell];
+    uint16_t previous = m_previous[cell];
+    if (previous != NO_CELL) {
+        m_next[previous] = next;
+    } else {
+        m_buckets[m_building[cell].distance % BUCKET_COUNT] = next;
+    }
+    if (next != NO_CELL) {
+        m_previous[next] = previous;
+    }
+    m_openCount--;
+}
+
+void FlowField::Settle(uint16_t cell) {
+    m_cellStates[cell] = CellState::SETTLED;
+    FlowCell& settled = m_building[cell];
+    settled.inSight = IsInSight(cell) ? 1 : 0;
+    uint32_t steps = m_grid.steps[cell];
+    for (uint32_t s = 0; s < NEIGHBOR_STEP_COUNT; ++s) {
+        if (!(steps & (1u << s))) continue;
+        const NeighborStep& step = NEIGHBOR_STEPS[s];
+        uint16_t neighbor = static_cast<uint16_t>(cell + step.dz * NAV_GRID_SIZE + step.dx);
+        if (m_cellStates[neighbor] == CellState::SETTLED) continue;
+        uint32_t distance = settled.distance + step.cost;
+        if (distance < m_building[neighbor].distance) {
+            Push(neighbor, static_cast<uint16_t>(distance), settled.target);
+        }
+    }
+}
+
+uint16_t FlowField::GetTargetCell(uint8_t target) const {
+    for (uint32_t i = 0; i < m_buildTargets.count; ++i) {
+        if (m_buildTargets.ids[i] == target) return m_buildTargets.cells[i];
+    }
+    return 0;
+}
+
+bool FlowField::IsInSight(uint16_t cell) const {
+    // In sight when the cells the line back to the target crosses first are
+    // (settled before this one, as they cost less on open floor)
+    const FlowCell& seen = m_building[cell];
+    if (seen.distance == 0) return true;
+    uint16_t target = GetTargetCell(seen.target);
+    int x = cell % NAV_GRID_SIZE;
+    int z = cell / NAV_GRID_SIZE;
+    int dx = x - target % NAV_GRID_SIZE;
+    int dz = z - target / NAV_GRID_SIZE;
+    int backX = x - (dx > 0) + (dx < 0);
+    int backZ = z - (dz > 0) + (dz < 0);
+    auto inSight = [&](int checkX, int checkZ) {
+        int check = checkZ * NAV_GRID_SIZE + checkX;
+        return m_cellStates[check] == CellState::SETTLED && m_building[check].target == seen.target &&
+               m_building[check].inSight;
+    };
+    if (std::abs(dx) > std::abs(dz)) {
+        return inSight(backX, z) && (dz == 0 || inSight(backX, backZ));
+    }
+    if (std::abs(dz) > std::abs(dx)) {
+        return inSight(x, backZ) && (dx == 0 || inSight(backX, backZ));
+    }
+    // An exact diagonal passes between two corners, which must both be open
+    return inSight(backX, backZ) && m_grid.walkable[z * NAV_GRID_SIZE + backX] && m_grid.walkable[backZ * NAV_GRID_SIZE + x];
+}
+
+void FlowField::Aim(uint32_t cell) {
+    // In sight, at the target's cell; otherwise downhill: every cheaper
+    // neighbour on the same target's paths pulls by how much cheaper it is
+    FlowCell& aimed = m_building[cell];
+    aimed.directionX = 0;
+    aimed.directionZ = 0;
+    if (aimed.distance == 0 || aimed.distance == FLOW_UNREACHED) return;
+
+    int x = static_cast<int>(cell) % NAV_GRID_SIZE;
+    int z = static_cast<int>(cell) / NAV_GRID_SIZE;
+    if (aimed.inSight) {
+        uint16_t target = GetTargetCell(aimed.target);
+        float towardX = GetCellCenter(target % NAV_GRID_SIZE) - GetCellCenter(x);
+        float towardZ = GetCellCenter(target / NAV_GRID_SIZE) - GetCellCenter(z);
+        float length = std::sqrt(towardX * towardX + towardZ * towardZ);
+        aimed.directionX = PackDirection(towardX / length);
+        aimed.directionZ = PackDirection(towardZ / length);
+        return;
+    }
+    float sumX = 0.0f;
+    float sumZ = 0.0f;
+    uint32_t steps = m_grid.steps[cell];
+    for (uint32_t s = 0; s < NEIGHBOR_STEP_COUNT; ++s) {
+        if (!(steps & (1u << s))) continue;
+        const NeighborStep& step = NEIGHBOR_STEPS[s];
+        const FlowCell& neighbor = m_building[cell + step.dz * NAV_GRID_SIZE + step.dx];
+        // Across the line where two targets' paths meet, cheaper is toward the other one
+        if (neighbor.distance >= aimed.distance || neighbor.target != aimed.target) continue;
+        float drop = static_cast<float>(aimed.distance - neighbor.distance) * step.scale;
+        sumX += drop * static_cast<float>(step.dx);
+        sumZ += drop * static_cast<float>(step.dz);
+    }
+    float length = std::sqrt(sumX * sumX + sumZ * sumZ);
+    if (length > 0.0f) {
+        aimed.directionX = PackDirection(sumX / length);
+        aimed.directionZ = PackDirection(sumZ / length);
+    }
+}
+
+void FlowField::Publish() {
+    if (!m_retired.empty()) {
+        std::swap(m_retired, m_published);
+        m_retiredTargets = m_publishedTargets;
+    }
+    std::swap(m_published, m_building);
+    m_publishedTargets = m_buildTargets;
+    m_phase = Phase::IDLE;
+    m_progress = 0;
+}
+
+Vector3 FlowField::GetChaseDirection(Vector3 from, Vector3 target, uint8_t targetId) const {
+    const FlowCell& cell = Sample(from.x, from.z);
+    if (cell.target == targetId && !cell.inSight && cell.distance > FLOW_DIAGONAL_COST &&
+        cell.distance != FLOW_UNREACHED) {
+        return {cell.GetDirectionX(), 0.0f, cell.GetDirectionZ()};
+    }
+    Vector3 direction = {target.x - from.x, 0.0f, target.z - from.z};
+    float length = Vector3Length(direction);
+    return length > 0.0f ? Vector3Scale(direction, 1.0f / length) : Vector3{0.0f, 0.0f, 0.0f};
+}
+
+FlowFieldRecord FlowField::Save() const {
+    FlowFieldRecord record = {};
+    record.published = m_publishedTargets;
+    record.building = m_buildTargets;
+    record.progress = m_phase == Phase::IDLE ? 0 : m_progress;
+    return record;
+}
+
+void FlowField::Restore(const FlowFieldRecord& record) {
+    PROFILE_ZONE("FlowField::Restore");
+
+    // Builds are deterministic: redo the published one in full, then the
+    // running one up to the work it had done. Either may already be here,
+    // or the published one may be the field it replaced.
+    if (!m_retired.empty() && record.published == m_retiredTargets) {
+        std::swap(m_published, m_retired);
+        std::swap(m_publishedTargets, m_retiredTargets);
+    } else if (record.published != m_publishedTargets) {
+        StartBuild(record.published);
+        Step(UINT32_MAX);
+    }
+    if (record.progress == 0) {
+        m_buildTargets = record.building;
+        m_phase = Phase::IDLE;
+        m_progress = 0;
+    } else if (m_phase != Phase::IDLE && record.building == m_buildTargets && m_progress <= record.progress) {
+        Step(record.progress - m_progress);
+    } else {
+        StartBuild(record.building);
+        Step(record.progress);
+    }
+    m_desired = m_publishedTargets;
+}
+
+} // namespace TimeMaster
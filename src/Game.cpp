@@ -1,177 +1,543 @@
 #include "Game.hpp"
 #include "BossState.hpp"
+#include "FrameSnapshot.hpp"
+#include "JobSystem.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include "Replication.hpp"
 #include "raymath.h"
-#include <cstdlib>
-#include <ctime>
+#include <algorithm>
 
 namespace TimeMaster {
 
-Game::Game() 
-    : m_state(GameState::MENU)
-    , m_arenaModel{0}
-    , m_arenaModelLoaded(false)
-    , m_tomatoSpawnTimer(0.0f)
-    , m_playerAttackCooldown(0.0f)
-    , m_selectedSetting(0) {
-    
-    srand(static_cast<unsigned int>(time(nullptr)));
-    
-    // Load static assets
-    Player::LoadModel();
-    Tomato::LoadModel();
-    
-    // Load arena model
-    m_arenaModel = LoadModel("assets/models/arena/scene.gltf");
-    if (m_arenaModel.meshCount > 0 && m_arenaModel.meshes != nullptr) {
-        m_arenaModelLoaded = true;
-        TraceLog(LOG_INFO, "Arena model loaded successfully");
-    } else {
-        TraceLog(LOG_WARNING, "Failed to load arena model - using fallback rendering");
-        m_arenaModel = (Model){0};
-        m_arenaModelLoaded = false;
+namespace {
+// Work per job for the parallel update stages (small pools run as one job)
+constexpr uint32_t PROJECTILES_PER_JOB = 256;
+constexpr uint32_t MINIONS_PER_JOB = 128;
+
+constexpr float TOMATO_SPAWN_SECONDS = 3.0f;     // A spawn attempt (50%) this often
+constexpr float PLAYER_SHOT_COOLDOWN = 0.2f;     // Fast attack speed
+
+// Boss bullets kept in flight by DebugFireBossVolley (the old fixed pool size,
+// so the boss_projectile_spam perf scenario stays comparable)
+constexpr uint32_t DEBUG_VOLLEY_BULLETS = 10;
+
+constexpr float HIT_FLASH_SECONDS = 0.3f;        // HUD flash after the player is hit
+constexpr float DEBUG_BURST_RADIUS = 80.0f;      // DebugBurstEffects: around the local player
+
+// Horde mode: the boss summons a ring of minions every few seconds
+constexpr float HORDE_FIRST_WAVE_SECONDS = 2.0f;
+constexpr float HORDE_WAVE_SECONDS = 3.0f;
+constexpr uint32_t HORDE_WAVE_MINIONS = 200;
+constexpr float HORDE_SPAWN_INNER_RADIUS = 60.0f;       // Around the boss
+constexpr float HORDE_SPAWN_OUTER_RADIUS = 140.0f;
+constexpr float HORDE_CONTACT_DAMAGE_PER_SECOND = 4.0f; // While any minion touches a player
+constexpr float MINION_MELEE_REACH = 15.0f;             // Melee kills minions this far past the player's box
+
+// Co-op players line up beside the first one, told apart by colour
+constexpr float COOP_SPAWN_SPACING = 60.0f;
+constexpr Color PLAYER_COLORS[MAX_PLAYERS] = {BLUE, DARKGREEN};
+
+/**
+ * @brief Fixed part of a state frame (rewind, rollback); the projectile and
+ * tomato archetypes, the tomatoes' expiry timers, the minions, the live
+ * pattern emitters (emitterCount entries) and the boss bullets follow it
+ */
+struct GameRecord {
+    GameState state;
+    uint64_t timerNow;
+    uint64_t timerSequence;
+    RandomState random;
+    uint64_t playerAttackReadyTick[MAX_PLAYERS];
+    TimerRecord tomatoSpawnTimer;
+    TimerRecord hordeWaveTimer;
+    FlowFieldRecord flowField;
+    PlayerRecord players[MAX_PLAYERS];
+    BossRecord boss;
+    uint32_t emitterCount;
+};
+
+constexpr uint32_t WordsFor(size_t bytes) {
+    return static_cast<uint32_t>((bytes + 3) / 4);
+}
+
+constexpr uint32_t MAX_STATE_WORDS = WordsFor(sizeof(GameRecord)) +
+                                     WordsFor(sizeof(PatternEmitter) * MAX_PATTERN_EMITTERS) +
+                                     BulletStore::GetMaxStateWords(MAX_BOSS_PROJECTILES) +
+                                     ProjectileArchetype::GetMaxStateWords(MAX_PLAYER_PROJECTILES) +
+                                     TomatoArchetype::GetMaxStateWords(MAX_TOMATOES) +
+                                     WordsFor(sizeof(TimerRecord) * MAX_TOMATOES) +
+                                     MinionHorde::GetMaxStateWords(MAX_MINIONS);
+
+// Pools no larger than the snapshot and the rewind record have room for
+GameOptions ClampOptions(GameOptions options) {
+    options.bossBullets = std::min<uint32_t>(options.bossBullets, MAX_BOSS_PROJECTILES);
+    options.minions = std::min<uint32_t>(options.minions, MAX_MINIONS);
+    return options;
+}
+
+// Room for REWIND_SECONDS of history with this many minions alive
+uint32_t GetRewindStorageBytes(uint32_t minions) {
+    return REWIND_STORAGE_BYTES + minions * REWIND_STORAGE_BYTES_PER_MINION;
+}
+
+// Trace marker names for boss state transitions (string literals, registered once)
+const char* GetStateMarkerName(BossState state) {
+    switch (state) {
+        case BossState::IDLE:     return "Boss -> IDLE";
+        case BossState::ATTACK_1: return "Boss -> ATTACK_1";
+        case BossState::ATTACK_2: return "Boss -> ATTACK_2";
+        case BossState::ATTACK_3: return "Boss -> ATTACK_3";
+        case BossState::DEATH:    return "Boss -> DEATH";
     }
+    return "Boss -> ?";
+}
+}
+
+Game::Game(const GameAssets& assets, uint64_t seed, const GameOptions& options) 
+    : m_state(GameState::MENU)
+    , m_matchMode(MatchMode::BOSS)
+    , m_options(ClampOptions(options))
+    , m_random(seed)
+    , m_tick(0)
+    , m_timers(options.timers)
+    , m_events(options.eventsPerType)
+    , m_playerCount(1)
+    , m_localPlayer(0)
+    , m_tomatoes(MAX_TOMATOES)
+    , m_bullets(m_options.bossBullets)
+    , m_playerProjectiles(MAX_PLAYER_PROJECTILES)
+    , m_horde(m_options.minions)
+    , m_flowField(assets.GetNavGrid(), m_options.rewind)
+    , m_patterns(assets.GetPatterns())
+    , m_playerAttackReadyTick{}
+    , m_playerHitTick(0)
+    , m_effects{}
+    , m_effectHead(0)
+    , m_effectCount(0)
+    , m_playerViewTick{}
+    , m_rewind(options.rewind ? std::make_unique<RewindBuffer>(MAX_STATE_WORDS, REWIND_MAX_FRAMES) : nullptr)
+    , m_rewinding(false)
+    , m_selectedSetting(0)
+    , m_jobContext{}
+    , m_projectileHits(m_options.bossBullets + MAX_PLAYER_PROJECTILES, 0)
+    , m_flightSample{} {
     
     // Initialize systems
     m_cameraManager = std::make_unique<CameraManager>();
-    m_hud = std::make_unique<HUD>();
+    m_cameraManager->SetMouseSensitivity(m_config.mouseSensitivity);
     
-    // Initialize entities
-    m_player = std::make_unique<Player>();
-    m_boss = std::make_unique<Boss>();
-    
-    // Initialize tomato pool
-    m_tomatoes.reserve(MAX_TOMATOES);
-    for (int i = 0; i < MAX_TOMATOES; ++i) {
-        m_tomatoes.push_back(std::make_unique<Tomato>());
+    // Initialize entities (every co-op slot exists; SetPlayers picks how many play)
+    for (auto& player : m_players) {
+        player = std::make_unique<Player>(m_config, assets.GetPlayer());
     }
+    m_boss = std::make_unique<Boss>(m_random, m_config, assets.GetBoss(), m_timers, m_events);
     
-    // Initialize projectile pool
-    m_projectiles.reserve(MAX_BOSS_PROJECTILES);
-    for (int i = 0; i < MAX_BOSS_PROJECTILES; ++i) {
-        m_projectiles.push_back(std::make_unique<Projectile>());
-    }
-    
-    // Initialize player projectile pool
-    m_playerProjectiles.reserve(MAX_BOSS_PROJECTILES);
-    for (int i = 0; i < MAX_BOSS_PROJECTILES; ++i) {
-        m_playerProjectiles.push_back(std::make_unique<Projectile>());
-    }
-}
-
-Game::~Game() {
-    // Unload static assets
-    Player::UnloadModel();
-    Tomato::UnloadModel();
-    
-    // Unload arena model
-    if (m_arenaModelLoaded) {
-        UnloadModel(m_arenaModel);
-    }
+    // Game-side consumers (HUD hit flash, particle bursts); audio subscribes the same way
+    m_events.Subscribe<StateChangedEvent>(&Game::OnBossStateChanged, this);
+    m_events.Subscribe<HitEvent>(&Game::OnHit, this);
+    m_events.Subscribe<HealEvent>(&Game::OnHeal, this);
+    m_events.Subscribe<CollectEvent>(&Game::OnCollect, this);
 }
 
 void Game::Init() {
-    m_player->Reset();
+    // Drop the previous match's timers and undelivered events before entities
+    // schedule new ones
+    m_timers.Clear();
+    m_events.Clear();
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        Player& player = *m_players[i];
+        player.Reset();
+        Vector3 position = player.GetPosition();
+        position.z += COOP_SPAWN_SPACING * static_cast<float>(i);
+        player.SetPosition(position);
+        player.SetColor(PLAYER_COLORS[i]);
+        m_playerAttackReadyTick[i] = 0;
+        m_playerViewTick[i] = 0;
+    }
     m_boss->Reset();
     m_cameraManager->Reset();
-    m_tomatoSpawnTimer = 0.0f;
-    m_playerAttackCooldown = 0.0f;
-    
-    // Ensure cursor is locked for gameplay
-    DisableCursor();
+    m_tomatoSpawnTimer = m_timers.Schedule(TimerWheel::SecondsToTicks(TOMATO_SPAWN_SECONDS),
+                                           &Game::TomatoSpawnTimerExpired, this);
+    m_hordeWaveTimer = m_matchMode == MatchMode::HORDE
+        ? m_timers.Schedule(TimerWheel::SecondsToTicks(HORDE_FIRST_WAVE_SECONDS), &Game::HordeWaveTimerExpired, this)
+        : TimerHandle{};
+    m_flowField.SetTargets(GetFlowTargets());
+    m_flowField.Rebuild();
+    m_playerHitTick = 0;
+    m_effectHead = 0;
+    m_effectCount = 0;
+    m_hitboxes.Clear();
+    if (m_rewind) {
+        // The horde's share of the budget is set aside here and taken as it grows
+        m_rewind->ResetStorage(REWIND_STORAGE_BYTES);
+        if (m_matchMode == MatchMode::HORDE) {
+            m_rewind->ReserveStorage(GetRewindStorageBytes(m_options.minions));
+        }
+    }
+    m_rewinding = false;
     
-    // Clear any accumulated mouse delta from menu
-    GetMouseDelta();
+    // Ensure cursor is locked for gameplay (applied by the renderer)
+    m_cameraManager->SetCursorLocked(true);
     
-    // Reset all tomatoes and projectiles
-    for (auto& tomato : m_tomatoes) {
-        tomato->OnCollect();
-    }
-    for (auto& projectile : m_projectiles) {
-        projectile->Deactivate();
-    }
+    // Reset all tomatoes, projectiles, minions and running patterns (their timers went with the wheel)
+    m_tomatoes.Clear();
+    m_playerProjectiles.Clear();
+    m_horde.Clear();
+    m_bullets.Clear();
+    m_patternRunner.Clear();
 }
 
-void Game::Update() {
+void Game::Update(const InputFrame& input, float deltaTime) {
+    PROFILE_ZONE("Game::Update");
+    
+    RandomState randomBefore = m_random.GetState();
+    m_tick++;
+    
     switch (m_state) {
         case GameState::MENU:
-            UpdateMenu();
+            UpdateMenu(input);
             break;
         case GameState::SETTINGS:
-            UpdateSettings();
+            UpdateSettings(input);
             break;
         case GameState::PLAYING:
-            UpdatePlaying();
+            UpdatePlaying(input, deltaTime);
             break;
         case GameState::PAUSED:
-            UpdatePaused();
+            UpdatePaused(input);
             break;
         case GameState::GAME_OVER:
-            UpdateGameOver();
+            UpdateGameOver(input);
             break;
         case GameState::VICTORY:
-            UpdateVictory();
+            UpdateVictory(input);
             break;
     }
+    
+    // Hand this tick's events to their consumers in one batch per type
+    m_events.Dispatch();
+    
+    RecordFlightSample(input, randomBefore);
 }
 
-void Game::Draw() {
-    switch (m_state) {
-        case GameState::MENU:
-            DrawMenu();
-            break;
-        case GameState::SETTINGS:
-            DrawSettings();
-            break;
-        case GameState::PLAYING:
-            DrawPlaying();
-            break;
-        case GameState::PAUSED:
-            DrawPaused();
-            break;
-        case GameState::GAME_OVER:
-            DrawGameOver();
-            break;
-        case GameState::VICTORY:
-            DrawVictory();
-            break;
+void Game::UpdateNetworked(const PlayerCommand* commands, float deltaTime) {
+    PROFILE_ZONE("Game::Update");
+    
+    RandomState randomBefore = m_random.GetState();
+    m_tick++;
+    
+    // The match ends at game over or victory: there is no menu to return to in lockstep
+    if (m_state == GameState::PLAYING) {
+        Simulate(commands, deltaTime);
+        RecordHitboxes();
+    }
+    m_events.Dispatch();
+    
+    const PlayerCommand& local = commands[m_localPlayer];
+    RecordFlightSample(InputFrame{local.held, local.pressed, 0.0f, 0.0f, 0.0f}, randomBefore);
+}
+
+void Game::ResimulateNetworked(const PlayerCommand* commands, float deltaTime) {
+    PROFILE_ZONE("Game::Resimulate");
+    
+    if (m_state == GameState::PLAYING) {
+        Simulate(commands, deltaTime);
     }
+    m_events.Clear();
 }
 
-bool Game::ShouldClose() const {
-    return WindowShouldClose();
+void Game::SetPlayers(int count, int localPlayer) {
+    m_playerCount = std::max(1, std::min(count, MAX_PLAYERS));
+    m_localPlayer = std::max(0, std::min(localPlayer, m_playerCount - 1));
 }
 
-void Game::UpdateMenu() {
-    if (IsKeyPressed(KEY_ENTER)) {
-        Init();
-        TransitionTo(GameState::PLAYING);
+void Game::RecordFlightSample(const InputFrame& input, const RandomState& randomBefore) {
+    GameplaySample& sample = m_flightSample;
+    sample.state = m_state;
+    sample.bossState = m_boss->GetState();
+    sample.bossTime = m_boss->GetTime();
+    sample.playerTime = LocalPlayer().GetTime();
+    sample.playerPosition = LocalPlayer().GetPosition();
+    sample.activeProjectiles = static_cast<int>(m_bullets.GetCount());
+    sample.activePlayerProjectiles = static_cast<int>(m_playerProjectiles.GetCount());
+    sample.activeTomatoes = static_cast<int>(m_tomatoes.GetCount());
+    sample.input = input;
+    sample.random = randomBefore;
+#if TM_STATE_CHECKSUM
+    sample.stateHash = ComputeChecksum().combined;
+#else
+    sample.stateHash = 0;
+#endif
+}
+
+StateChecksum Game::ComputeChecksum() const {
+    PROFILE_ZONE("Game::ComputeChecksum");
+    
+    StateHasher hashers[STATE_FIELD_COUNT];
+    auto field = [&](StateField f) -> StateHasher& { return hashers[static_cast<int>(f)]; };
+    
+    StateHasher& game = field(StateField::GAME);
+    // m_tick is not hashed: it counts menu and paused ticks too and only
+    // drives view effects
+    game.Add(static_cast<int>(m_state));
+    game.Add(static_cast<int>(m_matchMode));
+    game.Add(m_playerCount);
+    TimerRecord spawnTimer = m_timers.SaveTimer(m_tomatoSpawnTimer);
+    game.Add(spawnTimer.deadline);
+    game.Add(spawnTimer.sequence);
+    TimerRecord waveTimer = m_timers.SaveTimer(m_hordeWaveTimer);
+    game.Add(waveTimer.deadline);
+    game.Add(waveTimer.sequence);
+    
+    // The fields themselves are rebuilt from their targets
+    FlowFieldRecord paths = m_flowField.Save();
+    StateHasher& flowField = field(StateField::FLOW_FIELD);
+    for (const FlowTargets* targets : {&paths.published, &paths.building}) {
+        flowField.Add(targets->count);
+        for (uint32_t i = 0; i < targets->count; ++i) {
+            flowField.Add(static_cast<uint32_t>(targets->cells[i]));
+            flowField.Add(static_cast<uint32_t>(targets->ids[i]));
+        }
     }
-    if (IsKeyPressed(KEY_S)) {
+    flowField.Add(paths.progress);
+    
+    field(StateField::RANDOM).Add(m_random.GetState().state);
+    field(StateField::RANDOM).Add(m_random.GetState().increment);
+    field(StateField::TIMERS).Add(m_timers.GetNow());
+    field(StateField::TIMERS).Add(m_timers.GetSequence());
+    field(StateField::TIMERS).Add(m_timers.GetPendingCount());
+    
+    for (int i = 0; i < m_playerCount; ++i) {
+        PlayerRecord player = m_players[i]->SaveRecord();
+        game.Add(m_playerAttackReadyTick[i]);
+        field(StateField::PLAYER_POSITION).Add(player.position);
+        field(StateField::PLAYER_TIME).Add(player.time);
+        field(StateField::PLAYER_TIME).Add(player.alive);
+        StateHasher& playerMotion = field(StateField::PLAYER_MOTION);
+        playerMotion.Add(player.velocity);
+        playerMotion.Add(player.rotation);
+        playerMotion.Add(player.moving);
+        playerMotion.Add(player.running);
+        StateHasher& playerAnimation = field(StateField::PLAYER_ANIMATION);
+        playerAnimation.Add(player.animIndex);
+        playerAnimation.Add(player.animFrame);
+        playerAnimation.Add(player.animTimer);
+        playerAnimation.Add(player.color);
+    }
+    
+    BossRecord boss = m_boss->SaveRecord();
+    field(StateField::BOSS_POSITION).Add(boss.position);
+    field(StateField::BOSS_TIME).Add(boss.time);
+    field(StateField::BOSS_TIME).Add(boss.alive);
+    StateHasher& bossState = field(StateField::BOSS_STATE);
+    bossState.Add(static_cast<int>(boss.state));
+    bossState.Add(boss.stateTimer.deadline);
+    bossState.Add(boss.stateTimer.sequence);
+    bossState.Add(boss.attackReadyTick);
+    bossState.Add(boss.hasAttackedInState);
+    StateHasher& bossMotion = field(StateField::BOSS_MOTION);
+    bossMotion.Add(boss.velocity);
+    bossMotion.Add(boss.targetRotation);
+    bossMotion.Add(boss.currentRotation);
+    bossMotion.Add(boss.moveTimer);
+    StateHasher& bossAnimation = field(StateField::BOSS_ANIMATION);
+    bossAnimation.Add(boss.animIndex);
+    bossAnimation.Add(boss.animFrame);
+    bossAnimation.Add(boss.animTimer);
+    bossAnimation.Add(boss.color);
+    
+    StateHasher& bullets = field(StateField::BOSS_BULLETS);
+    const Bullet* bulletData = m_bullets.GetData();
+    bullets.Add(m_bullets.GetCount());
+    for (uint32_t i = 0; i < m_bullets.GetCount(); ++i) {
+        bullets.Add(bulletData[i].position);
+        bullets.Add(bulletData[i].velocity);
+        bullets.Add(bulletData[i].radius);
+        bullets.Add(bulletData[i].color);
+    }
+    
+    // Rows, not entity ids: ids only name rows for timers and never affect play
+    StateHasher& projectiles = field(StateField::PLAYER_PROJECTILES);
+    projectiles.Add(m_playerProjectiles.GetCount());
+    for (uint32_t row = 0; row < m_playerProjectiles.GetCount(); ++row) {
+        projectiles.Add(m_playerProjectiles.Get<Position>()[row].value);
+        projectiles.Add(m_playerProjectiles.Get<Velocity>()[row].value);
+        projectiles.Add(m_playerProjectiles.Get<LagCompensation>()[row].ticks);
+    }
+    
+    StateHasher& tomatoes = field(StateField::TOMATOES);
+    tomatoes.Add(m_tomatoes.GetCount());
+    for (uint32_t row = 0; row < m_tomatoes.GetCount(); ++row) {
+        TimerRecord expiry = m_timers.SaveTimer(m_tomatoes.Get<Lifetime>()[row].expiry);
+        tomatoes.Add(m_tomatoes.Get<Position>()[row].value);
+        tomatoes.Add(m_tomatoes.Get<Lifetime>()[row].spawnTick);
+        tomatoes.Add(expiry.deadline);
+        tomatoes.Add(expiry.sequence);
+    }
+    
+    StateHasher& minions = field(StateField::MINIONS);
+    minions.Add(m_horde.GetCount());
+    for (uint32_t row = 0; row < m_horde.GetCount(); ++row) {
+        minions.Add(m_horde.GetX()[row]);
+        minions.Add(m_horde.GetZ()[row]);
+        minions.Add(m_horde.GetVelocityX()[row]);
+        minions.Add(m_horde.GetVelocityZ()[row]);
+    }
+    
+    // Emitters point into the shared library: hash the volley index, not the address
+    StateHasher& patterns = field(StateField::PATTERNS);
+    const PatternEmitter* emitters = m_patternRunner.GetEmitters();
+    patterns.Add(m_patternRunner.GetActiveEmitters());
+    for (int i = 0; i < m_patternRunner.GetActiveEmitters(); ++i) {
+        patterns.Add(m_patterns.GetVolleyIndex(emitters[i].volley));
+        patterns.Add(emitters[i].timer);
+        patterns.Add(emitters[i].baseAngle);
+        patterns.Add(emitters[i].shotsLeft);
+    }
+    
+    StateChecksum checksum;
+    for (int i = 0; i < STATE_FIELD_COUNT; ++i) {
+        checksum.fields[i] = hashers[i].GetHash();
+    }
+    checksum.Combine();
+    return checksum;
+}
+
+void Game::WriteSnapshot(FrameSnapshot& snapshot) const {
+    PROFILE_ZONE("Game::WriteSnapshot");
+    
+    snapshot.tick = m_tick;
+    snapshot.state = m_state;
+    snapshot.mode = m_matchMode;
+    snapshot.selectedSetting = m_selectedSetting;
+    snapshot.cursorLocked = m_cameraManager->IsCursorLocked();
+    snapshot.camera = m_cameraManager->GetCamera();
+    snapshot.player = LocalPlayer().GetSnapshot();
+    snapshot.partnerCount = 0;
+    for (int i = 0; i < m_playerCount; ++i) {
+        if (i != m_localPlayer) {
+            snapshot.partners[snapshot.partnerCount++] = m_players[i]->GetSnapshot();
+        }
+    }
+    snapshot.boss = m_boss->GetSnapshot();
+    
+    uint64_t flashTicks = TimerWheel::SecondsToTicks(HIT_FLASH_SECONDS);
+    uint64_t sinceHit = m_tick - m_playerHitTick;
+    snapshot.playerHitFlash = m_playerHitTick > 0 && sinceHit < flashTicks
+        ? 1.0f - static_cast<float>(sinceHit) / static_cast<float>(flashTicks)
+        : 0.0f;
+    
+    uint32_t projectileCount = 0;
+    const Bullet* bullets = m_bullets.GetData();
+    for (uint32_t i = 0; i < m_bullets.GetCount(); ++i) {
+        snapshot.projectiles[projectileCount++] = {bullets[i].position, bullets[i].radius, bullets[i].color, true};
+    }
+    for (uint32_t row = 0; row < m_playerProjectiles.GetCount(); ++row) {
+        snapshot.projectiles[projectileCount++] = GetProjectileSnapshot(m_playerProjectiles, row);
+    }
+    snapshot.projectileCount = projectileCount;
+    for (uint32_t i = 0; i < MAX_TOMATOES; ++i) {
+        snapshot.tomatoes[i] = i < m_tomatoes.GetCount() ? GetTomatoSnapshot(m_tomatoes, i, m_timers.GetNow())
+                                                         : TomatoSnapshot{};
+    }
+    snapshot.minionCount = m_horde.GetCount();
+    for (uint32_t row = 0; row < m_horde.GetCount(); ++row) {
+        snapshot.minions[row] = {m_horde.GetX()[row], MINION_Y, m_horde.GetZ()[row]};
+    }
+    uint32_t firstEffect = m_effectHead + EFFECT_HISTORY - m_effectCount;
+    for (uint32_t i = 0; i < m_effectCount; ++i) {
+        snapshot.effects[i] = m_effects[(firstEffect + i) % EFFECT_HISTORY];
+    }
+    snapshot.effectCount = m_effectCount;
+    
+    const GameConfig& config = m_config;
+    snapshot.config.mouseSensitivity = config.mouseSensitivity;
+    snapshot.config.playerSpeed = config.playerSpeed;
+    snapshot.config.playerStartingTime = config.playerStartingTime;
+    snapshot.config.playerMaxTime = config.playerMaxTime;
+    snapshot.config.playerDamagePerHit = config.playerDamagePerHit;
+    snapshot.config.bossStartingTime = config.bossStartingTime;
+    snapshot.config.bossDamagePerHit = config.bossDamagePerHit;
+    snapshot.config.tomatoHealAmount = config.tomatoHealAmount;
+    
+    snapshot.rewinding = m_rewinding;
+    snapshot.rewindSeconds = m_rewind ? static_cast<float>(m_rewind->GetFrameCount()) / SIMULATION_TICK_RATE : 0.0f;
+    snapshot.net = NetSnapshot{};   // Filled in by the NetSession, if any
+    
+    snapshot.flight = m_flightSample;
+}
+
+void Game::WriteReplicatedState(ReplicatedState& state) const {
+    state.tick = static_cast<uint32_t>(m_tick);
+    state.state = static_cast<uint8_t>(m_state);
+    state.playerCount = static_cast<uint8_t>(m_playerCount);
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        state.players[i] = i < m_playerCount ? QuantizePlayer(m_players[i]->GetSnapshot()) : ReplicatedState::Player{};
+    }
+    state.boss = QuantizeBoss(m_boss->GetSnapshot());
+    
+    // Rows are packed, so the masks are runs of low bits
+    state.tomatoMask = 0;
+    for (uint32_t i = 0; i < MAX_TOMATOES; ++i) {
+        bool active = i < m_tomatoes.GetCount();
+        state.tomatoes[i] = active ? QuantizePosition(m_tomatoes.Get<Position>()[i].value) : ReplicatedState::Point{};
+        if (active) state.tomatoMask |= 1u << i;
+    }
+    state.projectileMask = 0;
+    for (uint32_t i = 0; i < MAX_PLAYER_PROJECTILES; ++i) {
+        bool active = i < m_playerProjectiles.GetCount();
+        state.projectiles[i] = active ? QuantizePosition(m_playerProjectiles.Get<Position>()[i].value)
+                                      : ReplicatedState::Point{};
+        if (active) state.projectileMask |= 1u << i;
+    }
+    
+    state.bulletCount = std::min(m_bullets.GetCount(), REPLICATION_MAX_BULLETS);
+    const Bullet* bullets = m_bullets.GetData();
+    for (uint32_t i = 0; i < state.bulletCount; ++i) {
+        state.bullets[i] = QuantizeBullet(bullets[i]);
+    }
+}
+
+void Game::StartMatch() {
+    Init();
+    TransitionTo(GameState::PLAYING);
+}
+
+void Game::UpdateMenu(const InputFrame& input) {
+    if (input.WasPressed(INPUT_CONFIRM)) {
+        m_matchMode = MatchMode::BOSS;
+        StartMatch();
+    } else if (input.WasPressed(INPUT_START_HORDE)) {
+        m_matchMode = MatchMode::HORDE;
+        StartMatch();
+    }
+    if (input.WasPressed(INPUT_OPEN_SETTINGS)) {
         m_selectedSetting = 0;
         TransitionTo(GameState::SETTINGS);
     }
 }
 
-void Game::UpdateSettings() {
-    auto& config = GameConfig::GetInstance();
+void Game::UpdateSettings(const InputFrame& input) {
+    GameConfig& config = m_config;
     
     // Navigate settings
-    if (IsKeyPressed(KEY_UP)) {
+    if (input.WasPressed(INPUT_MENU_UP)) {
         m_selectedSetting--;
         if (m_selectedSetting < 0) m_selectedSetting = 7; // 8 options (0-7)
     }
-    if (IsKeyPressed(KEY_DOWN)) {
+    if (input.WasPressed(INPUT_MENU_DOWN)) {
         m_selectedSetting++;
         if (m_selectedSetting > 7) m_selectedSetting = 0;
     }
     
     // Adjust values
     float adjustSpeed = 1.0f;
-    if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+    if (input.IsDown(INPUT_RUN)) {
         adjustSpeed = 5.0f; // Fast adjustment
     }
     
-    if (IsKeyPressed(KEY_LEFT) || IsKeyDown(KEY_LEFT)) {
+    if (input.IsDown(INPUT_MENU_LEFT)) {
         switch (m_selectedSetting) {
             case 0: // Mouse Sensitivity
                 config.mouseSensitivity -= 0.01f;
@@ -209,7 +575,7 @@ void Game::UpdateSettings() {
         }
     }
     
-    if (IsKeyPressed(KEY_RIGHT) || IsKeyDown(KEY_RIGHT)) {
+    if (input.IsDown(INPUT_MENU_RIGHT)) {
         switch (m_selectedSetting) {
             case 0: // Mouse Sensitivity
                 config.mouseSensitivity += 0.01f;
@@ -248,85 +614,132 @@ void Game::UpdateSettings() {
     }
     
     // Reset to defaults
-    if (IsKeyPressed(KEY_R)) {
+    if (input.WasPressed(INPUT_RESET_SETTINGS)) {
         config.ResetToDefaults();
         m_cameraManager->SetMouseSensitivity(config.mouseSensitivity);
     }
     
     // Return to menu
-    if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER)) {
+    if (input.WasPressed(INPUT_BACK) || input.WasPressed(INPUT_CONFIRM)) {
         TransitionTo(GameState::MENU);
     }
 }
 
-void Game::UpdatePlaying() {
-    float deltaTime = GetFrameTime();
+void Game::UpdatePlaying(const InputFrame& input, float deltaTime) {
+    PROFILE_ZONE("Game::UpdatePlaying");
     
-    // Decrease time for player and boss automatically
-    m_player->TakeDamage(deltaTime);
-    m_boss->TakeDamage(deltaTime);
-    
-    // Update camera to follow player with mouse control
-    m_cameraManager->UpdateThirdPerson(m_player->GetPosition(), deltaTime);
+    PlayerCommand commands[MAX_PLAYERS] = {};
+    commands[m_localPlayer] = UpdateView(input, deltaTime);
     
-    // Update player rotation to face camera
-    m_player->SetCameraAngle(m_cameraManager->GetAngleAroundPlayer());
+    // Holding rewind scrubs the history back instead of simulating
+    m_rewinding = m_rewind && input.IsDown(INPUT_REWIND);
+    if (m_rewinding) {
+        RewindStep();
+    } else {
+        Simulate(commands, deltaTime);
+        if (m_rewind) {
+            CaptureRewindFrame();
+        }
+    }
     
-    // Update player with camera-relative movement
-    Vector3 cameraForward = m_cameraManager->GetForwardDirection();
-    Vector3 cameraRight   = m_cameraManager->GetRightDirection();
+    // Pause
+    if (input.WasPressed(INPUT_PAUSE)) {
+        TransitionTo(GameState::PAUSED);
+    }
+}
 
-    m_player->UpdateWithCamera(deltaTime, cameraForward, cameraRight);
-    
-    // Update boss with player position for smooth rotation
-    m_boss->UpdateWithPlayer(m_player->GetPosition(), deltaTime);
+PlayerCommand Game::UpdateView(const InputFrame& input, float deltaTime) {
+    // Update camera to follow player with mouse control
+    m_cameraManager->UpdateThirdPerson(LocalPlayer().GetPosition(), input, deltaTime);
     
-    // Update player attack cooldown
-    m_playerAttackCooldown -= deltaTime;
-    if (m_playerAttackCooldown < 0) m_playerAttackCooldown = 0;
+    // The player moves relative to where the camera looks now (before a mode toggle resets it)
+    PlayerCommand command = {input.held & INPUT_PLAYER_BUTTONS, input.pressed & INPUT_PLAYER_BUTTONS,
+                             m_cameraManager->GetAngleAroundPlayer()};
     
     // Toggle camera mode with C key
-    if (IsKeyPressed(KEY_C)) {
+    if (input.WasPressed(INPUT_TOGGLE_CAMERA)) {
         m_cameraManager->ToggleMode();
     }
     
     // Toggle cursor lock with ESC key (for debugging or menu access)
-    if (IsKeyPressed(KEY_ESCAPE)) {
+    if (input.WasPressed(INPUT_TOGGLE_CURSOR)) {
         m_cameraManager->ToggleCursorLock();
     }
     
     // Toggle boss debug hitbox with H key
-    if (IsKeyPressed(KEY_H)) {
+    if (input.WasPressed(INPUT_TOGGLE_HITBOX)) {
         m_boss->ToggleDebugHitbox();
     }
+    return command;
+}
+
+void Game::Simulate(const PlayerCommand* commands, float deltaTime) {
+    PROFILE_ZONE("Game::Simulate");
     
-    // Handle player attack
-    if (IsKeyPressed(KEY_SPACE)) {
-        HandlePlayerAttack();
+    bool wasAlive[MAX_PLAYERS] = {};
+    for (int i = 0; i < m_playerCount; ++i) {
+        wasAlive[i] = m_players[i]->IsAlive();
     }
     
-    // Handle player projectile attack (Left Mouse Button)
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && m_playerAttackCooldown <= 0) {
-        // Shoot projectile toward boss
-        for (auto& projectile : m_playerProjectiles) {
-            if (!projectile->IsActive()) {
-                projectile->Launch(m_player->GetPosition(), m_boss->GetPosition());
-                m_playerAttackCooldown = 0.2f; // Fast attack speed - 0.2 second cooldown
-                break;
-            }
+    // Fire the timers due this tick: boss state changes, tomato expiry and spawns
+    m_timers.Advance();
+    
+    // Decrease time for players and boss automatically
+    for (int i = 0; i < m_playerCount; ++i) {
+        if (wasAlive[i]) {
+            m_players[i]->TakeDamage(deltaTime);
+        }
+    }
+    m_boss->TakeDamage(deltaTime);
+    
+    // Update players with movement relative to their own camera
+    for (int i = 0; i < m_playerCount; ++i) {
+        if (!wasAlive[i]) continue;
+        const PlayerCommand& command = commands[i];
+        Player& player = *m_players[i];
+        player.SetCameraAngle(command.aimYaw);
+        player.UpdateWithCamera(command, deltaTime,
+                                CameraManager::GetForwardDirection(command.aimYaw),
+                                CameraManager::GetRightDirection(command.aimYaw));
+    }
+    
+    // Paths follow the players into their new cells, a budgeted step per tick
+    m_flowField.SetTargets(GetFlowTargets());
+    m_flowField.Update();
+    
+    // Update boss with its target's position for smooth rotation, walking there along the paths
+    int bossTarget = GetBossTargetSlot();
+    Vector3 bossTargetPosition = m_players[bossTarget]->GetPosition();
+    m_boss->UpdateWithPlayer(bossTargetPosition,
+                             m_flowField.GetChaseDirection(m_boss->GetPosition(), bossTargetPosition,
+                                                           static_cast<uint8_t>(bossTarget)),
+                             deltaTime);
+    
+    // Handle player attacks: melee and projectiles (Left Mouse Button)
+    for (int i = 0; i < m_playerCount; ++i) {
+        if (!wasAlive[i]) continue;
+        if (commands[i].WasPressed(INPUT_MELEE)) {
+            HandlePlayerAttack(i);
+        }
+        if (commands[i].WasPressed(INPUT_SHOOT)) {
+            HandlePlayerShot(i);
         }
     }
     
-    // Resolve collision between player and boss (prevent overlap)
-    if (m_player->IsAlive() && m_boss->IsAlive()) {
-        AABB playerAABB = m_player->GetAABB();
+    // Resolve collision between players and boss (prevent overlap)
+    for (int i = 0; i < m_playerCount; ++i) {
+        Player& player = *m_players[i];
+        if (!player.IsAlive() || !m_boss->IsAlive()) continue;
+        PROFILE_ZONE("Collision");
+        
+        AABB playerAABB = player.GetAABB();
         AABB bossAABB = m_boss->GetAABB();
         
         CollisionResolution collision = ResolveAABBCollision(playerAABB, bossAABB);
         if (collision.hasCollision) {
             // Push the player away from the boss
             // We push only the player to keep the boss movement stable
-            m_player->ApplyPushback(collision.pushback);
+            player.ApplyPushback(collision.pushback);
         }
     }
     
@@ -339,224 +752,570 @@ void Game::UpdatePlaying() {
         HandleBossAttack();
         m_boss->MarkAttackTriggered();
     }
+    m_patternRunner.Update(deltaTime, m_boss->GetPosition(), GetBossTarget().GetPosition(), m_bullets);
     
-    // Update projectiles
-    UpdateProjectiles(deltaTime);
-    
-    // Update player projectiles
-    auto& config = GameConfig::GetInstance();
-    for (auto& projectile : m_playerProjectiles) {
-        projectile->Update(deltaTime);
-        
-        if (projectile->CheckCollision(m_boss->GetPosition(), m_boss->GetSize().x / 2.0f)) {
-            m_boss->TakeDamage(config.playerDamagePerHit);
-            projectile->Deactivate();
+    // Projectile integration + hit tests run in parallel; gameplay
+    // consequences are applied in slot order by the jobs that follow them
+    m_jobContext.deltaTime = deltaTime;
+    m_jobContext.playerCount = 0;
+    for (int i = 0; i < m_playerCount; ++i) {
+        if (m_players[i]->IsAlive()) {
+            m_jobContext.playerPositions[m_jobContext.playerCount] = m_players[i]->GetPosition();
+            m_jobContext.playerIndices[m_jobContext.playerCount] = static_cast<uint8_t>(i);
+            m_jobContext.playerCount++;
         }
     }
+    m_jobContext.playerRadius = m_players[0]->GetApproxRadius();
+    // The hitbox history is only written between ticks, so jobs may read it
+    m_jobContext.boss = {&m_boss->GetHitCapsules(), &m_hitboxes, GetTick()};
+    m_jobContext.bulletCount = m_bullets.GetCount();
+    m_jobContext.projectileCount = m_playerProjectiles.GetCount();
     
-    // Update tomatoes
-    UpdateTomatoes(deltaTime);
+    // Minions steer in the same pass, from a grid of where they stand now
+    HordeTargets& horde = m_jobContext.horde;
+    horde.playerCount = static_cast<uint32_t>(m_playerCount);
+    for (int i = 0; i < m_playerCount; ++i) {
+        horde.players[i] = m_players[i]->GetPosition();
+        horde.playerBoxes[i] = m_players[i]->GetAABB();
+        horde.alive[i] = m_players[i]->IsAlive();
+    }
+    horde.bossBox = m_boss->GetAABB();
+    horde.bossAlive = m_boss->IsAlive();
+    horde.paths = &m_flowField;
+    const bool minions = m_horde.GetCount() > 0;
     
-    // Spawn tomatoes
-    m_tomatoSpawnTimer += deltaTime;
-    if (m_tomatoSpawnTimer > 3.0f) { // Spawn every 3 seconds on average
-        if (GetRandomValue(0, 1) == 1) {
-            SpawnTomato();
+    if (m_options.parallelUpdate) {
+        JobSystem& jobs = JobSystem::GetInstance();
+        jobs.Wait(ScheduleSimulation(jobs, minions));
+    } else {
+        if (minions) {
+            m_horde.BuildGrid();
         }
-        m_tomatoSpawnTimer = 0.0f;
+        UpdateProjectilesJob(this, 0, m_jobContext.bulletCount + m_jobContext.projectileCount);
+        if (minions) {
+            SteerMinionsJob(this, 0, m_horde.GetCount());
+        }
+        ApplyProjectileHits();
+        ApplyContacts();
     }
     
-    // Check tomato collection
-    CheckTomatoCollection();
-    
-    // Check game over conditions
-    if (!m_player->IsAlive()) {
+    // Check game over conditions: every player down
+    bool anyAlive = false;
+    for (int i = 0; i < m_playerCount; ++i) {
+        const Player& player = *m_players[i];
+        if (player.IsAlive()) {
+            anyAlive = true;
+        } else if (wasAlive[i]) {
+            m_events.Emit(DeathEvent{EventEntity::PLAYER, static_cast<uint8_t>(i), player.GetPosition()});
+        }
+    }
+    if (!anyAlive) {
         TransitionTo(GameState::GAME_OVER);
     }
     if (!m_boss->IsAlive()) {
+        m_events.Emit(DeathEvent{EventEntity::BOSS, 0, m_boss->GetPosition()});
         TransitionTo(GameState::VICTORY);
     }
-    
-    // Pause
-    if (IsKeyPressed(KEY_P) || IsKeyPressed(KEY_ESCAPE)) {
-        TransitionTo(GameState::PAUSED);
+}
+
+void Game::UpdatePaused(const InputFrame& input) {
+    // ESC also reports INPUT_PAUSE, so check it first
+    if (input.WasPressed(INPUT_BACK)) {
+        TransitionTo(GameState::MENU);
+    } else if (input.WasPressed(INPUT_PAUSE) || input.WasPressed(INPUT_CONFIRM)) {
+        TransitionTo(GameState::PLAYING);  // Re-locks the cursor
     }
 }
 
-void Game::UpdatePaused() {
-    if (IsKeyPressed(KEY_P) || IsKeyPressed(KEY_ENTER)) {
-        DisableCursor(); // Re-lock cursor when resuming
-        GetMouseDelta(); // Clear accumulated mouse delta
-        TransitionTo(GameState::PLAYING);
+void Game::UpdateGameOver(const InputFrame& input) {
+    if (input.WasPressed(INPUT_CONFIRM)) {
+        StartMatch();
     }
-    if (IsKeyPressed(KEY_ESCAPE)) {
+    if (input.WasPressed(INPUT_BACK)) {
         TransitionTo(GameState::MENU);
     }
 }
 
-void Game::UpdateGameOver() {
-    if (IsKeyPressed(KEY_ENTER)) {
-        Init();
-        TransitionTo(GameState::PLAYING);
+void Game::UpdateVictory(const InputFrame& input) {
+    if (input.WasPressed(INPUT_CONFIRM)) {
+        StartMatch();
     }
-    if (IsKeyPressed(KEY_ESCAPE)) {
+    if (input.WasPressed(INPUT_BACK)) {
         TransitionTo(GameState::MENU);
     }
 }
 
-void Game::UpdateVictory() {
-    if (IsKeyPressed(KEY_ENTER)) {
-        Init();
-        TransitionTo(GameState::PLAYING);
+const Player& Game::GetBossTarget() const {
+    return *m_players[GetBossTargetSlot()];
+}
+
+int Game::GetBossTargetSlot() const {
+    // Nearest living player (lowest index on a tie); the first one once all are down
+    int target = 0;
+    float nearest = 0.0f;
+    bool found = false;
+    for (int i = 0; i < m_playerCount; ++i) {
+        const Player& player = *m_players[i];
+        if (!player.IsAlive()) continue;
+        float distance = Vector3DistanceSqr(player.GetPosition(), m_boss->GetPosition());
+        if (!found || distance < nearest) {
+            target = i;
+            nearest = distance;
+            found = true;
+        }
     }
-    if (IsKeyPressed(KEY_ESCAPE)) {
-        TransitionTo(GameState::MENU);
+    return target;
+}
+
+FlowTargets Game::GetFlowTargets() const {
+    FlowTargets targets = {};
+    for (int i = 0; i < m_playerCount; ++i) {
+        if (!m_players[i]->IsAlive()) continue;
+        Vector3 position = m_players[i]->GetPosition();
+        targets.cells[targets.count] = FlowField::GetCell(position.x, position.z);
+        targets.ids[targets.count] = static_cast<uint8_t>(i);
+        targets.count++;
     }
+    return targets;
 }
 
-void Game::DrawMenu() {
-    m_hud->DrawMenu();
+uint32_t Game::GetViewLag(int player) const {
+    uint32_t view = m_playerViewTick[player];
+    uint32_t now = GetTick();
+    if (view == 0 || view >= now) return 0;
+    return std::min(now - view, LAG_COMPENSATION_MAX_TICKS);
 }
 
-void Game::DrawSettings() {
-    m_hud->DrawSettings(m_selectedSetting);
+const AABB* Game::FindSeenHitbox(int entity, uint32_t lagTicks) const {
+    return lagTicks > 0 ? m_hitboxes.Find(GetTick() - lagTicks, entity) : nullptr;
 }
 
-void Game::DrawPlaying() {
-    BeginMode3D(m_cameraManager->GetCamera());
-    
-    DrawArena();
+void Game::RecordHitboxes() {
+    AABB boxes[HITBOX_ENTITIES];
+    boxes[HITBOX_BOSS] = m_boss->GetAABB();
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        boxes[GetPlayerHitbox(i)] = m_players[i]->GetAABB();
+    }
+    m_hitboxes.Record(GetTick(), boxes, m_boss->GetHitCapsules());
+}
+
+void Game::HandlePlayerAttack(int player) {
+    const GameConfig& config = m_config;
+    // Validate against the boss the attacker saw (the live one without lag)
+    const AABB* seen = FindSeenHitbox(HITBOX_BOSS, GetViewLag(player));
+    AABB bossAABB = seen ? *seen : m_boss->GetAABB();
+    if (bossAABB.Intersects(m_players[player]->GetAABB())) {
+        m_boss->TakeDamage(config.bossDamagePerHit);
+        m_events.Emit(HitEvent{EventEntity::BOSS, 0, config.bossDamagePerHit, m_boss->GetPosition()});
+    }
     
-    // Draw all entities
-    m_player->Draw();
-    m_boss->Draw();
+    // The swing also clears the minions around the attacker
+    Vector3 reach = Vector3Add(m_players[player]->GetAABB().GetHalfExtents(), {MINION_MELEE_REACH, 0.0f, MINION_MELEE_REACH});
+    m_horde.KillInBox(AABB::FromCenter(m_players[player]->GetPosition(), reach));
+}
+
+void Game::HandlePlayerShot(int player) {
+    if (m_timers.GetNow() < m_playerAttackReadyTick[player]) return;
     
-    for (const auto& tomato : m_tomatoes) {
-        tomato->Draw();
+    // Shoot projectile toward the boss where the shooter saw it; its hit tests
+    // keep looking the same number of ticks back
+    uint32_t lag = GetViewLag(player);
+    const AABB* seen = FindSeenHitbox(HITBOX_BOSS, lag);
+    Vector3 target = seen ? seen->GetCenter() : m_boss->GetPosition();
+    if (LaunchProjectile(m_playerProjectiles, m_players[player]->GetPosition(), target, m_config.projectileSpeed,
+                         seen ? lag : 0) != INVALID_ENTITY) {
+        m_playerAttackReadyTick[player] = m_timers.GetNow() + TimerWheel::SecondsToTicks(PLAYER_SHOT_COOLDOWN);
     }
-    
-    for (const auto& projectile : m_projectiles) {
-        projectile->Draw();
+}
+
+void Game::DebugFireBossVolley() {
+    while (m_bullets.GetCount() < DEBUG_VOLLEY_BULLETS) {
+        FireBossBullet();
     }
-    
-    for (const auto& projectile : m_playerProjectiles) {
-        projectile->Draw();
+}
+
+void Game::DebugStartBossPatterns() {
+    if (!m_patternRunner.IsIdle()) return;
+    for (int s = 0; s < BOSS_STATE_COUNT; ++s) {
+        int pattern = m_patterns.GetPatternFor(static_cast<BossState>(s));
+        if (pattern >= 0) {
+            m_patternRunner.Start(m_patterns, pattern, m_boss->GetPosition(), GetBossTarget().GetPosition());
+        }
+    }
+}
+
+void Game::DebugFillTomatoPool() {
+    for (int i = 0; i < MAX_TOMATOES; ++i) {
+        SpawnTomato();
     }
+}
+
+void Game::DebugFillHorde() {
+    SummonMinions(m_horde.GetCapacity());
+}
+
+void Game::DebugBurstEffects() {
+    // Every slot of the effect ring, on a circle around the local player; stamped
+    // with the coming tick, since the renderer already drew the current one
+    Vector3 center = LocalPlayer().GetPosition();
+    for (uint32_t i = 0; i < EFFECT_HISTORY; ++i) {
+        float angle = 2.0f * PI * static_cast<float>(i) / static_cast<float>(EFFECT_HISTORY);
+        Vector3 position = {center.x + DEBUG_BURST_RADIUS * cosf(angle), center.y,
+                            center.z + DEBUG_BURST_RADIUS * sinf(angle)};
+        AddEffect(static_cast<EffectKind>(i % static_cast<uint32_t>(EffectKind::COUNT)), position, m_tick + 1);
+    }
+}
+
+void Game::HandleBossAttack() {
+    int pattern = m_patterns.GetPatternFor(m_boss->GetState());
+    if (pattern >= 0) {
+        m_patternRunner.Start(m_patterns, pattern, m_boss->GetPosition(), GetBossTarget().GetPosition());
+    } else {
+        FireBossBullet();
+    }
+}
+
+void Game::FireBossBullet() {
+    uint32_t granted;
+    Bullet* bullet = m_bullets.Append(1, granted);
+    if (granted == 0) return;
     
-    EndMode3D();
+    Vector3 direction = Vector3Normalize(Vector3Subtract(GetBossTarget().GetPosition(), m_boss->GetPosition()));
+    *bullet = {m_boss->GetPosition(), Vector3Scale(direction, m_config.projectileSpeed), PROJECTILE_RADIUS, ORANGE};
+}
+
+Job* Game::ScheduleSimulation(JobSystem& jobs, bool minions) {
+    // Grid build, then steering, alongside projectile integration, then hits;
+    // contacts wait for both and are the sink. Hits and contacts both change
+    // the players, so they keep the serial order
+    uint32_t count = m_jobContext.bulletCount + m_jobContext.projectileCount;
+    Job* projectiles = jobs.CreateParallelFor(count, PROJECTILES_PER_JOB,
+                                              &Game::UpdateProjectilesJob, this);
+    Job* hits = jobs.Create(&Game::ApplyProjectileHitsJob, this);
+    Job* contacts = jobs.Create(&Game::ApplyContactsJob, this);
+    jobs.AddDependency(hits, projectiles);
+    jobs.AddDependency(contacts, hits);
+    if (minions) {
+        Job* grid = jobs.Create(&Game::BuildGridJob, this);
+        Job* steering = jobs.CreateParallelFor(m_horde.GetCount(), MINIONS_PER_JOB, &Game::SteerMinionsJob, this);
+        jobs.AddDependency(steering, grid);
+        jobs.AddDependency(contacts, steering);
+        jobs.Submit(steering);
+        jobs.Submit(grid);
+    }
+    // Dependents before their prerequisites, as every link must exist first
+    jobs.Submit(contacts);
+    jobs.Submit(hits);
+    jobs.Submit(projectiles);
+    return contacts;
+}
+
+void Game::UpdateProjectilesJob(void* context, uint32_t begin, uint32_t end) {
+    PROFILE_ZONE("Game::UpdateProjectiles");
     
-    // Draw HUD
-    m_hud->Draw(*m_player, *m_boss);
+    Game& game = *static_cast<Game*>(context);
+    const UpdateJobContext& frame = game.m_jobContext;
+    const uint32_t bulletCount = frame.bulletCount;
     
-    // Draw attack hint
-    float distance = Vector3Distance(m_player->GetPosition(), m_boss->GetPosition());
-    m_hud->DrawAttackHint(distance);
+    // Boss bullets hit the players, player projectiles hit the boss
+    if (begin < bulletCount) {
+        game.m_bullets.Update(begin, std::min(end, bulletCount), frame.deltaTime,
+                              frame.playerPositions, frame.playerCount, frame.playerRadius,
+                              game.m_projectileHits.data());
+    }
+    if (end > bulletCount) {
+        UpdateProjectiles(game.m_playerProjectiles, std::max(begin, bulletCount) - bulletCount, end - bulletCount,
+                          frame.deltaTime, frame.boss, game.m_projectileHits.data() + bulletCount);
+    }
 }
 
-void Game::DrawPaused() {
-    // Draw game in background
-    DrawPlaying();
-    
-    // Draw pause overlay
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
-    DrawText("PAUSED", SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 50, WHITE);
-    DrawText("Press P or ENTER to Continue", SCREEN_WIDTH / 2 - 180, SCREEN_HEIGHT / 2 + 20, 20, WHITE);
-    DrawText("Press ESC for Menu", SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 + 50, 20, WHITE);
+void Game::BuildGridJob(void* context, uint32_t, uint32_t) {
+    static_cast<Game*>(context)->m_horde.BuildGrid();
 }
 
-void Game::DrawGameOver() {
-    m_hud->DrawGameOver();
+void Game::SteerMinionsJob(void* context, uint32_t begin, uint32_t end) {
+    Game& game = *static_cast<Game*>(context);
+    const UpdateJobContext& frame = game.m_jobContext;
+    game.m_horde.Steer(begin, end, frame.deltaTime, frame.horde);
 }
 
-void Game::DrawVictory() {
-    m_hud->DrawVictory();
+void Game::ApplyProjectileHitsJob(void* context, uint32_t, uint32_t) {
+    static_cast<Game*>(context)->ApplyProjectileHits();
 }
 
-void Game::HandlePlayerAttack() {
-    auto& config = GameConfig::GetInstance();
-    if (m_boss->CheckCollisionWithPlayer(*m_player)) {
-        m_boss->TakeDamage(config.bossDamagePerHit);
-    }
+void Game::ApplyContactsJob(void* context, uint32_t, uint32_t) {
+    static_cast<Game*>(context)->ApplyContacts();
 }
 
-void Game::HandleBossAttack() {
-    for (auto& projectile : m_projectiles) {
-        if (!projectile->IsActive()) {
-            projectile->Launch(m_boss->GetPosition(), m_player->GetPosition());
-            break;
-        }
+void Game::ApplyContacts() {
+    if (m_horde.GetCount() > 0) {
+        m_horde.EndStep();
+        ApplyMinionContacts(m_jobContext.deltaTime);
     }
+    CheckTomatoCollection();
 }
 
-void Game::UpdateProjectiles(float deltaTime) {
-    auto& config = GameConfig::GetInstance();
-    for (auto& projectile : m_projectiles) {
-        projectile->Update(deltaTime);
-        
-        if (projectile->CheckCollision(m_player->GetPosition(), m_player->GetApproxRadius())) {
-            m_player->TakeDamage(config.playerDamagePerHit);
-        }
+void Game::ApplyMinionContacts(float deltaTime) {
+    // A swarmed player drains at one rate however many minions touch it. Like
+    // the passive time drain this is no HitEvent: one every tick would keep
+    // the hit flash lit and burst particles 60 times a second
+    float damage = HORDE_CONTACT_DAMAGE_PER_SECOND * deltaTime;
+    uint32_t contacts = m_horde.GetContacts();
+    for (int player = 0; player < m_playerCount; ++player) {
+        if (!(contacts & (1u << player))) continue;
+        m_players[player]->TakeDamage(damage);
     }
 }
 
-void Game::UpdateTomatoes(float deltaTime) {
-    for (auto& tomato : m_tomatoes) {
-        tomato->Update(deltaTime);
+void Game::ApplyProjectileHits() {
+    PROFILE_ZONE("Collision");
+    
+    const GameConfig& config = m_config;
+    const uint32_t bulletCount = m_jobContext.bulletCount;
+    const Bullet* bullets = m_bullets.GetData();
+    for (uint32_t i = 0; i < bulletCount; ++i) {
+        if (!m_projectileHits[i]) continue;
+        uint8_t player = m_jobContext.playerIndices[m_projectileHits[i] - 1];
+        m_players[player]->TakeDamage(config.playerDamagePerHit);
+        m_events.Emit(HitEvent{EventEntity::PLAYER, player, config.playerDamagePerHit, bullets[i].position});
     }
+    uint8_t* status = m_projectileHits.data() + bulletCount;
+    const Position* positions = m_playerProjectiles.Get<Position>();
+    for (uint32_t row = 0; row < m_jobContext.projectileCount; ++row) {
+        if (status[row] != PROJECTILE_HIT) continue;
+        m_boss->TakeDamage(config.playerDamagePerHit);
+        m_events.Emit(HitEvent{EventEntity::BOSS, 0, config.playerDamagePerHit, positions[row].value});
+    }
+    m_bullets.RemoveDead();
+    RemoveFinishedProjectiles(m_playerProjectiles, status);
 }
 
 void Game::CheckTomatoCollection() {
-    auto& config = GameConfig::GetInstance();
-    for (auto& tomato : m_tomatoes) {
-        if (tomato->CheckCollision(m_player->GetPosition(), m_player->GetApproxRadius())) {
-            m_player->Heal(config.tomatoHealAmount);
-            tomato->OnCollect();
+    PROFILE_ZONE("Collision");
+    
+    const GameConfig& config = m_config;
+    uint32_t row = 0;
+    while (row < m_tomatoes.GetCount()) {
+        // First living player in reach collects it
+        bool collected = false;
+        for (int p = 0; p < m_playerCount && !collected; ++p) {
+            Player& player = *m_players[p];
+            if (!player.IsAlive() || !OverlapsSphere(m_tomatoes, row, player.GetPosition(), player.GetApproxRadius())) {
+                continue;
+            }
+            player.Heal(config.tomatoHealAmount);
+            m_events.Emit(HealEvent{static_cast<uint8_t>(p), config.tomatoHealAmount, player.GetPosition()});
+            m_events.Emit(CollectEvent{m_tomatoes.GetEntity(row), m_tomatoes.Get<Position>()[row].value});
+            CollectTomato(m_tomatoes, m_timers, row);   // The last row moves here: check it next
+            collected = true;
         }
+        if (!collected) ++row;
     }
 }
 
-void Game::SpawnTomato() {
-    for (auto& tomato : m_tomatoes) {
-        if (!tomato->IsActive()) {
-            float x = static_cast<float>(GetRandomValue(-ARENA_SIZE + 50, ARENA_SIZE - 50));
-            float z = static_cast<float>(GetRandomValue(-ARENA_SIZE + 50, ARENA_SIZE - 50));
-            tomato->Spawn(x, ARENA_FLOOR_Y + TOMATO_RADIUS, z);  // Spawn on arena floor
-            break;
+void Game::OnBossStateChanged(void*, const StateChangedEvent* events, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        Profiler::GetInstance().Marker(GetStateMarkerName(events[i].to));
+        TM_LOG_DEBUG(BOSS, "Boss: %s -> %s", GetBossStateName(events[i].from), GetBossStateName(events[i].to));
+    }
+}
+
+void Game::OnHit(void* context, const HitEvent* events, uint32_t count) {
+    Game& game = *static_cast<Game*>(context);
+    for (uint32_t i = 0; i < count; ++i) {
+        const HitEvent& hit = events[i];
+        bool boss = hit.target == EventEntity::BOSS;
+        game.AddEffect(boss ? EffectKind::BOSS_HIT : EffectKind::PLAYER_HIT, hit.position, game.m_tick);
+        if (!boss && hit.player == game.m_localPlayer) {
+            game.m_playerHitTick = game.m_tick;
         }
     }
 }
 
-void Game::DrawArena() const {
-    if (m_arenaModelLoaded) {
-        // Draw the 3D arena model much lower to account for model's center/top origin
-        DrawModel(m_arenaModel, {0.0f, ARENA_MODEL_Y, 0.0f}, 1.0f, WHITE);
+void Game::OnHeal(void* context, const HealEvent* events, uint32_t count) {
+    Game& game = *static_cast<Game*>(context);
+    for (uint32_t i = 0; i < count; ++i) {
+        game.AddEffect(EffectKind::HEAL, events[i].position, game.m_tick);
+    }
+}
+
+void Game::OnCollect(void* context, const CollectEvent* events, uint32_t count) {
+    Game& game = *static_cast<Game*>(context);
+    for (uint32_t i = 0; i < count; ++i) {
+        game.AddEffect(EffectKind::PICKUP, events[i].position, game.m_tick);
+    }
+}
+
+void Game::WriteState(StateWriter& writer, StateEncoding encoding) const {
+    GameRecord record;
+    record.state = m_state;
+    record.timerNow = m_timers.GetNow();
+    record.timerSequence = m_timers.GetSequence();
+    record.random = m_random.GetState();
+    record.tomatoSpawnTimer = m_timers.SaveTimer(m_tomatoSpawnTimer);
+    record.hordeWaveTimer = m_timers.SaveTimer(m_hordeWaveTimer);
+    record.flowField = m_flowField.Save();
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        record.playerAttackReadyTick[i] = m_playerAttackReadyTick[i];
+        record.players[i] = m_players[i]->SaveRecord();
+    }
+    record.boss = m_boss->SaveRecord();
+    record.emitterCount = static_cast<uint32_t>(m_patternRunner.GetActiveEmitters());
+    
+    TimerRecord tomatoTimers[MAX_TOMATOES];
+    SaveTomatoTimers(m_tomatoes, m_timers, tomatoTimers);
+    
+    writer.Write(record);
+    m_playerProjectiles.Write(writer);
+    m_tomatoes.Write(writer);
+    writer.WriteArray(tomatoTimers, m_tomatoes.GetCount());
+    if (encoding == StateEncoding::REWIND) {
+        m_horde.WriteRewind(writer);
     } else {
-        // Fallback to simple arena rendering
-        DrawPlane({0.0f, ARENA_FLOOR_Y, 0.0f}, {ARENA_SIZE * 2, ARENA_SIZE * 2}, LIGHTGRAY);
-        DrawGrid(40, 50.0f);
-        
-        // Draw arena walls
-        DrawCubeWires({0, 50, -ARENA_SIZE}, ARENA_SIZE * 2, 100, 2, DARKGRAY);
-        DrawCubeWires({0, 50, ARENA_SIZE}, ARENA_SIZE * 2, 100, 2, DARKGRAY);
-        DrawCubeWires({-ARENA_SIZE, 50, 0}, 2, 100, ARENA_SIZE * 2, DARKGRAY);
-        DrawCubeWires({ARENA_SIZE, 50, 0}, 2, 100, ARENA_SIZE * 2, DARKGRAY);
+        m_horde.Write(writer);
+    }
+    writer.WriteArray(m_patternRunner.GetEmitters(), record.emitterCount);
+    if (encoding == StateEncoding::REWIND) {
+        m_bullets.WriteRewind(writer, m_rewind->GetKeyframeAge());
+    } else {
+        m_bullets.Write(writer);
+    }
+}
+
+void Game::ReadState(StateReader& reader, StateEncoding encoding) {
+    GameRecord record;
+    if (!reader.Read(record)) return;
+    
+    if (record.state != m_state) {
+        TransitionTo(record.state);
+    }
+    
+    // Timers are not saved as such: owners restore theirs, schedule order included
+    m_timers.Restart(record.timerNow, record.timerSequence);
+    m_random.SetState(record.random);
+    m_tomatoSpawnTimer = m_timers.RestoreTimer(record.tomatoSpawnTimer, &Game::TomatoSpawnTimerExpired, this);
+    m_hordeWaveTimer = m_timers.RestoreTimer(record.hordeWaveTimer, &Game::HordeWaveTimerExpired, this);
+    m_flowField.Restore(record.flowField);
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        m_playerAttackReadyTick[i] = record.playerAttackReadyTick[i];
+        m_players[i]->LoadRecord(record.players[i]);
+    }
+    m_boss->LoadRecord(record.boss);
+    m_playerProjectiles.Read(reader);
+    TimerRecord tomatoTimers[MAX_TOMATOES];
+    if (!m_tomatoes.Read(reader) || !reader.ReadArray(tomatoTimers, m_tomatoes.GetCount())) {
+        m_tomatoes.Clear();
+    }
+    RestoreTomatoTimers(m_tomatoes, m_timers, tomatoTimers);
+    if (encoding == StateEncoding::REWIND) {
+        m_horde.ReadRewind(reader);
+    } else {
+        m_horde.Read(reader);
+    }
+    
+    PatternEmitter emitters[MAX_PATTERN_EMITTERS];
+    uint32_t emitterCount = std::min<uint32_t>(record.emitterCount, MAX_PATTERN_EMITTERS);
+    reader.ReadArray(emitters, emitterCount);
+    m_patternRunner.Restore(emitters, static_cast<int>(emitterCount));
+    
+    if (encoding == StateEncoding::REWIND) {
+        m_bullets.ReadRewind(reader);
+    } else {
+        m_bullets.Read(reader);
     }
 }
 
+uint32_t Game::SaveState(uint32_t* words, uint32_t capacity) const {
+    PROFILE_ZONE("Game::SaveState");
+    
+    StateWriter writer(words, capacity);
+    WriteState(writer, StateEncoding::EXACT);
+    return writer.HasOverflowed() ? 0 : writer.GetWordCount();
+}
+
+void Game::LoadState(const uint32_t* words, uint32_t count) {
+    PROFILE_ZONE("Game::LoadState");
+    
+    StateReader reader(words, count);
+    ReadState(reader, StateEncoding::EXACT);
+}
+
+uint32_t Game::GetMaxStateWords() {
+    return MAX_STATE_WORDS;
+}
+
+void Game::CaptureRewindFrame() {
+    StateWriter writer(m_rewind->GetFrame(), m_rewind->GetMaxFrameWords());
+    WriteState(writer, StateEncoding::REWIND);
+    m_rewind->Push(writer.GetWordCount());
+}
+
+void Game::RewindStep() {
+    // Step back REWIND_FRAMES_PER_TICK frames, then keep the restored frame
+    // as the newest one so history never runs dry and resuming continues from it
+    uint32_t words = 0;
+    int popped = 0;
+    while (popped <= REWIND_FRAMES_PER_TICK && m_rewind->Pop(words)) {
+        popped++;
+    }
+    if (popped == 0) return;
+    
+    StateReader reader(m_rewind->GetFrame(), words);
+    ReadState(reader, StateEncoding::REWIND);
+    m_rewind->Push(words);
+}
+
+void Game::TomatoSpawnTimerExpired(void* context, uint32_t) {
+    Game& game = *static_cast<Game*>(context);
+    if (game.m_random.Range(0, 1) == 1) {
+        game.SpawnTomato();
+    }
+    game.m_tomatoSpawnTimer = game.m_timers.Schedule(TimerWheel::SecondsToTicks(TOMATO_SPAWN_SECONDS),
+                                                     &Game::TomatoSpawnTimerExpired, context);
+}
+
+void Game::SpawnTomato() {
+    if (m_tomatoes.IsFull()) return;
+    
+    float x = static_cast<float>(m_random.Range(-ARENA_SIZE + 50, ARENA_SIZE - 50));
+    float z = static_cast<float>(m_random.Range(-ARENA_SIZE + 50, ARENA_SIZE - 50));
+    TimeMaster::SpawnTomato(m_tomatoes, m_timers, {x, ARENA_FLOOR_Y + TOMATO_RADIUS, z}, m_config.tomatoLifetime);  // On the floor
+}
+
+void Game::HordeWaveTimerExpired(void* context, uint32_t) {
+    Game& game = *static_cast<Game*>(context);
+    game.SummonMinions(HORDE_WAVE_MINIONS);
+    game.m_hordeWaveTimer = game.m_timers.Schedule(TimerWheel::SecondsToTicks(HORDE_WAVE_SECONDS),
+                                                   &Game::HordeWaveTimerExpired, context);
+}
+
+void Game::SummonMinions(uint32_t count) {
+    m_horde.Spawn(m_boss->GetPosition(), HORDE_SPAWN_INNER_RADIUS, HORDE_SPAWN_OUTER_RADIUS, count, m_random);
+    if (m_rewind) {
+        m_rewind->GrowStorage(GetRewindStorageBytes(m_horde.GetCount()));
+    }
+}
+
+void Game::AddEffect(EffectKind kind, Vector3 position, uint64_t tick) {
+    m_effects[m_effectHead] = {tick, position, kind};
+    m_effectHead = (m_effectHead + 1) % EFFECT_HISTORY;
+    m_effectCount = std::min(m_effectCount + 1, EFFECT_HISTORY);
+}
+
 void Game::TransitionTo(GameState newState) {
     m_state = newState;
     
-    // Handle cursor state based on game state
+    // Handle cursor state based on game state (applied by the renderer)
     switch (newState) {
         case GameState::MENU:
         case GameState::SETTINGS:
         case GameState::PAUSED:
         case GameState::GAME_OVER:
         case GameState::VICTORY:
-            EnableCursor();
+            m_cameraManager->SetCursorLocked(false);
             break;
         case GameState::PLAYING:
-            DisableCursor();
+            m_cameraManager->SetCursorLocked(true);
             break;
     }
 }
@@ -0,0 +1,132 @@
+#include "GameAssets.hpp"
+#include "Log.hpp"
+
+namespace TimeMaster {
+
+namespace {
+
+ModelAsset EmptyAsset() {
+    ModelAsset asset;
+    asset.model = (Model){0};
+    asset.animations = nullptr;
+    asset.animationCount = 0;
+    asset.hitboxes = BoneHitboxRig{};
+    asset.loaded = false;
+    return asset;
+}
+
+void UnloadAsset(ModelAsset& asset) {
+    if (asset.loaded) {
+        ::UnloadModel(asset.model);
+        if (asset.animations) {
+            ::UnloadModelAnimations(asset.animations, asset.animationCount);
+        }
+    }
+    asset = EmptyAsset();
+}
+
+} // namespace
+
+GameAssets::GameAssets()
+    : m_player(EmptyAsset())
+    , m_boss(EmptyAsset())
+    , m_tomato(EmptyAsset()) {
+}
+
+GameAssets::~GameAssets() {
+    Unload();
+}
+
+void GameAssets::Load() {
+    if (!m_player.loaded) LoadPlayer();
+    if (!m_boss.loaded) LoadBoss();
+    if (!m_tomato.loaded) LoadTomato();
+    LoadData();
+}
+
+void GameAssets::LoadData() {
+    if (m_patterns.GetPatternCount() == 0) m_patterns.LoadFile(BULLET_PATTERNS_PATH);
+}
+
+void GameAssets::Unload() {
+    UnloadAsset(m_player);
+    UnloadAsset(m_boss);
+    UnloadAsset(m_tomato);
+    m_patterns.Clear();
+}
+
+void GameAssets::LoadPlayer() {
+    const char* modelPath = "assets/models/player/scene.gltf";
+    Model model = ::LoadModel(modelPath);
+
+    if (model.meshCount > 0 && model.meshes != nullptr) {
+        m_player.model = model;
+        m_player.animations = ::LoadModelAnimations(modelPath, &m_player.animationCount);
+        m_player.loaded = true;
+
+        TM_LOG_INFO(ASSETS, "Player model loaded with %d animations", m_player.animationCount);
+
+        for (int i = 0; i < m_player.animationCount; i++) {
+            TM_LOG_INFO(ASSETS, "  Animation %d: %s (%d frames)",
+                        i, m_player.animations[i].name, m_player.animations[i].frameCount);
+        }
+
+        for (int i = 0; i < model.materialCount; i++) {
+            if (model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture.id > 0) {
+                SetTextureFilter(
+                    model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture,
+                    TEXTURE_FILTER_BILINEAR
+                );
+            }
+        }
+    }
+}
+
+void GameAssets::LoadBoss() {
+    const char* modelPath = "assets/models/plant_boss/scene.gltf";
+    
+    if (FileExists(modelPath)) {
+        m_boss.model = ::LoadModel(modelPath);  // Use global Raylib function
+        m_boss.animations = ::LoadModelAnimations(modelPath, &m_boss.animationCount);
+        m_boss.loaded = true;
+        TM_LOG_INFO(ASSETS, "Boss model loaded successfully!");
+        TM_LOG_INFO(ASSETS, "  Animations found: %d", m_boss.animationCount);
+        
+        // Print info about each animation
+        for (int i = 0; i < m_boss.animationCount; i++) {
+            TM_LOG_INFO(ASSETS, "  Animation %d: %d frames", i, m_boss.animations[i].frameCount);
+        }
+        
+        // Print model bounds for debugging
+        BoundingBox bounds = GetModelBoundingBox(m_boss.model);
+        TM_LOG_DEBUG(ASSETS, "  Model bounds: min(%.2f, %.2f, %.2f) max(%.2f, %.2f, %.2f)",
+                     bounds.min.x, bounds.min.y, bounds.min.z,
+                     bounds.max.x, bounds.max.y, bounds.max.z);
+        Vector3 modelSize = {
+            bounds.max.x - bounds.min.x,
+            bounds.max.y - bounds.min.y,
+            bounds.max.z - bounds.min.z
+        };
+        TM_LOG_DEBUG(ASSETS, "  Model size: (%.2f, %.2f, %.2f)", modelSize.x, modelSize.y, modelSize.z);
+        TM_LOG_DEBUG(ASSETS, "  Using fixed scale: 12.0 (hitbox is for collision only, not visual sizing)");
+        
+        FitBoneHitboxes(m_boss.model, m_boss.hitboxes);
+        TM_LOG_INFO(ASSETS, "  Bone hit capsules: %u", m_boss.hitboxes.count);
+    } else {
+        TM_LOG_WARNING(ASSETS, "Boss model not found at %s", modelPath);
+    }
+}
+
+void GameAssets::LoadTomato() {
+    Model model = ::LoadModel("assets/models/tomato/scene.gltf");
+    // Check if model loaded successfully with valid meshes and materials
+    if (model.meshCount > 0 && model.meshes != nullptr) {
+        m_tomato.model = model;
+        m_tomato.loaded = true;
+        TM_LOG_INFO(ASSETS, "Tomato model loaded successfully");
+    } else {
+        TM_LOG_WARNING(ASSETS, "Failed to load tomato model - using fallback rendering");
+    }
+}
+
+} // namespace TimeMaster
@@ -1,12 +1,25 @@
 #include "HUD.hpp"
-#include "Player.hpp"
-#include "Boss.hpp"
+#include "AllocTracker.hpp"
 #include "Config.hpp"
+#include "FrameSnapshot.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
 #include "raymath.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 
 namespace TimeMaster {
 
+namespace {
+// m:ss, as the entities' FormatTime
+void FormatClock(float time, char* buffer, size_t size) {
+    int minutes = static_cast<int>(time / 60);
+    int seconds = static_cast<int>(time) % 60;
+    snprintf(buffer, size, "%d:%02d", minutes, seconds);
+}
+}
+
 HUD::HUD() : m_fontLoaded(false) {
     // Initialize font to zero
     m_font = {0};
@@ -25,26 +38,75 @@ HUD::~HUD() {
     // Manual unload causes issues with some graphics drivers
 }
 
-void HUD::Draw(const Player& player, const Boss& boss) {
+void HUD::Draw(const FrameSnapshot& frame) {
+    PROFILE_ZONE("HUD::Draw");
+    
     // Draw HUD background
     DrawRectangle(0, 0, SCREEN_WIDTH, 80, Fade(LIGHTGRAY, 0.9f));
     DrawLine(0, 80, SCREEN_WIDTH, 80, BLACK);
     
     // Draw player time
-    std::string playerTimeStr = player.GetTimeString();
+    float playerTime = frame.player.time;
+    char playerTimeStr[16];
+    FormatClock(playerTime, playerTimeStr, sizeof(playerTimeStr));
     DrawTimerDisplay("YOUR TIME:", playerTimeStr, 20, 15, DARKBLUE, 
-                    player.GetTime() < 20 ? RED : BLUE);
+                    playerTime < 20 ? RED : BLUE);
     
     // Draw player time bar
-    auto& config = GameConfig::GetInstance();
-    DrawTimeBar(300, 30, player.GetTime(), config.playerMaxTime, SKYBLUE);
+    const ConfigSnapshot& config = frame.config;
+    DrawTimeBar(300, 30, playerTime, config.playerMaxTime, SKYBLUE);
+    
+    // Co-op partners' time under the bar
+    for (int i = 0; i < frame.partnerCount; ++i) {
+        char partnerTimeStr[16];
+        FormatClock(frame.partners[i].time, partnerTimeStr, sizeof(partnerTimeStr));
+        DrawTextWithFont(TextFormat("PARTNER: %s", frame.partners[i].alive ? partnerTimeStr : "DOWN"),
+                         300, 55 + 18 * i, 16, DARKGREEN);
+    }
     
     // Draw boss health as a clock instead of a bar
     DrawTextWithFont("BOSS HP:", SCREEN_WIDTH - 200, 15, 25, RED);
-    DrawClockDisplay(SCREEN_WIDTH - 95, 45, boss.GetTime(), config.bossStartingTime, 28);
+    DrawClockDisplay(SCREEN_WIDTH - 95, 45, frame.boss.time, config.bossStartingTime, 28);
+    if (frame.mode == MatchMode::HORDE) {
+        DrawTextWithFont(TextFormat("MINIONS: %u", frame.minionCount), SCREEN_WIDTH - 420, 15, 25, DARKGREEN);
+    }
+    
+    // Draw controls hint (no rewind in a networked match)
+    DrawTextWithFont(frame.net.active ? "WASD: Move | LMB: Shoot | SPACE: Melee"
+                                      : "WASD: Move | LMB: Shoot | SPACE: Melee | R: Rewind",
+                     10, SCREEN_HEIGHT - 25, 18, DARKGRAY);
+    if (frame.net.active) {
+        DrawNetStatus(frame.net);
+    }
     
-    // Draw controls hint
-    DrawTextWithFont("WASD: Move | LMB: Shoot | SPACE: Melee", 10, SCREEN_HEIGHT - 25, 18, DARKGRAY);
+    // Rewind overlay with the history left to scrub
+    if (frame.rewinding) {
+        char rewindStr[32];
+        snprintf(rewindStr, sizeof(rewindStr), "<< REWIND  %.1fs", frame.rewindSeconds);
+        DrawRectangle(0, 80, SCREEN_WIDTH, SCREEN_HEIGHT - 80, Fade(SKYBLUE, 0.15f));
+        DrawTextWithFont(rewindStr, SCREEN_WIDTH / 2 - 110, 100, 30, DARKBLUE);
+    }
+    
+    // Flash the screen edge when the player is hit
+    if (frame.playerHitFlash > 0.0f) {
+        Color flash = Fade(RED, 0.6f * frame.playerHitFlash);
+        DrawRectangleLinesEx({0, 0, static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)}, 12.0f, flash);
+    }
+}
+
+void HUD::DrawNetStatus(const NetSnapshot& net) {
+    int x = SCREEN_WIDTH - 260;
+    int y = 90;
+    if (!net.connected) {
+        DrawTextWithFont("CO-OP: waiting for partner...", x, y, 16, ORANGE);
+        return;
+    }
+    DrawTextWithFont(TextFormat("CO-OP P%d  ping %.0f ms", net.localPlayer + 1, net.pingMs), x, y, 16, DARKGRAY);
+    DrawTextWithFont(TextFormat("rollbacks %u (last %d)  stalls %u", net.rollbacks, net.lastRollbackTicks, net.stalls),
+                     x, y + 18, 14, GRAY);
+    if (net.desynced) {
+        DrawTextWithFont("DESYNC", x, y + 36, 20, RED);
+    }
 }
 
 void HUD::DrawMenu() {
@@ -58,11 +120,10 @@ void HUD::DrawMenu() {
     DrawTextWithFont("Time decreases automatically!", SCREEN_WIDTH / 2 - 250, 530, 20, ORANGE);
     DrawTextWithFont("Press ENTER to Start", SCREEN_WIDTH / 2 - 150, 600, 25, GREEN);
     DrawTextWithFont("Press S for Settings", SCREEN_WIDTH / 2 - 140, 640, 20, BLUE);
+    DrawTextWithFont("Press H for Minion Horde", SCREEN_WIDTH / 2 - 160, 670, 20, DARKGREEN);
 }
 
-void HUD::DrawSettings(int selectedOption) {
-    auto& config = GameConfig::GetInstance();
-    
+void HUD::DrawSettings(int selectedOption, const ConfigSnapshot& config) {
     DrawTextWithFont("SETTINGS", SCREEN_WIDTH / 2 - 100, 50, 40, DARKBLUE);
     DrawTextWithFont("Use UP/DOWN to select, LEFT/RIGHT to adjust, R to reset", SCREEN_WIDTH / 2 - 300, 110, 18, GRAY);
     
@@ -121,16 +182,18 @@ void HUD::DrawSettings(int selectedOption) {
     DrawTextWithFont("Press ESC or ENTER to return to menu", SCREEN_WIDTH / 2 - 200, SCREEN_HEIGHT - 60, 20, GREEN);
 }
 
-void HUD::DrawGameOver() {
+void HUD::DrawGameOver(bool canRetry) {
     DrawTextWithFont("GAME OVER", SCREEN_WIDTH / 2 - 150, 300, 50, RED);
     DrawTextWithFont("You ran out of time!", SCREEN_WIDTH / 2 - 130, 370, 25, DARKGRAY);
+    if (!canRetry) return;
     DrawTextWithFont("Press ENTER to Retry", SCREEN_WIDTH / 2 - 130, 450, 25, GREEN);
     DrawTextWithFont("Press ESC for Menu", SCREEN_WIDTH / 2 - 120, 490, 20, GRAY);
 }
 
-void HUD::DrawVictory() {
+void HUD::DrawVictory(bool canRetry) {
     DrawTextWithFont("VICTORY!", SCREEN_WIDTH / 2 - 120, 300, 50, GOLD);
     DrawTextWithFont("You defeated the Boss!", SCREEN_WIDTH / 2 - 140, 370, 25, DARKGRAY);
+    if (!canRetry) return;
     DrawTextWithFont("Press ENTER to Play Again", SCREEN_WIDTH / 2 - 150, 450, 25, GREEN);
     DrawTextWithFont("Press ESC for Menu", SCREEN_WIDTH / 2 - 120, 490, 20, GRAY);
 }
@@ -141,6 +204,134 @@ void HUD::DrawAttackHint(float distance) {
     }
 }
 
+void HUD::DrawProfilerOverlay(Profiler& profiler) {
+    const int panelWidth = 480;
+    const int rowHeight = 14;
+    const int graphHeight = 80;
+    const float graphMaxMs = 50.0f;
+    int zoneCount = profiler.GetZoneCount();
+    int x = SCREEN_WIDTH - panelWidth - 10;
+    int y = 90;
+    int panelHeight = 40 + (zoneCount + 1) * rowHeight + graphHeight + 20;
+    
+    DrawRectangle(x, y, panelWidth, panelHeight, Fade(BLACK, 0.75f));
+    DrawRectangleLines(x, y, panelWidth, panelHeight, DARKGRAY);
+    
+    // Header: whole-frame statistics
+    ZoneStats frame = profiler.GetFrameStats();
+    DrawText(TextFormat("PROFILER (F3)  frame avg %.2f  p95 %.2f  p99 %.2f ms",
+                        frame.average, frame.p95, frame.p99),
+             x + 8, y + 6, 10, RAYWHITE);
+    DrawText("zone", x + 8, y + 24, 10, GRAY);
+    DrawText("avg", x + 250, y + 24, 10, GRAY);
+    DrawText("p95", x + 310, y + 24, 10, GRAY);
+    DrawText("p99", x + 370, y + 24, 10, GRAY);
+    bool trackingAllocs = AllocTracker::IsEnabled();
+    if (trackingAllocs) {
+        DrawText("allocs", x + 425, y + 24, 10, GRAY);
+    }
+    
+    // Per-zone rows
+    int rowY = y + 24 + rowHeight;
+    for (int i = 0; i < zoneCount; i++) {
+        ZoneStats stats = profiler.GetZoneStats(static_cast<ZoneId>(i));
+        Color rowColor = (stats.p99 > 4.0f) ? ORANGE : RAYWHITE;
+        DrawText(profiler.GetZoneName(static_cast<ZoneId>(i)), x + 8, rowY, 10, rowColor);
+        DrawText(TextFormat("%.3f", stats.average), x + 250, rowY, 10, rowColor);
+        DrawText(TextFormat("%.3f", stats.p95), x + 310, rowY, 10, rowColor);
+        DrawText(TextFormat("%.3f", stats.p99), x + 370, rowY, 10, rowColor);
+        if (trackingAllocs) {
+            uint32_t allocs = AllocTracker::GetInstance().GetLastZoneAllocations(static_cast<uint16_t>(i));
+            DrawText(TextFormat("%u", allocs), x + 425, rowY, 10, allocs > 0 ? RED : RAYWHITE);
+        }
+        rowY += rowHeight;
+    }
+    
+    // Frame-time graph (newest on the right)
+    int graphX = x + 8;
+    int graphY = rowY + 8;
+    int graphWidth = panelWidth - 16;
+    DrawRectangle(graphX, graphY, graphWidth, graphHeight, Fade(DARKGRAY, 0.5f));
+    
+    int historyCount = profiler.GetHistoryCount();
+    float barWidth = static_cast<float>(graphWidth) / PROFILER_HISTORY_FRAMES;
+    for (int i = 0; i < historyCount; i++) {
+        float ms = profiler.GetFrameTime(i);
+        int barHeight = static_cast<int>(std::min(ms / graphMaxMs, 1.0f) * graphHeight);
+        int barX = graphX + graphWidth - static_cast<int>((i + 1) * barWidth);
+        Color barColor = (ms > 33.4f) ? RED : (ms > 16.8f) ? ORANGE : GREEN;
+        DrawRectangle(barX, graphY + graphHeight - barHeight,
+                      std::max(1, static_cast<int>(barWidth)), barHeight, barColor);
+    }
+    
+    // 60 FPS and 30 FPS budget lines
+    int line60 = graphY + graphHeight - static_cast<int>(16.7f / graphMaxMs * graphHeight);
+    int line30 = graphY + graphHeight - static_cast<int>(33.3f / graphMaxMs * graphHeight);
+    DrawLine(graphX, line60, graphX + graphWidth, line60, Fade(SKYBLUE, 0.8f));
+    DrawLine(graphX, line30, graphX + graphWidth, line30, Fade(RED, 0.8f));
+    
+    uint32_t dropped = profiler.GetDroppedEventCount();
+    if (dropped > 0) {
+        DrawText(TextFormat("dropped events: %u", dropped), graphX, graphY + graphHeight + 4, 10, RED);
+    }
+    if (trackingAllocs) {
+        const AllocCounters& allocs = AllocTracker::GetInstance().GetLastFrame();
+        DrawText(TextFormat("heap allocs/frame (F7): %u  (%llu bytes)", allocs.allocations,
+                            static_cast<unsigned long long>(allocs.bytes)),
+                 graphX + 200, graphY + graphHeight + 4, 10, allocs.allocations > 0 ? RED : GREEN);
+    }
+}
+
+void HUD::DrawTraceCaptureStatus(const Profiler& profiler) {
+    int x = 10;
+    int y = SCREEN_HEIGHT - 50;
+    if (profiler.IsCapturing()) {
+        float progress = profiler.GetCaptureProgress();
+        DrawCircle(x + 6, y + 6, 5, RED);
+        DrawText(TextFormat("CAPTURING TRACE %3d%%", static_cast<int>(progress * 100.0f)),
+                 x + 16, y, 12, RED);
+    } else if (!profiler.GetLastCapturePath().empty()) {
+        DrawText(TextFormat("Trace saved: %s (F4 to capture again)", profiler.GetLastCapturePath().c_str()),
+                 x, y, 12, DARKGRAY);
+    }
+}
+
+void HUD::DrawRenderStatsOverlay(const RenderStats& stats) {
+    const int panelWidth = 230;
+    const int rowHeight = 14;
+    int x = 10;
+    int y = SCREEN_HEIGHT - 170;
+    int panelHeight = 24 + 6 * rowHeight + 8;
+    
+    DrawRectangle(x, y, panelWidth, panelHeight, Fade(BLACK, 0.75f));
+    DrawRectangleLines(x, y, panelWidth, panelHeight, DARKGRAY);
+    
+    if (stats.IsRecording()) {
+        DrawCircle(x + panelWidth - 12, y + 11, 5, RED);
+        DrawText(TextFormat("RENDER STATS (F5)  CSV %zu", stats.GetRecordedFrames()), x + 8, y + 6, 10, RED);
+    } else {
+        DrawText("RENDER STATS (F5)  F6: CSV", x + 8, y + 6, 10, RAYWHITE);
+    }
+    
+    const RenderCounters& frame = stats.GetLastFrame();
+    int rowY = y + 24;
+    auto row = [&](const char* label, const char* value) {
+        DrawText(label, x + 8, rowY, 10, GRAY);
+        DrawText(value, x + 130, rowY, 10, RAYWHITE);
+        rowY += rowHeight;
+    };
+    row("draw calls", TextFormat("%u", frame.drawCalls));
+    row("triangles", TextFormat("%u", frame.triangles));
+    row("skinned vertices", TextFormat("%u", frame.skinnedVertices));
+    row("uploaded", TextFormat("%.1f KB", static_cast<double>(frame.uploadBytes) / 1024.0));
+    row("texture binds", TextFormat("%u", frame.textureBinds));
+    row("shader switches", TextFormat("%u", frame.shaderSwitches));
+    
+    if (!stats.IsRecording() && !stats.GetLastCsvPath().empty()) {
+        DrawText(TextFormat("Saved %s", stats.GetLastCsvPath().c_str()), x, y - 14, 10, DARKGRAY);
+    }
+}
+
 void HUD::DrawTimeBar(int x, int y, float current, float max, Color color) {
     const int width = 250;
     const int height = 30;
@@ -152,10 +343,10 @@ void HUD::DrawTimeBar(int x, int y, float current, float max, Color color) {
     DrawRectangleLines(x, y, width, height, BLACK);
 }
 
-void HUD::DrawTimerDisplay(const std::string& label, const std::string& time,
+void HUD::DrawTimerDisplay(const char* label, const char* time,
                           int x, int y, Color labelColor, Color timeColor) {
-    DrawTextWithFont(label.c_str(), x, y, 25, labelColor);
-    DrawTextWithFont(time.c_str(), x, y + 30, 30, timeColor);
+    DrawTextWithFont(label, x, y, 25, labelColor);
+    DrawTextWithFont(time, x, y + 30, 30, timeColor);
 }
 
 void HUD::DrawClockDisplay(int x, int y, float current, float max, int radius) {
@@ -208,9 +399,9 @@ void HUD::DrawClockDisplay(int x, int y, float current, float max, int radius) {
     DrawCircle(x, y, 3, BLACK);
     
     // Draw time text in center
-    std::string timeText = TextFormat("%.0f", current);
-    int textWidth = MeasureText(timeText.c_str(), 14);
-    DrawText(timeText.c_str(), x - textWidth / 2, y + radius + 5, 14, BLACK);
+    const char* timeText = TextFormat("%.0f", current);
+    int textWidth = MeasureText(timeText, 14);
+    DrawText(timeText, x - textWidth / 2, y + radius + 5, 14, BLACK);
 }
 
 void HUD::DrawTextWithFont(const char* text, int x, int y, int fontSize, Color color) {
@@ -0,0 +1,24 @@
+#include "HitboxHistory.hpp"
+
+namespace TimeMaster {
+
+HitboxHistory::HitboxHistory() {
+    Clear();
+}
+
+void HitboxHistory::Clear() {
+    for (Frame& frame : m_frames) {
+        frame.tick = 0;
+    }
+}
+
+void HitboxHistory::Record(uint32_t tick, const AABB* boxes, const CapsuleSet& bossCapsules) {
+    Frame& frame = m_frames[tick & (HITBOX_HISTORY_TICKS - 1)];
+    frame.tick = tick;
+    for (int i = 0; i < HITBOX_ENTITIES; ++i) {
+        frame.boxes[i] = boxes[i];
+    }
+    frame.bossCapsules = bossCapsules;
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,59 @@
+#include "Input.hpp"
+#include "raylib.h"
+
+namespace TimeMaster {
+
+InputFrame SampleInput() {
+    InputFrame input = {0, 0, 0.0f, 0.0f, 0.0f};
+
+    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))    input.held |= INPUT_FORWARD;
+    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))  input.held |= INPUT_BACKWARD;
+    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))  input.held |= INPUT_LEFT;
+    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) input.held |= INPUT_RIGHT;
+    if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) input.held |= INPUT_RUN;
+    if (IsKeyDown(KEY_R))                         input.held |= INPUT_REWIND;
+
+    if (IsKeyPressed(KEY_SPACE))                  input.pressed |= INPUT_MELEE;
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))  input.pressed |= INPUT_SHOOT;
+    if (IsKeyPressed(KEY_C))                      input.pressed |= INPUT_TOGGLE_CAMERA;
+    if (IsKeyPressed(KEY_H))                      input.pressed |= INPUT_TOGGLE_HITBOX;
+    if (IsKeyPressed(KEY_P))                      input.pressed |= INPUT_PAUSE;
+    if (IsKeyPressed(KEY_ESCAPE))                 input.pressed |= INPUT_TOGGLE_CURSOR | INPUT_PAUSE | INPUT_BACK;
+
+    if (IsKeyPressed(KEY_ENTER))                  input.pressed |= INPUT_CONFIRM;
+    if (IsKeyPressed(KEY_H))                      input.pressed |= INPUT_START_HORDE;
+    if (IsKeyPressed(KEY_S))                      input.pressed |= INPUT_OPEN_SETTINGS;
+    if (IsKeyPressed(KEY_UP))                     input.pressed |= INPUT_MENU_UP;
+    if (IsKeyPressed(KEY_DOWN))                   input.pressed |= INPUT_MENU_DOWN;
+    if (IsKeyPressed(KEY_R))                      input.pressed |= INPUT_RESET_SETTINGS;
+    if (IsKeyDown(KEY_LEFT))                      input.held |= INPUT_MENU_LEFT;
+    if (IsKeyDown(KEY_RIGHT))                     input.held |= INPUT_MENU_RIGHT;
+
+    Vector2 mouseDelta = GetMouseDelta();
+    input.lookX = mouseDelta.x;
+    input.lookY = mouseDelta.y;
+    input.zoom = GetMouseWheelMove();
+
+    return input;
+}
+
+void InputMailbox::Push(const InputFrame& input) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.held = input.held;
+    m_pending.pressed |= input.pressed;
+    m_pending.lookX += input.lookX;
+    m_pending.lookY += input.lookY;
+    m_pending.zoom += input.zoom;
+}
+
+InputFrame InputMailbox::Take() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    InputFrame input = m_pending;
+    m_pending.pressed = 0;
+    m_pending.lookX = 0.0f;
+    m_pending.lookY = 0.0f;
+    m_pending.zoom = 0.0f;
+    return input;
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,313 @@
+#include "JobSystem.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+namespace TimeMaster {
+
+/**
+ * @brief One unit of work (pool slot)
+ */
+struct alignas(64) Job {
+    JobFunction function;
+    void* context;
+    Job* parent;                               // Parallel-for root of a chunk
+    uint32_t begin;
+    uint32_t end;
+    uint32_t grain;                            // > 0: parallel-for root, split when run
+    int continuationCount;
+    std::atomic<int32_t> unfinished;           // This job + unfinished chunks
+    std::atomic<int32_t> pendingDependencies;  // Unfinished prerequisites (+1 until submitted)
+    Job* continuations[JOB_MAX_CONTINUATIONS];
+};
+
+int JobSystem::s_requestedWorkers = -1;
+
+namespace {
+// Deque owned by the calling thread (-1 until an external thread claims one,
+// -2 when every external deque was taken and the thread only steals)
+thread_local int t_queueIndex = -1;
+}
+
+// ---------------------------------------------------------------------------
+// WorkStealingQueue (Chase-Lev; seq_cst where the owner and thieves race for
+// the last element)
+// ---------------------------------------------------------------------------
+
+WorkStealingQueue::WorkStealingQueue()
+    : m_top(0)
+    , m_bottom(0)
+    , m_jobs(std::make_unique<std::atomic<Job*>[]>(JOB_QUEUE_CAPACITY)) {
+}
+
+bool WorkStealingQueue::Push(Job* job) {
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= static_cast<int64_t>(JOB_QUEUE_CAPACITY)) {
+        return false;
+    }
+    m_jobs[bottom & (JOB_QUEUE_CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+Job* WorkStealingQueue::Pop() {
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+        // Empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Job* job = m_jobs[bottom & (JOB_QUEUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // Last element: race the thieves for it
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingQueue::Steal() {
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+        return nullptr;
+    }
+    Job* job = m_jobs[top & (JOB_QUEUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;  // Lost to the owner or another thief
+    }
+    return job;
+}
+
+// ---------------------------------------------------------------------------
+// JobSystem
+// ---------------------------------------------------------------------------
+
+JobSystem::JobSystem()
+    : m_pool(std::make_unique<Job[]>(JOB_POOL_SIZE))
+    , m_nextJob(0)
+    , m_nextExternalQueue(0)
+    , m_workerNames{}
+    , m_queuedJobs(0)
+    , m_sleepingWorkers(0)
+    , m_stop(false) {
+    int workers = s_requestedWorkers;
+    if (workers < 0) {
+        workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    workers = std::clamp(workers, 0, JOB_MAX_WORKERS);
+
+    m_queues.reserve(JOB_MAX_EXTERNAL_THREADS + workers);
+    for (int i = 0; i < JOB_MAX_EXTERNAL_THREADS + workers; ++i) {
+        m_queues.push_back(std::make_unique<WorkStealingQueue>());
+    }
+    m_workers.reserve(workers);
+    for (int i = 0; i < workers; ++i) {
+        std::snprintf(m_workerNames[i], sizeof(m_workerNames[i]), "Worker %d", i + 1);
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this, JOB_MAX_EXTERNAL_THREADS + i);
+    }
+    TM_LOG_INFO(GAME, "Job system started with %d worker thread(s)", workers);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop.store(true);
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+int JobSystem::GetQueueIndex() {
+    if (t_queueIndex == -1) {
+        int index = m_nextExternalQueue.fetch_add(1, std::memory_order_relaxed);
+        if (index >= JOB_MAX_EXTERNAL_THREADS) {
+            TM_LOG_ERROR(GAME, "More than %d external threads use the job system", JOB_MAX_EXTERNAL_THREADS);
+            index = -2;
+        }
+        t_queueIndex = index;
+    }
+    return t_queueIndex;
+}
+
+Job* JobSystem::AllocateJob() {
+    Job* job = &m_pool[m_nextJob.fetch_add(1, std::memory_order_relaxed) & (JOB_POOL_SIZE - 1)];
+    // The ring wrapped onto a job still running: more than JOB_POOL_SIZE alive at once
+    assert(job->unfinished.load(std::memory_order_acquire) == 0 && "Job pool slot reused before its job finished");
+    job->function = nullptr;
+    job->context = nullptr;
+    job->parent = nullptr;
+    job->begin = 0;
+    job->end = 0;
+    job->grain = 0;
+    job->continuationCount = 0;
+    job->unfinished.store(1, std::memory_order_relaxed);
+    job->pendingDependencies.store(1, std::memory_order_relaxed);
+    return job;
+}
+
+Job* JobSystem::Create(JobFunction function, void* context, uint32_t begin, uint32_t end) {
+    Job* job = AllocateJob();
+    job->function = function;
+    job->context = context;
+    job->begin = begin;
+    job->end = end;
+    return job;
+}
+
+Job* JobSystem::CreateParallelFor(uint32_t count, uint32_t grain, JobFunction function, void* context) {
+    Job* job = Create(function, context, 0, count);
+    uint32_t minGrain = count / JOB_MAX_CHUNKS + (count % JOB_MAX_CHUNKS != 0 ? 1 : 0);
+    job->grain = std::max({grain, minGrain, 1u});
+    return job;
+}
+
+bool JobSystem::AddDependency(Job* job, Job* prerequisite) {
+    if (prerequisite->continuationCount >= JOB_MAX_CONTINUATIONS) {
+        TM_LOG_ERROR(GAME, "Job has more than %d dependents", JOB_MAX_CONTINUATIONS);
+        return false;
+    }
+    prerequisite->continuations[prerequisite->continuationCount++] = job;
+    job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void JobSystem::Submit(Job* job) {
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Enqueue(job);
+    }
+}
+
+void JobSystem::Enqueue(Job* job) {
+    int queueIndex = GetQueueIndex();
+    if (queueIndex < 0 || !m_queues[queueIndex]->Push(job)) {
+        // No deque or deque full: run it here rather than dropping it
+        Execute(job);
+        return;
+    }
+    m_queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (m_sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+Job* JobSystem::FindJob(int queueIndex) {
+    Job* job = queueIndex >= 0 ? m_queues[queueIndex]->Pop() : nullptr;
+    if (job == nullptr) {
+        int queueCount = static_cast<int>(m_queues.size());
+        int start = std::max(queueIndex, 0);
+        for (int i = 1; i <= queueCount && job == nullptr; ++i) {
+            int victim = (start + i) % queueCount;
+            if (victim != queueIndex) {
+                job = m_queues[victim]->Steal();
+            }
+        }
+    }
+    if (job != nullptr) {
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::Execute(Job* job) {
+    uint32_t begin = job->begin;
+    uint32_t end = job->end;
+    if (job->grain > 0 && end - begin > job->grain) {
+        // Parallel-for root: queue every chunk but the first, run the first here
+        for (uint32_t start = begin + job->grain; start < end; start += job->grain) {
+            Job* chunk = AllocateJob();
+            chunk->function = job->function;
+            chunk->context = job->context;
+            chunk->parent = job;
+            chunk->begin = start;
+            chunk->end = std::min(end, start + job->grain);
+            chunk->pendingDependencies.store(0, std::memory_order_relaxed);
+            job->unfinished.fetch_add(1, std::memory_order_relaxed);
+            Enqueue(chunk);
+        }
+        end = begin + job->grain;
+    }
+    if (job->function != nullptr && (job->grain == 0 || begin < end)) {
+        job->function(job->context, begin, end);
+    }
+    Finish(job);
+}
+
+void JobSystem::Finish(Job* job) {
+    // Read the links first: once unfinished reaches zero a waiter may move on
+    Job* parent = job->parent;
+    int continuationCount = job->continuationCount;
+    Job* continuations[JOB_MAX_CONTINUATIONS];
+    std::copy(job->continuations, job->continuations + continuationCount, continuations);
+
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    for (int i = 0; i < continuationCount; ++i) {
+        Submit(continuations[i]);
+    }
+    if (parent != nullptr) {
+        Finish(parent);
+    }
+}
+
+void JobSystem::Wait(const Job* job) {
+    while (!IsFinished(job)) {
+        Job* next = FindJob(GetQueueIndex());
+        if (next != nullptr) {
+            Execute(next);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::IsFinished(const Job* job) const {
+    return job->unfinished.load(std::memory_order_acquire) == 0;
+}
+
+void JobSystem::WorkerLoop(int queueIndex) {
+    t_queueIndex = queueIndex;
+    // Registers the profiler's event ring now rather than on the first zone
+    Profiler::GetInstance().SetThreadName(m_workerNames[queueIndex - JOB_MAX_EXTERNAL_THREADS]);
+
+    int idleRounds = 0;
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        Job* job = FindJob(queueIndex);
+        if (job != nullptr) {
+            Execute(job);
+            idleRounds = 0;
+            continue;
+        }
+        if (++idleRounds < JOB_IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+        idleRounds = 0;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        m_wake.wait(lock, [this]() {
+            return m_stop.load(std::memory_order_relaxed) ||
+                   m_queuedJobs.load(std::memory_order_seq_cst) > 0;
+        });
+        m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace TimeMaster
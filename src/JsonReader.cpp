@@ -0,0 +1,231 @@
+#include "JsonReader.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace TimeMaster {
+
+namespace {
+
+class JsonParser {
+private:
+    const std::string& m_text;
+    size_t m_pos;
+    std::string m_error;
+    
+    void SkipWhitespace() {
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                m_pos++;
+            } else {
+                break;
+            }
+        }
+    }
+    
+    bool Fail(const char* message) {
+        if (m_error.empty()) {
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "%s at offset %zu", message, m_pos);
+            m_error = buffer;
+        }
+        return false;
+    }
+    
+    bool Expect(const char* literal) {
+        size_t length = std::strlen(literal);
+        if (m_text.compare(m_pos, length, literal) != 0) {
+            return Fail("Unexpected token");
+        }
+        m_pos += length;
+        return true;
+    }
+    
+    bool ParseString(std::string& out) {
+        if (m_text[m_pos] != '"') return Fail("Expected string");
+        m_pos++;
+        out.clear();
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos++];
+            if (c == '"') return true;
+            if (c == '\\') {
+                if (m_pos >= m_text.size()) break;
+                char e = m_text[m_pos++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u':
+                        // Data files are ASCII; keep the escape verbatim
+                        out += "\\u";
+                        break;
+                    default: out += e; break;
+                }
+            } else {
+                out += c;
+            }
+        }
+        return Fail("Unterminated string");
+    }
+    
+    bool ParseNumber(JsonValue& out) {
+        const char* start = m_text.c_str() + m_pos;
+        char* end = nullptr;
+        double value = std::strtod(start, &end);
+        if (end == start) return Fail("Invalid number");
+        m_pos += static_cast<size_t>(end - start);
+        out.type = JsonValue::Type::NUMBER;
+        out.number = value;
+        return true;
+    }
+    
+public:
+    explicit JsonParser(const std::string& text) : m_text(text), m_pos(0) {}
+    
+    const std::string& GetError() const { return m_error; }
+    
+    bool ParseValue(JsonValue& out) {
+        SkipWhitespace();
+        if (m_pos >= m_text.size()) return Fail("Unexpected end of input");
+        
+        char c = m_text[m_pos];
+        if (c == '{') {
+            out.type = JsonValue::Type::OBJECT;
+            m_pos++;
+            SkipWhitespace();
+            if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+                m_pos++;
+                return true;
+            }
+            for (;;) {
+                SkipWhitespace();
+                std::string key;
+                if (!ParseString(key)) return false;
+                SkipWhitespace();
+                if (m_pos >= m_text.size() || m_text[m_pos] != ':') return Fail("Expected ':'");
+                m_pos++;
+                out.keys.push_back(key);
+                out.items.emplace_back();
+                if (!ParseValue(out.items.back())) return false;
+                SkipWhitespace();
+                if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                    m_pos++;
+                    continue;
+                }
+                if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+                    m_pos++;
+                    return true;
+                }
+                return Fail("Expected ',' or '}'");
+            }
+        }
+        if (c == '[') {
+            out.type = JsonValue::Type::ARRAY;
+            m_pos++;
+            SkipWhitespace();
+            if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+                m_pos++;
+                return true;
+            }
+            for (;;) {
+                out.items.emplace_back();
+                if (!ParseValue(out.items.back())) return false;
+                SkipWhitespace();
+                if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                    m_pos++;
+                    continue;
+                }
+                if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+                    m_pos++;
+                    return true;
+                }
+                return Fail("Expected ',' or ']'");
+            }
+        }
+        if (c == '"') {
+            out.type = JsonValue::Type::STRING;
+            return ParseString(out.string);
+        }
+        if (c == 't') {
+            out.type = JsonValue::Type::BOOLEAN;
+            out.boolean = true;
+            return Expect("true");
+        }
+        if (c == 'f') {
+            out.type = JsonValue::Type::BOOLEAN;
+            out.boolean = false;
+            return Expect("false");
+        }
+        if (c == 'n') {
+            out.type = JsonValue::Type::NUL;
+            return Expect("null");
+        }
+        return ParseNumber(out);
+    }
+    
+    bool AtEnd() {
+        SkipWhitespace();
+        return m_pos >= m_text.size();
+    }
+};
+
+} // namespace
+
+const JsonValue* JsonValue::Find(const char* key) const {
+    if (type != Type::OBJECT) return nullptr;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == key) return &items[i];
+    }
+    return nullptr;
+}
+
+double JsonValue::GetNumber(const char* key, double fallback) const {
+    const JsonValue* value = Find(key);
+    return (value && value->type == Type::NUMBER) ? value->number : fallback;
+}
+
+std::string JsonValue::GetString(const char* key, const std::string& fallback) const {
+    const JsonValue* value = Find(key);
+    return (value && value->type == Type::STRING) ? value->string : fallback;
+}
+
+bool JsonValue::GetBool(const char* key, bool fallback) const {
+    const JsonValue* value = Find(key);
+    return (value && value->type == Type::BOOLEAN) ? value->boolean : fallback;
+}
+
+bool ParseJson(const std::string& text, JsonValue& out, std::string* error) {
+    out = JsonValue();
+    JsonParser parser(text);
+    bool ok = parser.ParseValue(out);
+    if (ok && !parser.AtEnd()) {
+        ok = false;
+        if (error) *error = "Trailing characters after JSON value";
+        return false;
+    }
+    if (!ok && error) {
+        *error = parser.GetError();
+    }
+    return ok;
+}
+
+bool LoadJsonFile(const char* path, JsonValue& out, std::string* error) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        if (error) *error = std::string("Cannot open ") + path;
+        return false;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, read);
+    }
+    fclose(file);
+    return ParseJson(text, out, error);
+}
+
+} // namespace TimeMaster
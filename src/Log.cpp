@@ -0,0 +1,255 @@
+#include "Log.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr size_t LOG_RING_MASK = LOG_RING_CAPACITY - 1;
+constexpr auto LOG_IDLE_SLEEP = std::chrono::milliseconds(2);
+
+const char* GetLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG:   return "DEBUG";
+        case LogLevel::INFO:    return "INFO";
+        case LogLevel::WARNING: return "WARN";
+        case LogLevel::ERROR:   return "ERROR";
+    }
+    return "?";
+}
+
+const char* GetCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::GAME:     return "Game";
+        case LogCategory::BOSS:     return "Boss";
+        case LogCategory::PLAYER:   return "Player";
+        case LogCategory::CAMERA:   return "Camera";
+        case LogCategory::ASSETS:   return "Assets";
+        case LogCategory::PROFILER: return "Profiler";
+        case LogCategory::NET:      return "Net";
+    }
+    return "?";
+}
+
+bool IsLengthModifier(char c) {
+    return c == 'h' || c == 'l' || c == 'L' || c == 'z' || c == 'j' || c == 't' || c == 'q';
+}
+
+} // namespace
+
+int FormatLogMessage(const LogRecord& record, char* out, int size) {
+    if (size <= 0) return 0;
+    
+    int length = 0;
+    int argIndex = 0;
+    auto append = [&](int written) {
+        if (written > 0) length = std::min(size - 1, length + written);
+    };
+    
+    for (const char* p = record.format; *p && length < size - 1; ++p) {
+        if (*p != '%') {
+            out[length++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[length++] = '%';
+            ++p;
+            continue;
+        }
+        
+        // Rebuild the conversion spec without its length modifier; the
+        // captured argument type decides the actual width
+        char spec[32];
+        int specLength = 0;
+        spec[specLength++] = '%';
+        ++p;
+        while (*p && std::strchr("-+ #0123456789.", *p) && specLength < 24) {
+            spec[specLength++] = *p++;
+        }
+        while (*p && IsLengthModifier(*p)) {
+            ++p;
+        }
+        if (!*p) break;
+        char conversion = *p;
+        
+        if (argIndex >= record.argCount) {
+            append(snprintf(out + length, size - length, "<?>"));
+            continue;
+        }
+        LogArgType type = record.types[argIndex];
+        const LogArgValue& value = record.args[argIndex];
+        argIndex++;
+        
+        switch (type) {
+            case LogArgType::INT:
+                if (conversion == 'c') {
+                    spec[specLength++] = 'c';
+                    spec[specLength] = '\0';
+                    append(snprintf(out + length, size - length, spec, static_cast<int>(value.i)));
+                } else {
+                    spec[specLength++] = 'l';
+                    spec[specLength++] = 'l';
+                    spec[specLength++] = std::strchr("diouxX", conversion) ? conversion : 'd';
+                    spec[specLength] = '\0';
+                    append(snprintf(out + length, size - length, spec, static_cast<long long>(value.i)));
+                }
+                break;
+            case LogArgType::UINT:
+                spec[specLength++] = 'l';
+                spec[specLength++] = 'l';
+                spec[specLength++] = std::strchr("ouxX", conversion) ? conversion : 'u';
+                spec[specLength] = '\0';
+                append(snprintf(out + length, size - length, spec, static_cast<unsigned long long>(value.u)));
+                break;
+            case LogArgType::DOUBLE:
+                spec[specLength++] = std::strchr("fFeEgGaA", conversion) ? conversion : 'g';
+                spec[specLength] = '\0';
+                append(snprintf(out + length, size - length, spec, value.d));
+                break;
+            case LogArgType::STRING:
+                spec[specLength++] = 's';
+                spec[specLength] = '\0';
+                append(snprintf(out + length, size - length, spec, record.strings + value.u));
+                break;
+            case LogArgType::POINTER:
+                append(snprintf(out + length, size - length, "%p", value.p));
+                break;
+        }
+    }
+    
+    out[length] = '\0';
+    return length;
+}
+
+Logger::Logger()
+    : m_cells(new Cell[LOG_RING_CAPACITY])
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+    , m_dropped(0)
+#ifdef NDEBUG
+    , m_minLevel(static_cast<uint8_t>(LogLevel::INFO))
+#else
+    , m_minLevel(static_cast<uint8_t>(LogLevel::DEBUG))
+#endif
+    , m_running(true)
+    , m_startTime(std::chrono::steady_clock::now()) {
+    for (size_t i = 0; i < LOG_RING_CAPACITY; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_writer = std::thread(&Logger::WriterLoop, this);
+}
+
+Logger::~Logger() {
+    m_running.store(false, std::memory_order_release);
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    delete[] m_cells;
+}
+
+Logger& Logger::GetInstance() {
+    static Logger instance;
+    return instance;
+}
+
+LogRecord* Logger::Acquire(size_t& position) {
+    // Bounded MPMC queue (Vyukov) used with a single consumer
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = m_cells[pos & LOG_RING_MASK];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                position = pos;
+                return &cell.record;
+            }
+        } else if (diff < 0) {
+            // Full: the writer is behind; drop instead of waiting
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::Publish(size_t position) {
+    m_cells[position & LOG_RING_MASK].sequence.store(position + 1, std::memory_order_release);
+}
+
+void Logger::CaptureString(LogRecord& record, const char* text) {
+    if (record.argCount >= LOG_MAX_ARGS) return;
+    if (!text) text = "(null)";
+    
+    int index = record.argCount++;
+    int offset = record.stringBytes;
+    int available = LOG_STRING_BYTES - offset;
+    record.types[index] = LogArgType::STRING;
+    if (available <= 0) {
+        // Out of space: point at the terminator of the previous string
+        record.args[index].u = static_cast<uint64_t>(LOG_STRING_BYTES - 1);
+        return;
+    }
+    size_t length = std::min(std::strlen(text), static_cast<size_t>(available - 1));
+    std::memcpy(record.strings + offset, text, length);
+    record.strings[offset + length] = '\0';
+    record.args[index].u = static_cast<uint64_t>(offset);
+    record.stringBytes = static_cast<uint8_t>(offset + length + 1);
+}
+
+bool Logger::WriteNext(char* line) {
+    Cell& cell = m_cells[m_dequeuePos & LOG_RING_MASK];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != m_dequeuePos + 1) {
+        return false;
+    }
+    
+    const LogRecord& record = cell.record;
+    int length = snprintf(line, LOG_LINE_BYTES, "[%9.3f] %-5s %-8s ",
+                          static_cast<double>(record.timestamp) * 1e-9,
+                          GetLevelName(record.level), GetCategoryName(record.category));
+    length += FormatLogMessage(record, line + length, LOG_LINE_BYTES - length - 1);
+    line[length++] = '\n';
+    FILE* stream = (record.level >= LogLevel::WARNING) ? stderr : stdout;
+    
+    // Release the slot before the (possibly slow) write
+    cell.sequence.store(m_dequeuePos + LOG_RING_CAPACITY, std::memory_order_release);
+    m_dequeuePos++;
+    
+    fwrite(line, 1, static_cast<size_t>(length), stream);
+    return true;
+}
+
+void Logger::WriterLoop() {
+    char line[LOG_LINE_BYTES + 1];
+    uint32_t reportedDropped = 0;
+    
+    for (;;) {
+        bool running = m_running.load(std::memory_order_acquire);
+        
+        int written = 0;
+        while (WriteNext(line)) {
+            written++;
+        }
+        
+        uint32_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped) {
+            fprintf(stderr, "[log] %u message(s) dropped (ring full)\n", dropped - reportedDropped);
+            reportedDropped = dropped;
+        }
+        if (written > 0) {
+            fflush(stdout);
+        }
+        
+        // Final pass above ran after the stop flag was seen: everything published is out
+        if (!running) break;
+        if (written == 0) {
+            std::this_thread::sleep_for(LOG_IDLE_SLEEP);
+        }
+    }
+}
+
+} // namespace TimeMaster
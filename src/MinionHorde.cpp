@@ -0,0 +1,319 @@
+#include "MinionHorde.hpp"
+#include "Profiler.hpp"
+#include "Replication.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace TimeMaster {
+
+namespace {
+constexpr float SEPARATION_GAIN = 900.0f;   // Push per unit of 1/distance (units per second)
+constexpr float COHESION_GAIN = 1.5f;       // Pull toward the neighbours' centre, per unit of offset
+constexpr float STEER_RATE = 8.0f;          // How fast velocity turns toward the steering (1/s)
+
+constexpr float NEIGHBOR_RADIUS_SQR = MINION_NEIGHBOR_RADIUS * MINION_NEIGHBOR_RADIUS;
+constexpr float SEPARATION_RADIUS_SQR = MINION_SEPARATION_RADIUS * MINION_SEPARATION_RADIUS;
+constexpr float ARENA_LIMIT = ARENA_SIZE - MINION_HALF_WIDTH;
+
+int GetGridCoordinate(float position) {
+    int cell = static_cast<int>((position + ARENA_SIZE) * (1.0f / MINION_NEIGHBOR_RADIUS));
+    return std::max(0, std::min(cell, MINION_GRID_SIZE - 1));
+}
+
+bool OverlapsMinionHeight(const AABB& box) {
+    return box.min.y <= MINION_Y + MINION_HALF_HEIGHT && box.max.y >= MINION_Y - MINION_HALF_HEIGHT;
+}
+
+/**
+ * @brief A minion in a rewind frame, quantized as replication does it
+ */
+struct RewindMinion {
+    uint16_t x, z;
+    int16_t velocityX, velocityZ;
+};
+
+static_assert(sizeof(RewindMinion) <= 4 * sizeof(float), "GetMaxStateWords counts full minions");
+}
+
+MinionHorde::MinionHorde(uint32_t capacity)
+    : m_current(capacity + SIMD_WIDTH)
+    , m_next(capacity + SIMD_WIDTH)
+    , m_cellStart(MINION_GRID_CELLS + 1, 0)
+    , m_cellCursor(MINION_GRID_CELLS, 0)
+    , m_rowCell(capacity, 0)
+    , m_flockX(capacity, 0.0f)
+    , m_flockZ(capacity, 0.0f)
+    , m_contacts(capacity, 0)
+    , m_capacity(capacity)
+    , m_count(0) {
+}
+
+uint32_t MinionHorde::Spawn(Vector3 center, float innerRadius, float outerRadius, uint32_t count, Random& random) {
+    uint32_t added = std::min(count, m_capacity - m_count);
+    for (uint32_t i = 0; i < added; ++i) {
+        float angle = random.Float01() * 2.0f * PI;
+        float distance = innerRadius + random.Float01() * (outerRadius - innerRadius);
+        uint32_t row = m_count++;
+        m_current.x[row] = std::max(-ARENA_LIMIT, std::min(center.x + cosf(angle) * distance, ARENA_LIMIT));
+        m_current.z[row] = std::max(-ARENA_LIMIT, std::min(center.z + sinf(angle) * distance, ARENA_LIMIT));
+        m_current.velocityX[row] = 0.0f;
+        m_current.velocityZ[row] = 0.0f;
+    }
+    return added;
+}
+
+uint32_t MinionHorde::KillInBox(const AABB& box) {
+    if (!OverlapsMinionHeight(box)) return 0;
+
+    uint32_t killed = 0;
+    uint32_t row = 0;
+    while (row < m_count) {
+        float x = m_current.x[row];
+        float z = m_current.z[row];
+        bool inside = x - MINION_HALF_WIDTH <= box.max.x && x + MINION_HALF_WIDTH >= box.min.x &&
+                      z - MINION_HALF_WIDTH <= box.max.z && z + MINION_HALF_WIDTH >= box.min.z;
+        if (inside) {
+            // The last minion moves into this row: check it next
+            uint32_t last = --m_count;
+            m_current.x[row] = m_current.x[last];
+            m_current.z[row] = m_current.z[last];
+            m_current.velocityX[row] = m_current.velocityX[last];
+            m_current.velocityZ[row] = m_current.velocityZ[last];
+            killed++;
+        } else {
+            ++row;
+        }
+    }
+    return killed;
+}
+
+void MinionHorde::BuildGrid() {
+    PROFILE_ZONE("MinionHorde::BuildGrid");
+
+    // Counting sort: cell sizes, then prefix sums, then a stable scatter
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+    for (uint32_t row = 0; row < m_count; ++row) {
+        int cell = GetGridCoordinate(m_current.z[row]) * MINION_GRID_SIZE + GetGridCoordinate(m_current.x[row]);
+        m_rowCell[row] = static_cast<uint16_t>(cell);
+        m_cellStart[cell + 1]++;
+    }
+    for (int cell = 0; cell < MINION_GRID_CELLS; ++cell) {
+        m_cellStart[cell + 1] += m_cellStart[cell];
+        m_cellCursor[cell] = m_cellStart[cell];
+    }
+    for (uint32_t row = 0; row < m_count; ++row) {
+        uint32_t sorted = m_cellCursor[m_rowCell[row]]++;
+        m_next.x[sorted] = m_current.x[row];
+        m_next.z[sorted] = m_current.z[row];
+        m_next.velocityX[sorted] = m_current.velocityX[row];
+        m_next.velocityZ[sorted] = m_current.velocityZ[row];
+    }
+    std::swap(m_current, m_next);
+}
+
+void MinionHorde::Flock(uint32_t row) {
+    const float* xs = m_current.x.data();
+    const float* zs = m_current.z.data();
+    Float4 x = Float4::Splat(xs[row]);
+    Float4 z = Float4::Splat(zs[row]);
+    Float4 zero = Float4::Splat(0.0f);
+    Float4 one = Float4::Splat(1.0f);
+    Float4 neighborRadius = Float4::Splat(NEIGHBOR_RADIUS_SQR);
+    Float4 separationRadius = Float4::Splat(SEPARATION_RADIUS_SQR);
+    Float4 separationX = zero;
+    Float4 separationZ = zero;
+    Float4 offsetX = zero;      // Sum of (this - neighbour)
+    Float4 offsetZ = zero;
+    Float4 neighbors = zero;
+
+    int cellX = GetGridCoordinate(xs[row]);
+    int cellZ = GetGridCoordinate(zs[row]);
+    for (int gz = std::max(0, cellZ - 1); gz <= std::min(cellZ + 1, MINION_GRID_SIZE - 1); ++gz) {
+        // The three cells of a grid row are adjacent, so their minions are one run
+        int first = gz * MINION_GRID_SIZE + std::max(0, cellX - 1);
+        int last = gz * MINION_GRID_SIZE + std::min(cellX + 1, MINION_GRID_SIZE - 1);
+        uint32_t end = m_cellStart[last + 1];
+        for (uint32_t other = m_cellStart[first]; other < end; other += SIMD_WIDTH) {
+            Float4 dx = x - Float4::Load(xs + other);
+            Float4 dz = z - Float4::Load(zs + other);
+            Float4 distanceSqr = dx * dx + dz * dz;
+            // Coincident minions (and this one) have no direction to push along
+            Mask4 near = Mask4::FirstLanes(end - other) & (distanceSqr > zero) & (distanceSqr < neighborRadius);
+            Mask4 close = near & (distanceSqr < separationRadius);
+            Float4 safeDistanceSqr = Select(close, distanceSqr, one);
+            separationX = separationX + Select(close, dx / safeDistanceSqr, zero);
+            separationZ = separationZ + Select(close, dz / safeDistanceSqr, zero);
+            offsetX = offsetX + Select(near, dx, zero);
+            offsetZ = offsetZ + Select(near, dz, zero);
+            neighbors = neighbors + Select(near, one, zero);
+        }
+    }
+
+    float count = neighbors.Sum();
+    float cohesionX = count > 0.0f ? -offsetX.Sum() / count : 0.0f;
+    float cohesionZ = count > 0.0f ? -offsetZ.Sum() / count : 0.0f;
+    m_flockX[row] = separationX.Sum() * SEPARATION_GAIN + cohesionX * COHESION_GAIN;
+    m_flockZ[row] = separationZ.Sum() * SEPARATION_GAIN + cohesionZ * COHESION_GAIN;
+}
+
+void MinionHorde::Steer(uint32_t begin, uint32_t end, float deltaTime, const HordeTargets& targets) {
+    PROFILE_ZONE("MinionHorde::Steer");
+
+    // Neighbours: one minion at a time, four neighbours per step
+    for (uint32_t row = begin; row < end; ++row) {
+        Flock(row);
+    }
+
+    // Seek, integrate and push out: four minions per step
+    Float4 zero = Float4::Splat(0.0f);
+    Float4 one = Float4::Splat(1.0f);
+    Float4 speed = Float4::Splat(MINION_SPEED);
+    Float4 speedSqr = Float4::Splat(MINION_SPEED * MINION_SPEED);
+    Float4 blend = Float4::Splat(std::min(1.0f, STEER_RATE * deltaTime));
+    Float4 dt = Float4::Splat(deltaTime);
+    Float4 arenaMin = Float4::Splat(-ARENA_LIMIT);
+    Float4 arenaMax = Float4::Splat(ARENA_LIMIT);
+    bool pushBoss = targets.bossAlive && OverlapsMinionHeight(targets.bossBox);
+
+    for (uint32_t row = begin; row < end; row += SIMD_WIDTH) {
+        // The last step of a range may cover rows another job owns: read and write only ours
+        uint32_t lanes = std::min(SIMD_WIDTH, end - row);
+        float flock[2][SIMD_WIDTH] = {};
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            flock[0][lane] = m_flockX[row + lane];
+            flock[1][lane] = m_flockZ[row + lane];
+        }
+        Float4 x = Float4::Load(m_current.x.data() + row);
+        Float4 z = Float4::Load(m_current.z.data() + row);
+        Float4 velocityX = Float4::Load(m_current.velocityX.data() + row);
+        Float4 velocityZ = Float4::Load(m_current.velocityZ.data() + row);
+
+        // Seek along the flow field; in sight or within a step of the player it leads to, straight at them
+        float path[5][SIMD_WIDTH];
+        for (uint32_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+            const FlowCell& cell = targets.paths->Sample(m_current.x[row + lane], m_current.z[row + lane]);
+            bool close = cell.inSight || cell.distance <= FLOW_DIAGONAL_COST;
+            path[0][lane] = cell.GetDirectionX();
+            path[1][lane] = cell.GetDirectionZ();
+            path[2][lane] = targets.players[cell.target].x;
+            path[3][lane] = targets.players[cell.target].z;
+            path[4][lane] = close ? 1.0f : 0.0f;
+        }
+        Mask4 close = Float4::Load(path[4]) > zero;
+        Float4 dx = Float4::Load(path[2]) - x;
+        Float4 dz = Float4::Load(path[3]) - z;
+        Float4 distanceSqr = dx * dx + dz * dz;
+        Mask4 seeking = close & (distanceSqr > zero);
+        Float4 scale = Select(seeking, speed / Sqrt(Select(seeking, distanceSqr, one)), zero);
+        Float4 steerX = Select(close, dx * scale, Float4::Load(path[0]) * speed) + Float4::Load(flock[0]);
+        Float4 steerZ = Select(close, dz * scale, Float4::Load(path[1]) * speed) + Float4::Load(flock[1]);
+
+        // Turn toward the steering, capped at top speed
+        velocityX = velocityX + (steerX - velocityX) * blend;
+        velocityZ = velocityZ + (steerZ - velocityZ) * blend;
+        Float4 currentSqr = velocityX * velocityX + velocityZ * velocityZ;
+        Mask4 tooFast = currentSqr > speedSqr;
+        Float4 limit = Select(tooFast, speed / Sqrt(Select(tooFast, currentSqr, one)), one);
+        velocityX = velocityX * limit;
+        velocityZ = velocityZ * limit;
+        x = x + velocityX * dt;
+        z = z + velocityZ * dt;
+
+        // Pushed out of the boss and the players like a player is pushed out of the boss
+        Float4 pushbackX;
+        Float4 pushbackZ;
+        if (pushBoss) {
+            ResolveAABBCollisionXZ(x, z, MINION_HALF_WIDTH, MINION_HALF_WIDTH, targets.bossBox, pushbackX, pushbackZ);
+            x = x + pushbackX;
+            z = z + pushbackZ;
+        }
+        Mask4 touched[MAX_PLAYERS] = {};
+        for (uint32_t t = 0; t < targets.playerCount; ++t) {
+            if (!targets.alive[t]) continue;
+            touched[t] = ResolveAABBCollisionXZ(x, z, MINION_HALF_WIDTH, MINION_HALF_WIDTH, targets.playerBoxes[t],
+                                                pushbackX, pushbackZ);
+            x = x + pushbackX;
+            z = z + pushbackZ;
+        }
+        x = Min(Max(x, arenaMin), arenaMax);
+        z = Min(Max(z, arenaMin), arenaMax);
+
+        float out[4][SIMD_WIDTH];
+        x.Store(out[0]);
+        z.Store(out[1]);
+        velocityX.Store(out[2]);
+        velocityZ.Store(out[3]);
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            m_next.x[row + lane] = out[0][lane];
+            m_next.z[row + lane] = out[1][lane];
+            m_next.velocityX[row + lane] = out[2][lane];
+            m_next.velocityZ[row + lane] = out[3][lane];
+            uint8_t contacts = 0;
+            for (uint32_t t = 0; t < targets.playerCount; ++t) {
+                if (targets.alive[t] && touched[t].IsSet(lane)) contacts |= static_cast<uint8_t>(1u << t);
+            }
+            m_contacts[row + lane] = contacts;
+        }
+    }
+}
+
+void MinionHorde::EndStep() {
+    std::swap(m_current, m_next);
+}
+
+uint32_t MinionHorde::GetContacts() const {
+    uint32_t contacts = 0;
+    for (uint32_t row = 0; row < m_count; ++row) {
+        contacts |= m_contacts[row];
+    }
+    return contacts;
+}
+
+void MinionHorde::Write(StateWriter& writer) const {
+    writer.Write(m_count);
+    writer.WriteArray(m_current.x.data(), m_count);
+    writer.WriteArray(m_current.z.data(), m_count);
+    writer.WriteArray(m_current.velocityX.data(), m_count);
+    writer.WriteArray(m_current.velocityZ.data(), m_count);
+}
+
+void MinionHorde::WriteRewind(StateWriter& writer) const {
+    writer.Write(m_count);
+    for (uint32_t row = 0; row < m_count; ++row) {
+        ReplicatedState::Point point = QuantizePosition({m_current.x[row], MINION_Y, m_current.z[row]});
+        writer.Write(RewindMinion{point.x, point.z, QuantizeSpeed(m_current.velocityX[row]),
+                                  QuantizeSpeed(m_current.velocityZ[row])});
+    }
+}
+
+bool MinionHorde::Read(StateReader& reader) {
+    uint32_t count = 0;
+    bool ok = reader.Read(count) && count <= m_capacity &&
+              reader.ReadArray(m_current.x.data(), count) &&
+              reader.ReadArray(m_current.z.data(), count) &&
+              reader.ReadArray(m_current.velocityX.data(), count) &&
+              reader.ReadArray(m_current.velocityZ.data(), count);
+    m_count = ok ? count : 0;
+    return ok;
+}
+
+bool MinionHorde::ReadRewind(StateReader& reader) {
+    uint32_t count = 0;
+    m_count = 0;
+    if (!reader.Read(count) || count > m_capacity) return false;
+
+    for (uint32_t row = 0; row < count; ++row) {
+        RewindMinion saved;
+        if (!reader.Read(saved)) return false;
+        Vector3 position = GetReplicatedPosition({saved.x, 0, saved.z});
+        m_current.x[row] = position.x;
+        m_current.z[row] = position.z;
+        m_current.velocityX[row] = GetReplicatedSpeed(saved.velocityX);
+        m_current.velocityZ[row] = GetReplicatedSpeed(saved.velocityZ);
+    }
+    m_count = count;
+    return true;
+}
+
+} // namespace TimeMaster
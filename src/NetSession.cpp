@@ -0,0 +1,323 @@
+#include "NetSession.hpp"
+#include "FrameSnapshot.hpp"
+#include "Game.hpp"
+#include "Log.hpp"
+#include "Packet.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr uint32_t HANDSHAKE_INTERVAL_TICKS = 15;   // Client repeats HELLO until welcomed
+constexpr uint32_t HEADER_BYTES = 4;
+constexpr uint32_t TIME_SYNC_INTERVAL_TICKS = 10;   // At most one wait per this many frames
+constexpr float TIME_SYNC_MAX_ADVANTAGE = 1.5f;     // Frames ahead of the peer tolerated
+
+double NowMs() {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void WriteHeader(PacketWriter& writer, uint8_t type) {
+    writer.Put8('T');
+    writer.Put8('M');
+    writer.Put8(NET_PROTOCOL_VERSION);
+    writer.Put8(type);
+}
+
+} // namespace
+
+NetSession::NetSession(Game& game, const NetOptions& options, float deltaTime)
+    : m_game(game)
+    , m_options(options)
+    , m_deltaTime(deltaTime)
+    , m_hasPeer(false)
+    , m_started(false)
+    , m_seed(options.seed)
+    , m_rollback(game, MAX_PLAYERS, options.host ? 0 : 1, deltaTime)
+    , m_remotePlayer(options.host ? 1 : 0)
+    , m_peerKnown(NET_INPUT_DELAY)
+    , m_pendingPressed(0)
+    , m_handshakeTicks(0)
+    , m_peerSendTime(0)
+    , m_remoteFrame(0)
+    , m_lastWaitFrame(0)
+    , m_timeSyncWaits(0)
+    , m_lastReceiveMs(0.0)
+    , m_pingMs(0.0f)
+    , m_remoteSyncFrame(0)
+    , m_remoteSyncChecksum(0)
+    , m_checkedSyncFrame(0)
+    , m_syncChecks(0)
+    , m_desynced(false)
+    , m_timedOut(false)
+    , m_startMs(NowMs())
+    , m_shimRandom(static_cast<uint64_t>(m_startMs) ^ (options.host ? 0x40u : 0x41u))
+    , m_shimCount(0) {
+}
+
+bool NetSession::Open() {
+    if (m_options.host) {
+        if (!m_socket.Open(m_options.port)) return false;
+        TM_LOG_INFO(NET, "Hosting co-op on UDP port %u", static_cast<unsigned>(m_options.port));
+    } else {
+        if (!ResolveAddress(m_options.address.c_str(), m_options.port, m_peer)) return false;
+        if (!m_socket.Open(0)) return false;
+        m_hasPeer = true;
+        TM_LOG_INFO(NET, "Joining co-op at %s:%u", m_options.address.c_str(), static_cast<unsigned>(m_options.port));
+    }
+    const NetConditions& conditions = m_options.conditions;
+    if (conditions.latencyMs > 0.0f || conditions.jitterMs > 0.0f || conditions.lossPercent > 0.0f) {
+        TM_LOG_INFO(NET, "Simulating %.0f ms latency, %.0f ms jitter, %.1f%% loss",
+                    conditions.latencyMs, conditions.jitterMs, conditions.lossPercent);
+    }
+    m_lastReceiveMs = NowMs();
+    return true;
+}
+
+PlayerCommand NetSession::Quantize(const PlayerCommand& command) {
+    return DecodeCommand(EncodeCommandButtons(command), EncodeCommandYaw(command.aimYaw));
+}
+
+void NetSession::StartMatch(uint64_t seed) {
+    m_seed = seed;
+    m_game.GetRandom().Seed(seed);
+    m_rollback.Start(NET_INPUT_DELAY);
+    m_started = true;
+    TM_LOG_INFO(NET, "Co-op match started (seed %llu, player %d)",
+                static_cast<unsigned long long>(seed), m_rollback.GetLocalPlayer() + 1);
+}
+
+void NetSession::Tick(const InputFrame& input) {
+    PROFILE_ZONE("NetSession::Tick");
+
+    double nowMs = NowMs();
+    Receive(nowMs);
+    if (m_hasPeer && !m_timedOut && nowMs - m_lastReceiveMs > NET_TIMEOUT_SECONDS * 1000.0f) {
+        m_timedOut = true;
+        TM_LOG_WARNING(NET, "Peer silent for %.0f s: connection lost", NET_TIMEOUT_SECONDS);
+    }
+
+    PlayerCommand command = m_game.UpdateView(input, m_deltaTime);
+    if (!m_started) {
+        if (!m_options.host && m_handshakeTicks++ % HANDSHAKE_INTERVAL_TICKS == 0) {
+            SendHandshake(nowMs);
+        }
+        FlushShim(nowMs);
+        return;
+    }
+
+    // The local command goes in NET_INPUT_DELAY frames ahead; while stalled the
+    // window is full, so presses wait for the next free frame instead of vanishing
+    command.pressed |= m_pendingPressed;
+    command = Quantize(command);
+    int local = m_rollback.GetLocalPlayer();
+    uint32_t next = m_rollback.GetKnownFrames(local);
+    if (next <= m_rollback.GetFrame() + NET_INPUT_DELAY && m_rollback.AddCommand(local, next, command)) {
+        m_pendingPressed = 0;
+    } else {
+        m_pendingPressed = command.pressed;
+    }
+
+    // The side that started first runs ahead and ends up doing all the rolling
+    // back: it idles one tick now and then until both are equally far ahead
+    float tickMs = m_deltaTime * 1000.0f;
+    float remoteFrame = static_cast<float>(m_remoteFrame) + m_pingMs * 0.5f / tickMs;
+    float advantage = static_cast<float>(m_rollback.GetFrame()) - remoteFrame;
+    if (m_remoteFrame > 0 && advantage > TIME_SYNC_MAX_ADVANTAGE &&
+        m_rollback.GetFrame() % TIME_SYNC_INTERVAL_TICKS == 0 && m_rollback.GetFrame() != m_lastWaitFrame) {
+        m_lastWaitFrame = m_rollback.GetFrame();
+        m_timeSyncWaits++;
+    } else {
+        m_rollback.Advance();
+    }
+    CheckSync();
+    SendInputs(nowMs);
+    FlushShim(nowMs);
+}
+
+void NetSession::Receive(double nowMs) {
+    uint8_t data[NET_MAX_PACKET_BYTES];
+    NetAddress from;
+    int size;
+    while ((size = m_socket.Receive(from, data, sizeof(data))) >= 0) {
+        if (size < static_cast<int>(HEADER_BYTES) || data[0] != 'T' || data[1] != 'M' ||
+            data[2] != NET_PROTOCOL_VERSION) {
+            continue;
+        }
+        if (m_hasPeer && from != m_peer) continue;   // One peer per session
+
+        uint8_t type = data[3];
+        if (type == PACKET_HELLO && m_options.host) {
+            if (!m_hasPeer) {
+                m_peer = from;
+                m_hasPeer = true;
+                TM_LOG_INFO(NET, "Peer joined");
+            }
+            if (!m_started) {
+                StartMatch(m_seed != 0 ? m_seed : static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()));
+            }
+            // Answer every HELLO: the client keeps asking until one WELCOME gets through
+            uint8_t reply[HEADER_BYTES + 8];
+            PacketWriter writer(reply);
+            WriteHeader(writer, PACKET_WELCOME);
+            writer.Put64(m_seed);
+            Send(reply, writer.GetSize(), nowMs);
+        } else if (type == PACKET_WELCOME && !m_options.host) {
+            PacketReader reader(data + HEADER_BYTES, static_cast<uint32_t>(size) - HEADER_BYTES);
+            uint64_t seed = reader.Get64();
+            if (reader.IsValid() && !m_started) {
+                StartMatch(seed);
+            }
+        } else if (type == PACKET_INPUT && m_started) {
+            HandleInput(data + HEADER_BYTES, static_cast<uint32_t>(size) - HEADER_BYTES, nowMs);
+        } else {
+            continue;
+        }
+        m_lastReceiveMs = nowMs;
+    }
+}
+
+void NetSession::HandleInput(const uint8_t* data, uint32_t size, double nowMs) {
+    PacketReader reader(data, size);
+    uint32_t sendTime = reader.Get32();
+    uint32_t echoTime = reader.Get32();
+    uint32_t ack = reader.Get32();
+    uint32_t firstFrame = reader.Get32();
+    uint32_t remoteFrame = reader.Get32();
+    uint32_t count = std::min<uint32_t>(reader.Get8(), NET_COMMANDS_PER_PACKET);
+    PlayerCommand commands[NET_COMMANDS_PER_PACKET];
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t bits = reader.Get8();
+        commands[i] = DecodeCommand(bits, reader.Get16());
+    }
+    uint32_t syncFrame = reader.Get32();
+    uint64_t syncChecksum = reader.Get64();
+    if (!reader.IsValid()) return;
+
+    // Packets may arrive reordered: only ever move forward
+    m_peerKnown = std::max(m_peerKnown, ack);
+    m_remoteFrame = std::max(m_remoteFrame, remoteFrame);
+    if (sendTime >= m_peerSendTime) {
+        m_peerSendTime = sendTime;
+        if (echoTime != 0) {
+            float roundTrip = static_cast<float>(nowMs - m_startMs) - static_cast<float>(echoTime);
+            m_pingMs = std::max(0.0f, roundTrip);
+        }
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        m_rollback.AddCommand(m_remotePlayer, firstFrame + i, commands[i]);
+    }
+    if (syncFrame > m_remoteSyncFrame && syncFrame > m_checkedSyncFrame) {
+        m_remoteSyncFrame = syncFrame;
+        m_remoteSyncChecksum = syncChecksum;
+    }
+}
+
+void NetSession::CheckSync() {
+    if (m_remoteSyncFrame == 0 || m_rollback.GetLastSyncFrame() < m_remoteSyncFrame) return;
+
+    uint64_t checksum = 0;
+    if (m_rollback.GetSyncChecksum(m_remoteSyncFrame, checksum)) {
+        m_syncChecks++;
+        if (checksum != m_remoteSyncChecksum && !m_desynced) {
+            m_desynced = true;
+            TM_LOG_ERROR(NET, "Desync at frame %u: peers disagree on the confirmed state", m_remoteSyncFrame);
+        }
+    }
+    // Compared, or already out of the history: either way done with it
+    m_checkedSyncFrame = m_remoteSyncFrame;
+    m_remoteSyncFrame = 0;
+}
+
+void NetSession::SendHandshake(double nowMs) {
+    uint8_t data[HEADER_BYTES];
+    PacketWriter writer(data);
+    WriteHeader(writer, PACKET_HELLO);
+    Send(data, writer.GetSize(), nowMs);
+}
+
+void NetSession::SendInputs(double nowMs) {
+    if (!m_hasPeer) return;
+
+    int local = m_rollback.GetLocalPlayer();
+    uint32_t known = m_rollback.GetKnownFrames(local);
+    uint32_t first = std::max(m_peerKnown, known > NET_COMMANDS_PER_PACKET ? known - NET_COMMANDS_PER_PACKET : 0u);
+    uint32_t count = known > first ? known - first : 0;
+
+    uint32_t syncFrame = m_rollback.GetLastSyncFrame();
+    uint64_t syncChecksum = 0;
+    if (!m_rollback.GetSyncChecksum(syncFrame, syncChecksum)) {
+        syncFrame = 0;
+    }
+
+    uint8_t data[NET_MAX_PACKET_BYTES];
+    PacketWriter writer(data);
+    WriteHeader(writer, PACKET_INPUT);
+    writer.Put32(std::max(1u, static_cast<uint32_t>(nowMs - m_startMs)));
+    writer.Put32(m_peerSendTime);
+    writer.Put32(m_rollback.GetKnownFrames(m_remotePlayer));
+    writer.Put32(first);
+    writer.Put32(m_rollback.GetFrame());
+    writer.Put8(static_cast<uint8_t>(count));
+    for (uint32_t frame = first; frame < known; ++frame) {
+        const PlayerCommand& command = m_rollback.GetKnownCommand(local, frame);
+        writer.Put8(EncodeCommandButtons(command));
+        writer.Put16(EncodeCommandYaw(command.aimYaw));
+    }
+    writer.Put32(syncFrame);
+    writer.Put64(syncChecksum);
+    Send(data, writer.GetSize(), nowMs);
+}
+
+void NetSession::Send(const uint8_t* data, uint32_t size, double nowMs) {
+    const NetConditions& conditions = m_options.conditions;
+    if (conditions.lossPercent > 0.0f && m_shimRandom.Float01() * 100.0f < conditions.lossPercent) {
+        return;
+    }
+    double delayMs = conditions.latencyMs + (m_shimRandom.Float01() * 2.0f - 1.0f) * conditions.jitterMs;
+    if (delayMs <= 0.0 && m_shimCount == 0) {
+        m_socket.Send(m_peer, data, size);
+        return;
+    }
+    if (m_shimCount == NET_SHIM_QUEUE) {
+        return;   // A link this slow drops the overflow too
+    }
+    DelayedPacket& packet = m_shim[m_shimCount++];
+    packet.sendAtMs = nowMs + std::max(0.0, delayMs);
+    packet.size = size;
+    std::memcpy(packet.data, data, size);
+}
+
+void NetSession::FlushShim(double nowMs) {
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < m_shimCount; ++i) {
+        if (m_shim[i].sendAtMs <= nowMs) {
+            m_socket.Send(m_peer, m_shim[i].data, m_shim[i].size);
+        } else {
+            if (kept != i) {
+                m_shim[kept] = m_shim[i];
+            }
+            kept++;
+        }
+    }
+    m_shimCount = kept;
+}
+
+void NetSession::WriteSnapshot(NetSnapshot& snapshot) const {
+    const RollbackStats& stats = m_rollback.GetStats();
+    snapshot.active = true;
+    snapshot.connected = m_started && !m_timedOut;
+    snapshot.desynced = m_desynced;
+    snapshot.localPlayer = m_rollback.GetLocalPlayer();
+    snapshot.pingMs = m_pingMs;
+    snapshot.lastRollbackTicks = static_cast<int>(stats.lastDepth);
+    snapshot.rollbacks = stats.rollbacks;
+    snapshot.stalls = stats.stalls;
+}
+
+} // namespace TimeMaster
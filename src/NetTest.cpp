@@ -0,0 +1,95 @@
+#include "NetTest.hpp"
+#include "Config.hpp"
+#include "Game.hpp"
+#include "GameAssets.hpp"
+#include "Input.hpp"
+#include "Random.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr float NET_TEST_DELTA_TIME = 1.0f / SIMULATION_TICK_RATE;
+constexpr int NET_TEST_TICKS_PER_SECOND = static_cast<int>(SIMULATION_TICK_RATE);
+constexpr int NET_TEST_JOIN_TICKS = 30 * NET_TEST_TICKS_PER_SECOND;    // Host gives up without a peer
+constexpr int NET_TEST_LINGER_TICKS = NET_TEST_TICKS_PER_SECOND;       // Keep answering so the peer can finish
+constexpr double FRAME_BUDGET_US = 1000000.0 / SIMULATION_TICK_RATE;
+
+/**
+ * @brief Next frame of this peer's scripted input
+ * Holds each movement choice for a few ticks, like a player would, so
+ * predictions are right most of the time and wrong at every change.
+ */
+InputFrame NextInput(Random& random, InputFrame& held, int tick) {
+    if (tick % 12 == 0) {
+        held.held = random.NextU32() & (INPUT_FORWARD | INPUT_BACKWARD | INPUT_LEFT | INPUT_RIGHT | INPUT_RUN);
+        held.lookX = static_cast<float>(random.Range(-4, 4));
+    }
+    InputFrame input = {held.held, 0, held.lookX, 0.0f, 0.0f};
+    uint32_t roll = random.NextU32();
+    if (roll % 10 == 0) input.pressed |= INPUT_SHOOT;
+    if ((roll >> 8) % 40 == 0) input.pressed |= INPUT_MELEE;
+    return input;
+}
+
+} // namespace
+
+int RunNetTest(const NetOptions& options, int ticks) {
+    GameAssets assets;
+    assets.LoadData();
+    auto game = std::make_unique<Game>(assets, options.seed);
+    auto session = std::make_unique<NetSession>(*game, options, NET_TEST_DELTA_TIME);
+    if (!session->Open()) {
+        return 2;
+    }
+
+    Random inputRandom(options.seed ^ (options.host ? 0x1111u : 0x2222u));
+    InputFrame held = {0, 0, 0.0f, 0.0f, 0.0f};
+
+    using Clock = std::chrono::steady_clock;
+    const auto tick = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(NET_TEST_DELTA_TIME));
+    auto nextTick = Clock::now();
+    int waited = 0;
+    int lingered = 0;
+    int inputTick = 0;
+    while (lingered < NET_TEST_LINGER_TICKS) {
+        bool started = session->IsStarted();
+        session->Tick(started ? NextInput(inputRandom, held, inputTick++) : held);
+
+        if (session->HasTimedOut()) {
+            std::printf("Net test FAILED: peer went silent at frame %u\n", session->GetRollback().GetFrame());
+            return 2;
+        }
+        if (!started && ++waited > NET_TEST_JOIN_TICKS) {
+            std::printf("Net test FAILED: no peer within %d s\n", NET_TEST_JOIN_TICKS / NET_TEST_TICKS_PER_SECOND);
+            return 2;
+        }
+        if (session->GetRollback().GetFrame() >= static_cast<uint32_t>(ticks)) {
+            lingered++;
+        }
+
+        nextTick += tick;
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    const RollbackSession& rollback = session->GetRollback();
+    const RollbackStats& stats = rollback.GetStats();
+    double averageDepth = stats.rollbacks ? static_cast<double>(stats.resimulatedTicks) / stats.rollbacks : 0.0;
+    double averageUs = stats.rollbacks ? stats.resimulateUs / stats.rollbacks : 0.0;
+    std::printf("Net test (%s, seed %llu): %u frames, ping %.0f ms\n",
+                options.host ? "host" : "client", static_cast<unsigned long long>(session->GetSeed()),
+                rollback.GetFrame(), session->GetPingMs());
+    std::printf("  sync checks %u, %s\n", session->GetSyncChecks(), session->IsDesynced() ? "DESYNC" : "all matched");
+    std::printf("  rollbacks %u (avg %.1f ticks, max %u), resim avg %.0f us, max %.0f us (%.0f%% of a tick)\n",
+                stats.rollbacks, averageDepth, stats.maxDepth, averageUs, stats.maxResimulateUs,
+                stats.maxResimulateUs * 100.0 / FRAME_BUDGET_US);
+    std::printf("  stalls %u, time-sync waits %u\n", stats.stalls, session->GetTimeSyncWaits());
+    return session->IsDesynced() ? 1 : 0;
+}
+
+} // namespace TimeMaster
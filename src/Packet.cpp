@@ -0,0 +1,51 @@
+#include "Packet.hpp"
+#include <cmath>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr float YAW_STEPS = 65536.0f;
+
+// Wire button bits: held movement, then one-tick presses
+constexpr uint8_t WIRE_FORWARD = 1 << 0;
+constexpr uint8_t WIRE_BACKWARD = 1 << 1;
+constexpr uint8_t WIRE_LEFT = 1 << 2;
+constexpr uint8_t WIRE_RIGHT = 1 << 3;
+constexpr uint8_t WIRE_RUN = 1 << 4;
+constexpr uint8_t WIRE_MELEE = 1 << 5;
+constexpr uint8_t WIRE_SHOOT = 1 << 6;
+
+} // namespace
+
+uint8_t EncodeCommandButtons(const PlayerCommand& command) {
+    uint8_t bits = 0;
+    if (command.IsDown(INPUT_FORWARD))      bits |= WIRE_FORWARD;
+    if (command.IsDown(INPUT_BACKWARD))     bits |= WIRE_BACKWARD;
+    if (command.IsDown(INPUT_LEFT))         bits |= WIRE_LEFT;
+    if (command.IsDown(INPUT_RIGHT))        bits |= WIRE_RIGHT;
+    if (command.IsDown(INPUT_RUN))          bits |= WIRE_RUN;
+    if (command.WasPressed(INPUT_MELEE))    bits |= WIRE_MELEE;
+    if (command.WasPressed(INPUT_SHOOT))    bits |= WIRE_SHOOT;
+    return bits;
+}
+
+uint16_t EncodeCommandYaw(float yaw) {
+    float turns = yaw / 360.0f;
+    turns -= std::floor(turns);
+    return static_cast<uint16_t>(static_cast<uint32_t>(turns * YAW_STEPS) & 0xFFFF);
+}
+
+PlayerCommand DecodeCommand(uint8_t buttons, uint16_t yaw) {
+    PlayerCommand command = {0, 0, static_cast<float>(yaw) * (360.0f / YAW_STEPS)};
+    if (buttons & WIRE_FORWARD)     command.held |= INPUT_FORWARD;
+    if (buttons & WIRE_BACKWARD)    command.held |= INPUT_BACKWARD;
+    if (buttons & WIRE_LEFT)        command.held |= INPUT_LEFT;
+    if (buttons & WIRE_RIGHT)       command.held |= INPUT_RIGHT;
+    if (buttons & WIRE_RUN)         command.held |= INPUT_RUN;
+    if (buttons & WIRE_MELEE)       command.pressed |= INPUT_MELEE;
+    if (buttons & WIRE_SHOOT)       command.pressed |= INPUT_SHOOT;
+    return command;
+}
+
+} // namespace TimeMaster
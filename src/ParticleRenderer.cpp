@@ -0,0 +1,170 @@
+#include "ParticleRenderer.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace TimeMaster {
+
+namespace {
+
+// Two triangles, counter-clockwise once the shader turns them to the camera
+constexpr float QUAD_CORNERS[] = {
+    -0.5f, -0.5f,   0.5f, -0.5f,   0.5f, 0.5f,
+    -0.5f, -0.5f,   0.5f, 0.5f,   -0.5f, 0.5f,
+};
+constexpr int QUAD_VERTICES = 6;
+
+// Instance attributes, in the order of the columns in the instance buffer
+const char* const INSTANCE_ATTRIBUTES[] = {
+    "instanceX", "instanceY", "instanceZ", "instanceSize",
+    "instanceRed", "instanceGreen", "instanceBlue", "instanceAlpha",
+};
+
+const char* const PARTICLE_VERTEX_SHADER = R"(#version 330
+in vec2 vertexCorner;
+in float instanceX;
+in float instanceY;
+in float instanceZ;
+in float instanceSize;
+in float instanceRed;
+in float instanceGreen;
+in float instanceBlue;
+in float instanceAlpha;
+uniform mat4 mvp;
+uniform vec3 cameraRight;
+uniform vec3 cameraUp;
+out vec2 fragCorner;
+out vec4 fragColor;
+void main() {
+    vec3 center = vec3(instanceX, instanceY, instanceZ);
+    vec3 corner = center + (cameraRight * vertexCorner.x + cameraUp * vertexCorner.y) * instanceSize;
+    fragCorner = vertexCorner;
+    fragColor = vec4(instanceRed, instanceGreen, instanceBlue, instanceAlpha);
+    gl_Position = mvp * vec4(corner, 1.0);
+}
+)";
+
+const char* const PARTICLE_FRAGMENT_SHADER = R"(#version 330
+in vec2 fragCorner;
+in vec4 fragColor;
+out vec4 finalColor;
+void main() {
+    float fade = 1.0 - 2.0 * length(fragCorner);
+    if (fade <= 0.0) discard;
+    finalColor = vec4(fragColor.rgb, fragColor.a * fade);
+}
+)";
+
+// Read components floats per vertex, from offsetBytes into the bound buffer
+// (raylib 5.5 takes the offset as an integer, earlier versions as a pointer)
+void SetFloatAttribute(int location, int components, size_t offsetBytes) {
+#if RAYLIB_VERSION_MAJOR > 5 || (RAYLIB_VERSION_MAJOR == 5 && RAYLIB_VERSION_MINOR >= 5)
+    rlSetVertexAttribute(static_cast<unsigned int>(location), components, RL_FLOAT, false, 0,
+                         static_cast<int>(offsetBytes));
+#else
+    rlSetVertexAttribute(static_cast<unsigned int>(location), components, RL_FLOAT, false, 0,
+                         reinterpret_cast<const void*>(offsetBytes));
+#endif
+    rlEnableVertexAttribute(static_cast<unsigned int>(location));
+}
+
+} // namespace
+
+ParticleRenderer::ParticleRenderer(uint32_t capacity)
+    : m_shader(0)
+    , m_vertexArray(0)
+    , m_cornerBuffer(0)
+    , m_instanceBuffer(0)
+    , m_mvpLocation(-1)
+    , m_cameraRightLocation(-1)
+    , m_cameraUpLocation(-1)
+    , m_capacity(capacity)
+    , m_ready(false) {
+
+    // A shader that fails to build comes back as the default one, which has
+    // none of these attributes: particles are then not drawn
+    m_shader = rlLoadShaderCode(PARTICLE_VERTEX_SHADER, PARTICLE_FRAGMENT_SHADER);
+    int cornerLocation = rlGetLocationAttrib(m_shader, "vertexCorner");
+    int instanceLocations[COLUMN_COUNT];
+    bool located = m_shader != rlGetShaderIdDefault() && cornerLocation >= 0;
+    for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+        instanceLocations[c] = rlGetLocationAttrib(m_shader, INSTANCE_ATTRIBUTES[c]);
+        located = located && instanceLocations[c] >= 0;
+    }
+    if (!located) {
+        TM_LOG_WARNING(ASSETS, "Failed to build the particle shader - particles are not drawn");
+        return;
+    }
+    m_mvpLocation = rlGetLocationUniform(m_shader, "mvp");
+    m_cameraRightLocation = rlGetLocationUniform(m_shader, "cameraRight");
+    m_cameraUpLocation = rlGetLocationUniform(m_shader, "cameraUp");
+
+    // Corners per vertex; every column of the instance buffer advances per instance
+    m_vertexArray = rlLoadVertexArray();
+    rlEnableVertexArray(m_vertexArray);
+    m_cornerBuffer = rlLoadVertexBuffer(QUAD_CORNERS, sizeof(QUAD_CORNERS), false);
+    SetFloatAttribute(cornerLocation, 2, 0);
+    m_instanceBuffer = rlLoadVertexBuffer(nullptr, static_cast<int>(COLUMN_COUNT * m_capacity * sizeof(float)), true);
+    for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+        SetFloatAttribute(instanceLocations[c], 1, c * m_capacity * sizeof(float));
+        rlSetVertexAttributeDivisor(static_cast<unsigned int>(instanceLocations[c]), 1);
+    }
+    rlDisableVertexArray();
+    m_ready = true;
+}
+
+ParticleRenderer::~ParticleRenderer() {
+    if (m_vertexArray != 0) {
+        rlUnloadVertexArray(m_vertexArray);
+        rlUnloadVertexBuffer(m_cornerBuffer);
+        rlUnloadVertexBuffer(m_instanceBuffer);
+    }
+    if (m_shader != 0 && m_shader != rlGetShaderIdDefault()) {
+        rlUnloadShaderProgram(m_shader);
+    }
+}
+
+void ParticleRenderer::Draw(const ParticleSystem& particles, const Camera3D& camera) {
+    PROFILE_ZONE("Draw::Particles");
+
+    uint32_t count = std::min(particles.GetCount(), m_capacity);
+    if (!m_ready || count == 0) return;
+
+    // Shapes batched so far go first: particles do not write depth, so
+    // anything drawn after them would cover them
+    rlDrawRenderBatchActive();
+
+    const float* columns[COLUMN_COUNT] = {
+        particles.GetX(), particles.GetY(), particles.GetZ(), particles.GetSize(),
+        particles.GetRed(), particles.GetGreen(), particles.GetBlue(), particles.GetAlpha(),
+    };
+    int columnBytes = static_cast<int>(count * sizeof(float));
+    for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+        rlUpdateVertexBuffer(m_instanceBuffer, columns[c], columnBytes, static_cast<int>(c * m_capacity * sizeof(float)));
+    }
+
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3CrossProduct(right, forward);
+
+    BeginBlendMode(BLEND_ADDITIVE);
+    rlDisableDepthMask();
+    rlEnableShader(m_shader);
+    rlSetUniformMatrix(m_mvpLocation, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlSetUniform(m_cameraRightLocation, &right, RL_SHADER_UNIFORM_VEC3, 1);
+    rlSetUniform(m_cameraUpLocation, &up, RL_SHADER_UNIFORM_VEC3, 1);
+    rlEnableVertexArray(m_vertexArray);
+    rlDrawVertexArrayInstanced(0, QUAD_VERTICES, static_cast<int>(count));
+    rlDisableVertexArray();
+    rlDisableShader();
+    rlEnableDepthMask();
+    EndBlendMode();
+
+    RenderStats::GetInstance().AddInstanced(2 * count, m_shader, static_cast<uint64_t>(COLUMN_COUNT) * columnBytes);
+}
+
+} // namespace TimeMaster
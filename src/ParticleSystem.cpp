@@ -0,0 +1,166 @@
+#include "ParticleSystem.hpp"
+#include "Config.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr uint32_t COLOR_CHANNELS = 4;
+
+/**
+ * @brief How one effect kind bursts: particles fly out in every direction
+ * at a random speed, plus a lift upwards, fading from start to end colour
+ */
+struct Burst {
+    uint32_t count;
+    float minSpeed;
+    float maxSpeed;
+    float lift;
+    float minLifetime;
+    float maxLifetime;
+    float size;
+    Color start;
+    Color end;
+};
+
+// By EffectKind
+constexpr Burst BURSTS[static_cast<int>(EffectKind::COUNT)] = {
+    {48, 60.0f, 180.0f, 80.0f, 0.4f, 0.8f, 3.0f, {255, 220, 120, 255}, {200, 40, 0, 0}},     // Boss hit: sparks
+    {32, 40.0f, 140.0f, 40.0f, 0.3f, 0.6f, 2.5f, {255, 255, 255, 255}, {230, 20, 20, 0}},    // Player hit
+    {40, 40.0f, 120.0f, 100.0f, 0.5f, 0.9f, 2.5f, {230, 41, 55, 255}, {120, 10, 10, 0}},     // Pickup: tomato bits
+    {24, 10.0f, 40.0f, 220.0f, 0.6f, 1.0f, 2.0f, {160, 255, 160, 255}, {0, 228, 48, 0}},     // Heal: rising sparkles
+};
+
+} // namespace
+
+ParticleSystem::ParticleSystem(uint32_t capacity)
+    : m_columns(static_cast<size_t>(COLUMN_COUNT) * (capacity + SIMD_WIDTH), 0.0f)
+    , m_expiredGroups((capacity + SIMD_WIDTH) / SIMD_WIDTH, 0)
+    , m_stride(capacity + SIMD_WIDTH)
+    , m_capacity(capacity)
+    , m_count(0) {
+}
+
+uint32_t ParticleSystem::Emit(EffectKind kind, Vector3 position) {
+    const Burst& burst = BURSTS[static_cast<int>(kind)];
+    uint32_t count = std::min(burst.count, m_capacity - m_count);
+
+    float* x = GetColumn(POSITION_X);
+    float* y = GetColumn(POSITION_Y);
+    float* z = GetColumn(POSITION_Z);
+    float* velocityX = GetColumn(VELOCITY_X);
+    float* velocityY = GetColumn(VELOCITY_Y);
+    float* velocityZ = GetColumn(VELOCITY_Z);
+    float* age = GetColumn(AGE);
+    float* lifetime = GetColumn(LIFETIME);
+    float* size = GetColumn(SIZE);
+    float* color[COLOR_CHANNELS];
+    float* colorRate[COLOR_CHANNELS];
+    for (uint32_t c = 0; c < COLOR_CHANNELS; ++c) {
+        color[c] = GetColumn(static_cast<Column>(COLOR_RED + c));
+        colorRate[c] = GetColumn(static_cast<Column>(COLOR_RED_RATE + c));
+    }
+    const float start[COLOR_CHANNELS] = {burst.start.r / 255.0f, burst.start.g / 255.0f, burst.start.b / 255.0f,
+                                         burst.start.a / 255.0f};
+    const float end[COLOR_CHANNELS] = {burst.end.r / 255.0f, burst.end.g / 255.0f, burst.end.b / 255.0f,
+                                       burst.end.a / 255.0f};
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t row = m_count++;
+
+        // Uniform direction on the sphere
+        float up = 2.0f * m_random.Float01() - 1.0f;
+        float angle = 2.0f * PI * m_random.Float01();
+        float across = std::sqrt(1.0f - up * up);
+        float speed = burst.minSpeed + (burst.maxSpeed - burst.minSpeed) * m_random.Float01();
+        float life = burst.minLifetime + (burst.maxLifetime - burst.minLifetime) * m_random.Float01();
+
+        x[row] = position.x;
+        y[row] = position.y;
+        z[row] = position.z;
+        velocityX[row] = across * std::cos(angle) * speed;
+        velocityY[row] = up * speed + burst.lift;
+        velocityZ[row] = across * std::sin(angle) * speed;
+        age[row] = 0.0f;
+        lifetime[row] = life;
+        size[row] = burst.size;
+        for (uint32_t c = 0; c < COLOR_CHANNELS; ++c) {
+            color[c][row] = start[c];
+            colorRate[c][row] = (end[c] - start[c]) / life;
+        }
+    }
+    return count;
+}
+
+void ParticleSystem::Update(float deltaTime) {
+    float* x = GetColumn(POSITION_X);
+    float* y = GetColumn(POSITION_Y);
+    float* z = GetColumn(POSITION_Z);
+    float* velocityX = GetColumn(VELOCITY_X);
+    float* velocityY = GetColumn(VELOCITY_Y);
+    float* velocityZ = GetColumn(VELOCITY_Z);
+    float* age = GetColumn(AGE);
+    const float* lifetime = GetColumn(LIFETIME);
+    float* color[COLOR_CHANNELS];
+    const float* colorRate[COLOR_CHANNELS];
+    for (uint32_t c = 0; c < COLOR_CHANNELS; ++c) {
+        color[c] = GetColumn(static_cast<Column>(COLOR_RED + c));
+        colorRate[c] = GetColumn(static_cast<Column>(COLOR_RED_RATE + c));
+    }
+
+    const Float4 step = Float4::Splat(deltaTime);
+    const Float4 damping = Float4::Splat(std::max(0.0f, 1.0f - PARTICLE_DRAG * deltaTime));
+    const Float4 fall = Float4::Splat(GRAVITY * deltaTime);
+    const Float4 zero = Float4::Splat(0.0f);
+    const Float4 one = Float4::Splat(1.0f);
+
+    // Integrate four rows at a time (lanes past m_count run on padding and are ignored)
+    uint32_t expiredGroupCount = 0;
+    for (uint32_t i = 0; i < m_count; i += SIMD_WIDTH) {
+        Float4 vx = Float4::Load(velocityX + i) * damping;
+        Float4 vy = Float4::Load(velocityY + i) * damping - fall;
+        Float4 vz = Float4::Load(velocityZ + i) * damping;
+        vx.Store(velocityX + i);
+        vy.Store(velocityY + i);
+        vz.Store(velocityZ + i);
+        (Float4::Load(x + i) + vx * step).Store(x + i);
+        (Float4::Load(y + i) + vy * step).Store(y + i);
+        (Float4::Load(z + i) + vz * step).Store(z + i);
+
+        for (uint32_t c = 0; c < COLOR_CHANNELS; ++c) {
+            Float4 value = Float4::Load(color[c] + i) + Float4::Load(colorRate[c] + i) * step;
+            Min(Max(value, zero), one).Store(color[c] + i);
+        }
+
+        Float4 older = Float4::Load(age + i) + step;
+        older.Store(age + i);
+        Mask4 expired = (older >= Float4::Load(lifetime + i)) & Mask4::FirstLanes(m_count - i);
+        if (expired.Any()) {
+            m_expiredGroups[expiredGroupCount++] = i;
+        }
+    }
+
+    // Back to front, so the last row is always a live one when it fills a hole
+    for (uint32_t g = expiredGroupCount; g-- > 0;) {
+        uint32_t first = m_expiredGroups[g];
+        for (uint32_t lane = SIMD_WIDTH; lane-- > 0;) {
+            uint32_t row = first + lane;
+            if (row >= m_count || age[row] < lifetime[row]) continue;
+            m_count--;
+            if (row != m_count) {
+                MoveRow(m_count, row);
+            }
+        }
+    }
+}
+
+void ParticleSystem::MoveRow(uint32_t from, uint32_t to) {
+    for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+        float* column = GetColumn(static_cast<Column>(c));
+        column[to] = column[from];
+    }
+}
+
+} // namespace TimeMaster
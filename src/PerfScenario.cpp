@@ -0,0 +1,400 @@
+#include "PerfScenario.hpp"
+#include "AllocTracker.hpp"
+#include "Config.hpp"
+#include "FrameSnapshot.hpp"
+#include "Game.hpp"
+#include "GameAssets.hpp"
+#include "JsonReader.hpp"
+#include "RenderStats.hpp"
+#include "Renderer.hpp"
+#include "Rollback.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr float PERF_DELTA_TIME = 1.0f / 60.0f;
+constexpr uint64_t PERF_RANDOM_SEED = 0x5eed;     // Same boss attacks / tomato spawns every run
+
+// Defaults when the baseline file does not specify a tolerance
+constexpr float PERF_DEFAULT_P99_RATIO = 1.15f;   // Allowed relative p99 growth
+constexpr float PERF_DEFAULT_P99_SLACK_MS = 0.5f; // Absolute slack for very fast scenarios
+
+/**
+ * @brief Scripted input for one frame of a scenario
+ * Called before Game::Update; may also poke the game through its debug hooks.
+ */
+using ScenarioScript = void (*)(Game& game, int frame, InputFrame& input);
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    ScenarioScript script;
+    bool rollback = false;   // Drive a two-player RollbackSession instead of Game::Update
+    MatchMode mode = MatchMode::BOSS;
+};
+
+void ScriptCameraOrbit(Game&, int frame, InputFrame& input) {
+    // Full orbit every ~4 seconds with a slow pitch sweep
+    input.lookX = 150.0f;
+    input.lookY = 40.0f * sinf(static_cast<float>(frame) * 0.02f);
+}
+
+void ScriptBossProjectileSpam(Game& game, int frame, InputFrame& input) {
+    game.DebugFireBossVolley();
+    // Keep the player moving so projectiles spread across the arena
+    input.held |= (frame / 90) % 2 == 0 ? INPUT_LEFT : INPUT_RIGHT;
+    input.held |= INPUT_FORWARD;
+}
+
+void ScriptBossBulletPatterns(Game& game, int frame, InputFrame& input) {
+    game.DebugStartBossPatterns();
+    // Strafe around the boss so aimed volleys keep turning
+    input.held |= (frame / 120) % 2 == 0 ? INPUT_LEFT : INPUT_RIGHT;
+    input.lookX = 10.0f;
+}
+
+void ScriptRewindScrub(Game& game, int frame, InputFrame& input) {
+    // Patterns keep hundreds of bullets in every frame; play 3 s, scrub back 2 s
+    game.DebugStartBossPatterns();
+    if (frame % 300 >= 180) {
+        input.held |= INPUT_REWIND;
+    }
+    input.held |= (frame / 120) % 2 == 0 ? INPUT_LEFT : INPUT_RIGHT;
+}
+
+void ScriptFullTomatoPool(Game& game, int frame, InputFrame& input) {
+    game.DebugFillTomatoPool();
+    input.lookX = 20.0f;
+    input.held |= (frame / 120) % 2 == 0 ? INPUT_FORWARD : INPUT_BACKWARD;
+}
+
+void ScriptMinionHorde(Game& game, int frame, InputFrame& input) {
+    // Kept at capacity, so the melee swings below are refilled at once
+    game.DebugFillHorde();
+    input.held |= (frame / 120) % 2 == 0 ? INPUT_LEFT : INPUT_RIGHT;
+    if (frame % 30 == 0) {
+        input.pressed |= INPUT_MELEE;
+    }
+}
+
+void ScriptParticleStorm(Game& game, int frame, InputFrame& input) {
+    // A full effect ring every tick keeps the particle pool near capacity
+    game.DebugBurstEffects();
+    input.lookX = 20.0f;
+    input.held |= (frame / 120) % 2 == 0 ? INPUT_LEFT : INPUT_RIGHT;
+}
+
+void ScriptMaxZoomOut(Game&, int frame, InputFrame& input) {
+    // Wheel out every frame (CameraManager clamps at the max distance) and orbit slowly
+    input.zoom = -50.0f;
+    input.lookX = 40.0f;
+    input.lookY = frame < 60 ? -10.0f : 0.0f;
+}
+
+void ScriptRollbackResim(Game& game, int frame, InputFrame& input) {
+    // Bullets in flight make every replayed tick a full one
+    game.DebugStartBossPatterns();
+    input.held |= (frame / 120) % 2 == 0 ? INPUT_LEFT : INPUT_RIGHT;
+    input.lookX = 10.0f;
+}
+
+/**
+ * @brief One rollback_resim tick: the partner's command arrives as late as
+ * allowed and is never what was predicted (it always shoots), so every frame
+ * loads a state ROLLBACK_MAX_TICKS back and replays all of them
+ */
+void StepRollback(RollbackSession& rollback, Game& game, const InputFrame& input) {
+    PlayerCommand local = game.UpdateView(input, PERF_DELTA_TIME);
+    rollback.AddCommand(0, rollback.GetKnownFrames(0), local);
+
+    uint32_t remoteFrame = rollback.GetKnownFrames(1);
+    if (remoteFrame + ROLLBACK_MAX_TICKS <= rollback.GetFrame()) {
+        uint32_t held = (remoteFrame / 90) % 2 == 0 ? INPUT_FORWARD : INPUT_BACKWARD;
+        rollback.AddCommand(1, remoteFrame, PlayerCommand{held, INPUT_SHOOT, static_cast<float>(remoteFrame % 360)});
+    }
+    rollback.Advance();
+}
+
+const Scenario SCENARIOS[] = {
+    {"camera_orbit", "Continuous third-person camera orbit around the arena", ScriptCameraOrbit},
+    {"boss_projectile_spam", "Every boss projectile slot in flight each frame", ScriptBossProjectileSpam},
+    {"boss_bullet_patterns", "Every bound boss bullet pattern running back to back", ScriptBossBulletPatterns},
+    {"rewind_scrub", "Bullet patterns with the rewind history captured and scrubbed", ScriptRewindScrub},
+    {"full_tomato_pool", "All tomato slots spawned and drawn", ScriptFullTomatoPool},
+    {"max_zoom_out", "Camera at maximum distance looking over the whole arena", ScriptMaxZoomOut},
+    {"rollback_resim", "Co-op rollback replaying the deepest window every frame", ScriptRollbackResim, true},
+    {"minion_horde", "Horde mode with every minion slot flocking around the player", ScriptMinionHorde, false,
+     MatchMode::HORDE},
+    {"particle_storm", "Hit and pickup bursts every tick, the particle pool near capacity", ScriptParticleStorm},
+};
+
+double NowMs() {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+float Percentile(const std::vector<float>& sorted, float p) {
+    if (sorted.empty()) return 0.0f;
+    int index = static_cast<int>(std::ceil(p * static_cast<float>(sorted.size()))) - 1;
+    index = std::max(0, std::min(index, static_cast<int>(sorted.size()) - 1));
+    return sorted[index];
+}
+
+PerfResult RunScenario(const Scenario& scenario, const PerfOptions& options, const GameAssets& assets) {
+    // Update and draw run back to back on this thread so a frame's cost is
+    // sim + render, independent of how the two threads would overlap
+    Game game(assets, PERF_RANDOM_SEED);
+    Renderer renderer(assets);
+    auto snapshot = std::make_unique<FrameSnapshot>();
+    std::unique_ptr<RollbackSession> rollback;
+    game.SetMatchMode(scenario.mode);
+    if (scenario.rollback) {
+        rollback = std::make_unique<RollbackSession>(game, MAX_PLAYERS, 0, PERF_DELTA_TIME);
+        rollback->Start(0);
+    } else {
+        game.StartMatch();
+    }
+
+    std::vector<float> samples;
+    samples.reserve(options.frames);
+    int allocatingFrames = 0;
+    uint64_t allocations = 0;
+    AllocTracker& allocTracker = AllocTracker::GetInstance();
+
+    int totalFrames = options.warmupFrames + options.frames;
+    for (int frame = 0; frame < totalFrames; ++frame) {
+        if (options.allocTest && frame == options.warmupFrames) {
+            allocTracker.SetEnabled(true);
+        }
+
+        // The scripted player can die or win under load; keep the match running.
+        // A restart frame is not steady state, so it is exempt from the alloc test.
+        bool steadyState = true;
+        if (game.GetState() != GameState::PLAYING) {
+            game.StartMatch();
+            steadyState = false;
+        }
+
+        InputFrame input = {};
+        scenario.script(game, frame, input);
+
+        RenderStats::GetInstance().BeginFrame();
+        double start = NowMs();
+        if (rollback) {
+            StepRollback(*rollback, game, input);
+        } else {
+            game.Update(input, PERF_DELTA_TIME);
+        }
+        game.WriteSnapshot(*snapshot);
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        renderer.Draw(*snapshot);
+        EndDrawing();
+        double end = NowMs();
+        RenderStats::GetInstance().EndFrame();
+        allocTracker.EndFrame();
+
+        if (frame >= options.warmupFrames) {
+            samples.push_back(static_cast<float>(end - start));
+
+            uint32_t frameAllocations = allocTracker.GetLastFrame().allocations;
+            if (options.allocTest && steadyState && frameAllocations > 0) {
+                if (allocatingFrames == 0) {
+                    std::printf("  ALLOC ASSERT: frame %d made %u heap allocation(s)\n",
+                                frame - options.warmupFrames, frameAllocations);
+                }
+                allocatingFrames++;
+                allocations += frameAllocations;
+            }
+        }
+    }
+
+    if (options.allocTest) {
+        allocTracker.SetEnabled(false);
+        if (allocatingFrames > 0) {
+            allocTracker.ReportCallSites(10);
+        }
+    }
+
+    PerfResult result;
+    result.name = scenario.name;
+    result.frames = static_cast<int>(samples.size());
+
+    double sum = 0.0;
+    for (float s : samples) sum += s;
+    result.mean = samples.empty() ? 0.0f : static_cast<float>(sum / samples.size());
+
+    std::sort(samples.begin(), samples.end());
+    result.p50 = Percentile(samples, 0.50f);
+    result.p95 = Percentile(samples, 0.95f);
+    result.p99 = Percentile(samples, 0.99f);
+    result.max = samples.empty() ? 0.0f : samples.back();
+    result.allocatingFrames = allocatingFrames;
+    result.allocations = allocations;
+    return result;
+}
+
+bool WriteResults(const char* path, const std::vector<PerfResult>& results, const PerfOptions& options) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+
+    std::fprintf(file, "{\n  \"warmup_frames\": %d,\n  \"tolerance\": {\"p99_ratio\": %.2f, \"p99_slack_ms\": %.2f},\n  \"scenarios\": {\n",
+                 options.warmupFrames, PERF_DEFAULT_P99_RATIO, PERF_DEFAULT_P99_SLACK_MS);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const PerfResult& r = results[i];
+        std::fprintf(file,
+            "    \"%s\": {\"frames\": %d, \"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}%s\n",
+            r.name.c_str(), r.frames, r.mean, r.p50, r.p95, r.p99, r.max,
+            (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  }\n}\n");
+    return std::fclose(file) == 0;
+}
+
+/**
+ * @brief Compare results against the baseline; returns the number of failures
+ * A scenario without a baseline entry fails too: it would otherwise never be checked.
+ */
+int CompareWithBaseline(const JsonValue& baseline, const std::vector<PerfResult>& results) {
+    float ratio = PERF_DEFAULT_P99_RATIO;
+    float slack = PERF_DEFAULT_P99_SLACK_MS;
+    if (const JsonValue* tolerance = baseline.Find("tolerance")) {
+        ratio = static_cast<float>(tolerance->GetNumber("p99_ratio", ratio));
+        slack = static_cast<float>(tolerance->GetNumber("p99_slack_ms", slack));
+    }
+
+    const JsonValue* scenarios = baseline.Find("scenarios");
+    int regressions = 0;
+    int missing = 0;
+
+    std::printf("\n%-24s %10s %10s %10s  %s\n", "scenario", "p99 (ms)", "baseline", "limit", "status");
+    for (const PerfResult& r : results) {
+        const JsonValue* entry = scenarios ? scenarios->Find(r.name.c_str()) : nullptr;
+        if (!entry || !entry->Find("p99")) {
+            std::printf("%-24s %10.3f %10s %10s  NO BASELINE\n", r.name.c_str(), r.p99, "-", "-");
+            missing++;
+            continue;
+        }
+        float expected = static_cast<float>(entry->GetNumber("p99", 0.0));
+        float limit = expected * ratio + slack;
+        bool regressed = r.p99 > limit;
+        std::printf("%-24s %10.3f %10.3f %10.3f  %s\n",
+                    r.name.c_str(), r.p99, expected, limit, regressed ? "REGRESSION" : "ok");
+        if (regressed) regressions++;
+    }
+    if (regressions > 0) {
+        std::printf("\n%d scenario(s) regressed p99 frame time\n", regressions);
+    }
+    if (missing > 0) {
+        std::printf("\n%d scenario(s) have no baseline entry (record them with make perf-baseline)\n", missing);
+    }
+    return regressions + missing;
+}
+
+} // namespace
+
+void ListPerfScenarios() {
+    for (const Scenario& scenario : SCENARIOS) {
+        std::printf("  %-24s %s\n", scenario.name, scenario.description);
+    }
+}
+
+int RunPerfScenarios(const PerfOptions& options) {
+    std::vector<const Scenario*> selected;
+    for (const Scenario& scenario : SCENARIOS) {
+        if (options.scenario == "all" || options.scenario == scenario.name) {
+            selected.push_back(&scenario);
+        }
+    }
+    if (selected.empty()) {
+        std::fprintf(stderr, "Unknown perf scenario '%s'. Available:\n", options.scenario.c_str());
+        ListPerfScenarios();
+        return 2;
+    }
+
+    // Load the baseline first so a typo fails before minutes of measuring
+    JsonValue baseline;
+    bool hasBaseline = false;
+    if (!options.baselinePath.empty()) {
+        std::string error;
+        if (!LoadJsonFile(options.baselinePath.c_str(), baseline, &error)) {
+            std::fprintf(stderr, "Failed to read baseline %s: %s\n", options.baselinePath.c_str(), error.c_str());
+            return 2;
+        }
+        hasBaseline = true;
+    }
+
+    // Hidden window, uncapped frame rate: measure the work, not the vsync wait
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Time Master - Perf");
+    SetTargetFPS(0);
+
+    GameAssets assets;
+    assets.Load();
+
+    std::vector<PerfResult> results;
+    for (const Scenario* scenario : selected) {
+        std::printf("Running %s (%d + %d frames)...\n", scenario->name, options.warmupFrames, options.frames);
+        std::fflush(stdout);
+        PerfResult result = RunScenario(*scenario, options, assets);
+        std::printf("  mean %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f ms\n",
+                    result.mean, result.p50, result.p95, result.p99, result.max);
+        if (options.allocTest) {
+            std::printf("  %d/%d steady-state frames allocated (%llu allocations)\n",
+                        result.allocatingFrames, result.frames,
+                        static_cast<unsigned long long>(result.allocations));
+        }
+        results.push_back(result);
+    }
+
+    assets.Unload();
+    CloseWindow();
+
+    if (!options.resultsPath.empty()) {
+        if (!WriteResults(options.resultsPath.c_str(), results, options)) {
+            std::fprintf(stderr, "Failed to write %s\n", options.resultsPath.c_str());
+            return 2;
+        }
+        std::printf("Wrote %s\n", options.resultsPath.c_str());
+    }
+    if (!options.writeBaselinePath.empty()) {
+        if (!WriteResults(options.writeBaselinePath.c_str(), results, options)) {
+            std::fprintf(stderr, "Failed to write %s\n", options.writeBaselinePath.c_str());
+            return 2;
+        }
+        std::printf("Wrote baseline %s\n", options.writeBaselinePath.c_str());
+    }
+
+    int exitCode = 0;
+    if (hasBaseline) {
+        if (CompareWithBaseline(baseline, results) > 0) {
+            exitCode = 1;
+        } else {
+            std::printf("\nAll scenarios within baseline tolerance\n");
+        }
+    }
+    if (options.allocTest) {
+        int allocating = 0;
+        for (const PerfResult& r : results) {
+            if (r.allocatingFrames > 0) allocating++;
+        }
+        if (allocating > 0) {
+            std::printf("\n%d scenario(s) allocate during steady-state gameplay\n", allocating);
+            exitCode = 1;
+        } else {
+            std::printf("\nNo steady-state gameplay frame allocated\n");
+        }
+    }
+    return exitCode;
+}
+
+} // namespace TimeMaster
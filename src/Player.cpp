@@ -1,4 +1,6 @@
 #include "Player.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
 #include "raymath.h"
 #include <cstdio>
 #include <algorithm>
@@ -9,70 +11,30 @@ constexpr Vector2 ARENA_CENTER = { 60.0f, 10.0f };
 
 namespace TimeMaster {
 
-// Static member initialization
-Model Player::s_model = {0};
-bool Player::s_modelLoaded = false;
-ModelAnimation* Player::s_animations = nullptr;
-int Player::s_animationCount = 0;
-
-Player::Player()
+Player::Player(const GameConfig& config, const ModelAsset& asset)
     : m_currentAnimFrame(0)
     , m_currentAnimIndex(-1)
     , m_animTimer(0.0f)
     , m_isMoving(false)
     , m_isRunning(false)
     , m_rotationAngle(0.0f)
+    , m_config(config)
+    , m_asset(asset)
+    , m_idleAnim(-1)
+    , m_walkAnim(-1)
+    , m_runAnim(-1)
 {
-    Reset();
-}
-
-Player::~Player() {
-    // Model is static and unloaded elsewhere
-}
-
-void Player::LoadModel() {
-    if (!s_modelLoaded) {
-        const char* modelPath = "assets/models/player/scene.gltf";
-        s_model = ::LoadModel(modelPath);
-
-        if (s_model.meshCount > 0 && s_model.meshes != nullptr) {
-            s_animations = ::LoadModelAnimations(modelPath, &s_animationCount);
-            s_modelLoaded = true;
-
-            TraceLog(LOG_INFO, "Player model loaded with %d animations", s_animationCount);
-
-            for (int i = 0; i < s_animationCount; i++) {
-                TraceLog(LOG_INFO, "  Animation %d: %s (%d frames)",
-                         i, s_animations[i].name, s_animations[i].frameCount);
-            }
-
-            for (int i = 0; i < s_model.materialCount; i++) {
-                if (s_model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture.id > 0) {
-                    SetTextureFilter(
-                        s_model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture,
-                        TEXTURE_FILTER_BILINEAR
-                    );
-                }
-            }
-        } else {
-            s_model = (Model){0};
-            s_modelLoaded = false;
-        }
-    }
-}
-
-void Player::UnloadModel() {
-    if (s_modelLoaded) {
-        ::UnloadModel(s_model);
-        if (s_animations) {
-            ::UnloadModelAnimations(s_animations, s_animationCount);
-        }
-        s_modelLoaded = false;
+    for (int i = 0; i < m_asset.animationCount; i++) {
+        const char* name = m_asset.animations[i].name;
+        if (strstr(name, "Idle") || strstr(name, "idle")) m_idleAnim = i;
+        if (strstr(name, "Walk") || strstr(name, "walk")) m_walkAnim = i;
+        if (strstr(name, "Run")  || strstr(name, "run"))  m_runAnim  = i;
     }
+    Reset();
 }
 
 void Player::Reset() {
-    auto& config = GameConfig::GetInstance();
+    const GameConfig& config = m_config;
 
     m_size = {40.0f / 3.0f, 60.0f / 3.0f, 40.0f / 3.0f};
     float halfHeight = m_size.y / 2.0f;
@@ -93,6 +55,25 @@ void Player::Reset() {
     m_rotationAngle = 0.0f;
 }
 
+PlayerRecord Player::SaveRecord() const {
+    return {m_position, m_velocity, m_time, m_rotationAngle, m_animTimer,
+            m_currentAnimIndex, m_currentAnimFrame, m_color, m_isAlive, m_isMoving, m_isRunning};
+}
+
+void Player::LoadRecord(const PlayerRecord& record) {
+    m_position = record.position;
+    m_velocity = record.velocity;
+    m_time = record.time;
+    m_rotationAngle = record.rotation;
+    m_animTimer = record.animTimer;
+    m_currentAnimIndex = record.animIndex;
+    m_currentAnimFrame = record.animFrame;
+    m_color = record.color;
+    m_isAlive = record.alive;
+    m_isMoving = record.moving;
+    m_isRunning = record.running;
+}
+
 void Player::Update(float deltaTime) {
     Vector3 movement = {0, 0, 0};
 
@@ -118,29 +99,19 @@ void Player::Update(float deltaTime) {
         m_velocity.y = 0;
     }
 
-    // Animation
-    if (s_modelLoaded && s_animationCount > 0) {
-        static int idleAnim = -1;
-        static int walkAnim = -1;
-        static int runAnim  = -1;
-
-        if (idleAnim == -1) {
-            for (int i = 0; i < s_animationCount; i++) {
-                const char* name = s_animations[i].name;
-                if (strstr(name, "Idle") || strstr(name, "idle")) idleAnim = i;
-                if (strstr(name, "Walk") || strstr(name, "walk")) walkAnim = i;
-                if (strstr(name, "Run")  || strstr(name, "run"))  runAnim  = i;
-            }
-        }
+    UpdateAnimation(deltaTime);
+}
 
-        int animIndex = (idleAnim >= 0) ? idleAnim : 0;
+void Player::UpdateAnimation(float deltaTime) {
+    if (m_asset.loaded && m_asset.animationCount > 0) {
+        int animIndex = (m_idleAnim >= 0) ? m_idleAnim : 0;
 
         if (m_isMoving) {
-            if (m_isRunning && runAnim >= 0) animIndex = runAnim;
-            else if (walkAnim >= 0) animIndex = walkAnim;
+            if (m_isRunning && m_runAnim >= 0) animIndex = m_runAnim;
+            else if (m_walkAnim >= 0) animIndex = m_walkAnim;
         }
 
-        if (animIndex >= s_animationCount) animIndex = 0;
+        if (animIndex >= m_asset.animationCount) animIndex = 0;
 
         if (animIndex != m_currentAnimIndex) {
             m_currentAnimIndex = animIndex;
@@ -153,15 +124,9 @@ void Player::Update(float deltaTime) {
             m_animTimer = 0.0f;
             m_currentAnimFrame++;
 
-            if (m_currentAnimFrame >= s_animations[m_currentAnimIndex].frameCount) {
+            if (m_currentAnimFrame >= m_asset.animations[m_currentAnimIndex].frameCount) {
                 m_currentAnimFrame = 0;
             }
-
-            UpdateModelAnimation(
-                s_model,
-                s_animations[m_currentAnimIndex],
-                m_currentAnimFrame
-            );
         }
     }
 }
@@ -203,28 +168,46 @@ void Player::ApplyPushback(Vector3 pushback) {
 }
 
 void Player::Draw() const {
-    if (!m_isAlive) return;
+    DrawSnapshot(GetSnapshot(), m_asset);
+}
+
+PlayerSnapshot Player::GetSnapshot() const {
+    PlayerSnapshot snapshot;
+    snapshot.position = m_position;
+    snapshot.size = m_size;
+    snapshot.rotation = m_rotationAngle;
+    snapshot.time = m_time;
+    snapshot.animIndex = m_currentAnimIndex;
+    snapshot.animFrame = m_currentAnimFrame;
+    snapshot.color = m_color;
+    snapshot.alive = m_isAlive;
+    return snapshot;
+}
 
-    if (s_modelLoaded) {
-        BoundingBox bounds = GetModelBoundingBox(s_model);
+void Player::DrawSnapshot(const PlayerSnapshot& snapshot, const ModelAsset& asset) {
+    if (!snapshot.alive) return;
+
+    if (asset.loaded) {
+        BoundingBox bounds = GetModelBoundingBox(asset.model);
 
         float scale = 10.0f;
         Vector3 modelScale = {scale, scale, scale};
 
-        Vector3 drawPos = m_position;
+        Vector3 drawPos = snapshot.position;
         drawPos.y = -bounds.min.y * scale + 5.0f;
 
-        DrawModelEx(
-            s_model,
+        Gfx::DrawModelEx(
+            asset.model,
             drawPos,
             {0.0f, 1.0f, 0.0f},
-            m_rotationAngle + 180.0f,
+            snapshot.rotation + 180.0f,
             modelScale,
             WHITE
         );
     } else {
-        DrawCube(m_position, m_size.x, m_size.y, m_size.z, m_color);
-        DrawCubeWires(m_position, m_size.x, m_size.y, m_size.z, DARKBLUE);
+        const Vector3& size = snapshot.size;
+        Gfx::DrawCube(snapshot.position, size.x, size.y, size.z, snapshot.color);
+        Gfx::DrawCubeWires(snapshot.position, size.x, size.y, size.z, DARKBLUE);
     }
 }
 
@@ -237,20 +220,20 @@ void Player::TakeDamage(float damage) {
 }
 
 void Player::Heal(float amount) {
-    auto& config = GameConfig::GetInstance();
-    m_time = std::min(m_time + amount, config.playerMaxTime);
+    m_time = std::min(m_time + amount, m_config.playerMaxTime);
 }
 
-std::string Player::GetTimeString() const {
+const char* Player::FormatTime(char* buffer, size_t size) const {
     int minutes = static_cast<int>(m_time / 60);
     int seconds = static_cast<int>(m_time) % 60;
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%d:%02d", minutes, seconds);
-    return std::string(buffer);
+    snprintf(buffer, size, "%d:%02d", minutes, seconds);
+    return buffer;
 }
 
-void Player::UpdateWithCamera(float deltaTime, Vector3 cameraForward, Vector3 cameraRight)
+void Player::UpdateWithCamera(const PlayerCommand& command, float deltaTime, Vector3 cameraForward, Vector3 cameraRight)
 {
+    PROFILE_ZONE("Player::UpdateWithCamera");
+
     Vector3 movement = {0, 0, 0};
 
     cameraForward.y = 0.0f;
@@ -259,19 +242,20 @@ void Player::UpdateWithCamera(float deltaTime, Vector3 cameraForward, Vector3 ca
     cameraForward = Vector3Normalize(cameraForward);
     cameraRight   = Vector3Normalize(cameraRight);
 
-    bool forward  = IsKeyDown(KEY_W) || IsKeyDown(KEY_UP);
-    bool backward = IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN);
-    bool left     = IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT);
-    bool right    = IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT);
+    bool forward  = command.IsDown(INPUT_FORWARD);
+    bool backward = command.IsDown(INPUT_BACKWARD);
+    bool left     = command.IsDown(INPUT_LEFT);
+    bool right    = command.IsDown(INPUT_RIGHT);
 
-    m_isRunning = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+    m_isRunning = command.IsDown(INPUT_RUN);
 
     if (forward)  movement = Vector3Add(movement, cameraForward);
     if (backward) movement = Vector3Subtract(movement, cameraForward);
     if (left)     movement = Vector3Subtract(movement, cameraRight);
     if (right)    movement = Vector3Add(movement, cameraRight);
 
-    if (Vector3Length(movement) > 0.0f) {
+    m_isMoving = (Vector3Length(movement) > 0.0f);
+    if (m_isMoving) {
         float originalSpeed = m_speed;
         m_speed = m_isRunning ? m_speed * 1.8f : m_speed;
 
@@ -280,6 +264,8 @@ void Player::UpdateWithCamera(float deltaTime, Vector3 cameraForward, Vector3 ca
         m_speed = originalSpeed;
         m_rotationAngle = atan2f(movement.x, movement.z) * RAD2DEG;
     }
+
+    UpdateAnimation(deltaTime);
 }
 
 } // namespace TimeMaster
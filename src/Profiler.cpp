@@ -0,0 +1,278 @@
+#include "Profiler.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace TimeMaster {
+
+std::atomic<bool> Profiler::s_enabled(false);
+
+namespace {
+thread_local ThreadEventBuffer* t_threadBuffer = nullptr;
+}
+
+Profiler::Profiler()
+    : m_zoneNames{}
+    , m_zoneCount(0)
+    , m_frameStart(0)
+    , m_frameIndex(0)
+    , m_frameTimes{}
+    , m_zoneTimes{}
+    , m_currentZoneTimes{}
+    , m_scratch{}
+    , m_overlayVisible(false)
+    , m_backgroundTiming(false)
+    , m_capturing(false)
+    , m_captureStart(0)
+    , m_captureDuration(0) {
+}
+
+Profiler& Profiler::GetInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+ZoneId Profiler::RegisterZone(const char* name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int i = 0; i < m_zoneCount; ++i) {
+        if (std::strcmp(m_zoneNames[i], name) == 0) {
+            return static_cast<ZoneId>(i);
+        }
+    }
+    if (m_zoneCount >= PROFILER_MAX_ZONES) {
+        // Out of slots: fold into the last zone rather than failing
+        return static_cast<ZoneId>(PROFILER_MAX_ZONES - 1);
+    }
+    m_zoneNames[m_zoneCount] = name;
+    return static_cast<ZoneId>(m_zoneCount++);
+}
+
+ThreadEventBuffer& Profiler::GetThreadBuffer() {
+    if (t_threadBuffer == nullptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint32_t threadIndex = static_cast<uint32_t>(m_threadBuffers.size());
+        m_threadBuffers.push_back(std::make_unique<ThreadEventBuffer>(threadIndex));
+        t_threadBuffer = m_threadBuffers.back().get();
+    }
+    return *t_threadBuffer;
+}
+
+void Profiler::Marker(const char* name) {
+    if (!IsEnabled()) return;
+    ZoneId zone = RegisterZone(name);
+    uint64_t now = Now();
+    GetThreadBuffer().Push({now, now, zone, ZoneEventKind::MARKER});
+}
+
+void Profiler::SetThreadName(const char* name) {
+    GetThreadBuffer().SetName(name);
+}
+
+void Profiler::UpdateEnabled() {
+    bool enabled = m_overlayVisible || m_capturing || m_backgroundTiming;
+    if (enabled && !IsEnabled()) {
+        // Start a fresh history so stale frames don't skew the statistics
+        m_frameIndex = 0;
+        m_frameStart = Now();
+
+        // Discard events left over from the previous enabled period
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& buffer : m_threadBuffers) {
+            buffer->Drain([](const ZoneEvent&) {});
+        }
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::SetOverlayVisible(bool visible) {
+    m_overlayVisible = visible;
+    UpdateEnabled();
+}
+
+void Profiler::SetBackgroundTiming(bool enabled) {
+    m_backgroundTiming = enabled;
+    UpdateEnabled();
+}
+
+void Profiler::BeginCapture(float seconds) {
+    if (m_capturing) return;
+
+    // Reserve up front (~256 events per frame at 60 FPS) so captures don't reallocate mid-run
+    size_t expectedFrames = static_cast<size_t>(seconds * 60.0f) + 1;
+    m_capturedEvents.clear();
+    m_capturedEvents.reserve(expectedFrames * 256);
+    m_capturedFrames.clear();
+    m_capturedFrames.reserve(expectedFrames * 2);
+
+    m_captureDuration = static_cast<uint64_t>(seconds * 1e9f);
+    m_capturing = true;
+    UpdateEnabled();
+    m_captureStart = Now();
+}
+
+float Profiler::GetCaptureProgress() const {
+    if (!m_capturing || m_captureDuration == 0) return 0.0f;
+    return std::min(1.0f, static_cast<float>(Now() - m_captureStart) / static_cast<float>(m_captureDuration));
+}
+
+void Profiler::FinishCapture() {
+    m_capturing = false;
+    UpdateEnabled();
+
+    char path[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(path, sizeof(path), "trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+
+    if (WriteChromeTrace(path)) {
+        m_lastCapturePath = path;
+        TM_LOG_INFO(PROFILER, "Wrote %zu events over %zu frames to %s",
+                    m_capturedEvents.size(), m_capturedFrames.size(), path);
+    } else {
+        m_lastCapturePath.clear();
+        TM_LOG_ERROR(PROFILER, "Failed to write trace file %s", path);
+    }
+
+    m_capturedEvents.clear();
+    m_capturedEvents.shrink_to_fit();
+    m_capturedFrames.clear();
+    m_capturedFrames.shrink_to_fit();
+}
+
+bool Profiler::WriteChromeTrace(const char* path) const {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+
+    // Timestamps are microseconds relative to the capture start
+    auto toMicros = [this](uint64_t ns) {
+        return static_cast<double>(ns > m_captureStart ? ns - m_captureStart : 0) / 1000.0;
+    };
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"time_master\"}}");
+
+    for (const auto& buffer : m_threadBuffers) {
+        const char* name = buffer->GetName();
+        if (name) {
+            std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                         buffer->GetThreadIndex(), name);
+        } else {
+            std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+                         buffer->GetThreadIndex(), buffer->GetThreadIndex());
+        }
+    }
+
+    // Frames go on the thread that calls BeginFrame/EndFrame
+    for (const auto& frame : m_capturedFrames) {
+        std::fprintf(file, ",\n{\"name\":\"Frame %llu\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     static_cast<unsigned long long>(frame.index), frame.thread,
+                     toMicros(frame.start), static_cast<double>(frame.end - frame.start) / 1000.0);
+    }
+
+    for (const auto& captured : m_capturedEvents) {
+        const ZoneEvent& event = captured.event;
+        if (event.kind == ZoneEventKind::MARKER) {
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"marker\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                         m_zoneNames[event.zone], captured.thread, toMicros(event.start));
+        } else {
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         m_zoneNames[event.zone], captured.thread,
+                         toMicros(event.start), static_cast<double>(event.end - event.start) / 1000.0);
+        }
+    }
+
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+}
+
+void Profiler::BeginFrame() {
+    if (!IsEnabled()) return;
+    m_frameStart = Now();
+}
+
+void Profiler::EndFrame() {
+    if (!IsEnabled()) return;
+
+    uint64_t frameEnd = Now();
+    m_currentZoneTimes.fill(0.0f);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& buffer : m_threadBuffers) {
+            uint32_t thread = buffer->GetThreadIndex();
+            buffer->Drain([this, thread](const ZoneEvent& event) {
+                m_currentZoneTimes[event.zone] += static_cast<float>(event.end - event.start) * 1e-6f;
+                if (m_capturing) {
+                    m_capturedEvents.push_back({event, thread});
+                }
+            });
+        }
+    }
+
+    if (m_capturing) {
+        uint32_t thread = GetThreadBuffer().GetThreadIndex();
+        m_capturedFrames.push_back({m_frameStart, frameEnd, m_frameIndex, thread});
+        if (frameEnd - m_captureStart >= m_captureDuration) {
+            FinishCapture();
+        }
+    }
+
+    int slot = static_cast<int>(m_frameIndex % PROFILER_HISTORY_FRAMES);
+    m_frameTimes[slot] = static_cast<float>(frameEnd - m_frameStart) * 1e-6f;
+    m_zoneTimes[slot] = m_currentZoneTimes;
+    m_frameIndex++;
+}
+
+int Profiler::GetHistoryCount() const {
+    return static_cast<int>(std::min<uint64_t>(m_frameIndex, PROFILER_HISTORY_FRAMES));
+}
+
+float Profiler::GetFrameTime(int framesAgo) const {
+    if (framesAgo < 0 || framesAgo >= GetHistoryCount()) return 0.0f;
+    uint64_t index = m_frameIndex - 1 - static_cast<uint64_t>(framesAgo);
+    return m_frameTimes[index % PROFILER_HISTORY_FRAMES];
+}
+
+ZoneStats Profiler::ComputeStats(const float* samples, int stride, int count) const {
+    ZoneStats stats = {0.0f, 0.0f, 0.0f, 0.0f};
+    if (count <= 0) return stats;
+
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        m_scratch[i] = samples[i * stride];
+        sum += m_scratch[i];
+    }
+    stats.average = sum / static_cast<float>(count);
+    stats.last = samples[((m_frameIndex - 1) % PROFILER_HISTORY_FRAMES) * stride];
+
+    auto percentile = [this, count](float p) {
+        int index = static_cast<int>(std::ceil(p * static_cast<float>(count))) - 1;
+        index = std::max(0, std::min(index, count - 1));
+        std::nth_element(m_scratch.begin(), m_scratch.begin() + index, m_scratch.begin() + count);
+        return m_scratch[index];
+    };
+    stats.p95 = percentile(0.95f);
+    stats.p99 = percentile(0.99f);
+    return stats;
+}
+
+ZoneStats Profiler::GetFrameStats() const {
+    return ComputeStats(m_frameTimes.data(), 1, GetHistoryCount());
+}
+
+ZoneStats Profiler::GetZoneStats(ZoneId zone) const {
+    return ComputeStats(&m_zoneTimes[0][zone], PROFILER_MAX_ZONES, GetHistoryCount());
+}
+
+uint32_t Profiler::GetDroppedEventCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t dropped = 0;
+    for (const auto& buffer : m_threadBuffers) {
+        dropped += buffer->GetDroppedCount();
+    }
+    return dropped;
+}
+
+} // namespace TimeMaster
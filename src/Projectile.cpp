@@ -1,58 +1,82 @@
 #include "Projectile.hpp"
+#include "RenderStats.hpp"
 #include "raymath.h"
 #include <cmath>
 
 namespace TimeMaster {
 
-Projectile::Projectile() 
-    : m_position{0, 0, 0}
-    , m_velocity{0, 0, 0}
-    , m_radius(PROJECTILE_RADIUS)
-    , m_active(false)
-    , m_color(ORANGE) {
+namespace {
+// Low-poly spheres: bullet patterns put thousands of projectiles on screen
+constexpr int PROJECTILE_SPHERE_RINGS = 6;
+constexpr int PROJECTILE_SPHERE_SLICES = 8;
 }
 
-void Projectile::Launch(Vector3 startPos, Vector3 targetPos) {
-    auto& config = GameConfig::GetInstance();
-    m_position = startPos;
-    Vector3 direction = Vector3Subtract(targetPos, startPos);
-    direction = Vector3Normalize(direction);
-    m_velocity = Vector3Scale(direction, config.projectileSpeed);
-    m_active = true;
+EntityId LaunchProjectile(ProjectileArchetype& projectiles, Vector3 start, Vector3 target, float speed,
+                          uint32_t lagTicks) {
+    EntityId entity = projectiles.Create();
+    if (entity == INVALID_ENTITY) return entity;
+
+    uint32_t row = projectiles.GetRow(entity);
+    Vector3 direction = Vector3Normalize(Vector3Subtract(target, start));
+    projectiles.Get<Position>()[row] = {start};
+    projectiles.Get<Velocity>()[row] = {Vector3Scale(direction, speed)};
+    projectiles.Get<Collider>()[row] = {PROJECTILE_RADIUS};
+    projectiles.Get<Renderable>()[row] = {ORANGE};
+    projectiles.Get<LagCompensation>()[row] = {lagTicks};
+    return entity;
 }
 
-void Projectile::Update(float deltaTime) {
-    if (!m_active) return;
-    
-    m_position = Vector3Add(m_position, Vector3Scale(m_velocity, deltaTime));
-    
-    // Deactivate if out of bounds
-    if (std::fabs(m_position.x) > ARENA_SIZE || 
-        m_position.y < 0 || 
-        m_position.y > 200 ||
-        std::fabs(m_position.z) > ARENA_SIZE) {
-        m_active = false;
+void UpdateProjectiles(ProjectileArchetype& projectiles, uint32_t begin, uint32_t end, float deltaTime,
+                       const ProjectileTarget& target, uint8_t* status) {
+    IntegrateMotion(projectiles, begin, end, deltaTime);
+
+    const Position* positions = projectiles.Get<Position>();
+    const Collider* colliders = projectiles.Get<Collider>();
+    const LagCompensation* lags = projectiles.Get<LagCompensation>();
+    for (uint32_t row = begin; row < end; ++row) {
+        Vector3 position = positions[row].value;
+        if (std::fabs(position.x) > ARENA_SIZE ||
+            position.y < 0 ||
+            position.y > 200 ||
+            std::fabs(position.z) > ARENA_SIZE) {
+            status[row] = PROJECTILE_LEFT_ARENA;
+            continue;
+        }
+
+        // A lagged shooter's projectile meets the target as it was lag ticks ago
+        const CapsuleSet* capsules = target.capsules;
+        uint32_t lag = lags[row].ticks;
+        if (const CapsuleSet* seen = lag > 0 ? target.history->FindBossCapsules(target.tick - lag) : nullptr) {
+            capsules = seen;
+        }
+        status[row] = capsules->OverlapsSphere(position, colliders[row].radius) ? PROJECTILE_HIT
+                                                                                 : PROJECTILE_FLYING;
     }
 }
 
-void Projectile::Draw() const {
-    if (m_active) {
-        DrawSphere(m_position, m_radius, m_color);
+void RemoveFinishedProjectiles(ProjectileArchetype& projectiles, uint8_t* status) {
+    uint32_t row = 0;
+    while (row < projectiles.GetCount()) {
+        if (status[row] != PROJECTILE_FLYING) {
+            // The last row moves into this one: check it next
+            status[row] = status[projectiles.GetCount() - 1];
+            projectiles.DestroyRow(row);
+        } else {
+            ++row;
+        }
     }
 }
 
-void Projectile::Deactivate() {
-    m_active = false;
+ProjectileSnapshot GetProjectileSnapshot(const ProjectileArchetype& projectiles, uint32_t row) {
+    return {projectiles.Get<Position>()[row].value, projectiles.Get<Collider>()[row].radius,
+            projectiles.Get<Renderable>()[row].color, true};
 }
 
-bool Projectile::CheckCollision(Vector3 pos, float otherRadius) {
-    if (!m_active) return false;
-    
-    if (Vector3Distance(m_position, pos) < m_radius + otherRadius) {
-        m_active = false;
-        return true;
+void DrawProjectileSnapshot(const ProjectileSnapshot& snapshot) {
+    if (snapshot.active) {
+        Gfx::DrawSphereEx(snapshot.position, snapshot.radius,
+                          PROJECTILE_SPHERE_RINGS, PROJECTILE_SPHERE_SLICES, snapshot.color);
     }
-    return false;
 }
 
 } // namespace TimeMaster
@@ -0,0 +1,182 @@
+#include "RenderStats.hpp"
+#include "Log.hpp"
+#include <cstdio>
+#include <ctime>
+
+namespace TimeMaster {
+
+RenderStats::RenderStats()
+    : m_current{}
+    , m_last{}
+    , m_frameIndex(0)
+    , m_boundTexture(0)
+    , m_boundShader(0)
+    , m_batchOpen(false)
+    , m_overlayVisible(false)
+    , m_recording(false) {
+}
+
+RenderStats& RenderStats::GetInstance() {
+    static RenderStats instance;
+    return instance;
+}
+
+void RenderStats::BeginFrame() {
+    m_current = RenderCounters{};
+    // A new frame starts with nothing bound as far as we can tell
+    m_boundTexture = 0;
+    m_boundShader = 0;
+    m_batchOpen = false;
+}
+
+void RenderStats::EndFrame() {
+    m_last = m_current;
+    m_frameIndex++;
+    if (m_recording) {
+        m_csvRows.push_back(m_current);
+    }
+}
+
+void RenderStats::Bind(unsigned int texture, unsigned int shader) {
+    if (texture != m_boundTexture) {
+        m_current.textureBinds++;
+        m_boundTexture = texture;
+    }
+    if (shader != m_boundShader) {
+        m_current.shaderSwitches++;
+        m_boundShader = shader;
+    }
+}
+
+void RenderStats::AddMesh(const Mesh& mesh, const Material& material) {
+    m_batchOpen = false;
+    m_current.drawCalls++;
+    m_current.triangles += static_cast<uint32_t>(mesh.triangleCount > 0 ? mesh.triangleCount : mesh.vertexCount / 3);
+    unsigned int texture = material.maps ? material.maps[MATERIAL_MAP_DIFFUSE].texture.id : 0;
+    Bind(texture, material.shader.id);
+}
+
+void RenderStats::AddImmediate(uint32_t triangles) {
+    if (!m_batchOpen) {
+        // Shapes go through rlgl's batch with the default texture and shader
+        m_batchOpen = true;
+        m_current.drawCalls++;
+        Bind(0, 0);
+    }
+    m_current.triangles += triangles;
+}
+
+void RenderStats::AddInstanced(uint32_t triangles, unsigned int shader, uint64_t uploadBytes) {
+    m_batchOpen = false;
+    m_current.drawCalls++;
+    m_current.triangles += triangles;
+    m_current.uploadBytes += uploadBytes;
+    Bind(0, shader);
+}
+
+void RenderStats::AddSkinning(uint32_t vertices, uint64_t uploadBytes) {
+    m_current.skinnedVertices += vertices;
+    m_current.uploadBytes += uploadBytes;
+}
+
+void RenderStats::ToggleCsvRecording() {
+    if (!m_recording) {
+        m_csvRows.clear();
+        m_csvRows.reserve(RENDER_STATS_CSV_RESERVE);
+        m_recording = true;
+        return;
+    }
+    
+    m_recording = false;
+    char path[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(path, sizeof(path), "render_stats_%Y%m%d_%H%M%S.csv", std::localtime(&now));
+    if (WriteCsv(path)) {
+        m_lastCsvPath = path;
+        TM_LOG_INFO(GAME, "Wrote %zu frames of render stats to %s", m_csvRows.size(), path);
+    } else {
+        m_lastCsvPath.clear();
+        TM_LOG_ERROR(GAME, "Failed to write render stats file %s", path);
+    }
+    m_csvRows.clear();
+    m_csvRows.shrink_to_fit();
+}
+
+bool RenderStats::WriteCsv(const char* path) const {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+    
+    std::fprintf(file, "frame,draw_calls,triangles,skinned_vertices,upload_bytes,texture_binds,shader_switches\n");
+    for (size_t i = 0; i < m_csvRows.size(); ++i) {
+        const RenderCounters& row = m_csvRows[i];
+        std::fprintf(file, "%zu,%u,%u,%u,%llu,%u,%u\n",
+                     i, row.drawCalls, row.triangles, row.skinnedVertices,
+                     static_cast<unsigned long long>(row.uploadBytes),
+                     row.textureBinds, row.shaderSwitches);
+    }
+    return std::fclose(file) == 0;
+}
+
+namespace Gfx {
+
+namespace {
+
+void CountModel(const Model& model) {
+    RenderStats& stats = RenderStats::GetInstance();
+    const Material noMaterial = {};
+    for (int i = 0; i < model.meshCount; i++) {
+        bool hasMaterial = model.materials && model.meshMaterial;
+        stats.AddMesh(model.meshes[i], hasMaterial ? model.materials[model.meshMaterial[i]] : noMaterial);
+    }
+}
+
+} // namespace
+
+void DrawModel(Model model, Vector3 position, float scale, Color tint) {
+    CountModel(model);
+    ::DrawModel(model, position, scale, tint);
+}
+
+void DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint) {
+    CountModel(model);
+    ::DrawModelEx(model, position, rotationAxis, rotationAngle, scale, tint);
+}
+
+void DrawCube(Vector3 position, float width, float height, float length, Color color) {
+    RenderStats::GetInstance().AddImmediate(12);
+    ::DrawCube(position, width, height, length, color);
+}
+
+void DrawCubeWires(Vector3 position, float width, float height, float length, Color color) {
+    RenderStats::GetInstance().AddImmediate(0);   // Lines only
+    ::DrawCubeWires(position, width, height, length, color);
+}
+
+void DrawSphere(Vector3 centerPos, float radius, Color color) {
+    RenderStats::GetInstance().AddImmediate(RENDER_STATS_SPHERE_TRIANGLES);
+    ::DrawSphere(centerPos, radius, color);
+}
+
+void DrawSphereEx(Vector3 centerPos, float radius, int rings, int slices, Color color) {
+    RenderStats::GetInstance().AddImmediate(static_cast<uint32_t>((rings + 2) * slices * 2));
+    ::DrawSphereEx(centerPos, radius, rings, slices, color);
+}
+
+void DrawCapsuleWires(Vector3 startPos, Vector3 endPos, float radius, int slices, int rings, Color color) {
+    RenderStats::GetInstance().AddImmediate(0);   // Lines only
+    ::DrawCapsuleWires(startPos, endPos, radius, slices, rings, color);
+}
+
+void DrawPlane(Vector3 centerPos, Vector2 size, Color color) {
+    RenderStats::GetInstance().AddImmediate(2);
+    ::DrawPlane(centerPos, size, color);
+}
+
+void DrawGrid(int slices, float spacing) {
+    RenderStats::GetInstance().AddImmediate(0);   // Lines only
+    ::DrawGrid(slices, spacing);
+}
+
+} // namespace Gfx
+
+} // namespace TimeMaster
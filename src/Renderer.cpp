@@ -0,0 +1,249 @@
+#include "Renderer.hpp"
+#include "AllocTracker.hpp"
+#include "Config.hpp"
+#include "FrameSnapshot.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
+#include "raymath.h"
+#include <algorithm>
+
+namespace TimeMaster {
+
+Renderer::Renderer(const GameAssets& assets)
+    : m_assets(assets)
+    , m_arenaModel{0}
+    , m_arenaModelLoaded(false)
+    , m_lastEffectTick(0)
+    , m_cursorLocked(false) {
+
+    // Load arena model
+    m_arenaModel = LoadModel("assets/models/arena/scene.gltf");
+    if (m_arenaModel.meshCount > 0 && m_arenaModel.meshes != nullptr) {
+        m_arenaModelLoaded = true;
+        TM_LOG_INFO(ASSETS, "Arena model loaded successfully");
+    } else {
+        TM_LOG_WARNING(ASSETS, "Failed to load arena model - using fallback rendering");
+        m_arenaModel = (Model){0};
+        m_arenaModelLoaded = false;
+    }
+
+    m_bossSkinner.Init(m_assets.GetBoss().model);
+    m_playerSkinner.Init(m_assets.GetPlayer().model);
+}
+
+Renderer::~Renderer() {
+    // Unload arena model
+    if (m_arenaModelLoaded) {
+        UnloadModel(m_arenaModel);
+    }
+}
+
+void Renderer::HandleDebugKeys() {
+    // Toggle profiler overlay with F3, capture a Chrome trace with F4 (any state)
+    if (IsKeyPressed(KEY_F3)) {
+        Profiler::GetInstance().ToggleOverlay();
+    }
+    if (IsKeyPressed(KEY_F4)) {
+        Profiler::GetInstance().BeginCapture(PROFILER_CAPTURE_SECONDS);
+    }
+
+    // Render stats overlay with F5, start/stop CSV recording with F6
+    if (IsKeyPressed(KEY_F5)) {
+        RenderStats::GetInstance().ToggleOverlay();
+    }
+    if (IsKeyPressed(KEY_F6)) {
+        RenderStats::GetInstance().ToggleCsvRecording();
+    }
+
+    // Heap allocation tracking with F7 (shown in the profiler overlay)
+    if (IsKeyPressed(KEY_F7)) {
+        AllocTracker::GetInstance().Toggle();
+        if (AllocTracker::IsEnabled()) {
+            Profiler::GetInstance().SetOverlayVisible(true);
+        }
+    }
+}
+
+void Renderer::Draw(const FrameSnapshot& frame) {
+    PROFILE_ZONE("Renderer::Draw");
+
+    // The simulation decides the cursor state; the window belongs to this thread
+    if (frame.cursorLocked != m_cursorLocked) {
+        m_cursorLocked = frame.cursorLocked;
+        if (m_cursorLocked) {
+            DisableCursor();
+            GetMouseDelta();  // Clear accumulated mouse delta
+        } else {
+            EnableCursor();
+        }
+    }
+
+    UpdateParticles(frame);
+
+    switch (frame.state) {
+        case GameState::MENU:
+            // A co-op session starts the match itself once the partner answers
+            if (frame.net.active) {
+                m_hud.DrawNetStatus(frame.net);
+            } else {
+                m_hud.DrawMenu();
+            }
+            break;
+        case GameState::SETTINGS:
+            m_hud.DrawSettings(frame.selectedSetting, frame.config);
+            break;
+        case GameState::PLAYING:
+            DrawPlaying(frame);
+            break;
+        case GameState::PAUSED:
+            DrawPaused(frame);
+            break;
+        case GameState::GAME_OVER:
+            m_hud.DrawGameOver(!frame.net.active);
+            break;
+        case GameState::VICTORY:
+            m_hud.DrawVictory(!frame.net.active);
+            break;
+    }
+
+    Profiler& profiler = Profiler::GetInstance();
+    if (profiler.IsOverlayVisible()) {
+        m_hud.DrawProfilerOverlay(profiler);
+    }
+    m_hud.DrawTraceCaptureStatus(profiler);
+
+    RenderStats& renderStats = RenderStats::GetInstance();
+    if (renderStats.IsOverlayVisible() || renderStats.IsRecording()) {
+        m_hud.DrawRenderStatsOverlay(renderStats);
+    }
+}
+
+Job* Renderer::ScheduleBossSkinning(JobSystem& jobs, const FrameSnapshot& frame) {
+    const ModelAsset& boss = m_assets.GetBoss();
+    int animIndex = frame.boss.animIndex;
+    if (animIndex < 0 || animIndex >= boss.animationCount) return nullptr;
+    return m_bossSkinner.Schedule(jobs, boss.model, boss.animations[animIndex], frame.boss.animFrame);
+}
+
+Job* Renderer::SchedulePlayerSkinning(JobSystem& jobs, const FrameSnapshot& frame) {
+    const ModelAsset& player = m_assets.GetPlayer();
+    int animIndex = frame.player.animIndex;
+    if (animIndex < 0 || animIndex >= player.animationCount) return nullptr;
+    return m_playerSkinner.Schedule(jobs, player.model, player.animations[animIndex], frame.player.animFrame);
+}
+
+void Renderer::DrawPlaying(const FrameSnapshot& frame) {
+    // Skin the snapshot's poses on the workers while the arena is drawn
+    JobSystem& jobs = JobSystem::GetInstance();
+    Job* bossSkinning = ScheduleBossSkinning(jobs, frame);
+    Job* playerSkinning = SchedulePlayerSkinning(jobs, frame);
+
+    BeginMode3D(frame.camera);
+
+    DrawArena();
+
+    // Skinned vertices go to the GPU from this (GL) thread
+    if (bossSkinning) {
+        jobs.Wait(bossSkinning);
+        m_bossSkinner.Upload();
+    }
+    if (playerSkinning) {
+        jobs.Wait(playerSkinning);
+        m_playerSkinner.Upload();
+    }
+
+    // Draw all entities
+    {
+        PROFILE_ZONE("Draw::Entities");
+        Player::DrawSnapshot(frame.player, m_assets.GetPlayer());
+        // Co-op partners share the model, so they show the local player's skinned pose
+        for (int i = 0; i < frame.partnerCount; ++i) {
+            Player::DrawSnapshot(frame.partners[i], m_assets.GetPlayer());
+        }
+        Boss::DrawSnapshot(frame.boss, m_assets.GetBoss());
+
+        for (const TomatoSnapshot& tomato : frame.tomatoes) {
+            DrawTomatoSnapshot(tomato, m_assets.GetTomato());
+        }
+
+        for (uint32_t i = 0; i < frame.projectileCount; ++i) {
+            DrawProjectileSnapshot(frame.projectiles[i]);
+        }
+    }
+    
+    // Thousands of minions: flat cubes, which raylib batches into few draw calls
+    {
+        PROFILE_ZONE("Draw::Minions");
+        for (uint32_t i = 0; i < frame.minionCount; ++i) {
+            Gfx::DrawCube(frame.minions[i], 2.0f * MINION_HALF_WIDTH, 2.0f * MINION_HALF_HEIGHT,
+                          2.0f * MINION_HALF_WIDTH, LIME);
+        }
+    }
+
+    m_particleRenderer.Draw(m_particles, frame.camera);
+
+    EndMode3D();
+
+    // Draw HUD
+    m_hud.Draw(frame);
+
+    // Draw attack hint
+    float distance = Vector3Distance(frame.player.position, frame.boss.position);
+    m_hud.DrawAttackHint(distance);
+}
+
+void Renderer::DrawPaused(const FrameSnapshot& frame) {
+    // Draw game in background
+    DrawPlaying(frame);
+
+    // Draw pause overlay
+    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
+    DrawText("PAUSED", SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 50, WHITE);
+    DrawText("Press P or ENTER to Continue", SCREEN_WIDTH / 2 - 180, SCREEN_HEIGHT / 2 + 20, 20, WHITE);
+    DrawText("Press ESC for Menu", SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 + 50, 20, WHITE);
+}
+
+void Renderer::UpdateParticles(const FrameSnapshot& frame) {
+    PROFILE_ZONE("Renderer::UpdateParticles");
+
+    // Bursts are kept while paused and dropped once the match is over
+    if (frame.state != GameState::PLAYING) {
+        if (frame.state != GameState::PAUSED) {
+            m_particles.Clear();
+        }
+        m_lastEffectTick = frame.tick;
+        return;
+    }
+
+    // A snapshot repeats the effects of the last few ticks; spawn only the new ones
+    for (uint32_t i = 0; i < frame.effectCount; ++i) {
+        const EffectSpawn& effect = frame.effects[i];
+        if (effect.tick > m_lastEffectTick) {
+            m_particles.Emit(effect.kind, effect.position);
+        }
+    }
+    m_lastEffectTick = std::max(m_lastEffectTick, frame.tick);
+    m_particles.Update(std::min(GetFrameTime(), PARTICLE_MAX_DELTA_TIME));
+}
+
+void Renderer::DrawArena() const {
+    PROFILE_ZONE("Renderer::DrawArena");
+
+    if (m_arenaModelLoaded) {
+        // Draw the 3D arena model much lower to account for model's center/top origin
+        Gfx::DrawModel(m_arenaModel, {0.0f, ARENA_MODEL_Y, 0.0f}, 1.0f, WHITE);
+    } else {
+        // Fallback to simple arena rendering
+        Gfx::DrawPlane({0.0f, ARENA_FLOOR_Y, 0.0f}, {ARENA_SIZE * 2, ARENA_SIZE * 2}, LIGHTGRAY);
+        Gfx::DrawGrid(40, 50.0f);
+
+        // Draw arena walls
+        Gfx::DrawCubeWires({0, 50, -ARENA_SIZE}, ARENA_SIZE * 2, 100, 2, DARKGRAY);
+        Gfx::DrawCubeWires({0, 50, ARENA_SIZE}, ARENA_SIZE * 2, 100, 2, DARKGRAY);
+        Gfx::DrawCubeWires({-ARENA_SIZE, 50, 0}, 2, 100, ARENA_SIZE * 2, DARKGRAY);
+        Gfx::DrawCubeWires({ARENA_SIZE, 50, 0}, 2, 100, ARENA_SIZE * 2, DARKGRAY);
+    }
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,341 @@
+#include "Replication.hpp"
+#include "BitStream.hpp"
+#include "Boss.hpp"
+#include "BulletStore.hpp"
+#include "Player.hpp"
+#include "StateHash.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace TimeMaster {
+
+namespace {
+
+constexpr float HEIGHT_OFFSET = ARENA_SIZE * 0.5f;
+constexpr uint32_t PLAYER_COUNT_BITS = 2;
+constexpr uint32_t MAX_FIELD_BITS = 3 + 16;          // Raw prefix + widest field
+constexpr uint32_t MAX_BULLET_BITS = 6 * MAX_FIELD_BITS;
+constexpr int32_t MAX_PREDICTED_TICKS = 255;
+
+static_assert(MAX_PLAYERS < (1 << PLAYER_COUNT_BITS), "Player count must fit PLAYER_COUNT_BITS");
+
+const ReplicatedState EMPTY_STATE = {};
+
+constexpr uint32_t Mask(uint32_t bits) {
+    return (1u << bits) - 1;
+}
+
+uint16_t QuantizeAxis(float value, float offset, uint32_t bits) {
+    float steps = std::round((value + offset) / REPLICATION_POSITION_STEP);
+    return static_cast<uint16_t>(std::max(0.0f, std::min(steps, static_cast<float>(Mask(bits)))));
+}
+
+uint16_t QuantizeTime(float seconds) {
+    float centiseconds = std::round(seconds * REPLICATION_TIME_SCALE);
+    return static_cast<uint16_t>(std::max(0.0f, std::min(centiseconds, static_cast<float>(Mask(REPLICATION_TIME_BITS)))));
+}
+
+uint16_t QuantizeRotation(float degrees) {
+    float turns = degrees / 360.0f;
+    float steps = std::round((turns - std::floor(turns)) * (1u << REPLICATION_ROTATION_BITS));
+    return static_cast<uint16_t>(static_cast<uint32_t>(steps) & Mask(REPLICATION_ROTATION_BITS));
+}
+
+int32_t SignExtend(uint32_t value, uint32_t bits) {
+    uint32_t sign = 1u << (bits - 1);
+    return static_cast<int32_t>((value ^ sign) - sign);
+}
+
+/**
+ * @brief Where a bullet with this (quantized) velocity is `ticks` ticks later
+ */
+uint32_t PredictAxis(uint32_t position, int32_t velocity, int32_t ticks, uint32_t bits) {
+    int32_t moved = velocity * ticks;
+    int32_t half = REPLICATION_VELOCITY_TICKS / 2;
+    moved = moved >= 0 ? (moved + half) / REPLICATION_VELOCITY_TICKS : -((half - moved) / REPLICATION_VELOCITY_TICKS);
+    return (position + static_cast<uint32_t>(moved)) & Mask(bits);
+}
+
+int32_t GetElapsedTicks(const ReplicatedState& state, const ReplicatedState* base) {
+    if (!base || state.tick <= base->tick) return 0;
+    return static_cast<int32_t>(std::min<uint32_t>(state.tick - base->tick, MAX_PREDICTED_TICKS));
+}
+
+/**
+ * @brief Field codes: 0 = as predicted, 10 + 4 bits = small change,
+ * 110 + 8 bits = medium change, 111 + raw value. Changes wrap at the field width.
+ */
+void WriteField(BitWriter& writer, uint32_t value, uint32_t predicted, uint32_t bits) {
+    uint32_t wrapped = (value - predicted) & Mask(bits);
+    if (wrapped == 0) {
+        writer.Write(0, 1);
+        return;
+    }
+    int32_t delta = SignExtend(wrapped, bits);
+    uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+    if (zigzag <= 16) {
+        writer.Write(0x1 | ((zigzag - 1) << 2), 6);
+    } else if (zigzag <= 16 + 256) {
+        writer.Write(0x3 | ((zigzag - 17) << 3), 11);
+    } else {
+        writer.Write(0x7, 3);
+        writer.Write(value, bits);
+    }
+}
+
+uint32_t ReadField(BitReader& reader, uint32_t predicted, uint32_t bits) {
+    if (!reader.Read(1)) return predicted;
+    uint32_t zigzag;
+    if (!reader.Read(1)) {
+        zigzag = reader.Read(4) + 1;
+    } else if (!reader.Read(1)) {
+        zigzag = reader.Read(8) + 17;
+    } else {
+        return reader.Read(bits);
+    }
+    uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1));
+    return (predicted + delta) & Mask(bits);
+}
+
+void WritePoint(BitWriter& writer, const ReplicatedState::Point& point, const ReplicatedState::Point& predicted) {
+    WriteField(writer, point.x, predicted.x, REPLICATION_POSITION_BITS);
+    WriteField(writer, point.y, predicted.y, REPLICATION_HEIGHT_BITS);
+    WriteField(writer, point.z, predicted.z, REPLICATION_POSITION_BITS);
+}
+
+void ReadPoint(BitReader& reader, ReplicatedState::Point& point, const ReplicatedState::Point& predicted) {
+    point.x = static_cast<uint16_t>(ReadField(reader, predicted.x, REPLICATION_POSITION_BITS));
+    point.y = static_cast<uint16_t>(ReadField(reader, predicted.y, REPLICATION_HEIGHT_BITS));
+    point.z = static_cast<uint16_t>(ReadField(reader, predicted.z, REPLICATION_POSITION_BITS));
+}
+
+/**
+ * @brief A bullet extrapolated from a reference (the baseline's, or its predecessor)
+ */
+ReplicatedState::Bullet PredictBullet(const ReplicatedState::Bullet& reference, int32_t ticks) {
+    ReplicatedState::Bullet predicted = reference;
+    predicted.position.x = static_cast<uint16_t>(PredictAxis(reference.position.x, reference.vx, ticks, REPLICATION_POSITION_BITS));
+    predicted.position.y = static_cast<uint16_t>(PredictAxis(reference.position.y, reference.vy, ticks, REPLICATION_HEIGHT_BITS));
+    predicted.position.z = static_cast<uint16_t>(PredictAxis(reference.position.z, reference.vz, ticks, REPLICATION_POSITION_BITS));
+    return predicted;
+}
+
+ReplicatedState::Bullet PredictBullet(const ReplicatedState& state, const ReplicatedState& base, uint32_t index,
+                                      int32_t elapsed) {
+    if (index < base.bulletCount) return PredictBullet(base.bullets[index], elapsed);
+    if (index > 0) return state.bullets[index - 1];
+    return ReplicatedState::Bullet{};
+}
+
+void WriteVelocity(BitWriter& writer, int16_t velocity, int16_t predicted) {
+    WriteField(writer, static_cast<uint16_t>(velocity) & Mask(REPLICATION_VELOCITY_BITS),
+               static_cast<uint16_t>(predicted) & Mask(REPLICATION_VELOCITY_BITS), REPLICATION_VELOCITY_BITS);
+}
+
+int16_t ReadVelocity(BitReader& reader, int16_t predicted) {
+    uint32_t bits = ReadField(reader, static_cast<uint16_t>(predicted) & Mask(REPLICATION_VELOCITY_BITS),
+                              REPLICATION_VELOCITY_BITS);
+    return static_cast<int16_t>(SignExtend(bits, REPLICATION_VELOCITY_BITS));
+}
+
+} // namespace
+
+ReplicatedState::Point QuantizePosition(Vector3 position) {
+    return ReplicatedState::Point{QuantizeAxis(position.x, ARENA_SIZE, REPLICATION_POSITION_BITS),
+                                  QuantizeAxis(position.y, HEIGHT_OFFSET, REPLICATION_HEIGHT_BITS),
+                                  QuantizeAxis(position.z, ARENA_SIZE, REPLICATION_POSITION_BITS)};
+}
+
+int16_t QuantizeSpeed(float unitsPerSecond) {
+    const float limit = static_cast<float>(Mask(REPLICATION_VELOCITY_BITS - 1));
+    float steps = std::round(unitsPerSecond / SIMULATION_TICK_RATE * REPLICATION_VELOCITY_TICKS / REPLICATION_POSITION_STEP);
+    return static_cast<int16_t>(std::max(-limit, std::min(steps, limit)));
+}
+
+ReplicatedState::Player QuantizePlayer(const PlayerSnapshot& player) {
+    return ReplicatedState::Player{QuantizePosition(player.position), QuantizeTime(player.time),
+                                   QuantizeRotation(player.rotation), player.alive};
+}
+
+ReplicatedState::Boss QuantizeBoss(const BossSnapshot& boss) {
+    return ReplicatedState::Boss{QuantizePosition(boss.position), QuantizeTime(boss.time),
+                                 QuantizeRotation(boss.rotation), static_cast<uint8_t>(boss.state)};
+}
+
+ReplicatedState::Bullet QuantizeBullet(const Bullet& bullet) {
+    return ReplicatedState::Bullet{QuantizePosition(bullet.position), QuantizeSpeed(bullet.velocity.x),
+                                   QuantizeSpeed(bullet.velocity.y), QuantizeSpeed(bullet.velocity.z)};
+}
+
+Vector3 GetReplicatedPosition(const ReplicatedState::Point& point) {
+    return Vector3{point.x * REPLICATION_POSITION_STEP - ARENA_SIZE, point.y * REPLICATION_POSITION_STEP - HEIGHT_OFFSET,
+                   point.z * REPLICATION_POSITION_STEP - ARENA_SIZE};
+}
+
+float GetReplicatedSpeed(int16_t speed) {
+    return static_cast<float>(speed) * REPLICATION_POSITION_STEP * SIMULATION_TICK_RATE / REPLICATION_VELOCITY_TICKS;
+}
+
+float GetReplicatedTime(uint16_t time) {
+    return static_cast<float>(time) / REPLICATION_TIME_SCALE;
+}
+
+float GetReplicatedRotation(uint16_t rotation) {
+    return static_cast<float>(rotation) * (360.0f / (1u << REPLICATION_ROTATION_BITS));
+}
+
+uint32_t EncodeReplicatedState(const ReplicatedState& state, const ReplicatedState* base,
+                               uint8_t* out, uint32_t capacity, uint32_t& bulletsWritten) {
+    const ReplicatedState& reference = base ? *base : EMPTY_STATE;
+    int32_t elapsed = GetElapsedTicks(state, base);
+    BitWriter writer(out, capacity);
+    bulletsWritten = 0;
+
+    writer.Write(state.state, REPLICATION_STATE_BITS);
+    writer.Write(state.playerCount, PLAYER_COUNT_BITS);
+    for (uint32_t i = 0; i < state.playerCount; ++i) {
+        const ReplicatedState::Player& player = state.players[i];
+        const ReplicatedState::Player& predicted = reference.players[i];
+        writer.WriteBool(player.alive);
+        WritePoint(writer, player.position, predicted.position);
+        WriteField(writer, player.time, predicted.time, REPLICATION_TIME_BITS);
+        WriteField(writer, player.rotation, predicted.rotation, REPLICATION_ROTATION_BITS);
+    }
+
+    WritePoint(writer, state.boss.position, reference.boss.position);
+    WriteField(writer, state.boss.time, reference.boss.time, REPLICATION_TIME_BITS);
+    WriteField(writer, state.boss.rotation, reference.boss.rotation, REPLICATION_ROTATION_BITS);
+    writer.Write(state.boss.state, REPLICATION_STATE_BITS);
+
+    // Pickups and player shots: a slot that was active in the baseline is a
+    // delta, a newly active one is sent against zero
+    writer.Write(state.tomatoMask, MAX_TOMATOES);
+    for (int i = 0; i < MAX_TOMATOES; ++i) {
+        if (!(state.tomatoMask & (1u << i))) continue;
+        bool known = (reference.tomatoMask & (1u << i)) != 0;
+        WritePoint(writer, state.tomatoes[i], known ? reference.tomatoes[i] : ReplicatedState::Point{});
+    }
+    writer.Write(state.projectileMask, MAX_PLAYER_PROJECTILES);
+    for (int i = 0; i < MAX_PLAYER_PROJECTILES; ++i) {
+        if (!(state.projectileMask & (1u << i))) continue;
+        bool known = (reference.projectileMask & (1u << i)) != 0;
+        WritePoint(writer, state.projectiles[i], known ? reference.projectiles[i] : ReplicatedState::Point{});
+    }
+    if (!writer.IsValid()) return 0;
+
+    // Bullets, each behind a continuation bit, for as long as a worst-case one still fits
+    const uint32_t capacityBits = capacity * 8;
+    uint32_t count = std::min(state.bulletCount, REPLICATION_MAX_BULLETS);
+    uint32_t i = 0;
+    for (; i < count && writer.GetBitCount() + 2 + MAX_BULLET_BITS <= capacityBits; ++i) {
+        const ReplicatedState::Bullet& bullet = state.bullets[i];
+        ReplicatedState::Bullet predicted = PredictBullet(state, reference, i, elapsed);
+        writer.Write(1, 1);
+        WritePoint(writer, bullet.position, predicted.position);
+        WriteVelocity(writer, bullet.vx, predicted.vx);
+        WriteVelocity(writer, bullet.vy, predicted.vy);
+        WriteVelocity(writer, bullet.vz, predicted.vz);
+    }
+    writer.Write(0, 1);
+    bulletsWritten = i;
+    return writer.Finish();
+}
+
+bool DecodeReplicatedState(const uint8_t* data, uint32_t size, const ReplicatedState* base, uint32_t tick,
+                           ReplicatedState& state) {
+    const ReplicatedState& reference = base ? *base : EMPTY_STATE;
+    BitReader reader(data, size);
+    state.tick = tick;
+    int32_t elapsed = GetElapsedTicks(state, base);
+
+    state.state = static_cast<uint8_t>(reader.Read(REPLICATION_STATE_BITS));
+    state.playerCount = static_cast<uint8_t>(reader.Read(PLAYER_COUNT_BITS));
+    if (state.playerCount < 1 || state.playerCount > MAX_PLAYERS) return false;
+    for (uint32_t i = 0; i < MAX_PLAYERS; ++i) {
+        ReplicatedState::Player& player = state.players[i];
+        if (i >= state.playerCount) {
+            player = ReplicatedState::Player{};
+            continue;
+        }
+        const ReplicatedState::Player& predicted = reference.players[i];
+        player.alive = reader.ReadBool();
+        ReadPoint(reader, player.position, predicted.position);
+        player.time = static_cast<uint16_t>(ReadField(reader, predicted.time, REPLICATION_TIME_BITS));
+        player.rotation = static_cast<uint16_t>(ReadField(reader, predicted.rotation, REPLICATION_ROTATION_BITS));
+    }
+
+    ReadPoint(reader, state.boss.position, reference.boss.position);
+    state.boss.time = static_cast<uint16_t>(ReadField(reader, reference.boss.time, REPLICATION_TIME_BITS));
+    state.boss.rotation = static_cast<uint16_t>(ReadField(reader, reference.boss.rotation, REPLICATION_ROTATION_BITS));
+    state.boss.state = static_cast<uint8_t>(reader.Read(REPLICATION_STATE_BITS));
+    if (state.boss.state >= BOSS_STATE_COUNT) return false;
+
+    state.tomatoMask = reader.Read(MAX_TOMATOES);
+    for (int i = 0; i < MAX_TOMATOES; ++i) {
+        state.tomatoes[i] = ReplicatedState::Point{};
+        if (!(state.tomatoMask & (1u << i))) continue;
+        bool known = (reference.tomatoMask & (1u << i)) != 0;
+        ReadPoint(reader, state.tomatoes[i], known ? reference.tomatoes[i] : ReplicatedState::Point{});
+    }
+    state.projectileMask = reader.Read(MAX_PLAYER_PROJECTILES);
+    for (int i = 0; i < MAX_PLAYER_PROJECTILES; ++i) {
+        state.projectiles[i] = ReplicatedState::Point{};
+        if (!(state.projectileMask & (1u << i))) continue;
+        bool known = (reference.projectileMask & (1u << i)) != 0;
+        ReadPoint(reader, state.projectiles[i], known ? reference.projectiles[i] : ReplicatedState::Point{});
+    }
+
+    uint32_t count = 0;
+    while (reader.ReadBool()) {
+        if (count >= REPLICATION_MAX_BULLETS || !reader.IsValid()) return false;
+        ReplicatedState::Bullet& bullet = state.bullets[count];
+        ReplicatedState::Bullet predicted = PredictBullet(state, reference, count, elapsed);
+        ReadPoint(reader, bullet.position, predicted.position);
+        bullet.vx = ReadVelocity(reader, predicted.vx);
+        bullet.vy = ReadVelocity(reader, predicted.vy);
+        bullet.vz = ReadVelocity(reader, predicted.vz);
+        count++;
+    }
+    state.bulletCount = count;
+    return reader.IsValid();
+}
+
+uint32_t ComputeReplicatedChecksum(const ReplicatedState& state) {
+    StateHasher hasher;
+    auto addPoint = [&](const ReplicatedState::Point& point) {
+        hasher.Add(static_cast<uint32_t>(point.x) | static_cast<uint32_t>(point.z) << 16);
+        hasher.Add(static_cast<uint32_t>(point.y));
+    };
+
+    hasher.Add(state.tick);
+    hasher.Add(static_cast<uint32_t>(state.state) | static_cast<uint32_t>(state.playerCount) << 8);
+    for (uint32_t i = 0; i < state.playerCount && i < MAX_PLAYERS; ++i) {
+        const ReplicatedState::Player& player = state.players[i];
+        addPoint(player.position);
+        hasher.Add(static_cast<uint32_t>(player.time) | static_cast<uint32_t>(player.rotation) << 16);
+        hasher.Add(player.alive);
+    }
+    addPoint(state.boss.position);
+    hasher.Add(static_cast<uint32_t>(state.boss.time) | static_cast<uint32_t>(state.boss.rotation) << 16);
+    hasher.Add(static_cast<uint32_t>(state.boss.state));
+    hasher.Add(state.tomatoMask);
+    for (int i = 0; i < MAX_TOMATOES; ++i) {
+        if (state.tomatoMask & (1u << i)) addPoint(state.tomatoes[i]);
+    }
+    hasher.Add(state.projectileMask);
+    for (int i = 0; i < MAX_PLAYER_PROJECTILES; ++i) {
+        if (state.projectileMask & (1u << i)) addPoint(state.projectiles[i]);
+    }
+    hasher.Add(state.bulletCount);
+    for (uint32_t i = 0; i < state.bulletCount && i < REPLICATION_MAX_BULLETS; ++i) {
+        const ReplicatedState::Bullet& bullet = state.bullets[i];
+        addPoint(bullet.position);
+        hasher.Add(static_cast<uint32_t>(static_cast<uint16_t>(bullet.vx)) |
+                   static_cast<uint32_t>(static_cast<uint16_t>(bullet.vy)) << 16);
+        hasher.Add(static_cast<uint32_t>(static_cast<uint16_t>(bullet.vz)));
+    }
+    uint64_t hash = hasher.GetHash();
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,228 @@
+#include "Rewind.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+namespace TimeMaster {
+
+namespace {
+constexpr uint32_t MAX_RUN = 0xFFFF;   // Longest zero or literal run in one token
+}
+
+uint32_t EncodeDelta(const uint32_t* frame, uint32_t words, const uint32_t* base, uint32_t baseWords, uint32_t* out) {
+    auto delta = [&](uint32_t i) { return i < baseWords ? frame[i] ^ base[i] : frame[i]; };
+
+    uint32_t size = 0;
+    out[size++] = words;
+    uint32_t i = 0;
+    while (i < words) {
+        uint32_t zeros = 0;
+        while (i < words && zeros < MAX_RUN && delta(i) == 0) {
+            zeros++;
+            i++;
+        }
+        uint32_t control = size++;
+        uint32_t literals = 0;
+        while (i < words && literals < MAX_RUN) {
+            uint32_t value = delta(i);
+            if (value == 0) break;
+            out[size++] = value;
+            literals++;
+            i++;
+        }
+        out[control] = (zeros << 16) | literals;
+    }
+    return size;
+}
+
+bool DecodeDelta(const uint32_t* encoded, uint32_t encodedWords, const uint32_t* base, uint32_t baseWords,
+                 uint32_t* out, uint32_t capacity, uint32_t& words) {
+    auto baseWord = [&](uint32_t i) { return i < baseWords ? base[i] : 0u; };
+
+    if (encodedWords == 0) return false;
+    words = encoded[0];
+    if (words > capacity) return false;
+    uint32_t position = 1;
+    uint32_t i = 0;
+    while (i < words) {
+        if (position >= encodedWords) return false;
+        uint32_t control = encoded[position++];
+        uint32_t zeros = control >> 16;
+        uint32_t literals = control & MAX_RUN;
+        if (zeros + literals > words - i || literals > encodedWords - position) return false;
+        for (uint32_t end = i + zeros; i < end; ++i) {
+            out[i] = baseWord(i);
+        }
+        for (uint32_t end = i + literals; i < end; ++i) {
+            out[i] = encoded[position++] ^ baseWord(i);
+        }
+    }
+    return true;
+}
+
+RewindBuffer::RewindBuffer(uint32_t maxFrameWords, uint32_t maxFrames, uint32_t storageBytes)
+    : m_frame(maxFrameWords, 0)
+    , m_keyframe(maxFrameWords, 0)
+    , m_encoded(GetMaxDeltaWords(maxFrameWords), 0)
+    , m_storage(storageBytes / sizeof(uint32_t), 0)
+    , m_records(maxFrames + REWIND_KEYFRAME_INTERVAL)  // A full window survives dropping a group
+    , m_keyframeWords(0)
+    , m_keyframeSequence(NO_KEYFRAME)
+    , m_oldest(0)
+    , m_next(0)
+    , m_writeOffset(0) {
+}
+
+void RewindBuffer::Clear() {
+    m_keyframeSequence = NO_KEYFRAME;
+    m_oldest = m_next;
+    m_writeOffset = 0;
+}
+
+void RewindBuffer::ReserveStorage(uint32_t bytes) {
+    m_storage.reserve(bytes / sizeof(uint32_t));
+}
+
+void RewindBuffer::GrowStorage(uint32_t bytes) {
+    // Records keep their offsets, and Reserve sees the room past the end
+    if (bytes / sizeof(uint32_t) > m_storage.size()) {
+        m_storage.resize(bytes / sizeof(uint32_t), 0);
+    }
+}
+
+void RewindBuffer::ResetStorage(uint32_t bytes) {
+    Clear();
+    m_storage.resize(bytes / sizeof(uint32_t), 0);
+    m_storage.shrink_to_fit();
+}
+
+uint32_t RewindBuffer::Encode(uint32_t words, const uint32_t* base, uint32_t baseWords) {
+    return EncodeDelta(m_frame.data(), words, base, baseWords, m_encoded.data());
+}
+
+uint32_t RewindBuffer::Decode(const Record& record, const uint32_t* base, uint32_t baseWords, uint32_t* out) const {
+    uint32_t words = 0;
+    DecodeDelta(m_storage.data() + record.offset, record.words, base, baseWords,
+                out, static_cast<uint32_t>(m_frame.size()), words);
+    return words;
+}
+
+void RewindBuffer::DropOldestGroup() {
+    // Deltas cannot outlive their keyframe
+    do {
+        m_oldest++;
+    } while (m_oldest < m_next && GetRecord(m_oldest).keyframe != m_oldest);
+
+    if (m_keyframeSequence != NO_KEYFRAME && m_keyframeSequence < m_oldest) {
+        m_keyframeSequence = NO_KEYFRAME;
+    }
+    if (m_oldest == m_next) {
+        m_writeOffset = 0;
+    }
+}
+
+bool RewindBuffer::Reserve(uint32_t words, uint32_t& offset) {
+    const uint32_t capacity = static_cast<uint32_t>(m_storage.size());
+    if (words > capacity) return false;
+
+    // Live records span [oldest record, m_writeOffset) circularly; a record
+    // never wraps, so it goes after the newest one or at the start
+    for (;;) {
+        if (m_oldest == m_next) {
+            offset = 0;
+            break;
+        }
+        uint32_t oldest = GetRecord(m_oldest).offset;
+        if (oldest >= m_writeOffset) {
+            if (oldest - m_writeOffset >= words) {
+                offset = m_writeOffset;
+                break;
+            }
+        } else if (capacity - m_writeOffset >= words) {
+            offset = m_writeOffset;
+            break;
+        } else if (oldest >= words) {
+            offset = 0;
+            break;
+        }
+        DropOldestGroup();
+    }
+    m_writeOffset = offset + words;
+    return true;
+}
+
+uint32_t RewindBuffer::GetKeyframeAge() const {
+    bool keyframe = m_oldest == m_next ||
+                    m_keyframeSequence == NO_KEYFRAME ||
+                    m_next - m_keyframeSequence >= REWIND_KEYFRAME_INTERVAL;
+    return keyframe ? 0 : static_cast<uint32_t>(m_next - m_keyframeSequence);
+}
+
+void RewindBuffer::Push(uint32_t words) {
+    PROFILE_ZONE("Rewind::Capture");
+
+    if (GetFrameCount() == m_records.size()) {
+        DropOldestGroup();
+    }
+
+    bool keyframe = GetKeyframeAge() == 0;
+    uint32_t encoded = keyframe ? Encode(words, nullptr, 0)
+                                : Encode(words, m_keyframe.data(), m_keyframeWords);
+
+    uint32_t offset;
+    if (!Reserve(encoded, offset)) {
+        TM_LOG_WARNING(GAME, "Rewind frame of %u words exceeds the history budget - dropped", words);
+        return;
+    }
+    if (!keyframe && m_keyframeSequence == NO_KEYFRAME) {
+        // Making room dropped our own keyframe: the history is empty now
+        keyframe = true;
+        encoded = Encode(words, nullptr, 0);
+        Reserve(encoded, offset);
+    }
+
+    std::copy(m_encoded.begin(), m_encoded.begin() + encoded, m_storage.begin() + offset);
+    GetRecord(m_next) = {offset, encoded, keyframe ? m_next : m_keyframeSequence};
+    if (keyframe) {
+        std::copy(m_frame.begin(), m_frame.begin() + words, m_keyframe.begin());
+        m_keyframeWords = words;
+        m_keyframeSequence = m_next;
+    }
+    m_next++;
+}
+
+bool RewindBuffer::Pop(uint32_t& words) {
+    PROFILE_ZONE("Rewind::Restore");
+
+    if (m_oldest == m_next) return false;
+
+    uint64_t sequence = m_next - 1;
+    const Record record = GetRecord(sequence);
+    if (record.keyframe == sequence) {
+        words = Decode(record, nullptr, 0, m_frame.data());
+    } else {
+        if (m_keyframeSequence != record.keyframe) {
+            m_keyframeWords = Decode(GetRecord(record.keyframe), nullptr, 0, m_keyframe.data());
+            m_keyframeSequence = record.keyframe;
+        }
+        words = Decode(record, m_keyframe.data(), m_keyframeWords, m_frame.data());
+    }
+
+    // The newest record always ends at the write offset
+    m_next--;
+    m_writeOffset = m_oldest == m_next ? 0 : record.offset;
+    if (m_keyframeSequence == sequence) {
+        m_keyframeSequence = NO_KEYFRAME;
+    }
+    return true;
+}
+
+uint32_t RewindBuffer::GetStoredBytes() const {
+    uint32_t words = 0;
+    for (uint64_t sequence = m_oldest; sequence < m_next; ++sequence) {
+        words += GetRecord(sequence).words;
+    }
+    return words * static_cast<uint32_t>(sizeof(uint32_t));
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,162 @@
+#include "Rollback.hpp"
+#include "Game.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace TimeMaster {
+
+namespace {
+double NowUs() {
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+RollbackSession::RollbackSession(Game& game, int playerCount, int localPlayer, float deltaTime)
+    : m_game(game)
+    , m_playerCount(std::max(1, std::min(playerCount, MAX_PLAYERS)))
+    , m_localPlayer(std::max(0, std::min(localPlayer, m_playerCount - 1)))
+    , m_deltaTime(deltaTime)
+    , m_frame(0)
+    , m_known{}
+    , m_commands{}
+    , m_used{}
+    , m_mispredicted(NONE)
+    , m_states(STATE_SLOTS * Game::GetMaxStateWords(), 0)
+    , m_stateWords{}
+    , m_stateSlotWords(Game::GetMaxStateWords())
+    , m_sync{}
+    , m_lastSyncFrame(0)
+    , m_stats{} {
+}
+
+void RollbackSession::Start(uint32_t inputDelay) {
+    m_game.SetPlayers(m_playerCount, m_localPlayer);
+    m_game.StartMatch();
+
+    inputDelay = std::min(inputDelay, ROLLBACK_COMMAND_WINDOW / 2);
+    for (int p = 0; p < m_playerCount; ++p) {
+        for (uint32_t frame = 0; frame < inputDelay; ++frame) {
+            m_commands[p][frame] = PlayerCommand{0, 0, 0.0f};
+        }
+        m_known[p] = inputDelay;
+    }
+    m_frame = 0;
+    m_mispredicted = NONE;
+    for (SyncPoint& sync : m_sync) {
+        sync = {NONE, 0};
+    }
+    m_lastSyncFrame = 0;
+    m_stats = RollbackStats{};
+}
+
+bool RollbackSession::AddCommand(int player, uint32_t frame, const PlayerCommand& command) {
+    if (player < 0 || player >= m_playerCount || frame != m_known[player]) return false;
+
+    // Frames back to the oldest replayable one must keep their commands
+    if (frame + ROLLBACK_MAX_TICKS >= m_frame + ROLLBACK_COMMAND_WINDOW) return false;
+
+    uint32_t index = frame % ROLLBACK_COMMAND_WINDOW;
+    m_commands[player][index] = command;
+    m_known[player]++;
+    if (frame < m_frame && command != m_used[player][index]) {
+        m_mispredicted = std::min(m_mispredicted, frame);
+    }
+    return true;
+}
+
+uint32_t RollbackSession::GetConfirmedFrames() const {
+    uint32_t confirmed = m_known[0];
+    for (int p = 1; p < m_playerCount; ++p) {
+        confirmed = std::min(confirmed, m_known[p]);
+    }
+    return confirmed;
+}
+
+PlayerCommand RollbackSession::GetCommand(int player, uint32_t frame) const {
+    if (frame < m_known[player]) {
+        return m_commands[player][frame % ROLLBACK_COMMAND_WINDOW];
+    }
+    // Prediction: keep holding what was held, facing where it faced; presses are one-offs
+    if (m_known[player] == 0) return PlayerCommand{0, 0, 0.0f};
+    PlayerCommand predicted = m_commands[player][(m_known[player] - 1) % ROLLBACK_COMMAND_WINDOW];
+    predicted.pressed = 0;
+    return predicted;
+}
+
+void RollbackSession::SimulateFrame(bool resimulate) {
+    m_stateWords[m_frame % STATE_SLOTS] = m_game.SaveState(GetStateSlot(m_frame), m_stateSlotWords);
+
+    uint32_t index = m_frame % ROLLBACK_COMMAND_WINDOW;
+    PlayerCommand commands[MAX_PLAYERS] = {};
+    for (int p = 0; p < m_playerCount; ++p) {
+        commands[p] = GetCommand(p, m_frame);
+        m_used[p][index] = commands[p];
+    }
+    if (resimulate) {
+        m_game.ResimulateNetworked(commands, m_deltaTime);
+    } else {
+        m_game.UpdateNetworked(commands, m_deltaTime);
+    }
+    m_frame++;
+
+    // Every command up to here is confirmed and was used as such: this frame is final
+    if (m_frame % ROLLBACK_SYNC_INTERVAL == 0 && m_frame > m_lastSyncFrame && m_frame <= GetConfirmedFrames()) {
+        m_sync[(m_frame / ROLLBACK_SYNC_INTERVAL) % ROLLBACK_SYNC_HISTORY] = {m_frame, m_game.ComputeChecksum().combined};
+        m_lastSyncFrame = m_frame;
+    }
+}
+
+void RollbackSession::Rollback() {
+    if (m_mispredicted == NONE) return;
+    PROFILE_ZONE("Rollback::Resimulate");
+
+    double start = NowUs();
+    uint32_t target = m_frame;
+    uint32_t depth = m_frame - m_mispredicted;
+    m_game.LoadState(GetStateSlot(m_mispredicted), m_stateWords[m_mispredicted % STATE_SLOTS]);
+    m_frame = m_mispredicted;
+    m_mispredicted = NONE;
+    while (m_frame < target) {
+        SimulateFrame(true);
+    }
+
+    double elapsed = NowUs() - start;
+    m_stats.rollbacks++;
+    m_stats.resimulatedTicks += depth;
+    m_stats.lastDepth = depth;
+    m_stats.maxDepth = std::max(m_stats.maxDepth, depth);
+    m_stats.resimulateUs += elapsed;
+    m_stats.maxResimulateUs = std::max(m_stats.maxResimulateUs, elapsed);
+}
+
+bool RollbackSession::Advance() {
+    PROFILE_ZONE("Rollback::Advance");
+
+    Rollback();
+
+    // Needs the local command, and must stay within replay reach of every remote one
+    bool ready = m_frame < m_known[m_localPlayer];
+    for (int p = 0; p < m_playerCount; ++p) {
+        if (p != m_localPlayer && m_frame >= m_known[p] + ROLLBACK_MAX_TICKS) {
+            ready = false;
+        }
+    }
+    if (!ready) {
+        m_stats.stalls++;
+        return false;
+    }
+    SimulateFrame(false);
+    return true;
+}
+
+bool RollbackSession::GetSyncChecksum(uint32_t frame, uint64_t& checksum) const {
+    if (frame == 0 || frame % ROLLBACK_SYNC_INTERVAL != 0) return false;
+    const SyncPoint& sync = m_sync[(frame / ROLLBACK_SYNC_INTERVAL) % ROLLBACK_SYNC_HISTORY];
+    if (sync.frame != frame) return false;
+    checksum = sync.checksum;
+    return true;
+}
+
+} // namespace TimeMaster
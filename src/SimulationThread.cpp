@@ -0,0 +1,70 @@
+#include "SimulationThread.hpp"
+#include "Game.hpp"
+#include "NetSession.hpp"
+#include "Profiler.hpp"
+#include <chrono>
+
+namespace TimeMaster {
+
+SimulationThread::SimulationThread(Game& game, InputMailbox& input, TripleBuffer<FrameSnapshot>& snapshots,
+                                   NetSession* session)
+    : m_game(game)
+    , m_input(input)
+    , m_snapshots(snapshots)
+    , m_session(session)
+    , m_stop(false) {
+}
+
+SimulationThread::~SimulationThread() {
+    Stop();
+}
+
+void SimulationThread::Start() {
+    if (m_thread.joinable()) return;
+    m_stop.store(false);
+    m_thread = std::thread(&SimulationThread::Run, this);
+}
+
+void SimulationThread::Stop() {
+    m_stop.store(true);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SimulationThread::Run() {
+    using Clock = std::chrono::steady_clock;
+    const auto tick = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / SIMULATION_TICK_RATE));
+    const float deltaTime = 1.0f / SIMULATION_TICK_RATE;
+    
+    // Registers the profiler's event ring now rather than on the first zone
+    Profiler::GetInstance().SetThreadName("Simulation");
+    
+    auto nextTick = Clock::now();
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        {
+            PROFILE_ZONE("Simulation::Tick");
+            FrameSnapshot& slot = m_snapshots.GetWriteSlot();
+            if (m_session) {
+                m_session->Tick(m_input.Take());
+                m_game.WriteSnapshot(slot);
+                m_session->WriteSnapshot(slot.net);
+            } else {
+                m_game.Update(m_input.Take(), deltaTime);
+                m_game.WriteSnapshot(slot);
+            }
+            m_snapshots.Publish();
+        }
+        
+        // Fixed rate; after a long stall resync instead of running a burst of catch-up ticks
+        nextTick += tick;
+        auto now = Clock::now();
+        if (now - nextTick > tick * SIMULATION_MAX_LAG_TICKS) {
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+} // namespace TimeMaster
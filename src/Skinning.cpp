@@ -0,0 +1,181 @@
+#include "Skinning.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
+#include "raymath.h"
+#include <algorithm>
+
+namespace TimeMaster {
+
+namespace {
+
+SkinBone IdentityBone() {
+    return {
+        {1.0f, 0.0f, 0.0f, 0.0f,
+         0.0f, 1.0f, 0.0f, 0.0f,
+         0.0f, 0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f,
+         0.0f, 1.0f, 0.0f,
+         0.0f, 0.0f, 1.0f}
+    };
+}
+
+bool IsSkinned(const Mesh& mesh) {
+    return mesh.boneIds != nullptr && mesh.boneWeights != nullptr && mesh.animVertices != nullptr;
+}
+
+} // namespace
+
+// Bind pose -> animated pose, matching raylib's per-influence math:
+// v' = rotate(q, (v - bindTranslation) * scale) + translation, q = pose * inverse(bind)
+SkinBone MakeSkinBone(const Transform& bind, const Transform& pose) {
+    Quaternion q = QuaternionMultiply(pose.rotation, QuaternionInvert(bind.rotation));
+    float x = q.x, y = q.y, z = q.z, w = q.w;
+
+    // Same (non-normalizing) expansion as Vector3RotateByQuaternion
+    float r[9] = {
+        x*x + w*w - y*y - z*z, 2*x*y - 2*w*z,         2*x*z + 2*w*y,
+        2*w*z + 2*x*y,         w*w - x*x + y*y - z*z, -2*w*x + 2*y*z,
+        -2*w*y + 2*x*z,        2*w*x + 2*y*z,         w*w - x*x - y*y + z*z
+    };
+    float scale[3] = {pose.scale.x, pose.scale.y, pose.scale.z};
+    float bindTranslation[3] = {bind.translation.x, bind.translation.y, bind.translation.z};
+    float translation[3] = {pose.translation.x, pose.translation.y, pose.translation.z};
+
+    SkinBone bone;
+    for (int row = 0; row < 3; ++row) {
+        float offset = translation[row];
+        for (int col = 0; col < 3; ++col) {
+            float m = r[row * 3 + col] * scale[col];
+            bone.position[row * 4 + col] = m;
+            bone.normal[row * 3 + col] = r[row * 3 + col];
+            offset -= m * bindTranslation[col];
+        }
+        bone.position[row * 4 + 3] = offset;
+    }
+    return bone;
+}
+
+Skinner::Skinner()
+    : m_model(nullptr)
+    , m_animation(nullptr)
+    , m_frame(0)
+    , m_vertexCount(0)
+    , m_pendingUpload(false) {
+}
+
+void Skinner::Init(const Model& model) {
+    m_model = &model;
+    m_bones.assign(static_cast<size_t>(std::max(model.boneCount, 0)), IdentityBone());
+    m_meshes.clear();
+    m_vertexCount = 0;
+    for (int i = 0; i < model.meshCount; ++i) {
+        if (IsSkinned(model.meshes[i])) {
+            m_meshes.push_back({i, m_vertexCount});
+            m_vertexCount += static_cast<uint32_t>(model.meshes[i].vertexCount);
+        }
+    }
+    m_animation = nullptr;
+    m_pendingUpload = false;
+}
+
+Job* Skinner::Schedule(JobSystem& jobs, const Model& model, const ModelAnimation& animation, int frame) {
+    if (m_vertexCount == 0 || animation.frameCount <= 0 || animation.framePoses == nullptr) {
+        return nullptr;
+    }
+    frame %= animation.frameCount;
+    if (&model == m_model && &animation == m_animation && frame == m_frame) {
+        return nullptr;  // Vertices already hold this pose
+    }
+    m_model = &model;
+    m_animation = &animation;
+    m_frame = frame;
+
+    uint32_t boneCount = static_cast<uint32_t>(std::min(model.boneCount, animation.boneCount));
+    Job* bones = jobs.Create(&Skinner::ComputeBonesJob, this, 0, boneCount);
+    Job* vertices = jobs.CreateParallelFor(m_vertexCount, SKINNING_VERTICES_PER_JOB, &Skinner::SkinVerticesJob, this);
+    jobs.AddDependency(vertices, bones);
+    jobs.Submit(vertices);
+    jobs.Submit(bones);
+    m_pendingUpload = true;
+    return vertices;
+}
+
+void Skinner::ComputeBonesJob(void* context, uint32_t begin, uint32_t end) {
+    PROFILE_ZONE("Animation::Pose");
+    Skinner& skinner = *static_cast<Skinner*>(context);
+    const Transform* bindPose = skinner.m_model->bindPose;
+    const Transform* framePose = skinner.m_animation->framePoses[skinner.m_frame];
+    for (uint32_t b = begin; b < end; ++b) {
+        skinner.m_bones[b] = MakeSkinBone(bindPose[b], framePose[b]);
+    }
+}
+
+void Skinner::SkinVerticesJob(void* context, uint32_t begin, uint32_t end) {
+    PROFILE_ZONE("Animation::Skinning");
+    static_cast<const Skinner*>(context)->SkinVertices(begin, end);
+}
+
+void Skinner::SkinVertices(uint32_t begin, uint32_t end) const {
+    const SkinBone* bones = m_bones.data();
+    for (size_t m = 0; m < m_meshes.size() && begin < end; ++m) {
+        const Mesh& mesh = m_model->meshes[m_meshes[m].meshIndex];
+        uint32_t meshFirst = m_meshes[m].firstVertex;
+        uint32_t meshEnd = meshFirst + static_cast<uint32_t>(mesh.vertexCount);
+        if (begin >= meshEnd) continue;
+
+        uint32_t last = std::min(end, meshEnd);
+        bool normals = mesh.normals != nullptr && mesh.animNormals != nullptr;
+        for (uint32_t v = begin - meshFirst; v < last - meshFirst; ++v) {
+            const float* in = mesh.vertices + v * 3;
+            float px = 0.0f, py = 0.0f, pz = 0.0f;
+            float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+            for (uint32_t j = v * 4; j < v * 4 + 4; ++j) {
+                float weight = mesh.boneWeights[j];
+                if (weight == 0.0f) continue;
+                const SkinBone& bone = bones[mesh.boneIds[j]];
+                const float* p = bone.position;
+                px += weight * (p[0] * in[0] + p[1] * in[1] + p[2]  * in[2] + p[3]);
+                py += weight * (p[4] * in[0] + p[5] * in[1] + p[6]  * in[2] + p[7]);
+                pz += weight * (p[8] * in[0] + p[9] * in[1] + p[10] * in[2] + p[11]);
+                if (normals) {
+                    const float* n = bone.normal;
+                    const float* inNormal = mesh.normals + v * 3;
+                    nx += weight * (n[0] * inNormal[0] + n[1] * inNormal[1] + n[2] * inNormal[2]);
+                    ny += weight * (n[3] * inNormal[0] + n[4] * inNormal[1] + n[5] * inNormal[2]);
+                    nz += weight * (n[6] * inNormal[0] + n[7] * inNormal[1] + n[8] * inNormal[2]);
+                }
+            }
+            float* out = mesh.animVertices + v * 3;
+            out[0] = px;
+            out[1] = py;
+            out[2] = pz;
+            if (normals) {
+                float* outNormal = mesh.animNormals + v * 3;
+                outNormal[0] = nx;
+                outNormal[1] = ny;
+                outNormal[2] = nz;
+            }
+        }
+        begin = last;
+    }
+}
+
+void Skinner::Upload() {
+    if (!m_pendingUpload) return;
+    m_pendingUpload = false;
+
+    uint64_t bytes = 0;
+    for (const SkinnedMesh& skinned : m_meshes) {
+        const Mesh& mesh = m_model->meshes[skinned.meshIndex];
+        int size = mesh.vertexCount * 3 * static_cast<int>(sizeof(float));
+        UpdateMeshBuffer(mesh, 0, mesh.animVertices, size, 0);
+        bytes += static_cast<uint64_t>(size);
+        if (mesh.normals != nullptr && mesh.animNormals != nullptr) {
+            UpdateMeshBuffer(mesh, 2, mesh.animNormals, size, 0);
+            bytes += static_cast<uint64_t>(size);
+        }
+    }
+    RenderStats::GetInstance().AddSkinning(m_vertexCount, bytes);
+}
+
+} // namespace TimeMaster
@@ -0,0 +1,182 @@
+#include "TimerWheel.hpp"
+#include "Config.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace TimeMaster {
+
+TimerWheel::TimerWheel(uint32_t capacity)
+    : m_timers(capacity, Timer{0, 0, nullptr, nullptr, 0, 0, NONE, NONE, NONE})
+    , m_free(NONE)
+    , m_pending(0)
+    , m_now(0)
+    , m_sequence(0) {
+    Clear();
+}
+
+void TimerWheel::Clear() {
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_timers.size()); ++i) {
+        Timer& timer = m_timers[i];
+        if (timer.bucket != NONE) {
+            timer.generation++;   // Outstanding handles go stale
+        }
+        timer.bucket = NONE;
+        timer.prev = NONE;
+        timer.next = i + 1 < m_timers.size() ? i + 1 : NONE;
+    }
+    m_free = m_timers.empty() ? NONE : 0;
+    std::fill(std::begin(m_buckets), std::end(m_buckets), NONE);
+    m_pending = 0;
+}
+
+TimerHandle TimerWheel::ScheduleAt(uint64_t tick, TimerCallback callback, void* context, uint32_t data) {
+    return Allocate(tick, m_sequence++, callback, context, data);
+}
+
+TimerHandle TimerWheel::RestoreTimer(const TimerRecord& record, TimerCallback callback, void* context, uint32_t data) {
+    if (record.deadline == 0) return TimerHandle{};
+    return Allocate(record.deadline, record.sequence, callback, context, data);
+}
+
+TimerHandle TimerWheel::Allocate(uint64_t tick, uint64_t sequence, TimerCallback callback, void* context, uint32_t data) {
+    if (m_free == NONE) {
+        TM_LOG_WARNING(GAME, "Timer wheel full (%u timers) - timer dropped", static_cast<uint32_t>(m_timers.size()));
+        return TimerHandle{};
+    }
+
+    uint32_t index = m_free;
+    Timer& timer = m_timers[index];
+    m_free = timer.next;
+
+    // Due no earlier than the next tick, no later than the top level reaches
+    timer.deadline = std::min(std::max(tick, m_now + 1), m_now + MAX_DELAY);
+    timer.sequence = sequence;
+    timer.callback = callback;
+    timer.context = context;
+    timer.data = data;
+    Insert(index);
+    m_pending++;
+    return TimerHandle{index, timer.generation};
+}
+
+void TimerWheel::Insert(uint32_t index) {
+    Timer& timer = m_timers[index];
+    uint64_t delta = timer.deadline - m_now;
+
+    // Lowest level whose span covers the delay; the slot comes from the
+    // deadline's own bits, so the timer is cascaded down (or fires) exactly
+    // when the wheel reaches it
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ull << ((level + 1) * TIMER_WHEEL_SLOT_BITS))) {
+        level++;
+    }
+    uint32_t slot = static_cast<uint32_t>(timer.deadline >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK;
+    uint32_t bucket = static_cast<uint32_t>(level) * SLOTS + slot;
+
+    timer.bucket = bucket;
+    timer.prev = NONE;
+    timer.next = m_buckets[bucket];
+    if (timer.next != NONE) {
+        m_timers[timer.next].prev = index;
+    }
+    m_buckets[bucket] = index;
+}
+
+void TimerWheel::Unlink(uint32_t index) {
+    Timer& timer = m_timers[index];
+    if (timer.prev != NONE) {
+        m_timers[timer.prev].next = timer.next;
+    } else {
+        m_buckets[timer.bucket] = timer.next;
+    }
+    if (timer.next != NONE) {
+        m_timers[timer.next].prev = timer.prev;
+    }
+}
+
+void TimerWheel::Release(uint32_t index) {
+    Unlink(index);
+    Timer& timer = m_timers[index];
+    timer.generation++;
+    timer.bucket = NONE;
+    timer.prev = NONE;
+    timer.next = m_free;
+    m_free = index;
+    m_pending--;
+}
+
+void TimerWheel::Cancel(TimerHandle& handle) {
+    if (IsPending(handle)) {
+        Release(handle.index);
+    }
+    handle = TimerHandle{};
+}
+
+bool TimerWheel::IsPending(TimerHandle handle) const {
+    return handle.index < m_timers.size() &&
+           m_timers[handle.index].generation == handle.generation &&
+           m_timers[handle.index].bucket != NONE;
+}
+
+TimerRecord TimerWheel::SaveTimer(TimerHandle handle) const {
+    if (!IsPending(handle)) return TimerRecord{};
+    const Timer& timer = m_timers[handle.index];
+    return TimerRecord{timer.deadline, timer.sequence};
+}
+
+void TimerWheel::Restart(uint64_t now, uint64_t sequence) {
+    Clear();
+    m_now = now;   // Slots are taken from deadline bits, so any start tick works
+    m_sequence = sequence;
+}
+
+void TimerWheel::Cascade(int level) {
+    uint32_t slot = static_cast<uint32_t>(m_now >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK;
+    uint32_t bucket = static_cast<uint32_t>(level) * SLOTS + slot;
+
+    // Everything here is due within this level's next slot span: re-file it lower
+    uint32_t index = m_buckets[bucket];
+    m_buckets[bucket] = NONE;
+    while (index != NONE) {
+        uint32_t next = m_timers[index].next;
+        Insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::Advance() {
+    PROFILE_ZONE("TimerWheel::Advance");
+
+    m_now++;
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+        uint64_t lowBits = (1ull << (level * TIMER_WHEEL_SLOT_BITS)) - 1;
+        if ((m_now & lowBits) != 0) break;
+        Cascade(level);
+    }
+
+    // Every timer in the current level-0 slot is due now. Pop one at a time,
+    // earliest scheduled first (list order depends on how timers got here),
+    // so callbacks can cancel the others; new timers never land in this slot.
+    uint32_t& head = m_buckets[m_now & SLOT_MASK];
+    while (head != NONE) {
+        uint32_t index = head;
+        for (uint32_t i = m_timers[head].next; i != NONE; i = m_timers[i].next) {
+            if (m_timers[i].sequence < m_timers[index].sequence) index = i;
+        }
+        TimerCallback callback = m_timers[index].callback;
+        void* context = m_timers[index].context;
+        uint32_t data = m_timers[index].data;
+        Release(index);
+        callback(context, data);
+    }
+}
+
+uint64_t TimerWheel::SecondsToTicks(float seconds) {
+    // Small epsilon so exact multiples of the tick (e.g. 1.5 s) do not round up
+    double ticks = std::ceil(static_cast<double>(seconds) * SIMULATION_TICK_RATE - 1e-4);
+    return ticks < 1.0 ? 1 : static_cast<uint64_t>(ticks);
+}
+
+} // namespace TimeMaster
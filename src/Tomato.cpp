@@ -1,88 +1,74 @@
 #include "Tomato.hpp"
+#include "RenderStats.hpp"
 #include "raymath.h"
+#include <cmath>
 
 namespace TimeMaster {
 
-// Static member initialization
-Model Tomato::s_model = {0};
-bool Tomato::s_modelLoaded = false;
+namespace {
+constexpr float TOMATO_SPIN_DEGREES_PER_SECOND = 90.0f;
 
-Tomato::Tomato() 
-    : m_position{0, 0, 0}
-    , m_radius(TOMATO_RADIUS)
-    , m_lifetime(0.0f)
-    , m_rotationAngle(0.0f)
-    , m_active(false) {
+// Timer context is the archetype, data the entity
+void OnTomatoExpired(void* context, uint32_t entity) {
+    static_cast<TomatoArchetype*>(context)->Destroy(entity);
+}
 }
 
-void Tomato::LoadModel() {
-    if (!s_modelLoaded) {
-        s_model = ::LoadModel("assets/models/tomato/scene.gltf");
-        // Check if model loaded successfully with valid meshes and materials
-        if (s_model.meshCount > 0 && s_model.meshes != nullptr) {
-            s_modelLoaded = true;
-            TraceLog(LOG_INFO, "Tomato model loaded successfully");
-        } else {
-            TraceLog(LOG_WARNING, "Failed to load tomato model - using fallback rendering");
-            // Ensure the model is zeroed out if it failed to load
-            s_model = (Model){0};
-            s_modelLoaded = false;
-        }
-    }
+EntityId SpawnTomato(TomatoArchetype& tomatoes, TimerWheel& timers, Vector3 position, float lifetime) {
+    EntityId entity = tomatoes.Create();
+    if (entity == INVALID_ENTITY) return entity;
+
+    uint32_t row = tomatoes.GetRow(entity);
+    tomatoes.Get<Position>()[row] = {position};
+    tomatoes.Get<Collider>()[row] = {TOMATO_RADIUS};
+    tomatoes.Get<Lifetime>()[row] = {timers.GetNow(), timers.Schedule(TimerWheel::SecondsToTicks(lifetime),
+                                                                      &OnTomatoExpired, &tomatoes, entity)};
+    return entity;
 }
 
-void Tomato::UnloadModel() {
-    if (s_modelLoaded) {
-        ::UnloadModel(s_model);
-        s_modelLoaded = false;
-    }
+void CollectTomato(TomatoArchetype& tomatoes, TimerWheel& timers, uint32_t row) {
+    timers.Cancel(tomatoes.Get<Lifetime>()[row].expiry);
+    tomatoes.DestroyRow(row);
 }
 
-void Tomato::Spawn(float x, float y, float z) {
-    auto& config = GameConfig::GetInstance();
-    m_position = {x, y, z};
-    m_active = true;
-    m_lifetime = config.tomatoLifetime;
-    m_rotationAngle = 0.0f;
+void SaveTomatoTimers(const TomatoArchetype& tomatoes, const TimerWheel& timers, TimerRecord* records) {
+    const Lifetime* lifetimes = tomatoes.Get<Lifetime>();
+    for (uint32_t row = 0; row < tomatoes.GetCount(); ++row) {
+        records[row] = timers.SaveTimer(lifetimes[row].expiry);
+    }
 }
 
-void Tomato::Update(float deltaTime) {
-    if (!m_active) return;
-    
-    m_lifetime -= deltaTime;
-    m_rotationAngle += deltaTime * 90.0f;
-    
-    if (m_lifetime <= 0) {
-        m_active = false;
+void RestoreTomatoTimers(TomatoArchetype& tomatoes, TimerWheel& timers, const TimerRecord* records) {
+    Lifetime* lifetimes = tomatoes.Get<Lifetime>();
+    for (uint32_t row = 0; row < tomatoes.GetCount(); ++row) {
+        lifetimes[row].expiry = timers.RestoreTimer(records[row], &OnTomatoExpired, &tomatoes, tomatoes.GetEntity(row));
     }
 }
 
-void Tomato::Draw() const {
-    if (!m_active) return;
-    
-    if (s_modelLoaded) {
-        DrawModelEx(s_model, m_position, {0, 1, 0}, m_rotationAngle, {m_radius, m_radius, m_radius}, WHITE);
+TomatoSnapshot GetTomatoSnapshot(const TomatoArchetype& tomatoes, uint32_t row, uint64_t now) {
+    float age = static_cast<float>(now - tomatoes.Get<Lifetime>()[row].spawnTick) / SIMULATION_TICK_RATE;
+    float rotation = fmodf(age * TOMATO_SPIN_DEGREES_PER_SECOND, 360.0f);
+    return {tomatoes.Get<Position>()[row].value, tomatoes.Get<Collider>()[row].radius, rotation, true};
+}
+
+void DrawTomatoSnapshot(const TomatoSnapshot& snapshot, const ModelAsset& asset) {
+    if (!snapshot.active) return;
+
+    float radius = snapshot.radius;
+    if (asset.loaded) {
+        Gfx::DrawModelEx(asset.model, snapshot.position, {0, 1, 0}, snapshot.rotation, {radius, radius, radius}, WHITE);
     } else {
         // Fallback to sphere if model not loaded
-        DrawSphere(m_position, m_radius, RED);
-        
+        Gfx::DrawSphere(snapshot.position, radius, RED);
+
         // Draw stem
         Vector3 stemPos = {
-            m_position.x, 
-            m_position.y + m_radius * 0.8f, 
-            m_position.z
+            snapshot.position.x,
+            snapshot.position.y + radius * 0.8f,
+            snapshot.position.z
         };
-        DrawSphere(stemPos, m_radius * 0.3f, GREEN);
+        Gfx::DrawSphere(stemPos, radius * 0.3f, GREEN);
     }
 }
 
-void Tomato::OnCollect() {
-    m_active = false;
-}
-
-bool Tomato::CheckCollision(Vector3 pos, float otherRadius) const {
-    if (!m_active) return false;
-    return Vector3Distance(m_position, pos) < m_radius + otherRadius;
-}
-
 } // namespace TimeMaster
@@ -0,0 +1,161 @@
+#include "UdpSocket.hpp"
+#include "Log.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace TimeMaster {
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+const SocketHandle INVALID_HANDLE = INVALID_SOCKET;
+
+bool StartNetworking() {
+    static bool started = false;
+    if (!started) {
+        WSADATA data;
+        started = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }
+    return started;
+}
+
+bool SetNonBlocking(SocketHandle handle) {
+    u_long enabled = 1;
+    return ioctlsocket(handle, FIONBIO, &enabled) == 0;
+}
+
+void CloseSocket(SocketHandle handle) {
+    closesocket(handle);
+}
+#else
+using SocketHandle = int;
+const SocketHandle INVALID_HANDLE = -1;
+
+bool StartNetworking() {
+    return true;
+}
+
+bool SetNonBlocking(SocketHandle handle) {
+    int flags = fcntl(handle, F_GETFL, 0);
+    return flags != -1 && fcntl(handle, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void CloseSocket(SocketHandle handle) {
+    close(handle);
+}
+#endif
+
+sockaddr_in ToSockaddr(const NetAddress& address) {
+    sockaddr_in result;
+    std::memset(&result, 0, sizeof(result));
+    result.sin_family = AF_INET;
+    result.sin_addr.s_addr = htonl(address.ip);
+    result.sin_port = htons(address.port);
+    return result;
+}
+
+} // namespace
+
+bool ResolveAddress(const char* host, uint16_t port, NetAddress& address) {
+    if (!StartNetworking()) return false;
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &result) != 0 || !result) {
+        TM_LOG_ERROR(NET, "Cannot resolve %s", host);
+        return false;
+    }
+    const sockaddr_in* ipv4 = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    address.ip = ntohl(ipv4->sin_addr.s_addr);
+    address.port = port;
+    freeaddrinfo(result);
+    return true;
+}
+
+UdpSocket::UdpSocket() : m_handle(-1) {
+}
+
+UdpSocket::~UdpSocket() {
+    Close();
+}
+
+bool UdpSocket::Open(uint16_t port) {
+    Close();
+    if (!StartNetworking()) return false;
+
+    SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_HANDLE) {
+        TM_LOG_ERROR(NET, "Cannot create a UDP socket");
+        return false;
+    }
+    sockaddr_in local = ToSockaddr(NetAddress{INADDR_ANY, port});
+    if (bind(handle, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+        TM_LOG_ERROR(NET, "Cannot bind UDP port %u", static_cast<unsigned>(port));
+        CloseSocket(handle);
+        return false;
+    }
+    if (!SetNonBlocking(handle)) {
+        TM_LOG_ERROR(NET, "Cannot make the UDP socket non-blocking");
+        CloseSocket(handle);
+        return false;
+    }
+    m_handle = static_cast<intptr_t>(handle);
+    return true;
+}
+
+void UdpSocket::Close() {
+    if (m_handle != -1) {
+        CloseSocket(static_cast<SocketHandle>(m_handle));
+        m_handle = -1;
+    }
+}
+
+bool UdpSocket::SetBufferSize(uint32_t bytes) {
+    if (m_handle == -1) return false;
+    int size = static_cast<int>(bytes);
+    SocketHandle handle = static_cast<SocketHandle>(m_handle);
+    bool ok = setsockopt(handle, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&size), sizeof(size)) == 0;
+    ok = setsockopt(handle, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&size), sizeof(size)) == 0 && ok;
+    if (!ok) {
+        TM_LOG_WARNING(NET, "Cannot grow the UDP socket buffers to %u bytes", bytes);
+    }
+    return ok;
+}
+
+bool UdpSocket::Send(const NetAddress& to, const uint8_t* data, uint32_t size) {
+    if (m_handle == -1) return false;
+    sockaddr_in address = ToSockaddr(to);
+    auto sent = sendto(static_cast<SocketHandle>(m_handle), reinterpret_cast<const char*>(data), size, 0,
+                       reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+int UdpSocket::Receive(NetAddress& from, uint8_t* data, uint32_t capacity) {
+    if (m_handle == -1) return -1;
+    sockaddr_in address;
+    socklen_t length = sizeof(address);
+    auto received = recvfrom(static_cast<SocketHandle>(m_handle), reinterpret_cast<char*>(data), capacity, 0,
+                             reinterpret_cast<sockaddr*>(&address), &length);
+    if (received < 0) return -1;   // Nothing queued (or a transient error: treated the same)
+    from.ip = ntohl(address.sin_addr.s_addr);
+    from.port = ntohs(address.sin_port);
+    return static_cast<int>(received);
+}
+
+} // namespace TimeMaster
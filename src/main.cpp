@@ -1,28 +1,206 @@
 #include "Game.hpp"
+#include "AllocTracker.hpp"
 #include "Config.hpp"
+#include "DeterminismTest.hpp"
+#include "FlightRecorder.hpp"
+#include "FrameSnapshot.hpp"
+#include "GameAssets.hpp"
+#include "Input.hpp"
+#include "JobSystem.hpp"
+#include "NetSession.hpp"
+#include "NetTest.hpp"
+#include "PerfScenario.hpp"
+#include "Profiler.hpp"
+#include "RenderStats.hpp"
+#include "Renderer.hpp"
+#include "SimulationThread.hpp"
+#include "TripleBuffer.hpp"
 #include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
 
 using namespace TimeMaster;
 
-int main() {
+namespace {
+
+void PrintUsage(const char* program) {
+    std::printf("Usage: %s [--perf <scenario|all> [--baseline <json>] [--results <json>]\n"
+                "          [--write-baseline <json>] [--frames <n>] [--warmup <n>]]\n"
+                "       %s [--alloc-test <scenario|all> [--frames <n>] [--warmup <n>]]\n"
+                "       %s [--determinism-test [--ticks <n>] [--seed <n>] [--horde] [--record <file> | --verify <file>]]\n"
+                "       %s [--coop-host <port> | --coop-join <host[:port]>] [--net-test [--ticks <n>] [--seed <n>]]\n"
+                "          [--net-latency <ms>] [--net-jitter <ms>] [--net-loss <percent>]\n"
+                "       --workers <n>   job system worker threads (default: hardware threads - 1)\n"
+                "       --hitch-ms <ms> frame time that dumps the flight recorder (default: 33)\n"
+                "Perf scenarios:\n", program, program, program, program);
+    ListPerfScenarios();
+}
+
+/**
+ * @brief Parse "host", "host:port" for --coop-join
+ */
+void ParseJoinAddress(const std::string& value, NetOptions& options) {
+    size_t colon = value.rfind(':');
+    if (colon == std::string::npos) {
+        options.address = value;
+        return;
+    }
+    options.address = value.substr(0, colon);
+    options.port = static_cast<uint16_t>(std::atoi(value.c_str() + colon + 1));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // Scripted performance runs
+    bool perfMode = false;
+    PerfOptions perfOptions;
+    bool determinismMode = false;
+    DeterminismOptions determinismOptions;
+    bool netTestMode = false;
+    NetOptions netOptions;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--perf" && hasValue) {
+            perfMode = true;
+            perfOptions.scenario = argv[++i];
+        } else if (arg == "--alloc-test" && hasValue) {
+            perfMode = true;
+            perfOptions.allocTest = true;
+            perfOptions.scenario = argv[++i];
+        } else if (arg == "--determinism-test") {
+            determinismMode = true;
+        } else if (arg == "--ticks" && hasValue) {
+            determinismOptions.ticks = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            determinismOptions.seed = std::strtoull(argv[++i], nullptr, 0);
+            netOptions.seed = determinismOptions.seed;
+        } else if (arg == "--coop-host" && hasValue) {
+            netOptions.enabled = true;
+            netOptions.host = true;
+            netOptions.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--coop-join" && hasValue) {
+            netOptions.enabled = true;
+            netOptions.host = false;
+            ParseJoinAddress(argv[++i], netOptions);
+        } else if (arg == "--net-latency" && hasValue) {
+            netOptions.conditions.latencyMs = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--net-jitter" && hasValue) {
+            netOptions.conditions.jitterMs = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--net-loss" && hasValue) {
+            netOptions.conditions.lossPercent = std::max(0.0f, std::min(100.0f, static_cast<float>(std::atof(argv[++i]))));
+        } else if (arg == "--net-test") {
+            netTestMode = true;
+        } else if (arg == "--horde") {
+            determinismOptions.horde = true;
+        } else if (arg == "--record" && hasValue) {
+            determinismOptions.recordPath = argv[++i];
+        } else if (arg == "--verify" && hasValue) {
+            determinismOptions.verifyPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            perfOptions.baselinePath = argv[++i];
+        } else if (arg == "--results" && hasValue) {
+            perfOptions.resultsPath = argv[++i];
+        } else if (arg == "--write-baseline" && hasValue) {
+            perfOptions.writeBaselinePath = argv[++i];
+        } else if (arg == "--frames" && hasValue) {
+            perfOptions.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            perfOptions.warmupFrames = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--workers" && hasValue) {
+            JobSystem::SetWorkerCount(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--hitch-ms" && hasValue) {
+            FlightRecorder::SetHitchThreshold(std::max(1.0f, static_cast<float>(std::atof(argv[++i]))));
+        } else {
+            PrintUsage(argv[0]);
+            return (arg == "--help" || arg == "-h") ? 0 : 2;
+        }
+    }
+    if (netTestMode) {
+        if (!netOptions.enabled) {
+            std::fprintf(stderr, "--net-test needs --coop-host or --coop-join\n");
+            return 2;
+        }
+        if (netOptions.seed == 0) {
+            netOptions.seed = determinismOptions.seed;
+        }
+        return RunNetTest(netOptions, determinismOptions.ticks);
+    }
+    if (determinismMode) {
+        return RunDeterminismTest(determinismOptions);
+    }
+    if (perfMode) {
+        return RunPerfScenarios(perfOptions);
+    }
+    
     // Initialize window
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Time Master - Boss Fight (3D)");
     SetTargetFPS(60);
     
+    // Models are loaded once on the GL thread and shared read-only
+    GameAssets assets;
+    assets.Load();
+    
     // Create game instance
-    Game game;
+    Game game(assets, static_cast<uint64_t>(time(nullptr)));
+    Renderer renderer(assets);
+    
+    // Co-op: the session drives the game from the simulation thread
+    std::unique_ptr<NetSession> session;
+    if (netOptions.enabled) {
+        session = std::make_unique<NetSession>(game, netOptions, 1.0f / SIMULATION_TICK_RATE);
+        if (!session->Open()) {
+            assets.Unload();
+            CloseWindow();
+            return 1;
+        }
+    }
     
-    // Main game loop
-    while (!game.ShouldClose()) {
-        game.Update();
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.SetThreadName("Main");
+    RenderStats& renderStats = RenderStats::GetInstance();
+    FlightRecorder& flightRecorder = FlightRecorder::GetInstance();
+    
+    // The simulation runs on its own thread; this one samples input and draws
+    // the newest published snapshot
+    InputMailbox input;
+    auto snapshots = std::make_unique<TripleBuffer<FrameSnapshot>>();
+    game.WriteSnapshot(snapshots->GetWriteSlot());
+    snapshots->Publish();
+    SimulationThread simulation(game, input, *snapshots, session.get());
+    simulation.Start();
+    
+    // Main loop (render thread)
+    while (!WindowShouldClose()) {
+        profiler.BeginFrame();
+        renderStats.BeginFrame();
+        
+        renderer.HandleDebugKeys();
+        input.Push(SampleInput());
+        snapshots->Acquire();
+        const FrameSnapshot& frame = snapshots->GetReadSlot();
         
         BeginDrawing();
         ClearBackground(RAYWHITE);
-        game.Draw();
+        renderer.Draw(frame);
         EndDrawing();
+        
+        renderStats.EndFrame();
+        AllocTracker::GetInstance().EndFrame();
+        profiler.EndFrame();
+        flightRecorder.SetGameplaySample(frame.flight);
+        flightRecorder.EndFrame(profiler);
     }
     
+    simulation.Stop();
+    
     // Cleanup
+    assets.Unload();
     CloseWindow();
     
     return 0;